@@ -0,0 +1,77 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE batch transpilation throughput benchmark
+# ==============================================================================
+#
+# Copies the example programs COPIES times into a scratch directory and
+# transpiles them all with one `gate batch` per worker count. Prints the best
+# files/s of each count and its speedup over one worker, and warns when the
+# generated files change with the worker count.
+#
+# USAGE:
+#   benchmarks/batch_scaling.sh [gate flags...]
+#
+# EXAMPLE:
+#   THREADS="1 2 4 8" COPIES=200 benchmarks/batch_scaling.sh --profile=release
+#
+# ENVIRONMENT:
+#   GATE    - path to the gate executable (default: ./bin/gate)
+#   INPUTS  - directory of .notal files to copy (default: examples)
+#   COPIES  - copies of every input file (default: 100)
+#   THREADS - worker counts to time (default: powers of two up to nproc)
+#   RUNS    - number of timed runs per count, best is reported (default: 3)
+# ==============================================================================
+
+set -euo pipefail
+
+GATE=${GATE:-./bin/gate}
+INPUTS=${INPUTS:-examples}
+COPIES=${COPIES:-100}
+RUNS=${RUNS:-3}
+
+if [ -z "${THREADS:-}" ]; then
+    THREADS=""
+    cores=$(nproc)
+    for ((n = 1; n < cores; n *= 2)); do
+        THREADS="$THREADS $n"
+    done
+    THREADS="$THREADS $cores"
+fi
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+mkdir -p "$work/in"
+for ((copy = 0; copy < COPIES; copy++)); do
+    for file in "$INPUTS"/*.notal; do
+        cp "$file" "$work/in/$(basename "$file" .notal)_$copy.notal"
+    done
+done
+ls "$work"/in/*.notal > "$work/files.txt"
+files=$(wc -l < "$work/files.txt")
+
+echo "batch: $files files"
+printf '%-8s %10s %10s %8s\n' workers time files/s speedup
+base=""
+for workers in $THREADS; do
+    best=""
+    for _ in $(seq "$RUNS"); do
+        rm -rf "$work/out"
+        start=$(date +%s.%N)
+        # Inputs that fail to transpile are reported by gate and counted as well.
+        "$GATE" batch -q -j "$workers" --out-dir "$work/out" "$@" "@$work/files.txt" > /dev/null 2>&1 || true
+        end=$(date +%s.%N)
+        elapsed=$(echo "$end - $start" | bc)
+        if [ -z "$best" ] || [ "$(echo "$elapsed < $best" | bc)" -eq 1 ]; then
+            best=$elapsed
+        fi
+    done
+    if [ -z "$base" ]; then
+        base=$best
+        mv "$work/out" "$work/base"
+    elif ! diff -rq "$work/base" "$work/out" > /dev/null; then
+        echo "warning: output with $workers workers differs from the first run" >&2
+    fi
+    printf '%-8s %9.3fs %10.1f %7.2fx\n' "$workers" "$best" "$(echo "$files / $best" | bc -l)" \
+        "$(echo "$base / $best" | bc -l)"
+done
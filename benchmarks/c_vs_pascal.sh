@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE C target versus Pascal target benchmark
+# ==============================================================================
+#
+# Transpiles each NOTAL program twice, with --target=pascal and --target=c,
+# builds the results with `fpc -O2 -Mobjfpc` and `cc -O2`, and reports the compile and
+# run wall-clock times of both. Warns when the outputs differ.
+# If <name>.stdin.sh exists next to a program, its output is fed to both runs.
+#
+# USAGE:
+#   benchmarks/c_vs_pascal.sh [program.notal...]
+#
+# EXAMPLE:
+#   benchmarks/c_vs_pascal.sh benchmarks/fib_recursive.notal examples/*.notal
+#
+# ENVIRONMENT:
+#   GATE  - path to the gate executable (default: ./bin/gate)
+#   FPC   - path to the Free Pascal compiler (default: fpc)
+#   CC    - path to the C compiler (default: cc)
+# ==============================================================================
+
+set -euo pipefail
+
+GATE=${GATE:-./bin/gate}
+FPC=${FPC:-fpc}
+CC=${CC:-cc}
+
+if [ $# -eq 0 ]; then
+    set -- benchmarks/*.notal
+fi
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+elapsed() {
+    local start end
+    start=$(date +%s.%N)
+    "$@" < "$work/stdin.txt" > "$work/out.txt" 2>&1 || true
+    end=$(date +%s.%N)
+    echo "$end - $start" | bc
+}
+
+printf '%-24s %12s %10s %12s %10s\n' "program" "fpc build" "fpc run" "cc build" "cc run"
+for source_file in "$@"; do
+    name=$(basename "$source_file" .notal)
+    stdin_script="$(dirname "$source_file")/$name.stdin.sh"
+    if [ -f "$stdin_script" ]; then
+        bash "$stdin_script" > "$work/stdin.txt"
+    else
+        : > "$work/stdin.txt"
+    fi
+
+    "$GATE" "$source_file" -o "$work/$name.pas" > /dev/null
+    fpc_build=$(elapsed "$FPC" -O2 -Mobjfpc -v0 -o"$work/$name.fpc" "$work/$name.pas")
+    fpc_time=$(elapsed "$work/$name.fpc")
+    mv "$work/out.txt" "$work/fpc.out"
+
+    "$GATE" "$source_file" --target=c -o "$work/$name.c" > /dev/null
+    cc_build=$(elapsed "$CC" -O2 -o "$work/$name.cc" "$work/$name.c" -lm)
+    cc_time=$(elapsed "$work/$name.cc")
+    mv "$work/out.txt" "$work/cc.out"
+
+    printf '%-24s %10.3f s %8.3f s %10.3f s %8.3f s\n' "$name" "$fpc_build" "$fpc_time" "$cc_build" "$cc_time"
+    if ! cmp -s "$work/fpc.out" "$work/cc.out"; then
+        echo "warning: output of $name differs between the Pascal and C targets" >&2
+    fi
+done
@@ -0,0 +1,125 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE generated-code benchmark (JSON report)
+# ==============================================================================
+#
+# Transpiles every NOTAL example and benchmark program with fixed GATE flags,
+# compiles each with fpc under fixed flags and runs it RUNS times on a fixed
+# stdin. Writes one JSON document with the median and best wall-clock time,
+# the median CPU time (user + system), the binary size and a checksum of the
+# output of every program, so reports from two GATE commits can be diffed.
+#
+# Stdin comes from benchmarks/fixtures/<name>.stdin, or from the output of
+# <name>.stdin.sh next to the program; otherwise it is empty. Programs that
+# fail to transpile, compile or run are reported with their status and no
+# timings.
+#
+# USAGE:
+#   benchmarks/codegen_bench.sh [program.notal...] > report.json
+#
+# EXAMPLE:
+#   OUT=before.json benchmarks/codegen_bench.sh
+#   git checkout my-branch && make && OUT=after.json benchmarks/codegen_bench.sh
+#   diff <(jq '.programs' before.json) <(jq '.programs' after.json)
+#
+# ENVIRONMENT:
+#   GATE       - path to the gate executable (default: ./bin/gate)
+#   FPC        - path to the Free Pascal compiler (default: fpc)
+#   GATE_FLAGS - flags passed to gate (default: --profile=release)
+#   FPC_FLAGS  - flags passed to fpc (default: -O2 -Mobjfpc -v0)
+#   RUNS       - number of timed runs per program (default: 5)
+#   OUT        - file to write the report to (default: stdout)
+# ==============================================================================
+
+set -uo pipefail
+
+GATE=${GATE:-./bin/gate}
+FPC=${FPC:-fpc}
+GATE_FLAGS=${GATE_FLAGS:---profile=release}
+FPC_FLAGS=${FPC_FLAGS:--O2 -Mobjfpc -v0}
+RUNS=${RUNS:-5}
+OUT=${OUT:-/dev/stdout}
+read -r -a gate_flags <<< "$GATE_FLAGS"
+read -r -a fpc_flags <<< "$FPC_FLAGS"
+
+if [ $# -eq 0 ]; then
+    set -- examples/*.notal benchmarks/*.notal
+fi
+if ! command -v "$FPC" > /dev/null; then
+    echo "error: fpc not found (set FPC)" >&2
+    exit 1
+fi
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+json_string() {
+    local text=${1//\\/\\\\}
+    text=${text//\"/\\\"}
+    printf '"%s"' "$text"
+}
+
+# Prints the median of the numbers on stdin
+median() {
+    sort -g | awk '{ v[NR] = $1 } END { if (NR % 2) print v[(NR + 1) / 2]; else print (v[NR / 2] + v[NR / 2 + 1]) / 2 }'
+}
+
+commit=$(git rev-parse --short HEAD 2> /dev/null || echo unknown)
+if [ -n "$(git status --porcelain --untracked-files=no 2> /dev/null)" ]; then
+    commit="$commit-dirty"
+fi
+
+{
+    printf '{\n'
+    printf '  "gate_commit": %s,\n' "$(json_string "$commit")"
+    printf '  "gate_flags": %s,\n' "$(json_string "$GATE_FLAGS")"
+    printf '  "fpc_version": %s,\n' "$(json_string "$("$FPC" -iV 2> /dev/null)")"
+    printf '  "fpc_flags": %s,\n' "$(json_string "$FPC_FLAGS")"
+    printf '  "host": %s,\n' "$(json_string "$(uname -sm)")"
+    printf '  "date": %s,\n' "$(json_string "$(date -u +%Y-%m-%dT%H:%M:%SZ)")"
+    printf '  "runs": %d,\n' "$RUNS"
+    printf '  "programs": ['
+
+    separator=""
+    for source_file in "$@"; do
+        name=$(basename "$source_file" .notal)
+        printf '%s\n    {"name": %s, "source": %s, ' "$separator" "$(json_string "$name")" "$(json_string "$source_file")"
+        separator=","
+
+        if [ -f "benchmarks/fixtures/$name.stdin" ]; then
+            cp "benchmarks/fixtures/$name.stdin" "$work/stdin.txt"
+        elif [ -f "$(dirname "$source_file")/$name.stdin.sh" ]; then
+            bash "$(dirname "$source_file")/$name.stdin.sh" > "$work/stdin.txt"
+        else
+            : > "$work/stdin.txt"
+        fi
+
+        if ! "$GATE" "$source_file" -o "$work/$name.pas" "${gate_flags[@]}" > /dev/null 2>&1; then
+            printf '"status": "transpile_failed"}'
+            continue
+        fi
+        if ! "$FPC" "${fpc_flags[@]}" -o"$work/$name" "$work/$name.pas" > /dev/null 2>&1; then
+            printf '"status": "compile_failed"}'
+            continue
+        fi
+
+        status=ok
+        : > "$work/wall.txt"
+        : > "$work/cpu.txt"
+        for ((run = 0; run < RUNS; run++)); do
+            TIMEFORMAT='%R %U %S'
+            if ! { time "$work/$name" < "$work/stdin.txt" > "$work/out.txt" 2> /dev/null; } 2> "$work/time.txt"; then
+                status=run_failed
+            fi
+            read -r wall user sys < "$work/time.txt"
+            echo "$wall" >> "$work/wall.txt"
+            echo "$user $sys" | awk '{ print $1 + $2 }' >> "$work/cpu.txt"
+        done
+
+        printf '"status": "%s", "binary_bytes": %d, ' "$status" "$(wc -c < "$work/$name" | tr -d ' ')"
+        printf '"wall_median_s": %s, "wall_min_s": %s, "cpu_median_s": %s, ' \
+            "$(median < "$work/wall.txt")" "$(sort -g "$work/wall.txt" | head -1)" "$(median < "$work/cpu.txt")"
+        printf '"output_cksum": %s}' "$(json_string "$(cksum < "$work/out.txt" | cut -d ' ' -f 1)")"
+    done
+    printf '\n  ]\n}\n'
+} > "$OUT"
@@ -0,0 +1,3 @@
+#!/usr/bin/env bash
+# One million small integers, one per line.
+seq 1 1000000 | awk '{ print $1 % 1000 }'
@@ -0,0 +1,73 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE parallel traversal scaling benchmark
+# ==============================================================================
+#
+# Transpiles a NOTAL benchmark that uses `traversal paralel`, compiles it once
+# with fpc and times it with GATE_THREADS set to each worker count. Prints
+# the best wall-clock time of each count and its speedup over one worker,
+# and warns when the output changes with the worker count.
+#
+# USAGE:
+#   benchmarks/parallel_scaling.sh [benchmark.notal] [gate flags...]
+#
+# EXAMPLE:
+#   THREADS="1 2 4 8 16" benchmarks/parallel_scaling.sh benchmarks/parallel_spin.notal
+#
+# ENVIRONMENT:
+#   GATE    - path to the gate executable (default: ./bin/gate)
+#   FPC     - path to the Free Pascal compiler (default: fpc)
+#   THREADS - worker counts to time (default: powers of two up to nproc)
+#   RUNS    - number of timed runs per count, best is reported (default: 3)
+# ==============================================================================
+
+set -euo pipefail
+
+GATE=${GATE:-./bin/gate}
+FPC=${FPC:-fpc}
+RUNS=${RUNS:-3}
+
+source_file=${1:-benchmarks/parallel_spin.notal}
+shift || true
+if [ $# -eq 0 ]; then
+    set -- --profile=release
+fi
+
+if [ -z "${THREADS:-}" ]; then
+    THREADS=""
+    cores=$(nproc)
+    for ((n = 1; n < cores; n *= 2)); do
+        THREADS="$THREADS $n"
+    done
+    THREADS="$THREADS $cores"
+fi
+
+name=$(basename "$source_file" .notal)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+"$GATE" "$source_file" -o "$work/$name.pas" "$@" > /dev/null
+"$FPC" -O2 -Mobjfpc -v0 -o"$work/$name" "$work/$name.pas" > /dev/null
+
+echo "benchmark: $name"
+printf '%-8s %10s %8s\n' workers time speedup
+base=""
+for workers in $THREADS; do
+    best=""
+    for _ in $(seq "$RUNS"); do
+        start=$(date +%s.%N)
+        GATE_THREADS=$workers "$work/$name" < /dev/null > "$work/$workers.out"
+        end=$(date +%s.%N)
+        elapsed=$(echo "$end - $start" | bc)
+        if [ -z "$best" ] || [ "$(echo "$elapsed < $best" | bc)" -eq 1 ]; then
+            best=$elapsed
+        fi
+    done
+    if [ -z "$base" ]; then
+        base=$best
+        cp "$work/$workers.out" "$work/base.out"
+    elif ! cmp -s "$work/base.out" "$work/$workers.out"; then
+        echo "warning: output with $workers workers differs from the first run" >&2
+    fi
+    printf '%-8s %9.3fs %7.2fx\n' "$workers" "$best" "$(echo "$base / $best" | bc -l)"
+done
@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE build profile benchmark
+# ==============================================================================
+#
+# Transpiles every NOTAL example under each --profile (none, release, debug,
+# checked), compiles the programs with fpc and prints a table of wall-clock
+# run times. Examples that fail to transpile or compile under a profile are
+# reported as "-". Programs read from /dev/null.
+#
+# USAGE:
+#   benchmarks/profile_bench.sh [examples directory]
+#
+# ENVIRONMENT:
+#   GATE  - path to the gate executable (default: ./bin/gate)
+#   FPC   - path to the Free Pascal compiler (default: fpc)
+#   RUNS  - number of timed runs per program, best is reported (default: 5)
+# ==============================================================================
+
+set -uo pipefail
+
+GATE=${GATE:-./bin/gate}
+FPC=${FPC:-fpc}
+RUNS=${RUNS:-5}
+examples=${1:-examples}
+profiles=(none release debug checked)
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+time_variant() {
+    local source_file=$1 profile=$2
+    local name label flags=()
+    name=$(basename "$source_file" .notal)
+    label="$name-$profile"
+    if [ "$profile" != none ]; then
+        flags=(--profile="$profile")
+    fi
+    "$GATE" "$source_file" -o "$work/$label.pas" "${flags[@]}" > /dev/null 2>&1 || { echo "-"; return; }
+    "$FPC" -v0 -o"$work/$label" "$work/$label.pas" > /dev/null 2>&1 || { echo "-"; return; }
+
+    local best="" start end elapsed
+    for _ in $(seq "$RUNS"); do
+        start=$(date +%s.%N)
+        "$work/$label" < /dev/null > /dev/null 2>&1
+        end=$(date +%s.%N)
+        elapsed=$(echo "$end - $start" | bc)
+        if [ -z "$best" ] || [ "$(echo "$elapsed < $best" | bc)" -eq 1 ]; then
+            best=$elapsed
+        fi
+    done
+    printf '%.4f' "$best"
+}
+
+printf '%-24s' example
+for profile in "${profiles[@]}"; do
+    printf '%10s' "$profile"
+done
+printf '\n'
+
+for source_file in "$examples"/*.notal; do
+    printf '%-24s' "$(basename "$source_file" .notal)"
+    for profile in "${profiles[@]}"; do
+        printf '%10s' "$(time_variant "$source_file" "$profile")"
+    done
+    printf '\n'
+done
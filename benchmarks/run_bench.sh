@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE code generation benchmark
+# ==============================================================================
+#
+# Transpiles a NOTAL benchmark twice (with BASE_FLAGS, and with the given GATE
+# flags), compiles both programs with fpc and reports the wall-clock time of
+# each run.
+# If benchmarks/<name>.stdin.sh exists, its output is fed to the program.
+#
+# USAGE:
+#   benchmarks/run_bench.sh <benchmark.notal> [gate flags...]
+#
+# EXAMPLE:
+#   benchmarks/run_bench.sh benchmarks/output_million.notal --fast-io
+#   BASE_FLAGS="--profile=release --inline-threshold=0" \
+#       benchmarks/run_bench.sh benchmarks/call_heavy.notal --profile=release
+#
+# ENVIRONMENT:
+#   GATE  - path to the gate executable (default: ./bin/gate)
+#   FPC   - path to the Free Pascal compiler (default: fpc)
+#   BASE_FLAGS - GATE flags for the baseline build (default: none)
+# ==============================================================================
+
+set -euo pipefail
+
+GATE=${GATE:-./bin/gate}
+FPC=${FPC:-fpc}
+read -r -a base_flags <<< "${BASE_FLAGS:-}"
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <benchmark.notal> [gate flags...]" >&2
+    exit 1
+fi
+
+source_file=$1
+shift
+name=$(basename "$source_file" .notal)
+stdin_script="$(dirname "$source_file")/$name.stdin.sh"
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+if [ -f "$stdin_script" ]; then
+    bash "$stdin_script" > "$work/stdin.txt"
+else
+    : > "$work/stdin.txt"
+fi
+
+run_variant() {
+    local label=$1
+    shift
+    "$GATE" "$source_file" -o "$work/$label.pas" "$@" > /dev/null
+    "$FPC" -O2 -Mobjfpc -v0 -o"$work/$label" "$work/$label.pas" > /dev/null
+    local start end
+    start=$(date +%s.%N)
+    "$work/$label" < "$work/stdin.txt" > "$work/$label.out"
+    end=$(date +%s.%N)
+    printf '%-10s %8.3f s\n' "$label" "$(echo "$end - $start" | bc)"
+}
+
+echo "benchmark: $name"
+run_variant baseline "${base_flags[@]}"
+if [ $# -gt 0 ]; then
+    run_variant tuned "$@"
+    if ! cmp -s "$work/baseline.out" "$work/tuned.out"; then
+        echo "warning: output differs between baseline and tuned builds" >&2
+    fi
+fi
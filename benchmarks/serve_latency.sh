@@ -0,0 +1,81 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE serve latency benchmark
+# ==============================================================================
+#
+# Transpiles one NOTAL file REQUESTS times with a fresh `gate` process and
+# REQUESTS times with `gate client` against a warm `gate serve`, and prints
+# the p50, p99 and maximum latency of each in milliseconds. The last line
+# is the latency an integration keeping its connection open sees: REQUESTS
+# requests sent on one connection by `gate client --repeat`.
+#
+# USAGE:
+#   benchmarks/serve_latency.sh [file.notal] [gate flags...]
+#
+# EXAMPLE:
+#   REQUESTS=1000 benchmarks/serve_latency.sh examples/record.notal --profile=release
+#
+# ENVIRONMENT:
+#   GATE     - path to the gate executable (default: ./bin/gate)
+#   REQUESTS - number of timed requests per mode (default: 200)
+# ==============================================================================
+
+set -euo pipefail
+
+GATE=${GATE:-./bin/gate}
+REQUESTS=${REQUESTS:-200}
+
+source_file=${1:-examples/traversal.notal}
+shift || true
+
+work=$(mktemp -d)
+socket="$work/gate.sock"
+server=""
+cleanup() {
+    if [ -n "$server" ]; then
+        kill "$server" 2> /dev/null || true
+        wait "$server" 2> /dev/null || true
+    fi
+    rm -rf "$work"
+}
+trap cleanup EXIT
+
+# Prints p50, p99 and the maximum of the nanosecond timings in a file, in ms.
+percentiles() {
+    sort -n "$1" | awk '{ t[NR] = $1 } END {
+        p50 = t[int((NR - 1) * 0.50) + 1]; p99 = t[int((NR - 1) * 0.99) + 1]
+        printf "%10.3f %10.3f %10.3f\n", p50 / 1e6, p99 / 1e6, t[NR] / 1e6 }'
+}
+
+# Runs a command REQUESTS times, recording each wall-clock time in a file.
+time_requests() {
+    local out=$1
+    shift
+    : > "$out"
+    for _ in $(seq "$REQUESTS"); do
+        start=$(date +%s%N)
+        "$@" > /dev/null
+        end=$(date +%s%N)
+        echo $((end - start)) >> "$out"
+    done
+}
+
+"$GATE" serve --socket "$socket" > /dev/null &
+server=$!
+for _ in $(seq 100); do
+    [ -S "$socket" ] && break
+    sleep 0.05
+done
+
+# Both modes print to stdout, so the file has to transpile for the comparison to be fair.
+"$GATE" client --socket "$socket" "$source_file" "$@" > /dev/null
+
+time_requests "$work/process.ns" "$GATE" "$source_file" "$@"
+time_requests "$work/client.ns" "$GATE" client --socket "$socket" "$source_file" "$@"
+
+echo "file: $source_file, $REQUESTS requests per mode"
+printf '%-14s %10s %10s %10s\n' mode p50/ms p99/ms max/ms
+printf '%-14s %s\n' "gate" "$(percentiles "$work/process.ns")"
+printf '%-14s %s\n' "gate client" "$(percentiles "$work/client.ns")"
+"$GATE" client --socket "$socket" --repeat "$REQUESTS" "$source_file" "$@" 2>&1 > /dev/null |
+    awk '{ printf "%-14s %10.3f %10.3f %10.3f\n", "connection", $4, $7, $10 }'
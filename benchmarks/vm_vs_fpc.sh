@@ -0,0 +1,66 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE bytecode VM versus Free Pascal benchmark
+# ==============================================================================
+#
+# Runs each NOTAL program twice: directly on the bytecode VM (`gate run
+# --integer-bits 32`, the integer width of -Mobjfpc) and as a transpiled
+# program compiled with `fpc -O2 -Mobjfpc`. Reports the wall-clock time of
+# both (the fpc column excludes compilation) and warns when the outputs
+# differ.
+# If <name>.stdin.sh exists next to a program, its output is fed to both runs.
+#
+# USAGE:
+#   benchmarks/vm_vs_fpc.sh [program.notal...]
+#
+# EXAMPLE:
+#   benchmarks/vm_vs_fpc.sh benchmarks/fib_recursive.notal examples/*.notal
+#
+# ENVIRONMENT:
+#   GATE  - path to the gate executable (default: ./bin/gate)
+#   FPC   - path to the Free Pascal compiler (default: fpc)
+# ==============================================================================
+
+set -euo pipefail
+
+GATE=${GATE:-./bin/gate}
+FPC=${FPC:-fpc}
+
+if [ $# -eq 0 ]; then
+    set -- benchmarks/*.notal
+fi
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+elapsed() {
+    local start end
+    start=$(date +%s.%N)
+    "$@" < "$work/stdin.txt" > "$work/out.txt" 2>&1 || true
+    end=$(date +%s.%N)
+    echo "$end - $start" | bc
+}
+
+printf '%-24s %10s %10s\n' "program" "vm" "fpc"
+for source_file in "$@"; do
+    name=$(basename "$source_file" .notal)
+    stdin_script="$(dirname "$source_file")/$name.stdin.sh"
+    if [ -f "$stdin_script" ]; then
+        bash "$stdin_script" > "$work/stdin.txt"
+    else
+        : > "$work/stdin.txt"
+    fi
+
+    vm_time=$(elapsed "$GATE" run --integer-bits 32 "$source_file")
+    mv "$work/out.txt" "$work/vm.out"
+
+    "$GATE" "$source_file" -o "$work/$name.pas" > /dev/null
+    "$FPC" -O2 -Mobjfpc -v0 -o"$work/$name" "$work/$name.pas" > /dev/null
+    fpc_time=$(elapsed "$work/$name")
+    mv "$work/out.txt" "$work/fpc.out"
+
+    printf '%-24s %8.3f s %8.3f s\n' "$name" "$vm_time" "$fpc_time"
+    if ! cmp -s "$work/vm.out" "$work/fpc.out"; then
+        echo "warning: output of $name differs between the VM and fpc" >&2
+    fi
+done
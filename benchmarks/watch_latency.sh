@@ -0,0 +1,90 @@
+#!/usr/bin/env bash
+# ==============================================================================
+# GATE watch latency benchmark
+# ==============================================================================
+#
+# Copies the programs in examples/ into a scratch directory COPIES times,
+# times one `gate batch` over all of them, then starts `gate watch` on the
+# directory and edits one file EDITS times. For each edit it records the
+# time from the write of the source to the appearance of its new output,
+# and prints the p50, p99 and maximum of that latency in milliseconds.
+# The latency includes the debounce interval.
+#
+# USAGE:
+#   benchmarks/watch_latency.sh [gate flags...]
+#
+# EXAMPLE:
+#   COPIES=20 DEBOUNCE_MS=5 benchmarks/watch_latency.sh --profile=release
+#
+# ENVIRONMENT:
+#   GATE        - path to the gate executable (default: ./bin/gate)
+#   COPIES      - copies of examples/ to watch (default: 10)
+#   EDITS       - number of timed edits (default: 100)
+#   DEBOUNCE_MS - debounce interval of `gate watch` (default: 10)
+# ==============================================================================
+
+set -euo pipefail
+
+GATE=${GATE:-./bin/gate}
+COPIES=${COPIES:-10}
+EDITS=${EDITS:-100}
+DEBOUNCE_MS=${DEBOUNCE_MS:-10}
+
+work=$(mktemp -d)
+watcher=""
+cleanup() {
+    if [ -n "$watcher" ]; then
+        kill "$watcher" 2> /dev/null || true
+        wait "$watcher" 2> /dev/null || true
+    fi
+    rm -rf "$work"
+}
+trap cleanup EXIT
+
+# Prints p50, p99 and the maximum of the nanosecond timings in a file, in ms.
+percentiles() {
+    sort -n "$1" | awk '{ t[NR] = $1 } END {
+        p50 = t[int((NR - 1) * 0.50) + 1]; p99 = t[int((NR - 1) * 0.99) + 1]
+        printf "%10.3f %10.3f %10.3f\n", p50 / 1e6, p99 / 1e6, t[NR] / 1e6 }'
+}
+
+# `gate batch` writes every output into one directory, so the copies get distinct names.
+mkdir -p "$work/src"
+for copy in $(seq "$COPIES"); do
+    for example in examples/*.notal; do
+        name=$(basename "$example" .notal)
+        [ "$name" = error ] && continue
+        cp "$example" "$work/src/${name}_$copy.notal"
+    done
+done
+files=$(find "$work/src" -name '*.notal' | wc -l)
+
+start=$(date +%s%N)
+"$GATE" batch -q --no-cache --out-dir "$work/batch" "$@" "$work"/src/*.notal > /dev/null
+end=$(date +%s%N)
+batch_ms=$(awk -v ns=$((end - start)) 'BEGIN { printf "%.1f", ns / 1e6 }')
+
+"$GATE" watch -q --no-cache --debounce-ms "$DEBOUNCE_MS" --out-dir "$work/out" "$@" "$work/src" > "$work/watch.log" 2>&1 &
+watcher=$!
+until grep -q '^Watching' "$work/watch.log"; do
+    sleep 0.05
+done
+
+# Every edit appends a different output statement, so every edit changes the output.
+edited="$work/src/output_1.notal"
+output="$work/out/output_1.pas"
+cp "$edited" "$work/original.notal"
+: > "$work/edit.ns"
+for i in $(seq "$EDITS"); do
+    rm -f "$output"
+    { cat "$work/original.notal"; printf '\n    output(%d)\n' "$i"; } > "$work/next.notal"
+    start=$(date +%s%N)
+    mv "$work/next.notal" "$edited"
+    until [ -e "$output" ]; do :; done
+    end=$(date +%s%N)
+    echo $((end - start)) >> "$work/edit.ns"
+done
+
+echo "files: $files, full batch: $batch_ms ms, debounce: $DEBOUNCE_MS ms, $EDITS edits"
+printf '%-14s %10s %10s %10s\n' mode p50/ms p99/ms max/ms
+printf '%-14s %s\n' "edit->output" "$(percentiles "$work/edit.ns")"
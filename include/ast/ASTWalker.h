@@ -0,0 +1,68 @@
+/**
+ * @file ASTWalker.h
+ * @brief Generic pre-order traversal helpers for NOTAL AST nodes
+ *
+ * This file declares small traversal utilities used by analysis passes that
+ * only need to inspect the tree (for example, "is this parameter ever written
+ * to?"). They avoid writing a full visitor for every read-only query.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_AST_AST_WALKER_H
+#define GATE_AST_AST_WALKER_H
+
+#include "ast/Expression.h"
+#include "ast/Statement.h"
+#include <functional>
+#include <memory>
+
+namespace gate::ast {
+
+/**
+ * @brief Callback invoked for every statement reached by the walker
+ * @return true to descend into the statement's children, false to skip them
+ */
+using StatementCallback = std::function<bool(const std::shared_ptr<Statement>&)>;
+
+/** @brief Callback invoked for every expression reached by the walker */
+using ExpressionCallback = std::function<void(const std::shared_ptr<Expression>&)>;
+
+/**
+ * @brief Walk a statement subtree in pre-order
+ *
+ * Visits the statement itself, every nested statement and every expression
+ * owned by those statements (conditions, bounds, targets, arguments...).
+ * Subprogram declarations are entered through their body, not their kamus.
+ *
+ * @param stmt Root of the subtree (may be null)
+ * @param onStatement Statement callback (may be empty)
+ * @param onExpression Expression callback (may be empty)
+ */
+void walkStatement(const std::shared_ptr<Statement>& stmt,
+                   const StatementCallback& onStatement,
+                   const ExpressionCallback& onExpression);
+
+/**
+ * @brief Walk an expression subtree in pre-order
+ * @param expr Root of the subtree (may be null)
+ * @param onExpression Expression callback
+ */
+void walkExpression(const std::shared_ptr<Expression>& expr, const ExpressionCallback& onExpression);
+
+/**
+ * @brief Find the variable an lvalue expression is rooted at
+ *
+ * Strips field accesses, array indexing, pointer dereferences and groupings,
+ * so `p.next^.data[i]` yields `p`.
+ *
+ * @param expr Lvalue-like expression
+ * @return The root Variable, or nullptr if the expression has none
+ */
+std::shared_ptr<Variable> rootVariable(const std::shared_ptr<Expression>& expr);
+
+} // namespace gate::ast
+
+#endif // GATE_AST_AST_WALKER_H
@@ -171,6 +171,8 @@ class Statement {
 public:
     /** @brief Weak reference to the parent statement in the AST hierarchy */
     std::weak_ptr<Statement> parent;
+    /** @brief Source line where the statement starts (0 when unknown) */
+    int line = 0;
     
     /** @brief Virtual destructor for proper cleanup of derived classes */
     virtual ~Statement() = default;
@@ -585,13 +587,17 @@ struct RecordTypeDeclStmt : Statement, public std::enable_shared_from_this<Recor
         core::Token name;
         /** @brief The type of the field */
         core::Token type;
+        /** @brief The pointed-to type token (for pointer fields) */
+        core::Token pointedToType;
         
         /**
          * @brief Constructor for a field
          * @param name The field name
          * @param type The field type
+         * @param pointedToType The pointed-to type (optional, for pointers)
          */
-        Field(core::Token name, core::Token type) : name(std::move(name)), type(std::move(type)) {}
+        Field(core::Token name, core::Token type, core::Token pointedToType = {core::TokenType::UNKNOWN, ""})
+            : name(std::move(name)), type(std::move(type)), pointedToType(std::move(pointedToType)) {}
     };
     
     /** @brief The name of the record type */
@@ -690,6 +696,8 @@ struct TraversalStmt : Statement, public std::enable_shared_from_this<TraversalS
     std::shared_ptr<Expression> step;
     /** @brief The body of the loop */
     std::shared_ptr<BlockStmt> body;
+    /** @brief Whether the loop was written `traversal paralel`, asking for parallel iterations */
+    bool parallel = false;
     
     /**
      * @brief Constructor for traversal statement
@@ -815,7 +823,8 @@ enum class ParameterMode {
 /**
  * @brief Parameter structure for functions and procedures
  * 
- * Represents a single parameter with its mode, name, and type.
+ * Represents a single parameter with its mode, name, and type. An input
+ * parameter may carry a constraint, as in `input x: integer | x >= 0`.
  * 
  * @author GATE Project Team
  * @version 1.0
@@ -828,15 +837,18 @@ struct Parameter {
     core::Token name;
     /** @brief The parameter type */
     core::Token type;
+    /** @brief Condition the argument must satisfy (may be null) */
+    std::shared_ptr<Expression> constraint;
     
     /**
      * @brief Constructor for parameter
      * @param mode The parameter mode
      * @param name The parameter name
      * @param type The parameter type
+     * @param constraint The constraint expression, if any
      */
-    Parameter(ParameterMode mode, core::Token name, core::Token type) 
-        : mode(mode), name(std::move(name)), type(std::move(type)) {}
+    Parameter(ParameterMode mode, core::Token name, core::Token type, std::shared_ptr<Expression> constraint = nullptr) 
+        : mode(mode), name(std::move(name)), type(std::move(type)), constraint(std::move(constraint)) {}
 };
 
 /**
@@ -0,0 +1,258 @@
+/**
+ * @file CCodeGenerator.h
+ * @brief C11 code generator for NOTAL AST transpilation
+ *
+ * This file defines the CCodeGenerator class, the `--target=c` counterpart
+ * of the PascalCodeGenerator. It walks the same AST and emits a single,
+ * self-contained C11 translation unit: the C runtime (strings with a small
+ * buffer optimization, length-tracked dynamic arrays, console I/O and the
+ * casting helpers) followed by the program's types, globals and functions.
+ * The result builds with `cc -O2 program.c -lm`.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_TRANSPILER_C_CODE_GENERATOR_H
+#define GATE_TRANSPILER_C_CODE_GENERATOR_H
+
+#include "ast/Expression.h"
+#include "ast/Statement.h"
+#include "core/PascalCodeGenerator.h"
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace gate::transpiler {
+
+/**
+ * @brief C code generator using visitor pattern
+ *
+ * Types are resolved statically, since C needs them for declarations,
+ * output formatting and string handling. Integers are 64-bit, like the
+ * bytecode VM. Of the code generation options only the build profile
+ * applies: debug and checked builds define GATE_CHECKED, which turns on
+ * index, pointer and division checks, and every profile but release checks
+ * constrained variables.
+ *
+ * Errors in the program are reported as std::runtime_error with the source
+ * line, like the Pascal generator.
+ */
+class CCodeGenerator : public ExpressionVisitor, public StatementVisitor {
+public:
+    /**
+     * @brief Construct a code generator
+     * @param options Code generation options; only the profile is used
+     */
+    explicit CCodeGenerator(CodeGenOptions options = {});
+
+    /**
+     * @brief Generate C code from NOTAL program AST
+     * @param program Root program statement to transpile
+     * @return Generated C code as string
+     * @throws std::runtime_error on constructs C cannot express
+     */
+    std::string generate(std::shared_ptr<ProgramStmt> program);
+
+    // Statement visitors
+    std::any visit(std::shared_ptr<ExpressionStmt> stmt) override;
+    std::any visit(std::shared_ptr<BlockStmt> stmt) override;
+    std::any visit(std::shared_ptr<ProgramStmt> stmt) override;
+    std::any visit(std::shared_ptr<KamusStmt> stmt) override;
+    std::any visit(std::shared_ptr<AlgoritmaStmt> stmt) override;
+    std::any visit(std::shared_ptr<VarDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<StaticArrayDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<DynamicArrayDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<AllocateStmt> stmt) override;
+    std::any visit(std::shared_ptr<DeallocateStmt> stmt) override;
+    std::any visit(std::shared_ptr<ConstDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<InputStmt> stmt) override;
+    std::any visit(std::shared_ptr<RecordTypeDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<EnumTypeDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<ConstrainedVarDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<IfStmt> stmt) override;
+    std::any visit(std::shared_ptr<WhileStmt> stmt) override;
+    std::any visit(std::shared_ptr<RepeatUntilStmt> stmt) override;
+    std::any visit(std::shared_ptr<DependOnStmt> stmt) override;
+    std::any visit(std::shared_ptr<OutputStmt> stmt) override;
+    std::any visit(std::shared_ptr<TraversalStmt> stmt) override;
+    std::any visit(std::shared_ptr<IterateStopStmt> stmt) override;
+    std::any visit(std::shared_ptr<RepeatNTimesStmt> stmt) override;
+    std::any visit(std::shared_ptr<StopStmt> stmt) override;
+    std::any visit(std::shared_ptr<SkipStmt> stmt) override;
+    std::any visit(std::shared_ptr<ProcedureStmt> stmt) override;
+    std::any visit(std::shared_ptr<FunctionStmt> stmt) override;
+    std::any visit(std::shared_ptr<ReturnStmt> stmt) override;
+
+    // Expression visitors
+    std::any visit(std::shared_ptr<Assign> expr) override;
+    std::any visit(std::shared_ptr<Binary> expr) override;
+    std::any visit(std::shared_ptr<Unary> expr) override;
+    std::any visit(std::shared_ptr<Grouping> expr) override;
+    std::any visit(std::shared_ptr<Literal> expr) override;
+    std::any visit(std::shared_ptr<Variable> expr) override;
+    std::any visit(std::shared_ptr<Call> expr) override;
+    std::any visit(std::shared_ptr<FieldAccess> expr) override;
+    std::any visit(std::shared_ptr<FieldAssign> expr) override;
+    std::any visit(std::shared_ptr<ArrayAccess> expr) override;
+
+private:
+    /** @brief Kinds of NOTAL types */
+    enum class Kind { INTEGER, REAL, BOOLEAN, CHARACTER, STRING, NIL, ENUM, RECORD, STATIC_ARRAY, DYNAMIC_ARRAY, POINTER };
+
+    /** @brief A NOTAL type and the C type that represents it */
+    struct CType {
+        Kind kind;
+        /** @brief C type name; empty for pointers, which are spelled from their target */
+        std::string name;
+        /** @brief Enum value names or record field names, as declared */
+        std::vector<std::string> names;
+        /** @brief Record field types */
+        std::vector<int> fieldTypes;
+        /** @brief Element type of arrays, target type of pointers */
+        int element = -1;
+        /** @brief Bounds of a static array */
+        long long low = 0, high = -1;
+    };
+
+    /** @brief A typed C expression */
+    struct CExpr {
+        std::string code;
+        /** @brief Type id, -1 for procedure calls */
+        int type = -1;
+        /** @brief Whether the code designates an object that can be assigned or addressed */
+        bool lvalue = false;
+    };
+
+    /** @brief A compile-time constant */
+    struct Constant {
+        int type = 0;
+        long long i = 0;
+        double r = 0.0;
+        std::string s;
+    };
+
+    /** @brief A variable or parameter in scope */
+    struct Symbol {
+        /** @brief Name as declared, for messages */
+        std::string name;
+        /** @brief C spelling of the name */
+        std::string cname;
+        int type = 0;
+        /** @brief Held through a pointer (output parameters, unmodified compound input parameters) */
+        bool reference = false;
+        /** @brief Declaration of a constrained variable */
+        std::shared_ptr<ConstrainedVarDeclStmt> constraint;
+    };
+
+    /** @brief Signature of a user subprogram */
+    struct Subprogram {
+        std::string cname;
+        std::vector<Parameter> params;
+        std::vector<int> paramTypes;
+        /** @brief Input parameters the body writes to, which get a private copy */
+        std::vector<bool> copied;
+        /** @brief Result type, -1 for procedures */
+        int returnType = -1;
+    };
+
+    /** @brief Code generation options */
+    CodeGenOptions options_;
+    /** @brief Whether GATE_CHECKED code (index, pointer and division checks) is emitted */
+    bool checked_ = false;
+    /** @brief Type table; the first six entries are the basic types */
+    std::vector<CType> types_;
+    /** @brief Record and enum names (lower case) to type ids */
+    std::map<std::string, int> typeNames_;
+    /** @brief Named constants and enum values (lower case) */
+    std::map<std::string, Constant> constants_;
+    /** @brief Global variables (lower case) */
+    std::map<std::string, Symbol> globals_;
+    /** @brief Parameters and locals of the current subprogram (lower case) */
+    std::map<std::string, Symbol> locals_;
+    /** @brief Subprogram signatures (lower case) */
+    std::map<std::string, Subprogram> subprograms_;
+    /** @brief Receives the variables declared by the KAMUS being visited */
+    std::map<std::string, Symbol>* scope_ = nullptr;
+    /** @brief Variables of the current subprogram released when it returns */
+    std::vector<Symbol> ownedLocals_;
+    /** @brief Enums whose values are written, which need a name table */
+    std::set<int> writtenEnums_;
+    /** @brief Function bodies and the main program */
+    std::stringstream out_;
+    /** @brief Global variable definitions */
+    std::stringstream globalsOut_;
+    int indentLevel_ = 0;
+    int line_ = 0;
+    int loopDepth_ = 0;
+    /** @brief Counter for unique C temporaries */
+    int tempCounter_ = 0;
+    /** @brief Set when an expression allocated arena temporaries */
+    bool temps_ = false;
+    /** @brief Result type of the function being generated, -1 elsewhere */
+    int returnType_ = -1;
+    bool inSubprogram_ = false;
+    /** @brief Whether a casting helper is called */
+    bool usesCasting_ = false;
+    /** @brief Runs pure functions for constants and array bounds that call them */
+    std::unique_ptr<ConstantEvaluator> evaluator_;
+
+    // Declarations
+    void declareVariable(const std::string& name, int type, std::shared_ptr<ConstrainedVarDeclStmt> constraint);
+    void declareSubprogram(std::shared_ptr<Statement> stmt);
+    void generateSubprogram(const std::string& name, std::shared_ptr<KamusStmt> kamus, std::shared_ptr<AlgoritmaStmt> body);
+    std::string signature(const Subprogram& sub) const;
+    int resolveType(const core::Token& type, const core::Token& pointedToType = core::Token());
+    int derivedType(CType info);
+    bool foldConstant(std::shared_ptr<Expression> expr, Constant& value) const;
+    std::string constantCode(const Constant& value) const;
+
+    // Types
+    std::string typeDefinitions();
+    void defineType(int type, std::set<int>& defined, std::vector<int>& order, std::stringstream& out) const;
+    std::string declaration(int type, const std::string& name) const;
+    std::string zeroValue(int type) const;
+    bool ownsMemory(int type) const;
+    bool isCompound(int type) const;
+    std::string copyCode(int type, const std::string& target, const std::string& source) const;
+    std::string freeCode(int type, const std::string& target) const;
+
+    // Emission
+    void emitLine(const std::string& text);
+    void emitBlock(std::shared_ptr<Statement> body);
+    void emitWithTemps(const std::string& code, bool temps);
+    void execute(std::shared_ptr<Statement> stmt);
+    std::string freshName(const std::string& base);
+    [[noreturn]] void error(const std::string& message) const;
+
+    // Expressions
+    CExpr evaluate(std::shared_ptr<Expression> expr);
+    std::string convert(const CExpr& value, int to) const;
+    std::string condition(std::shared_ptr<Expression> expr, bool& temps);
+    std::string equality(const CExpr& left, const CExpr& right) const;
+    std::string assign(std::shared_ptr<Expression> target, std::shared_ptr<Expression> value);
+    std::string store(int type, const std::string& target, const CExpr& value) const;
+    std::string constraintCheck(const Symbol& symbol);
+    std::string addressOf(const CExpr& value) const;
+    std::string indexCode(const CExpr& container, std::shared_ptr<Expression> index);
+    std::string resizeCode(const std::string& array, int type, const std::vector<std::string>& sizes, size_t level);
+    std::string releaseArrayCode(const std::string& array, int type);
+    bool lookup(const std::string& name, Symbol& symbol) const;
+    std::string symbolCode(const Symbol& symbol) const;
+    CExpr callSubprogram(std::shared_ptr<Call> expr);
+    CExpr callBuiltin(const std::string& name, std::shared_ptr<Call> expr);
+    bool isWritten(const std::string& name, std::shared_ptr<Statement> body, bool resizeOnly) const;
+    int elementType(int type) const;
+    int fieldIndex(int recordType, const std::string& name) const;
+    bool isStringish(int type) const;
+    bool isNumeric(int type) const;
+    std::string cName(const std::string& name) const;
+};
+
+} // namespace gate::transpiler
+
+#endif // GATE_TRANSPILER_C_CODE_GENERATOR_H
@@ -0,0 +1,213 @@
+/**
+ * @file ConstantEvaluator.h
+ * @brief Transpile-time evaluation of calls to pure NOTAL functions
+ *
+ * This file defines the ConstantEvaluator, a small interpreter that runs
+ * side-effect-free functions on constant arguments while the program is
+ * being transpiled, so that a call such as `fact(10)` can be replaced by
+ * its value. Every evaluation runs under a step and a memory budget; when
+ * a call cannot be evaluated, the reason is reported instead of a value.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_TRANSPILER_CONSTANT_EVALUATOR_H
+#define GATE_TRANSPILER_CONSTANT_EVALUATOR_H
+
+#include "ast/Expression.h"
+#include "ast/Statement.h"
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gate::transpiler {
+
+using namespace gate::ast;
+
+/**
+ * @brief Budgets and target limits of transpile-time evaluation
+ *
+ * The integer and string limits are those of the generated program, so a
+ * value is only folded when the compiled program would compute the same.
+ */
+struct ConstantEvaluatorLimits {
+    /** @brief Statements and expressions one top-level evaluation may execute */
+    long long steps = 1000000;
+    /** @brief Steps all evaluations of one program may execute together */
+    long long totalSteps = 20000000;
+    /** @brief Bytes of variables and strings that may be live at once */
+    size_t memory = 1 << 20;
+    /** @brief Deepest chain of nested calls */
+    int callDepth = 1000;
+    /** @brief Width of the target's integer type in bits */
+    int integerBits = 32;
+    /** @brief Longest string the target can hold */
+    size_t stringLength = 255;
+};
+
+/**
+ * @brief Interpreter for pure functions called with constant arguments
+ *
+ * A function can be evaluated when it only takes input parameters and
+ * declares locals of the basic types (integer, real, boolean, character,
+ * string) or enum types, does no input/output, allocation or pointer access, reads no
+ * global variable (global constants are fine) and calls nothing but other
+ * such functions and exact built-ins (abs, sqr, sqrt, ord, chr, succ,
+ * pred, round, trunc, length, upcase). Functions follow the semantics of
+ * the generated Pascal: `-> value` sets the result without leaving.
+ *
+ * Results are cached by call, so repeated calls with the same arguments
+ * are evaluated once.
+ */
+class ConstantEvaluator {
+public:
+    /**
+     * @brief Construct an evaluator for a program
+     * @param program Program whose functions and global constants are used
+     * @param limits Budgets and target limits
+     */
+    explicit ConstantEvaluator(std::shared_ptr<ProgramStmt> program, ConstantEvaluatorLimits limits = {});
+
+    /**
+     * @brief Evaluate a constant expression
+     *
+     * The expression may combine literals, global constants, operators,
+     * built-ins and calls to pure functions.
+     *
+     * @param expr Expression to evaluate
+     * @param shadowed Names that refer to locals at the expression's site
+     * @param reason Set to why the expression has no value, on failure
+     * @return The value as a literal, or nullptr
+     */
+    std::shared_ptr<Literal> evaluate(std::shared_ptr<Expression> expr, const std::set<std::string>& shadowed,
+                                      std::string& reason);
+
+    /**
+     * @brief Check whether an expression calls a user function
+     * @param expr Expression to inspect
+     * @return true if a function of the program is called anywhere in it
+     */
+    bool callsFunction(std::shared_ptr<Expression> expr) const;
+
+    /**
+     * @brief Check whether an expression only reads global constants
+     * @param expr Expression to inspect
+     * @param shadowed Names that refer to locals at the expression's site
+     * @return true if every name it reads (other than callees) is a global constant
+     */
+    bool readsOnlyConstants(std::shared_ptr<Expression> expr, const std::set<std::string>& shadowed) const;
+
+    /**
+     * @brief Check whether a name is a function of the program
+     * @param name Function name
+     */
+    bool isFunction(const std::string& name) const;
+
+    /**
+     * @brief Evaluate a one-parameter function for every argument in a range
+     *
+     * Arguments are given as ordinals of the parameter's type: character
+     * codes, positions of enum values or integers.
+     *
+     * @param function Function name
+     * @param low First ordinal
+     * @param high Last ordinal
+     * @param results Receives one value per ordinal, in order
+     * @param reason Set to why the function cannot be tabulated, on failure
+     * @return true if every call produced a value
+     */
+    bool tabulate(const std::string& function, long long low, long long high,
+                  std::vector<std::shared_ptr<Literal>>& results, std::string& reason);
+
+    /**
+     * @brief Get the values of an enum type
+     * @param name Enum type name
+     * @return The value names in declaration order, or nullptr if it is not an enum
+     */
+    const std::vector<std::string>* enumValues(const std::string& name) const;
+
+private:
+    /** @brief A runtime value of one of the basic types */
+    struct Value {
+        /** @brief INTEGER, REAL, BOOLEAN, CHARACTER, STRING, or IDENTIFIER for enums */
+        core::TokenType type = core::TokenType::INTEGER;
+        /** @brief Integer, boolean (0/1), character code or enum position */
+        long long integer = 0;
+        double real = 0.0;
+        /** @brief String, character, or enum type name (lower case) */
+        std::string text;
+    };
+
+    /** @brief A parameter or local of a running function */
+    struct Slot {
+        core::TokenType type;
+        Value value;
+        bool assigned = false;
+    };
+
+    /** @brief Variables of one running function, including its result */
+    struct Frame {
+        /** @brief Function being run, whose slot holds the result */
+        std::string function;
+        std::map<std::string, Slot> slots;
+        /** @brief Bytes accounted to this frame */
+        size_t bytes = 0;
+    };
+
+    /** @brief How a statement finished */
+    enum class Flow { NORMAL, BREAK, CONTINUE };
+
+    ConstantEvaluatorLimits limits_;
+    std::map<std::string, std::shared_ptr<FunctionStmt>> functions_;
+    std::set<std::string> procedures_;
+    /** @brief Enum types (lower case) to their value names */
+    std::map<std::string, std::vector<std::string>> enumTypes_;
+    /** @brief Enum values (lower case) */
+    std::map<std::string, Value> enumConstants_;
+    std::map<std::string, std::shared_ptr<ConstDeclStmt>> constantDecls_;
+    std::map<std::string, Value> constants_;
+    /** @brief Constants being evaluated, to detect cycles */
+    std::set<std::string> pendingConstants_;
+    /** @brief Why each function cannot be evaluated; empty when it can */
+    std::map<std::string, std::string> impurity_;
+    /** @brief Results of earlier calls, by function and arguments */
+    std::map<std::string, Value> callCache_;
+    std::vector<Frame> frames_;
+    /** @brief Names that are locals at the site of the top-level expression */
+    std::set<std::string> shadowed_;
+    long long steps_ = 0;
+    long long totalSteps_ = 0;
+    size_t memory_ = 0;
+
+    Value evaluateConstant(std::shared_ptr<Expression> expr, const std::set<std::string>& shadowed);
+    Value constantValue(const std::string& name);
+    std::string impurityOf(const std::string& name);
+    std::string findImpurity(std::shared_ptr<FunctionStmt> func);
+    bool isSupportedType(const core::Token& type) const;
+    Value call(const std::string& name, const std::vector<Value>& args, bool checkConstraints = true);
+    Flow execute(std::shared_ptr<Statement> stmt);
+    Value eval(std::shared_ptr<Expression> expr);
+    Value binary(core::TokenType op, const Value& left, const Value& right);
+    Value builtin(const std::string& name, const std::vector<Value>& args);
+    void assign(const std::string& name, const Value& value);
+    void store(Slot& slot, const Value& value) const;
+    Slot* slot(const std::string& name);
+    bool truthy(const Value& value) const;
+    bool equal(const Value& left, const Value& right) const;
+    int compare(const Value& left, const Value& right) const;
+    Value integer(long long value) const;
+    Value real(double value) const;
+    Value character(long long code) const;
+    Value stringValue(std::string text) const;
+    void step();
+    std::string describe(const Value& value) const;
+    std::shared_ptr<Literal> toLiteral(const Value& value) const;
+};
+
+} // namespace gate::transpiler
+
+#endif // GATE_TRANSPILER_CONSTANT_EVALUATOR_H
@@ -17,6 +17,8 @@
 
 #include "ast/Expression.h"
 #include "ast/Statement.h"
+#include "core/ConstantEvaluator.h"
+#include <memory>
 #include <string>
 #include <sstream>
 #include <map>
@@ -28,6 +30,95 @@ namespace gate::transpiler {
 // Using directives for convenience
 using namespace gate::ast;
 
+/**
+ * @brief Compiler-directive profile for the generated program
+ *
+ * NONE emits no directives, leaving FPC defaults in effect.
+ */
+enum class BuildProfile {
+    NONE,     ///< No directives (FPC defaults)
+    RELEASE,  ///< No range/overflow checks, inlining and -O3, constraint checks compiled out
+    DEBUG,    ///< Range, overflow and assertion checks
+    CHECKED   ///< DEBUG plus explicit dynamic-array bounds checks with readable messages
+};
+
+/**
+ * @brief How allocate/deallocate on pointers is lowered
+ */
+enum class AllocStrategy {
+    HEAP,  ///< New/Dispose through the FPC heap manager
+    POOL   ///< Per-type free-list pools carved from slabs (PoolNew_<T>/PoolDispose_<T>)
+};
+
+/**
+ * @brief How record type declarations are laid out
+ */
+enum class RecordLayout {
+    DECLARED,   ///< Fields in declaration order with natural alignment
+    REORDERED,  ///< Fields sorted by decreasing alignment, so padding is minimal
+    PACKED      ///< `packed record` in declaration order, no padding at all
+};
+
+/**
+ * @brief Instrumentation inserted into the generated program
+ */
+enum class Instrumentation {
+    NONE,    ///< No instrumentation
+    PROFILE  ///< Per-statement hit counters and per-subprogram timers, reported at exit
+};
+
+/**
+ * @brief Options controlling how Pascal code is generated
+ *
+ * Default-constructed options reproduce the plain, directive-free output the
+ * generator has always produced. Each field is set from a driver flag.
+ */
+struct CodeGenOptions {
+    /** @brief Enlarge the Input/Output text buffers and read input through a token reader (--fast-io) */
+    bool fastIO = false;
+    /** @brief Compiler-directive profile (--profile) */
+    BuildProfile profile = BuildProfile::NONE;
+    /** @brief Largest leaf subprogram, in AST nodes, that is marked inline; 0 disables (--inline-threshold) */
+    int inlineThreshold = 0;
+    /** @brief Pointer allocation strategy (--alloc) */
+    AllocStrategy alloc = AllocStrategy::HEAP;
+    /** @brief Store multi-dimensional dynamic arrays as one flat buffer (--flat-arrays) */
+    bool flatArrays = false;
+    /** @brief Unroll factor for `repeat N times` with a literal N; 0 disables (--unroll) */
+    int unrollFactor = 0;
+    /** @brief Instrumentation inserted into the generated program (--instrument) */
+    Instrumentation instrument = Instrumentation::NONE;
+    /** @brief Layout of record type declarations (--record-layout) */
+    RecordLayout recordLayout = RecordLayout::DECLARED;
+    /** @brief Store arrays of records as one parallel array per field (--soa) */
+    bool soa = false;
+    /** @brief Memoize pure recursive functions of one or two ordinal arguments (--memo) */
+    bool memo = false;
+    /** @brief Replace calls to pure functions with constant arguments by their value (--const-eval) */
+    bool constEval = false;
+    /** @brief Replace pure functions of a character, enum or small integer range by a table (--tabulate) */
+    bool tabulate = false;
+};
+
+/** @brief Width of `integer` in the generated program, which keeps FPC's default mode */
+constexpr int PASCAL_INTEGER_BITS = 16;
+
+/** @brief A constant expression the generator could not evaluate and left as written */
+struct ConstEvalFallback {
+    /** @brief Source line of the constant, call or array */
+    int line;
+    /** @brief Source column of the constant, call or array */
+    int column;
+    /** @brief What was left as written, and why */
+    std::string message;
+};
+
+/** @brief Inline threshold used by the release profile when --inline-threshold is not given */
+constexpr int DEFAULT_INLINE_THRESHOLD = 40;
+
+/** @brief Unroll factor used by the release profile when --unroll is not given */
+constexpr int DEFAULT_UNROLL_FACTOR = 4;
+
 /**
  * @brief Pascal code generator using visitor pattern
  * 
@@ -42,6 +133,12 @@ using namespace gate::ast;
  */
 class PascalCodeGenerator : public ExpressionVisitor, public StatementVisitor {
 public:
+    /**
+     * @brief Construct a code generator
+     * @param options Code generation options (defaults produce plain output)
+     */
+    explicit PascalCodeGenerator(CodeGenOptions options = {});
+
     /**
      * @brief Generate Pascal code from NOTAL program AST
      * @param program Root program statement to transpile
@@ -49,6 +146,12 @@ public:
      */
     std::string generate(std::shared_ptr<ProgramStmt> program);
 
+    /**
+     * @brief Get the constant expressions generate() left as written
+     * @return One entry per constant, call or array bound, in generation order
+     */
+    const std::vector<ConstEvalFallback>& constEvalFallbacks() const { return constEvalFallbacks_; }
+
     // Statement visitors
     /** @brief Visit expression statement */
     std::any visit(std::shared_ptr<ExpressionStmt> stmt) override;
@@ -130,6 +233,10 @@ public:
     std::any visit(std::shared_ptr<ArrayAccess> expr) override;
 
 private:
+    /** @brief Code generation options */
+    CodeGenOptions options_;
+    /** @brief ALGORITMA block of the main program, which receives the prologue/epilogue */
+    std::shared_ptr<AlgoritmaStmt> mainAlgoritma_;
     /** @brief Output stream for generated Pascal code */
     std::stringstream out_;
     /** @brief Current indentation level */
@@ -150,11 +257,194 @@ private:
     std::vector<std::string> loopVariables_;
     /** @brief Set of casting functions used in the program */
     std::set<std::string> usedCastingFunctions_;
+    /** @brief Map of record type names to their declarations */
+    std::map<std::string, std::shared_ptr<RecordTypeDeclStmt>> recordTypes_;
+    /** @brief Map of subprogram names to their declared parameter lists */
+    std::map<std::string, std::vector<Parameter>> subprogramParams_;
+    /** @brief Declared types of global variables */
+    std::map<std::string, core::Token> globalVarTypes_;
+    /** @brief Declared types of the current subprogram's parameters and locals */
+    std::map<std::string, core::Token> localVarTypes_;
+    /** @brief Pointed-to types of global pointer variables */
+    std::map<std::string, core::Token> globalPointerTargets_;
+    /** @brief Pointed-to types of the current subprogram's pointer locals */
+    std::map<std::string, core::Token> localPointerTargets_;
+    /** @brief Pointed-to types allocated through a pool (--alloc=pool), by NOTAL name, with their Pascal type */
+    std::map<std::string, std::string> pooledTypes_;
+    /** @brief Global dynamic arrays lowered to amortized growth */
+    std::set<std::string> grownArrays_;
+    /** @brief Dynamic arrays lowered to amortized growth, per subprogram */
+    std::map<std::string, std::set<std::string>> subprogramGrownArrays_;
+    /** @brief Parameters of the current subprogram that carry a constraint */
+    std::vector<Parameter> constrainedParams_;
+    /** @brief Names declared by the current subprogram (parameters and KAMUS) */
+    std::set<std::string> localNames_;
+    /** @brief Dynamic arrays of the current subprogram lowered to amortized growth */
+    std::set<std::string> localGrownArrays_;
+    /** @brief Global multi-dimensional dynamic arrays stored as one flat buffer */
+    std::set<std::string> flatArrays_;
+    /** @brief Multi-dimensional dynamic arrays stored flat, per subprogram */
+    std::map<std::string, std::set<std::string>> subprogramFlatArrays_;
+    /** @brief Multi-dimensional dynamic arrays of the current subprogram stored flat */
+    std::set<std::string> localFlatArrays_;
+    /** @brief Global arrays of records stored as one array per field, mapped to their record type */
+    std::map<std::string, std::string> soaArrays_;
+    /** @brief Arrays of records stored as one array per field, per subprogram */
+    std::map<std::string, std::map<std::string, std::string>> subprogramSoaArrays_;
+    /** @brief Arrays of records of the current subprogram stored as one array per field */
+    std::map<std::string, std::string> localSoaArrays_;
+    /** @brief Subprograms emitted with the inline directive */
+    std::set<std::string> inlineSubprograms_;
+    /** @brief Functions emitted behind a memo table (--memo) */
+    std::set<std::string> memoFunctions_;
+    /** @brief A pure function replaced by a constant table (--tabulate) */
+    struct TabulatedFunction {
+        /** @brief Index type of the table: char, an enum or an integer subrange */
+        std::string indexType;
+        std::string elementType;
+        /** @brief The result for every index, as Pascal constants */
+        std::vector<std::string> entries;
+        /** @brief The domain comes from a parameter constraint, which a call checks */
+        bool constrained = false;
+    };
+    /** @brief Functions replaced by a constant table, by name (--tabulate) */
+    std::map<std::string, TabulatedFunction> tabulatedFunctions_;
+    /** @brief Functions over a small domain whose table could not be computed, with the reason */
+    std::vector<std::pair<std::string, std::string>> untabulatedFunctions_;
+    /** @brief Runs pure functions on constant arguments while generating */
+    std::unique_ptr<ConstantEvaluator> evaluator_;
+    /** @brief A `traversal paralel` loop lowered to worker threads */
+    struct ParallelTraversal {
+        /** @brief Index used in the worker's name */
+        int id = 0;
+        /** @brief The loop itself */
+        std::shared_ptr<TraversalStmt> traversal;
+        /** @brief Shared scalars the body only adds to, summed per worker */
+        std::vector<std::string> reductions;
+        /** @brief Iterators each worker declares for itself */
+        std::set<std::string> privates;
+    };
+    /** @brief Loops that run on worker threads, in source order */
+    std::vector<ParallelTraversal> parallelTraversals_;
+    /** @brief Why each remaining `traversal paralel` loop runs sequentially */
+    std::map<const Statement*, std::string> sequentialTraversals_;
+    /** @brief Statements whose array indexing is proven in range, emitted under {$R-} */
+    std::set<const Statement*> rangeSafeStatements_;
+    /** @brief Profile counter index of each instrumented statement (--instrument=profile) */
+    std::map<const Statement*, int> statementIds_;
+    /** @brief NOTAL source line of each profile counter */
+    std::vector<int> statementLines_;
+    /** @brief Names of the timed subprograms, indexed by timer */
+    std::vector<std::string> profiledSubprograms_;
+    /** @brief Constant expressions left as written, reported by the driver */
+    std::vector<ConstEvalFallback> constEvalFallbacks_;
+    /** @brief Timer index of the subprogram being generated, or -1 */
+    int currentProfileId_ = -1;
 
     /** @brief Add proper indentation to output stream */
     void indent();
+    /** @brief Collect record types and subprogram signatures declared in the program */
+    void collectDeclarations(std::shared_ptr<ProgramStmt> program);
+    /** @brief Record the declared type of every variable in a KAMUS block */
+    void collectVariableTypes(std::shared_ptr<KamusStmt> kamus, std::map<std::string, core::Token>& types,
+                              std::map<std::string, core::Token>& pointerTargets);
+    /** @brief Look up a variable's declared type, preferring locals over globals */
+    const core::Token* lookupVariableType(const std::string& name) const;
+    /** @brief Find the pointed-to type of a pointer-valued expression */
+    const core::Token* pointerTargetType(std::shared_ptr<Expression> expr) const;
+    /** @brief Find the record type declaration an expression evaluates to */
+    std::shared_ptr<RecordTypeDeclStmt> recordTypeOf(std::shared_ptr<Expression> expr) const;
+    /** @brief Choose the pointed-to types that get a pool (--alloc=pool) */
+    void selectPooledTypes(std::shared_ptr<ProgramStmt> program);
+    /** @brief Code to analyse, each body paired with the names it shadows */
+    using ScopedBodies = std::vector<std::pair<std::shared_ptr<Statement>, std::set<std::string>>>;
+    /** @brief Choose the dynamic arrays that get amortized growth or flat storage */
+    void selectArrayLowerings(std::shared_ptr<ProgramStmt> program);
+    /** @brief Find candidate arrays used other than by full-rank indexing, allocate/deallocate or length() */
+    std::set<std::string> findArrayEscapes(const std::map<std::string, int>& candidates, const ScopedBodies& bodies);
+    /** @brief Find the one-dimensional arrays of a KAMUS block that grow inside loops */
+    std::set<std::string> findGrownArrays(std::shared_ptr<KamusStmt> kamus, const ScopedBodies& bodies);
+    /** @brief Find the multi-dimensional arrays of a KAMUS block that can be stored flat */
+    std::set<std::string> findFlatArrays(std::shared_ptr<KamusStmt> kamus, const ScopedBodies& bodies);
+    /** @brief Find the arrays of records of a KAMUS block that can be stored as one array per field */
+    std::map<std::string, std::string> findSoaArrays(std::shared_ptr<KamusStmt> kamus, const ScopedBodies& bodies,
+                                                     const std::set<std::string>& lowered);
+    /** @brief Check whether a dynamic array name in the current scope uses amortized growth */
+    bool isGrownArray(const std::string& name) const;
+    /** @brief Check whether a dynamic array name in the current scope is stored flat */
+    bool isFlatArray(const std::string& name) const;
+    /** @brief Get the record type of an array in the current scope stored as one array per field */
+    std::shared_ptr<RecordTypeDeclStmt> soaRecord(const std::string& name) const;
+    /** @brief Pascal type of a record field, including pointer fields */
+    std::string fieldPascalType(const RecordTypeDeclStmt::Field& field);
+    /** @brief Emit the per-field arrays that replace an array of records (--soa) */
+    void generateSoaDeclaration(const std::vector<core::Token>& names, const RecordTypeDeclStmt& record, const std::string& shape);
+    /** @brief Find the statements whose static array indexing needs no range check */
+    void selectRangeCheckElisions(std::shared_ptr<ProgramStmt> program);
+    /** @brief Get the literal trip count of a repeat loop that may be unrolled, or -1 */
+    int unrollableCount(std::shared_ptr<RepeatNTimesStmt> stmt) const;
+    /** @brief Collect every name declared by a subprogram */
+    std::set<std::string> declaredNames(const std::vector<Parameter>& params, std::shared_ptr<KamusStmt> kamus) const;
+    /** @brief Choose which subprograms get the inline directive */
+    void selectInlineSubprograms(std::shared_ptr<ProgramStmt> program);
+    /** @brief Choose the pure recursive functions that get a memo table (--memo) */
+    void selectMemoFunctions(std::shared_ptr<ProgramStmt> program);
+    /** @brief Emit the memo tables of every memoized function */
+    void generateMemoTables(std::shared_ptr<ProgramStmt> program);
+    /** @brief Emit the fill-on-miss wrapper of a memoized function */
+    void generateMemoWrapper(std::shared_ptr<FunctionStmt> stmt);
+    /** @brief Choose the pure functions over a small domain that become tables (--tabulate) */
+    void selectTabulatedFunctions(std::shared_ptr<ProgramStmt> program);
+    /** @brief Get the integer range a parameter constraint allows, if it is constant */
+    bool constraintRange(const Parameter& param, long long& low, long long& high);
+    /** @brief Emit the constant table of every tabulated function */
+    void generateTabulatedTables();
+    /** @brief Evaluate an expression calling pure functions to Pascal literal text, or "" with the reason */
+    std::string foldConstantCall(std::shared_ptr<Expression> expr, std::string& reason);
+    /** @brief Generate a static array bound, evaluating calls to pure functions */
+    std::string arrayBound(std::shared_ptr<Expression> bound, const core::Token& array);
+    /** @brief Record a constant expression left as written, once per position */
+    void noteConstEvalFallback(const core::Token& at, const std::string& what, const std::string& reason);
+    /** @brief Generate an expression without evaluating its calls again */
+    std::string writtenAsIs(std::shared_ptr<Expression> expr);
+    /** @brief Spell a folded value as an exact Pascal literal */
+    std::string foldedLiteral(std::shared_ptr<Literal> literal) const;
+    /** @brief Collect the names of a program's global variables, without constants */
+    std::set<std::string> globalVariableNames(std::shared_ptr<KamusStmt> kamus) const;
+    /** @brief Check whether a function reads and writes nothing but its own parameters and locals */
+    bool isPureFunction(std::shared_ptr<FunctionStmt> func, const std::set<std::string>& globals, bool& recursive) const;
+    /** @brief Choose the `traversal paralel` loops that run on worker threads */
+    void selectParallelTraversals(std::shared_ptr<ProgramStmt> program);
+    /** @brief Find what keeps a `traversal paralel` loop from running in parallel, or "" */
+    std::string parallelBlocker(std::shared_ptr<TraversalStmt> traversal, const std::set<std::string>& pureFunctions,
+                                ParallelTraversal& plan);
+    /** @brief Emit the worker function of every parallel traversal */
+    void generateParallelWorkers();
+    /** @brief Emit the directives that follow a subprogram heading */
+    void generateSubprogramDirectives(const std::string& name);
+    /** @brief Emit FPC compiler directives for the selected profile */
+    void generateCompilerDirectives();
+    /** @brief Assign profile counters to statements and timers to subprograms */
+    void numberStatements(std::shared_ptr<ProgramStmt> program);
+    /** @brief Emit the constant tables read by the Profile runtime section */
+    void generateProfileTables();
+    /** @brief Emit statements that run before the main program body */
+    void generateMainPrologue();
+    /** @brief Emit statements that run after the main program body */
+    void generateMainEpilogue();
+    /** @brief Emit a Pascal runtime support section from src/runtime */
+    void generateRuntimeSection(const std::string& name, const std::string& typeName = "",
+                                const std::string& valueType = "");
     /** @brief Generate Pascal parameter list from NOTAL parameters */
-    void generateParameterList(const std::vector<Parameter>& params);
+    void generateParameterList(const std::vector<Parameter>& params, std::shared_ptr<AlgoritmaStmt> body);
+    /** @brief Choose the Pascal passing modifier (var/const/constref) for a parameter */
+    std::string parameterModifier(const Parameter& param, std::shared_ptr<AlgoritmaStmt> body);
+    /** @brief Estimate the in-memory size of a NOTAL type in bytes */
+    int estimatedTypeSize(const core::Token& type, int depth = 0);
+    /** @brief Estimate the alignment Free Pascal gives a NOTAL type in bytes */
+    int estimatedTypeAlignment(const core::Token& type, int depth = 0);
+    /** @brief Check whether a subprogram body (or other subtree) writes to the named variable */
+    bool isParameterModified(const std::string& name, std::shared_ptr<Statement> body);
     /** @brief Convert NOTAL type token to Pascal type string */
     std::string pascalType(const core::Token& token);
     /** @brief Evaluate expression and return Pascal code string */
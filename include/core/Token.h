@@ -77,6 +77,8 @@ namespace gate::core {
         UNTIL,
         /** @brief traversal keyword - traversal loop */
         TRAVERSAL,
+        /** @brief paralel keyword - parallel traversal */
+        PARALEL,
         /** @brief step keyword - traversal step */
         STEP,
         /** @brief iterate keyword - iteration control */
@@ -300,6 +302,7 @@ namespace gate::core {
         {"repeat", TokenType::REPEAT},
         {"until", TokenType::UNTIL},
         {"traversal", TokenType::TRAVERSAL},
+        {"paralel", TokenType::PARALEL},
         {"step", TokenType::STEP},
         {"iterate", TokenType::ITERATE},
         {"stop", TokenType::STOP},
@@ -0,0 +1,94 @@
+/**
+ * @file Batch.h
+ * @brief Transpiling many NOTAL files in one process (`gate batch`)
+ *
+ * Files are transpiled concurrently on a WorkStealingPool, each with its own
+ * DiagnosticEngine, while the results are reported in input order, so the
+ * output of a batch does not depend on the number of threads.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_DRIVER_BATCH_H
+#define GATE_DRIVER_BATCH_H
+
+#include "driver/Cache.h"
+#include "driver/Transpile.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace gate::driver {
+
+/**
+ * @brief Settings of a batch run
+ */
+struct BatchOptions {
+    /** @brief Directory the generated files are written to */
+    std::string outDir;
+    /** @brief Worker threads; 0 uses one per hardware thread */
+    unsigned jobs = 0;
+    transpiler::CodeGenOptions codeGen;
+    Target target = Target::PASCAL;
+    /** @brief Report only failures, warnings and the summary */
+    bool quiet = false;
+    /** @brief Cache of earlier results, or nullptr */
+    OutputCache* cache = nullptr;
+};
+
+/**
+ * @brief Totals of a batch run
+ */
+struct BatchSummary {
+    size_t files = 0;
+    size_t succeeded = 0;
+    size_t failed = 0;
+    /** @brief Wall-clock time of the whole batch */
+    double seconds = 0.0;
+    /** @brief Worker threads used */
+    unsigned jobs = 0;
+};
+
+/**
+ * @brief Expands `@listfile` arguments into the files they list
+ *
+ * A list file names one input per line; empty lines and lines starting
+ * with `#` are skipped. Other arguments are taken as file names.
+ *
+ * @param args Command-line arguments
+ * @param files Receives the input files, in order
+ * @param error Set to the reason on failure
+ * @return false if a list file cannot be read
+ */
+bool expandInputs(const std::vector<std::string>& args, std::vector<std::string>& files, std::string& error);
+
+/**
+ * @brief Path a batch writes the output of an input file to
+ * @param input Input file
+ * @param options Batch settings (output directory and target)
+ * @return `<outDir>/<input stem>.pas`, or `.c` for the C target
+ */
+std::string batchOutputPath(const std::string& input, const BatchOptions& options);
+
+/**
+ * @brief Transpiles every file, reporting in input order
+ *
+ * For every file, a line naming the output (unless quiet) or the failure is
+ * written as soon as it and all files before it are done, followed by its
+ * diagnostic report. A summary line ends the run, followed by the cache
+ * statistics when a cache is used.
+ *
+ * @param files Input files
+ * @param options Batch settings
+ * @param out Stream for progress and the summary
+ * @param err Stream for failures and diagnostic reports
+ * @return Totals of the run
+ */
+BatchSummary runBatch(const std::vector<std::string>& files, const BatchOptions& options, std::ostream& out,
+                      std::ostream& err);
+
+} // namespace gate::driver
+
+#endif // GATE_DRIVER_BATCH_H
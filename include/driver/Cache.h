@@ -0,0 +1,152 @@
+/**
+ * @file Cache.h
+ * @brief Content-addressed on-disk cache of transpilation results
+ *
+ * A result is stored under a 128-bit hash of the source bytes, the code
+ * generation options, the target, the identity of the transpiler build and
+ * the contents of the runtime and casting templates, so byte-identical sources (resubmissions, templates, shared starter code)
+ * are transpiled once. The file name is not part of the key: reports are
+ * rendered again from the stored diagnostics under the caller's file name.
+ *
+ * Entries are written to a temporary file and renamed into place, so
+ * concurrent processes sharing a directory never read a partial entry. A
+ * hit refreshes the entry's modification time; when the directory outgrows
+ * its size bound, the least recently used entries are removed.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_DRIVER_CACHE_H
+#define GATE_DRIVER_CACHE_H
+
+#include "driver/Transpile.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace gate::driver {
+
+/** @brief Version of GATE, part of every cache key */
+constexpr const char* GATE_VERSION = "1.0.0";
+
+/** @brief Default size bound of a cache directory */
+constexpr uint64_t DEFAULT_CACHE_BYTES = 256ull * 1024 * 1024;
+
+/**
+ * @brief 64-bit xxHash (XXH64) of a buffer
+ * @param data Bytes to hash
+ * @param size Number of bytes
+ * @param seed Hash seed
+ * @return The hash
+ */
+uint64_t xxhash64(const void* data, size_t size, uint64_t seed = 0);
+
+/**
+ * @brief Cache directory used when none is given
+ * @return `$XDG_CACHE_HOME/gate`, else `$HOME/.cache/gate`, else empty
+ */
+std::string defaultCacheDir();
+
+/**
+ * @brief Counters of one process's use of a cache
+ */
+struct CacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t stores = 0;
+    size_t evictions = 0;
+
+    /** @brief One line such as "Cache: 40 hits, 10 misses (80.0% hit rate), 10 stored, 0 evicted" */
+    std::string describe() const;
+};
+
+/**
+ * @brief Transpilation results stored in a directory
+ *
+ * Safe to use from several threads and several processes at once.
+ */
+class OutputCache {
+public:
+    /**
+     * @param directory Cache directory, created by open()
+     * @param maxBytes Size bound of the directory
+     */
+    explicit OutputCache(std::string directory, uint64_t maxBytes = DEFAULT_CACHE_BYTES);
+
+    /**
+     * @brief Creates the cache directory
+     * @param error Set to the reason on failure
+     * @return false if the directory cannot be created
+     */
+    bool open(std::string& error);
+
+    /**
+     * @brief Key of a source transpiled with the given options
+     * @return 32 hexadecimal digits
+     */
+    static std::string key(const std::string& source, const transpiler::CodeGenOptions& options, Target target);
+
+    /**
+     * @brief Reads a stored result
+     *
+     * Fills everything but the report, which needs the caller's file name.
+     * An unreadable or corrupt entry is removed and counts as a miss.
+     *
+     * @param key Key from key()
+     * @param result Receives the stored result
+     * @return true on a hit
+     */
+    bool lookup(const std::string& key, TranspileResult& result);
+
+    /**
+     * @brief Stores a result, evicting old entries when the directory is full
+     * @param key Key from key()
+     * @param result Result to store; its report is not stored
+     */
+    void store(const std::string& key, const TranspileResult& result);
+
+    /** @brief Counters since the cache was created */
+    CacheStats stats() const;
+
+    const std::string& directory() const { return directory_; }
+
+private:
+    std::string directory_;
+    uint64_t maxBytes_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+    std::atomic<size_t> stores_{0};
+    std::atomic<size_t> evictions_{0};
+    std::atomic<size_t> tempCounter_{0};
+    /** @brief Guards usedBytes_ and eviction */
+    std::mutex mutex_;
+    /** @brief Estimated size of the directory; negative until first measured */
+    int64_t usedBytes_ = -1;
+
+    std::string entryPath(const std::string& key) const;
+    void evict();
+};
+
+/**
+ * @brief transpileSource through a cache
+ *
+ * On a hit the stored result is returned with its report rendered for
+ * fileName; on a miss the source is transpiled and the result stored,
+ * unless the code generator failed.
+ *
+ * @param cache Cache to use, or nullptr to always transpile
+ * @param sourceWithComments NOTAL source code as read from the file
+ * @param fileName Name used in diagnostics
+ * @param options Code generation options
+ * @param target Output language
+ * @return Generated code and diagnostics
+ */
+TranspileResult transpileCached(OutputCache* cache, const std::string& sourceWithComments, const std::string& fileName,
+                                const transpiler::CodeGenOptions& options, Target target = Target::PASCAL);
+
+} // namespace gate::driver
+
+#endif // GATE_DRIVER_CACHE_H
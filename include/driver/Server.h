@@ -0,0 +1,205 @@
+/**
+ * @file Server.h
+ * @brief Transpiler daemon on a Unix domain socket (`gate serve`) and its client
+ *
+ * A warm `gate serve` process answers transpilation requests without the
+ * process start-up, option parsing and first-use initialization a `gate`
+ * run pays for every file. A connection may send any number of requests.
+ * Requests, not connections, are the tasks of a WorkStealingPool: an idle
+ * connection waits in the server's poll set and holds no worker thread.
+ *
+ * Wire format: every message is a frame, a 4-byte big-endian payload length
+ * followed by the payload. A request payload is a list of `name=value`
+ * lines, an empty line, then the NOTAL source. `file` names the source in
+ * diagnostics; every other name is a code generation setting (see
+ * parseCodeGenSettings). A response payload is the lines
+ *
+ *     status=ok|failed
+ *     errors=N
+ *     warnings=N
+ *     diagnostic=<level>\t<line>\t<column>\t<code>\t<message>   (one per diagnostic)
+ *
+ * an empty line, then the generated code.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_DRIVER_SERVER_H
+#define GATE_DRIVER_SERVER_H
+
+#include "driver/Cache.h"
+#include "driver/Settings.h"
+#include "driver/Transpile.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gate::driver {
+
+/** @brief Largest frame accepted: the largest source file plus room for the settings */
+constexpr uint32_t MAX_FRAME_BYTES = 10 * 1024 * 1024 + 64 * 1024;
+
+/** @brief Time a client may stall in the middle of a frame before its connection is closed */
+constexpr int FRAME_TIMEOUT_SECONDS = 10;
+
+/**
+ * @brief One transpilation request
+ */
+struct ServeRequest {
+    /** @brief Name of the source in diagnostics */
+    std::string fileName = "<request>";
+    Settings settings;
+    std::string source;
+};
+
+/**
+ * @brief Writes one frame
+ * @param fd Connected socket
+ * @param payload Frame payload
+ * @return false if the peer is gone or the payload is too large
+ */
+bool writeFrame(int fd, const std::string& payload);
+
+/**
+ * @brief Reads one frame
+ * @param fd Connected socket
+ * @param payload Receives the frame payload
+ * @return false at end of stream, on errors and on frames over MAX_FRAME_BYTES
+ */
+bool readFrame(int fd, std::string& payload);
+
+/** @brief Request payload of a request */
+std::string encodeRequest(const ServeRequest& request);
+
+/** @brief Decodes a request payload; false if it has no end of the settings */
+bool decodeRequest(const std::string& payload, ServeRequest& request);
+
+/** @brief Response payload of a result; tabs and newlines in messages become spaces */
+std::string encodeResponse(const TranspileResult& result);
+
+/**
+ * @brief Decodes a response payload
+ *
+ * The diagnostics get their level, line, column, code and message; the
+ * report, which needs the source to render, stays empty.
+ *
+ * @param payload Response payload
+ * @param result Receives the response
+ * @return false if the payload is malformed
+ */
+bool decodeResponse(const std::string& payload, TranspileResult& result);
+
+/**
+ * @brief Answers one request payload, as the server does
+ *
+ * A malformed request or unknown setting is answered with a failed
+ * response carrying one error diagnostic.
+ *
+ * @param payload Request payload
+ * @param cache Cache of earlier results, or nullptr
+ * @return Response payload
+ */
+std::string serveRequest(const std::string& payload, OutputCache* cache = nullptr);
+
+/**
+ * @brief Connects to a `gate serve` socket
+ * @param socketPath Socket path
+ * @param error Set to the reason on failure
+ * @return The connected socket, or -1
+ */
+int connectToServer(const std::string& socketPath, std::string& error);
+
+/**
+ * @brief Sends a request on an open connection and reads the response
+ * @param fd Socket from connectToServer
+ * @param request Request to send
+ * @param result Receives the response
+ * @param error Set to the reason on failure
+ * @return false if the connection failed or the response is malformed
+ */
+bool transpileRemote(int fd, const ServeRequest& request, TranspileResult& result, std::string& error);
+
+/**
+ * @brief The `gate serve` daemon
+ */
+class Server {
+public:
+    /**
+     * @param socketPath Path of the socket to listen on
+     * @param threads Worker threads; 0 uses one per hardware thread
+     * @param cache Cache of earlier results, or nullptr
+     */
+    explicit Server(std::string socketPath, unsigned threads = 0, OutputCache* cache = nullptr);
+
+    /** @brief Closes the socket and removes its path */
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /**
+     * @brief Binds the socket and warms up the pipeline
+     *
+     * A stale socket left by a server that is gone is replaced; a socket
+     * with a live server behind it, or a path that is not a socket, is not.
+     *
+     * @param error Set to the reason on failure
+     * @return false if the socket cannot be bound
+     */
+    bool listen(std::string& error);
+
+    /**
+     * @brief Serves requests until stop is called
+     *
+     * Waits on the listening socket and every idle connection; each request
+     * that arrives becomes one task on the pool. Before returning, open
+     * connections are shut down and the requests in progress finish.
+     */
+    void run();
+
+    /** @brief Makes run return; safe to call from a signal handler */
+    void stop();
+
+    /** @brief Number of worker threads */
+    unsigned threads() const { return threads_; }
+
+    /** @brief Number of requests answered so far */
+    size_t requestCount() const { return requests_.load(); }
+
+private:
+    std::string socketPath_;
+    unsigned threads_;
+    OutputCache* cache_;
+    /** @brief An open connection and the buffers reused by its requests */
+    struct Connection {
+        int fd;
+        std::string request;
+        std::string response;
+    };
+
+    int listenFd_ = -1;
+    /** @brief Self-pipe written by stop() and polled by run() */
+    int stopPipe_[2] = {-1, -1};
+    /** @brief Self-pipe written by a worker that hands a connection back to run() */
+    int wakePipe_[2] = {-1, -1};
+    /** @brief Guards connections_ and returned_ */
+    std::mutex mutex_;
+    /** @brief Open connections by socket, shut down when the server stops */
+    std::map<int, std::unique_ptr<Connection>> connections_;
+    /** @brief Connections whose request was answered, to be polled again */
+    std::vector<int> returned_;
+    std::atomic<size_t> requests_{0};
+
+    void serveRequestOn(Connection& connection);
+    void closeConnection(int fd);
+};
+
+} // namespace gate::driver
+
+#endif // GATE_DRIVER_SERVER_H
@@ -0,0 +1,48 @@
+/**
+ * @file Settings.h
+ * @brief Code generation options as name/value pairs
+ *
+ * The command line, `gate client` and the `gate serve` protocol all name
+ * code generation options by their command-line flag (`profile=release`,
+ * `memo=true`), so one parser gives them the same meaning and defaults.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_DRIVER_SETTINGS_H
+#define GATE_DRIVER_SETTINGS_H
+
+#include "driver/Transpile.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gate::driver {
+
+/** @brief Flag names without the leading `--`, with their values, in order */
+using Settings = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Applies code generation settings
+ *
+ * Accepts the names of the code generation flags (`target`, `profile`,
+ * `inline-threshold`, `alloc`, `flat-arrays`, `unroll`, `instrument`,
+ * `record-layout`, `soa`, `memo`, `const-eval`, `tabulate`, `fast-io`).
+ * Boolean flags take `true` or `false`. A later setting overrides an earlier
+ * one. The release profile's inline threshold and unroll factor apply when
+ * the settings do not give them.
+ *
+ * @param settings Settings to apply
+ * @param options Receives the code generation options
+ * @param target Receives the output language
+ * @param error Set to the reason on failure
+ * @return false if a name or value is unknown
+ */
+bool parseCodeGenSettings(const Settings& settings, transpiler::CodeGenOptions& options, Target& target,
+                          std::string& error);
+
+} // namespace gate::driver
+
+#endif // GATE_DRIVER_SETTINGS_H
@@ -0,0 +1,128 @@
+/**
+ * @file Transpile.h
+ * @brief The NOTAL to Pascal/C pipeline as one call
+ *
+ * Runs comment removal, source validation, lexing, parsing and code
+ * generation on a source held in memory, collecting the generated code and
+ * the diagnostic report. Every call owns its DiagnosticEngine, so calls on
+ * different threads are independent.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_DRIVER_TRANSPILE_H
+#define GATE_DRIVER_TRANSPILE_H
+
+#include "core/PascalCodeGenerator.h"
+#include "diagnostics/Diagnostic.h"
+#include <string>
+#include <vector>
+
+namespace gate::driver {
+
+/**
+ * @brief Output language of the transpiler
+ */
+enum class Target {
+    PASCAL, ///< Free Pascal program (default)
+    C       ///< Single C11 translation unit (--target=c)
+};
+
+/**
+ * @brief Outcome of transpiling one source
+ */
+struct TranspileResult {
+    /** @brief Whether code was generated (no errors were reported) */
+    bool success = false;
+    /** @brief Generated program, empty on failure */
+    std::string code;
+    /** @brief Diagnostic report, empty when there are no errors or warnings */
+    std::string report;
+    size_t errors = 0;
+    size_t warnings = 0;
+    /** @brief Every diagnostic reported, in order */
+    std::vector<diagnostics::Diagnostic> diagnostics;
+    /** @brief The code generator threw, for instance because a template file could not be read */
+    bool generatorFailed = false;
+};
+
+/**
+ * @brief Extension of the files written for a target
+ * @param target Output language
+ * @return ".pas" or ".c"
+ */
+const char* outputExtension(Target target);
+
+/**
+ * @brief Checks an output file path for a target
+ *
+ * The path must pass InputValidator::isValidOutputPath and end with the
+ * target's extension.
+ *
+ * @param path Output file path
+ * @param target Output language
+ * @return true if the path is safe to write the target's code to
+ */
+bool isValidOutputPath(const std::string& path, Target target);
+
+/**
+ * @brief Lower-case name of a diagnostic level ("info", "warning", "error", "fatal")
+ * @param level Diagnostic level
+ * @return The name
+ */
+const char* diagnosticLevelName(diagnostics::DiagnosticLevel level);
+
+/**
+ * @brief One diagnostic as a single machine-readable line
+ *
+ * The line reads `file:line:column: level[code]: message`, without the
+ * `[code]` when the diagnostic has none and without a trailing newline.
+ * Line breaks inside the message are replaced by spaces.
+ *
+ * @param fileName Name of the file the diagnostic refers to
+ * @param diagnostic Diagnostic to format
+ * @return The line
+ */
+std::string diagnosticLine(const std::string& fileName, const diagnostics::Diagnostic& diagnostic);
+
+/**
+ * @brief Removes `{ ... }` comments, replacing each with a space
+ * @param source NOTAL source code
+ * @return The source without comments
+ */
+std::string removeComments(const std::string& source);
+
+/**
+ * @brief Renders the diagnostic report of diagnostics reported earlier
+ *
+ * Gives the report transpileSource would have produced for these
+ * diagnostics, naming the file as given here.
+ *
+ * @param sourceWithComments NOTAL source code the diagnostics refer to
+ * @param fileName Name used in the report
+ * @param diagnostics Diagnostics to render
+ * @return The report, empty when there are no errors or warnings
+ */
+std::string renderReport(const std::string& sourceWithComments, const std::string& fileName,
+                         const std::vector<diagnostics::Diagnostic>& diagnostics);
+
+/**
+ * @brief Transpiles a NOTAL source held in memory
+ *
+ * A code generator that throws (for constructs the target cannot express)
+ * is reported as an error of the file, not propagated.
+ *
+ * @param sourceWithComments NOTAL source code as read from the file
+ * @param fileName Name used in diagnostics
+ * @param options Code generation options
+ * @param target Output language
+ * @return Generated code and diagnostics
+ */
+TranspileResult transpileSource(const std::string& sourceWithComments, const std::string& fileName,
+                                const transpiler::CodeGenOptions& options, Target target = Target::PASCAL);
+
+} // namespace gate::driver
+
+#endif // GATE_DRIVER_TRANSPILE_H
@@ -0,0 +1,146 @@
+/**
+ * @file Watch.h
+ * @brief Rebuilding the outputs of a directory as its sources change (`gate watch`)
+ *
+ * The Watcher transpiles every `.notal` file under a directory, then waits
+ * for inotify events. Events arriving in a burst (an editor's save, a `git
+ * checkout`, a copy of many files) are collected until the directory has
+ * been quiet for the debounce interval and rebuilt together. The hash of
+ * every source and output is kept in memory: a file whose bytes did not
+ * change is not transpiled again, and an output whose bytes did not change
+ * is not written again, so tools watching the outputs see no spurious
+ * modifications.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_DRIVER_WATCH_H
+#define GATE_DRIVER_WATCH_H
+
+#include "driver/Cache.h"
+#include "driver/Transpile.h"
+#include "driver/WorkStealingPool.h"
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gate::driver {
+
+/**
+ * @brief Settings of `gate watch`
+ */
+struct WatchOptions {
+    /** @brief Directory whose `.notal` files are watched, with its subdirectories */
+    std::string directory;
+    /** @brief Directory mirroring the watched tree for the outputs; empty writes them beside the sources */
+    std::string outDir;
+    transpiler::CodeGenOptions codeGen;
+    Target target = Target::PASCAL;
+    /** @brief Quiet time that ends a burst of events */
+    unsigned debounceMs = 10;
+    /** @brief Worker threads; 0 uses one per hardware thread */
+    unsigned jobs = 0;
+    /** @brief Report only failures, warnings and the rebuild summaries */
+    bool quiet = false;
+    /** @brief Cache of earlier results, or nullptr */
+    OutputCache* cache = nullptr;
+};
+
+/**
+ * @brief Totals of one rebuild
+ */
+struct RebuildSummary {
+    /** @brief Files whose source changed and were transpiled */
+    size_t transpiled = 0;
+    /** @brief Outputs written because their bytes changed */
+    size_t written = 0;
+    /** @brief Files skipped because their source, or their output, did not change */
+    size_t unchanged = 0;
+    size_t failed = 0;
+    double milliseconds = 0.0;
+};
+
+/**
+ * @brief Watches a directory and keeps its outputs up to date
+ */
+class Watcher {
+public:
+    explicit Watcher(WatchOptions options);
+
+    /** @brief Removes the inotify watches */
+    ~Watcher();
+
+    Watcher(const Watcher&) = delete;
+    Watcher& operator=(const Watcher&) = delete;
+
+    /**
+     * @brief Watches the directory and its subdirectories
+     * @param error Set to the reason on failure
+     * @return false if the directory cannot be watched
+     */
+    bool start(std::string& error);
+
+    /**
+     * @brief Brings the given files' outputs up to date
+     *
+     * Files are reported in name order once all are done. A file that no
+     * longer exists is forgotten.
+     *
+     * @param files Source files
+     * @param out Stream for progress and the summary
+     * @param err Stream for failures and diagnostic reports
+     * @return Totals of the rebuild
+     */
+    RebuildSummary rebuild(const std::vector<std::string>& files, std::ostream& out, std::ostream& err);
+
+    /** @brief rebuild() of every `.notal` file under the directory */
+    RebuildSummary rebuildAll(std::ostream& out, std::ostream& err);
+
+    /**
+     * @brief Rebuilds the files changed by each burst of events until stop is called
+     * @param out Stream for progress and the summaries
+     * @param err Stream for failures and diagnostic reports
+     */
+    void run(std::ostream& out, std::ostream& err);
+
+    /** @brief Makes run return; safe to call from a signal handler */
+    void stop();
+
+    /**
+     * @brief Path the output of a source file is written to
+     * @param file Source file under the watched directory
+     * @return The path, with `.pas` or `.c` for the extension
+     */
+    std::string outputPath(const std::string& file) const;
+
+private:
+    /** @brief What is known about one source file */
+    struct FileState {
+        uint64_t sourceHash = 0;
+        /** @brief Hash of the output last written or found on disk */
+        uint64_t outputHash = 0;
+        bool hasOutput = false;
+    };
+
+    WatchOptions options_;
+    WorkStealingPool pool_;
+    int inotifyFd_ = -1;
+    /** @brief Self-pipe written by stop() and polled by run() */
+    int stopPipe_[2] = {-1, -1};
+    /** @brief Watched directory of every watch descriptor */
+    std::map<int, std::string> watches_;
+    std::map<std::string, FileState> files_;
+
+    void addWatches(const std::string& directory, std::set<std::string>* found);
+    void readEvents(std::set<std::string>& changed);
+    std::vector<std::string> sourcesUnder(const std::string& directory) const;
+};
+
+} // namespace gate::driver
+
+#endif // GATE_DRIVER_WATCH_H
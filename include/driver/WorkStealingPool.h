@@ -0,0 +1,97 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Fixed-size thread pool with per-worker queues and work stealing
+ *
+ * Every worker owns a double-ended queue. A worker takes its own newest task
+ * first and, when its queue is empty, steals the oldest task of another
+ * worker, so a few slow tasks (a large source file) do not leave the other
+ * workers idle while their own queues still hold work.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_DRIVER_WORK_STEALING_POOL_H
+#define GATE_DRIVER_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gate::driver {
+
+/**
+ * @brief Thread pool whose idle workers steal queued tasks from busy ones
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Starts the workers
+     * @param threads Number of workers; 0 uses one per hardware thread
+     */
+    explicit WorkStealingPool(unsigned threads = 0);
+
+    /** @brief Finishes every queued task, then stops the workers */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Queues a task
+     *
+     * A task submitted from a worker goes to that worker's own queue;
+     * others are dealt to the workers in turn.
+     *
+     * @param task Task to run
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task has finished
+     * @throws The first exception a task threw since the last wait
+     */
+    void wait();
+
+    /** @brief Number of workers */
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    /** @brief Number of tasks run by a worker other than the one they were queued to */
+    size_t stolenCount() const { return stolen_.load(); }
+
+private:
+    /** @brief Tasks queued to one worker */
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    /** @brief Guards queued_, pending_, stopping_ and error_ */
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    /** @brief Tasks waiting in some queue */
+    size_t queued_ = 0;
+    /** @brief Tasks submitted and not yet finished */
+    size_t pending_ = 0;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+    std::atomic<size_t> nextQueue_{0};
+    std::atomic<size_t> stolen_{0};
+
+    void run(size_t index);
+    bool take(size_t index, std::function<void()>& task);
+};
+
+} // namespace gate::driver
+
+#endif // GATE_DRIVER_WORK_STEALING_POOL_H
@@ -114,6 +114,7 @@ public:
     /**
      * @brief Validate output file path for security
      * @param path The output file path to validate
+     * @param extension Extension the file name must end with
      * @return true if path is safe, false otherwise
      * 
      * Checks for potentially dangerous path patterns:
@@ -121,7 +122,7 @@ public:
      * - Home directory references (~)
      * - Command injection attempts (|, >)
      */
-    static bool isValidOutputPath(const std::string& path) {
+    static bool isValidOutputPath(const std::string& path, const std::string& extension = ".pas") {
         if (path.empty()) return false;
 
         std::string trimmed_path = path;
@@ -135,7 +136,8 @@ public:
         if (trimmed_path.empty()) return false;
         if (trimmed_path.length() > MAX_PATH_LENGTH) return false;
 
-        if (trimmed_path.length() < 4 || trimmed_path.substr(trimmed_path.length() - 4) != ".pas") {
+        if (trimmed_path.length() <= extension.length() ||
+            trimmed_path.compare(trimmed_path.length() - extension.length(), extension.length(), extension) != 0) {
             return false;
         }
 
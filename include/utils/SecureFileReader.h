@@ -16,6 +16,7 @@
 #include <filesystem>
 #include <string>
 #include <fstream>
+#include <istream>
 #include <limits>
 #include <system_error>
 
@@ -38,6 +39,9 @@ public:
     /** @brief Maximum allowed file size (10MB) */
     static constexpr size_t MAX_FILE_SIZE = 10 * 1024 * 1024;
 
+    /** @brief Bytes requested from a stream per read (64KB) */
+    static constexpr size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
     /**
      * @brief Result structure for file reading operations
      * 
@@ -96,6 +100,33 @@ public:
         return {true, std::move(content), ""};
     }
 
+    /**
+     * @brief Read a whole stream, such as standard input, with a size limit
+     * @param in The stream to read until its end
+     * @return ReadResult containing success status, content, and error messages
+     *
+     * Reads in chunks of STREAM_CHUNK_SIZE bytes straight into the result,
+     * so a pipe is drained in few reads and without a temporary file. Input
+     * beyond MAX_FILE_SIZE is rejected like a file that is too large.
+     */
+    static ReadResult readStream(std::istream& in) {
+        std::string content;
+        size_t size = 0;
+        while (in) {
+            content.resize(size + STREAM_CHUNK_SIZE);
+            in.read(&content[size], STREAM_CHUNK_SIZE);
+            size += static_cast<size_t>(in.gcount());
+            if (size > MAX_FILE_SIZE) {
+                return {false, "", "Input too large (more than 10MB)"};
+            }
+        }
+        if (in.bad()) {
+            return {false, "", "Cannot read input"};
+        }
+        content.resize(size);
+        return {true, std::move(content), ""};
+    }
+
 private:
     /**
      * @brief Validate file path for security vulnerabilities
@@ -0,0 +1,242 @@
+/**
+ * @file Bytecode.h
+ * @brief Register-based bytecode of the GATE virtual machine
+ *
+ * A compiled program is a Module: one Function per subprogram plus the
+ * main algorithm, a constant pool and a table of the program's types. Each
+ * instruction has an opcode and three 32-bit operands; R[x] names register
+ * x of the current frame, K[x] a constant and G[x] a global (a register of
+ * the main frame).
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_VM_BYTECODE_H
+#define GATE_VM_BYTECODE_H
+
+#include "vm/Value.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gate::vm {
+
+/**
+ * @brief Opcode list as an X-macro: name and operand summary
+ *
+ * Kept in one place so the enum, the disassembler names and the dispatch
+ * table of the interpreter loop stay in the same order.
+ */
+#define GATE_VM_OPCODES(X) \
+    X(MOVE)        /* R[a] = R[b] */ \
+    X(COPY)        /* R[a] = deep copy of R[b] (records, static arrays) */ \
+    X(LOADK)       /* R[a] = K[b] */ \
+    X(LOADI)       /* R[a] = integer b */ \
+    X(INIT)        /* R[a] = default value of type b */ \
+    X(GETG)        /* R[a] = G[b] */ \
+    X(SETG)        /* G[a] = R[b] */ \
+    X(LOAD)        /* R[a] = *R[b] (R[b] holds an address) */ \
+    X(STORE)       /* *R[a] = R[b] */ \
+    X(ADDR_REG)    /* R[a] = address of R[b] */ \
+    X(ADDR_GLOBAL) /* R[a] = address of G[b] */ \
+    X(ADDR_INDEX)  /* R[a] = address of element R[c] of array R[b] */ \
+    X(ADDR_FIELD)  /* R[a] = address of field c of record R[b] */ \
+    X(ADDR_DEREF)  /* R[a] = address of the target of pointer R[b] */ \
+    X(INDEX)       /* R[a] = R[b][R[c]] (array element or string character) */ \
+    X(SETINDEX)    /* R[a][R[b]] = R[c] */ \
+    X(SETCHAR)     /* R[a] = copy of string R[a] with character R[b] set to R[c] */ \
+    X(FIELD)       /* R[a] = field c of record R[b] */ \
+    X(SETFIELD)    /* field b of record R[a] = R[c] */ \
+    X(DEREF)       /* R[a] = target of pointer R[b] */ \
+    X(SETDEREF)    /* target of pointer R[a] = R[b] */ \
+    X(ADD)         /* R[a] = R[b] + R[c] (numbers, or concatenation of strings/characters) */ \
+    X(ADDI)        /* R[a] = R[b] + c (integer immediate) */ \
+    X(SUB)         /* R[a] = R[b] - R[c] */ \
+    X(MUL)         /* R[a] = R[b] * R[c] */ \
+    X(DIVIDE)      /* R[a] = R[b] / R[c] (always real) */ \
+    X(IDIV)        /* R[a] = R[b] div R[c] */ \
+    X(MOD)         /* R[a] = R[b] mod R[c] */ \
+    X(POW)         /* R[a] = trunc(exp(R[c] * ln(R[b]))) */ \
+    X(NEG)         /* R[a] = -R[b] */ \
+    X(NOT)         /* R[a] = not R[b] (boolean or bitwise) */ \
+    X(BAND)        /* R[a] = R[b] and R[c] (integers, bitwise) */ \
+    X(BOR)         /* R[a] = R[b] or R[c] */ \
+    X(BXOR)        /* R[a] = R[b] xor R[c] */ \
+    X(EQ)          /* R[a] = R[b] = R[c] */ \
+    X(NE)          /* R[a] = R[b] <> R[c] */ \
+    X(LT)          /* R[a] = R[b] < R[c] */ \
+    X(LE)          /* R[a] = R[b] <= R[c] */ \
+    X(GT)          /* R[a] = R[b] > R[c] */ \
+    X(GE)          /* R[a] = R[b] >= R[c] */ \
+    X(TOREAL)      /* R[a] = R[b] as real */ \
+    X(TOCHAR)      /* R[a] = one-character string R[b] as character */ \
+    X(TOSTRING)    /* R[a] = character R[b] as string */ \
+    X(JMP)         /* pc = a */ \
+    X(JMPF)        /* if not R[a] then pc = b */ \
+    X(JMPT)        /* if R[a] then pc = b */ \
+    X(JGT)         /* if R[a] > R[b] then pc = c (integers) */ \
+    X(CALL)        /* R[a] = function b (R[a..a+c-1]) */ \
+    X(CALLB)       /* R[a] = builtin b (R[a..a+c-1]) */ \
+    X(RET)         /* return R[a] (a < 0: no value) */ \
+    X(NEWBOX)      /* R[a] = pointer to a new value of type b */ \
+    X(DISPOSE)     /* dispose the target of pointer R[a] */ \
+    X(ALLOC)       /* resize dynamic array R[a] to the c extents R[b..b+c-1] */ \
+    X(FREE)        /* empty dynamic array R[a] */ \
+    X(READ)        /* R[a] = next input value of type b */ \
+    X(WRITE)       /* write R[a]; b is its type (enum names) */ \
+    X(WRITELN)     /* end the output line */ \
+    X(CHECK)       /* if not R[a] then fail with message K[b] */ \
+    X(HALT)        /* stop the program */
+
+/**
+ * @brief Bytecode operation
+ */
+enum class OpCode : uint8_t {
+#define GATE_VM_OPCODE_ENUM(name) name,
+    GATE_VM_OPCODES(GATE_VM_OPCODE_ENUM)
+#undef GATE_VM_OPCODE_ENUM
+};
+
+/**
+ * @brief Returns the mnemonic of an opcode, for disassembly
+ */
+const char* opcodeName(OpCode op);
+
+/**
+ * @brief Builtin subprogram list as an X-macro: id and NOTAL name
+ *
+ * The casting procedures and functions take their result variable by
+ * reference as the second argument, as in the Pascal runtime they are
+ * transpiled against.
+ */
+#define GATE_VM_BUILTINS(X) \
+    X(LENGTH, "length") X(HIGH, "high") X(LOW, "low") \
+    X(ABS, "abs") X(SQR, "sqr") X(SQRT, "sqrt") X(SIN, "sin") X(COS, "cos") X(ARCTAN, "arctan") \
+    X(LN, "ln") X(EXP, "exp") X(ROUND, "round") X(TRUNC, "trunc") \
+    X(ORD, "ord") X(CHR, "chr") X(SUCC, "succ") X(PRED, "pred") X(UPCASE, "upcase") \
+    X(BOOLEAN_TO_CHAR, "booleantochar") X(BOOLEAN_TO_INTEGER, "booleantointeger") \
+    X(BOOLEAN_TO_REAL, "booleantoreal") X(BOOLEAN_TO_STRING, "booleantostring") \
+    X(CHAR_TO_BOOLEAN, "chartoboolean") X(CHAR_TO_INTEGER, "chartointeger") \
+    X(CHAR_TO_REAL, "chartoreal") X(CHAR_TO_STRING, "chartostring") \
+    X(INTEGER_TO_BOOLEAN, "integertoboolean") X(INTEGER_TO_CHAR, "integertochar") \
+    X(INTEGER_TO_HEX_STRING, "integertohexstring") X(INTEGER_TO_REAL, "integertoreal") \
+    X(INTEGER_TO_STRING, "integertostring") X(REAL_TO_BOOLEAN, "realtoboolean") \
+    X(REAL_TO_CHAR, "realtochar") X(REAL_TO_INTEGER, "realtointeger") \
+    X(REAL_TO_STRING, "realtostring") X(STRING_HEX_TO_INTEGER, "stringhextointeger") \
+    X(STRING_TO_BOOLEAN, "stringtoboolean") X(STRING_TO_CHAR, "stringtochar") \
+    X(STRING_TO_INTEGER, "stringtointeger") X(STRING_TO_REAL, "stringtoreal")
+
+/**
+ * @brief Builtin subprogram called by CALLB
+ */
+enum class Builtin : uint8_t {
+#define GATE_VM_BUILTIN_ENUM(id, name) id,
+    GATE_VM_BUILTINS(GATE_VM_BUILTIN_ENUM)
+#undef GATE_VM_BUILTIN_ENUM
+};
+
+/**
+ * @brief A single instruction
+ */
+struct Instruction {
+    /** @brief Operation */
+    OpCode op;
+    /** @brief First operand, usually the destination register */
+    int32_t a = 0;
+    /** @brief Second operand */
+    int32_t b = 0;
+    /** @brief Third operand */
+    int32_t c = 0;
+};
+
+/**
+ * @brief Kind of a type table entry
+ */
+enum class TypeKind : uint8_t {
+    INTEGER,
+    REAL,
+    BOOLEAN,
+    CHARACTER,
+    STRING,
+    NIL,            ///< Type of the NULL literal
+    ENUM,
+    RECORD,
+    STATIC_ARRAY,
+    DYNAMIC_ARRAY,
+    POINTER
+};
+
+/**
+ * @brief Entry of the module type table
+ *
+ * Multi-dimensional arrays are arrays of arrays: `array[1..3][1..4] of
+ * integer` is a STATIC_ARRAY over a STATIC_ARRAY over INTEGER.
+ */
+struct TypeInfo {
+    /** @brief Kind of type */
+    TypeKind kind;
+    /** @brief Declared name (records and enums) */
+    std::string name;
+    /** @brief Enum value names or record field names */
+    std::vector<std::string> names;
+    /** @brief Record field types */
+    std::vector<int> fieldTypes;
+    /** @brief Element type of arrays, target type of pointers */
+    int element = -1;
+    /** @brief Bounds of a static array */
+    int64_t low = 0, high = -1;
+};
+
+/** @brief Type table ids of the basic types */
+enum BasicType : int {
+    TYPE_INTEGER = 0,
+    TYPE_REAL = 1,
+    TYPE_BOOLEAN = 2,
+    TYPE_CHARACTER = 3,
+    TYPE_STRING = 4,
+    TYPE_NIL = 5,
+    BASIC_TYPE_COUNT = 6
+};
+
+/**
+ * @brief Compiled subprogram or main algorithm
+ */
+struct Function {
+    /** @brief Subprogram name ("main" for the algorithm) */
+    std::string name;
+    /** @brief Parameters occupy registers 0..paramCount-1 */
+    int paramCount = 0;
+    /** @brief Registers needed by a frame */
+    int registerCount = 0;
+    /** @brief Instructions */
+    std::vector<Instruction> code;
+    /** @brief Source line of each instruction, for runtime errors */
+    std::vector<int> lines;
+};
+
+/**
+ * @brief A compiled NOTAL program
+ */
+struct Module {
+    /** @brief Subprograms; the main algorithm is functions[main] */
+    std::vector<Function> functions;
+    /** @brief Index of the main algorithm in functions */
+    int main = -1;
+    /** @brief Constant pool */
+    std::vector<Value> constants;
+    /** @brief Type table; the first BASIC_TYPE_COUNT entries are the basic types */
+    std::vector<TypeInfo> types;
+    /** @brief Registers of the main frame that hold global variables */
+    int globalCount = 0;
+    /** @brief Width of integer in bits (16 or 32); results outside it are runtime errors */
+    int integerBits = 32;
+
+    /** @brief Returns a readable listing of the module */
+    std::string disassemble() const;
+};
+
+} // namespace gate::vm
+
+#endif // GATE_VM_BYTECODE_H
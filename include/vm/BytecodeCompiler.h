@@ -0,0 +1,186 @@
+/**
+ * @file BytecodeCompiler.h
+ * @brief Compiles the NOTAL AST to GATE bytecode
+ *
+ * The BytecodeCompiler walks a parsed program with the same visitor
+ * interfaces as the Pascal code generator and emits a register-based
+ * Module for the VirtualMachine. Variables of a subprogram live in fixed
+ * registers of its frame; temporaries are allocated above them in stack
+ * order. Global variables are the registers of the main frame.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_VM_BYTECODE_COMPILER_H
+#define GATE_VM_BYTECODE_COMPILER_H
+
+#include "ast/Expression.h"
+#include "ast/Statement.h"
+#include "core/ConstantEvaluator.h"
+#include "core/PascalCodeGenerator.h"
+#include "vm/Bytecode.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gate::vm {
+
+/**
+ * @brief NOTAL to bytecode compiler
+ *
+ * Expression visitors compile into the register in dest_ and return the
+ * static type id of the expression (-1 for procedure calls and
+ * assignments). Errors are reported as std::runtime_error with the source
+ * line, like the other GATE back ends.
+ */
+class BytecodeCompiler : public ast::StatementVisitor, public ast::ExpressionVisitor {
+public:
+    /**
+     * @brief Creates a compiler
+     * @param integerBits Width of integer in bits: 16 like the generated Pascal, or 32 like fpc -Mobjfpc
+     */
+    explicit BytecodeCompiler(int integerBits = transpiler::PASCAL_INTEGER_BITS);
+
+    /**
+     * @brief Compiles a whole program
+     * @param program Root of the AST
+     * @return Module The compiled program
+     * @throws std::runtime_error on constructs the VM does not support
+     */
+    Module compile(std::shared_ptr<ast::ProgramStmt> program);
+
+    // Statement visitors
+    std::any visit(std::shared_ptr<ast::ProgramStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::KamusStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::AlgoritmaStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::BlockStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::ExpressionStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::InputStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::OutputStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::VarDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::ConstDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::RecordTypeDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::EnumTypeDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::ConstrainedVarDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::StaticArrayDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::DynamicArrayDeclStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::IfStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::WhileStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::RepeatUntilStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::DependOnStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::TraversalStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::IterateStopStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::RepeatNTimesStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::StopStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::SkipStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::ProcedureStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::FunctionStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::ReturnStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::AllocateStmt> stmt) override;
+    std::any visit(std::shared_ptr<ast::DeallocateStmt> stmt) override;
+
+    // Expression visitors
+    std::any visit(std::shared_ptr<ast::Binary> expr) override;
+    std::any visit(std::shared_ptr<ast::Unary> expr) override;
+    std::any visit(std::shared_ptr<ast::Literal> expr) override;
+    std::any visit(std::shared_ptr<ast::Variable> expr) override;
+    std::any visit(std::shared_ptr<ast::Grouping> expr) override;
+    std::any visit(std::shared_ptr<ast::Assign> expr) override;
+    std::any visit(std::shared_ptr<ast::Call> expr) override;
+    std::any visit(std::shared_ptr<ast::FieldAccess> expr) override;
+    std::any visit(std::shared_ptr<ast::FieldAssign> expr) override;
+    std::any visit(std::shared_ptr<ast::ArrayAccess> expr) override;
+
+private:
+    /** @brief Where a variable lives */
+    struct Slot {
+        enum class Kind { LOCAL, REF, GLOBAL } kind = Kind::LOCAL;
+        /** @brief Register (LOCAL, REF) or global index (GLOBAL) */
+        int index = 0;
+        /** @brief Static type id */
+        int type = TYPE_INTEGER;
+        /** @brief Declaration of a constrained variable, checked after each assignment */
+        std::shared_ptr<ast::ConstrainedVarDeclStmt> constraint;
+    };
+
+    /** @brief Signature of a user subprogram */
+    struct Subprogram {
+        int index = -1;
+        std::vector<ast::Parameter> params;
+        std::vector<int> paramTypes;
+        /** @brief Result type, -1 for procedures */
+        int returnType = -1;
+    };
+
+    /** @brief Jumps of a loop waiting for their target */
+    struct Loop {
+        std::vector<size_t> breaks;
+        std::vector<size_t> continues;
+    };
+
+    Module module_;
+    int integerBits_;
+    Function* function_ = nullptr;
+    std::map<std::string, int> typeNames_;
+    std::map<std::string, std::pair<int, int>> constants_;          // name -> (constant index, type)
+    std::map<std::string, Slot> globals_;
+    std::map<std::string, Slot> locals_;
+    std::map<std::string, Subprogram> subprograms_;
+    std::map<std::string, Slot>* scope_ = nullptr;                   // receives declared variables
+    std::unique_ptr<transpiler::ConstantEvaluator> evaluator_;       // runs pure functions for constants
+    std::vector<Loop> loops_;
+    bool inMain_ = true;
+    int returnType_ = -1;
+    int result_ = -1;                                                // register holding the function result
+    int nextRegister_ = 0;
+    int dest_ = 0;
+    int line_ = 0;
+
+    // Declarations
+    void declareVariable(const std::string& name, int type, std::shared_ptr<ast::ConstrainedVarDeclStmt> constraint);
+    void declareSubprogram(std::shared_ptr<ast::Statement> stmt);
+    void compileSubprogram(const std::string& name, std::shared_ptr<ast::KamusStmt> kamus, std::shared_ptr<ast::AlgoritmaStmt> body);
+    int resolveType(const core::Token& type, const core::Token& pointedToType = core::Token());
+    int derivedType(TypeInfo info);
+    bool foldConstant(std::shared_ptr<ast::Expression> expr, Value& value, int& type);
+    bool fitsInteger(int64_t value) const;
+    int addConstant(const Value& value);
+
+    // Emission
+    size_t emit(OpCode op, int a = 0, int b = 0, int c = 0);
+    void patch(size_t at, size_t target);
+    size_t here() const;
+    int allocRegister();
+    void execute(std::shared_ptr<ast::Statement> stmt);
+    [[noreturn]] void error(const std::string& message) const;
+
+    // Expressions
+    int compileExpression(std::shared_ptr<ast::Expression> expr, int dest);
+    int operand(std::shared_ptr<ast::Expression> expr, int& reg);
+    void convert(int reg, int from, int to);
+    int prepareStore(int value, int from, int to);
+    void compileCondition(std::shared_ptr<ast::Expression> expr, std::vector<size_t>& falseJumps);
+    void closeLoop(size_t continueTarget, size_t breakTarget);
+    int compileCall(std::shared_ptr<ast::Call> expr, int dest);
+    int compileBuiltin(Builtin builtin, std::shared_ptr<ast::Call> expr, int dest);
+    bool lookup(const std::string& name, Slot& slot) const;
+    void loadSlot(const Slot& slot, int dest);
+    void storeSlot(const Slot& slot, int value);
+    void assign(std::shared_ptr<ast::Expression> target, int value, int type);
+    int compileAddress(std::shared_ptr<ast::Expression> expr, int dest);
+    int accessPrefix(std::shared_ptr<ast::ArrayAccess> access, size_t count, int& container, bool inPlace);
+    int containerOperand(std::shared_ptr<ast::Expression> expr, int& reg, bool inPlace);
+    bool containsCall(std::shared_ptr<ast::Expression> expr) const;
+    bool isContainer(int type) const;
+    void checkConstraint(const Slot& slot, const std::string& name);
+    bool isCompound(int type) const;
+    int elementType(int type) const;
+    int fieldIndex(int recordType, const std::string& name) const;
+};
+
+} // namespace gate::vm
+
+#endif // GATE_VM_BYTECODE_COMPILER_H
@@ -0,0 +1,162 @@
+/**
+ * @file Value.h
+ * @brief Runtime values of the GATE bytecode virtual machine
+ *
+ * A Value is a tagged scalar (integer, real, boolean, character, enum
+ * ordinal) or a reference to a heap object (string, array, record, pointer
+ * target). Strings, static arrays and records keep Pascal value semantics:
+ * copyOf duplicates them on assignment, while dynamic arrays are shared by
+ * reference as in Free Pascal.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_VM_VALUE_H
+#define GATE_VM_VALUE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gate::vm {
+
+/**
+ * @brief Runtime type tag of a Value
+ */
+enum class ValueKind : uint8_t {
+    NONE,       ///< Uninitialized register
+    INTEGER,    ///< 64-bit signed integer in `i`
+    REAL,       ///< Double in `r`
+    BOOLEAN,    ///< 0 or 1 in `i`
+    CHARACTER,  ///< Character code in `i`
+    ENUM,       ///< Enum ordinal in `i`
+    STRING,     ///< StringObject in `object`
+    ARRAY,      ///< ArrayObject in `object`
+    RECORD,     ///< RecordObject in `object`
+    POINTER,    ///< Box in `object`, or null for NULL
+    ADDRESS     ///< Location of another Value in `address` (by-reference parameters and stores)
+};
+
+struct Value;
+
+/** @brief Heap storage of a string value */
+struct StringObject {
+    /** @brief Characters of the string */
+    std::string text;
+};
+
+/** @brief Heap storage of an array value */
+struct ArrayObject {
+    /** @brief Index of the array type in Module::types */
+    int type = -1;
+    /** @brief Index of the first element */
+    int64_t low = 0;
+    /** @brief Elements in index order */
+    std::vector<Value> items;
+};
+
+/** @brief Heap storage of a record value */
+struct RecordObject {
+    /** @brief Field values in declaration order */
+    std::vector<Value> fields;
+};
+
+/**
+ * @brief A single runtime value
+ */
+struct Value {
+    /** @brief Runtime type tag */
+    ValueKind kind = ValueKind::NONE;
+    union {
+        /** @brief Integer, boolean, character or enum payload */
+        int64_t i;
+        /** @brief Real payload */
+        double r;
+        /** @brief Target of an ADDRESS value */
+        Value* address;
+    };
+    /** @brief Heap object of a string, array, record or pointer value */
+    std::shared_ptr<void> object;
+
+    Value() : i(0) {}
+
+    /** @brief Creates an integer value */
+    static Value integer(int64_t v) { Value value; value.kind = ValueKind::INTEGER; value.i = v; return value; }
+    /** @brief Creates a real value */
+    static Value real(double v) { Value value; value.kind = ValueKind::REAL; value.r = v; return value; }
+    /** @brief Creates a boolean value */
+    static Value boolean(bool v) { Value value; value.kind = ValueKind::BOOLEAN; value.i = v ? 1 : 0; return value; }
+    /** @brief Creates a character value */
+    static Value character(unsigned char v) { Value value; value.kind = ValueKind::CHARACTER; value.i = v; return value; }
+    /** @brief Creates an enum value from its ordinal */
+    static Value enumeration(int64_t ordinal) { Value value; value.kind = ValueKind::ENUM; value.i = ordinal; return value; }
+    /** @brief Creates a string value */
+    static Value string(std::string text) {
+        Value value;
+        value.kind = ValueKind::STRING;
+        value.object = std::make_shared<StringObject>(StringObject{std::move(text)});
+        return value;
+    }
+    /** @brief Creates the NULL pointer */
+    static Value nil() { Value value; value.kind = ValueKind::POINTER; return value; }
+    /** @brief Creates the address of another value */
+    static Value addressOf(Value* target) { Value value; value.kind = ValueKind::ADDRESS; value.address = target; return value; }
+
+    /** @brief Text of a string value */
+    const std::string& text() const { return static_cast<StringObject*>(object.get())->text; }
+    /** @brief Array object of an array value */
+    ArrayObject* array() const { return static_cast<ArrayObject*>(object.get()); }
+    /** @brief Record object of a record value */
+    RecordObject* record() const { return static_cast<RecordObject*>(object.get()); }
+};
+
+/** @brief Target of a pointer, created by `allocate` */
+struct Box {
+    /** @brief The pointed-to value */
+    Value value;
+    /** @brief Set by `deallocate`; dereferencing afterwards is an error */
+    bool disposed = false;
+};
+
+/**
+ * @brief Copies a value for assignment
+ *
+ * Static arrays and records are duplicated element by element, so the copy
+ * can be changed independently. Strings are shared until one of them is
+ * written (see VirtualMachine), dynamic arrays stay shared.
+ *
+ * @param value Value being assigned
+ * @param dynamicArray Tells whether an array object is a dynamic array
+ * @return Value The value to store
+ */
+template <typename IsDynamic>
+Value copyOf(const Value& value, const IsDynamic& dynamicArray) {
+    if (value.kind == ValueKind::ARRAY && value.object && !dynamicArray(value.array()->type)) {
+        auto copy = std::make_shared<ArrayObject>();
+        copy->type = value.array()->type;
+        copy->low = value.array()->low;
+        copy->items.reserve(value.array()->items.size());
+        for (const auto& item : value.array()->items) copy->items.push_back(copyOf(item, dynamicArray));
+        Value result;
+        result.kind = ValueKind::ARRAY;
+        result.object = std::move(copy);
+        return result;
+    }
+    if (value.kind == ValueKind::RECORD && value.object) {
+        auto copy = std::make_shared<RecordObject>();
+        copy->fields.reserve(value.record()->fields.size());
+        for (const auto& field : value.record()->fields) copy->fields.push_back(copyOf(field, dynamicArray));
+        Value result;
+        result.kind = ValueKind::RECORD;
+        result.object = std::move(copy);
+        return result;
+    }
+    return value;
+}
+
+} // namespace gate::vm
+
+#endif // GATE_VM_VALUE_H
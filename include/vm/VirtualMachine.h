@@ -0,0 +1,101 @@
+/**
+ * @file VirtualMachine.h
+ * @brief Interpreter for GATE bytecode
+ *
+ * Runs a Module produced by the BytecodeCompiler. Frames are windows into a
+ * single register stack: a call places its arguments at the top of the
+ * caller's registers and the callee's frame starts there, so arguments are
+ * never copied.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef GATE_VM_VIRTUAL_MACHINE_H
+#define GATE_VM_VIRTUAL_MACHINE_H
+
+#include "vm/Bytecode.h"
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gate::vm {
+
+/**
+ * @brief Error raised while a program runs (bounds, division by zero, constraints, ...)
+ */
+class RuntimeError : public std::runtime_error {
+public:
+    /**
+     * @brief Constructs a runtime error
+     * @param line Source line of the failing instruction, 0 if unknown
+     * @param message Description of the error
+     */
+    RuntimeError(int line, const std::string& message);
+
+    /** @brief Source line of the failing instruction */
+    int line() const { return line_; }
+
+private:
+    int line_;
+};
+
+/**
+ * @brief Bytecode interpreter
+ *
+ * Integers are held in 64 bits, but an integer result that leaves the
+ * module's integer width is a runtime error, the same rule the constant
+ * evaluator applies, so a program never prints a value the generated
+ * Pascal could not compute.
+ */
+class VirtualMachine {
+public:
+    /**
+     * @brief Creates a machine for a module
+     * @param module Compiled program; must outlive the machine
+     * @param input Stream read by `input`
+     * @param output Stream written by `output`
+     */
+    VirtualMachine(const Module& module, std::istream& input, std::ostream& output);
+
+    /**
+     * @brief Runs the main algorithm to completion
+     * @throws RuntimeError when the program fails
+     */
+    void run();
+
+private:
+    /** @brief Saved state of a caller */
+    struct Frame {
+        const Function* function;
+        const Instruction* returnPc;
+        Value* base;
+    };
+
+    const Module& module_;
+    std::istream& input_;
+    std::ostream& output_;
+    std::vector<Value> stack_;
+    std::vector<Frame> frames_;
+    Value emptyString_;
+    int64_t integerLimit_;
+
+    int64_t checked(int64_t value) const;
+
+    Value defaultValue(int type) const;
+    bool isDynamicArray(int type) const;
+    Value& element(const Value& array, const Value& index) const;
+    Box* box(const Value& pointer) const;
+    void resize(const Value& array, const Value* extents, int count) const;
+    Value arithmetic(OpCode op, const Value& left, const Value& right) const;
+    int compare(const Value& left, const Value& right, bool equalityOnly) const;
+    void callBuiltin(Builtin builtin, Value* args) const;
+    Value read(int type);
+    void write(const Value& value, int type);
+};
+
+} // namespace gate::vm
+
+#endif // GATE_VM_VIRTUAL_MACHINE_H
@@ -0,0 +1,137 @@
+/**
+ * @file ASTWalker.cpp
+ * @brief Implementation of the generic AST traversal helpers
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "ast/ASTWalker.h"
+
+namespace gate::ast {
+
+void walkExpression(const std::shared_ptr<Expression>& expr, const ExpressionCallback& onExpression) {
+    if (!expr) return;
+    if (onExpression) onExpression(expr);
+
+    if (auto assign = std::dynamic_pointer_cast<Assign>(expr)) {
+        walkExpression(assign->target, onExpression);
+        walkExpression(assign->value, onExpression);
+    } else if (auto binary = std::dynamic_pointer_cast<Binary>(expr)) {
+        walkExpression(binary->left, onExpression);
+        walkExpression(binary->right, onExpression);
+    } else if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+        walkExpression(unary->right, onExpression);
+    } else if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) {
+        walkExpression(grouping->expression, onExpression);
+    } else if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+        walkExpression(call->callee, onExpression);
+        for (const auto& arg : call->arguments) walkExpression(arg, onExpression);
+    } else if (auto fieldAccess = std::dynamic_pointer_cast<FieldAccess>(expr)) {
+        walkExpression(fieldAccess->object, onExpression);
+    } else if (auto fieldAssign = std::dynamic_pointer_cast<FieldAssign>(expr)) {
+        walkExpression(fieldAssign->target, onExpression);
+        walkExpression(fieldAssign->value, onExpression);
+    } else if (auto arrayAccess = std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+        walkExpression(arrayAccess->callee, onExpression);
+        for (const auto& index : arrayAccess->indices) walkExpression(index, onExpression);
+    }
+}
+
+void walkStatement(const std::shared_ptr<Statement>& stmt,
+                   const StatementCallback& onStatement,
+                   const ExpressionCallback& onExpression) {
+    if (!stmt) return;
+    if (onStatement && !onStatement(stmt)) return;
+
+    auto walk = [&](const std::shared_ptr<Statement>& s) { walkStatement(s, onStatement, onExpression); };
+    auto walkExpr = [&](const std::shared_ptr<Expression>& e) { walkExpression(e, onExpression); };
+
+    if (auto program = std::dynamic_pointer_cast<ProgramStmt>(stmt)) {
+        walk(program->kamus);
+        for (const auto& sub : program->subprograms) walk(sub);
+        walk(program->algoritma);
+    } else if (auto kamus = std::dynamic_pointer_cast<KamusStmt>(stmt)) {
+        // Subprogram declarations share their node with ProgramStmt::subprograms,
+        // so they are reached from there instead of being walked twice.
+        for (const auto& decl : kamus->declarations) {
+            if (std::dynamic_pointer_cast<ProcedureStmt>(decl) || std::dynamic_pointer_cast<FunctionStmt>(decl)) continue;
+            walk(decl);
+        }
+    } else if (auto algoritma = std::dynamic_pointer_cast<AlgoritmaStmt>(stmt)) {
+        walk(algoritma->body);
+    } else if (auto block = std::dynamic_pointer_cast<BlockStmt>(stmt)) {
+        for (const auto& s : block->statements) walk(s);
+    } else if (auto exprStmt = std::dynamic_pointer_cast<ExpressionStmt>(stmt)) {
+        walkExpr(exprStmt->expression);
+    } else if (auto constDecl = std::dynamic_pointer_cast<ConstDeclStmt>(stmt)) {
+        walkExpr(constDecl->initializer);
+    } else if (auto constrained = std::dynamic_pointer_cast<ConstrainedVarDeclStmt>(stmt)) {
+        walkExpr(constrained->constraint);
+    } else if (auto staticArray = std::dynamic_pointer_cast<StaticArrayDeclStmt>(stmt)) {
+        for (const auto& dim : staticArray->dimensions) {
+            walkExpr(dim.start);
+            walkExpr(dim.end);
+        }
+    } else if (auto input = std::dynamic_pointer_cast<InputStmt>(stmt)) {
+        walkExpr(input->variable);
+    } else if (auto output = std::dynamic_pointer_cast<OutputStmt>(stmt)) {
+        for (const auto& e : output->expressions) walkExpr(e);
+    } else if (auto allocate = std::dynamic_pointer_cast<AllocateStmt>(stmt)) {
+        walkExpr(allocate->callee);
+        for (const auto& size : allocate->sizes) walkExpr(size);
+    } else if (auto deallocate = std::dynamic_pointer_cast<DeallocateStmt>(stmt)) {
+        walkExpr(deallocate->callee);
+    } else if (auto ifStmt = std::dynamic_pointer_cast<IfStmt>(stmt)) {
+        walkExpr(ifStmt->condition);
+        walk(ifStmt->thenBranch);
+        walk(ifStmt->elseBranch);
+    } else if (auto whileStmt = std::dynamic_pointer_cast<WhileStmt>(stmt)) {
+        walkExpr(whileStmt->condition);
+        walk(whileStmt->body);
+    } else if (auto repeatUntil = std::dynamic_pointer_cast<RepeatUntilStmt>(stmt)) {
+        walk(repeatUntil->body);
+        walkExpr(repeatUntil->condition);
+    } else if (auto dependOn = std::dynamic_pointer_cast<DependOnStmt>(stmt)) {
+        for (const auto& e : dependOn->expressions) walkExpr(e);
+        for (const auto& c : dependOn->cases) {
+            for (const auto& cond : c.conditions) walkExpr(cond);
+            walk(c.body);
+        }
+        walk(dependOn->otherwiseBranch);
+    } else if (auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt)) {
+        walkExpr(traversal->start);
+        walkExpr(traversal->end);
+        walkExpr(traversal->step);
+        walk(traversal->body);
+    } else if (auto iterate = std::dynamic_pointer_cast<IterateStopStmt>(stmt)) {
+        walk(iterate->body);
+        walkExpr(iterate->condition);
+    } else if (auto repeatN = std::dynamic_pointer_cast<RepeatNTimesStmt>(stmt)) {
+        walkExpr(repeatN->times);
+        walk(repeatN->body);
+    } else if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(stmt)) {
+        walk(proc->kamus);
+        walk(proc->body);
+    } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(stmt)) {
+        walk(func->kamus);
+        walk(func->body);
+    } else if (auto ret = std::dynamic_pointer_cast<ReturnStmt>(stmt)) {
+        walkExpr(ret->value);
+    }
+}
+
+std::shared_ptr<Variable> rootVariable(const std::shared_ptr<Expression>& expr) {
+    if (!expr) return nullptr;
+    if (auto var = std::dynamic_pointer_cast<Variable>(expr)) return var;
+    if (auto fieldAccess = std::dynamic_pointer_cast<FieldAccess>(expr)) return rootVariable(fieldAccess->object);
+    if (auto arrayAccess = std::dynamic_pointer_cast<ArrayAccess>(expr)) return rootVariable(arrayAccess->callee);
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) return rootVariable(grouping->expression);
+    if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+        if (unary->op.type == core::TokenType::POWER) return rootVariable(unary->right);
+    }
+    return nullptr;
+}
+
+} // namespace gate::ast
@@ -0,0 +1,1834 @@
+/**
+ * @file CCodeGenerator.cpp
+ * @brief Implementation of the NOTAL to C code generator
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "core/CCodeGenerator.h"
+#include "ast/ASTWalker.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace gate::transpiler {
+
+using namespace gate::ast;
+using core::Token;
+using core::TokenType;
+
+namespace {
+
+constexpr int TYPE_INTEGER = 0;
+constexpr int TYPE_REAL = 1;
+constexpr int TYPE_BOOLEAN = 2;
+constexpr int TYPE_CHARACTER = 3;
+constexpr int TYPE_STRING = 4;
+constexpr int TYPE_NIL = 5;
+constexpr int BASIC_TYPE_COUNT = 6;
+
+std::string lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+/** @brief C keywords and C library names that a NOTAL identifier must not take */
+const std::set<std::string> RESERVED_C_NAMES = {
+    "auto", "bool", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+    "extern", "false", "float", "for", "goto", "if", "inline", "int", "long", "main", "register", "restrict",
+    "return", "short", "signed", "sizeof", "static", "struct", "switch", "true", "typedef", "union", "unsigned",
+    "void", "volatile", "while", "NULL", "EOF", "FILE", "errno", "stdin", "stdout", "stderr", "size_t",
+    "abs", "acos", "asin", "assert", "atan", "atan2", "atof", "atoi", "atol", "bcopy", "bzero", "calloc", "cbrt",
+    "ceil", "clock", "copysign", "cos", "cosh", "div", "erf", "exit", "exp", "exp2", "fabs", "fflush", "floor",
+    "fma", "fmax", "fmin", "fmod", "fprintf", "fputs", "free", "frexp", "fwrite", "gamma", "getchar", "getenv",
+    "hypot", "index", "isdigit", "isinf", "isnan", "j0", "j1", "jn", "labs", "ldexp", "lgamma", "log", "log10",
+    "log1p", "log2", "lround", "malloc", "memcmp", "memcpy", "memmove", "memset", "modf", "nan", "nearbyint",
+    "pow", "printf", "putchar", "puts", "qsort", "rand", "random", "realloc", "remainder", "remove", "rename",
+    "rindex", "rint", "round", "scanf", "setvbuf", "sin", "sinh", "snprintf", "sprintf", "sqrt", "srand",
+    "strcat", "strchr", "strcmp", "strcpy", "strdup", "strlen", "strncmp", "strstr", "strtod", "strtoll",
+    "system", "tan", "tanh", "tgamma", "time", "tolower", "toupper", "trunc", "y0", "y1", "yn"};
+
+/** @brief Casting helpers of src/casting, in their C spelling (gate_<Name>) */
+const std::vector<std::string> CASTING_FUNCTIONS = {
+    "BooleanToChar", "BooleanToInteger", "BooleanToReal", "BooleanToString", "CharToBoolean", "CharToInteger",
+    "CharToReal", "CharToString", "IntegerToBoolean", "IntegerToChar", "IntegerToHexString", "IntegerToReal",
+    "IntegerToString", "RealToBoolean", "RealToChar", "RealToInteger", "RealToString", "StringHexToInteger",
+    "StringToBoolean", "StringToChar", "StringToInteger", "StringToReal"};
+
+/** @brief Casting helpers that are functions reporting whether the conversion succeeded */
+const std::set<std::string> CASTING_PREDICATES = {
+    "BooleanToChar", "CharToBoolean", "CharToInteger", "CharToReal", "IntegerToChar", "RealToChar",
+    "StringHexToInteger", "StringToBoolean", "StringToChar", "StringToInteger", "StringToReal"};
+
+std::string readRuntime(const std::string& name) {
+    std::string filePath = "src/runtime/" + name + ".runtime.txt";
+    std::ifstream file(filePath);
+    if (!file) {
+        throw std::runtime_error("Could not open runtime file: " + filePath);
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+std::string escapeCharacter(unsigned char c, char quote) {
+    switch (c) {
+        case '\\': return "\\\\";
+        case '\n': return "\\n";
+        case '\r': return "\\r";
+        case '\t': return "\\t";
+        default: break;
+    }
+    if (c == static_cast<unsigned char>(quote)) return std::string("\\") + quote;
+    if (c < 32 || c >= 127) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "\\%03o", c);
+        return buffer;
+    }
+    return std::string(1, static_cast<char>(c));
+}
+
+std::string stringLiteral(const std::string& text) {
+    std::string result = "\"";
+    for (size_t i = 0; i < text.size(); ++i) {
+        // "??" could start a trigraph in strict C modes
+        if (text[i] == '?' && i > 0 && text[i - 1] == '?') result += "\\?";
+        else result += escapeCharacter(static_cast<unsigned char>(text[i]), '"');
+    }
+    return result + "\"";
+}
+
+std::string characterLiteral(unsigned char c) {
+    return "'" + escapeCharacter(c, '\'') + "'";
+}
+
+std::string integerLiteral(long long value) {
+    if (value == std::numeric_limits<long long>::min()) return "(-9223372036854775807LL - 1)";
+    std::string digits = std::to_string(value < 0 ? -value : value);
+    if (value > std::numeric_limits<int>::max() || value < std::numeric_limits<int>::min()) digits += "LL";
+    return value < 0 ? "(-" + digits + ")" : digits;
+}
+
+/** @brief Shortest decimal spelling that reads back as the same double */
+std::string realLiteral(double value) {
+    std::ostringstream text;
+    text << std::setprecision(15) << value;
+    if (std::strtod(text.str().c_str(), nullptr) != value) {
+        text.str("");
+        text << std::setprecision(17) << value;
+    }
+    std::string result = text.str();
+    if (result.find_first_of(".eEn") == std::string::npos) result += ".0";
+    return value < 0 ? "(" + result + ")" : result;
+}
+
+/** @brief Wraps code in parentheses unless one pair already encloses all of it */
+std::string parenthesized(const std::string& code) {
+    if (!code.empty() && code.front() == '(') {
+        int depth = 0;
+        for (size_t i = 0; i < code.size(); ++i) {
+            if (code[i] == '(') ++depth;
+            else if (code[i] == ')' && --depth == 0) {
+                if (i == code.size() - 1) return code;
+                break;
+            }
+        }
+    }
+    return "(" + code + ")";
+}
+
+/** @brief Indents every line of a multi-line code fragment by one level */
+std::string indented(const std::string& code) {
+    std::string result;
+    std::istringstream lines(code);
+    std::string line;
+    while (std::getline(lines, line)) result += "    " + line + "\n";
+    return result;
+}
+
+std::shared_ptr<Expression> stripGrouping(std::shared_ptr<Expression> expr) {
+    while (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) expr = grouping->expression;
+    return expr;
+}
+
+} // namespace
+
+CCodeGenerator::CCodeGenerator(CodeGenOptions options) : options_(std::move(options)) {}
+
+/**
+ * @brief Generates the C translation unit for a program
+ *
+ * The bodies are generated first, since they decide which parts of the
+ * output are needed (casting helpers, enum name tables). The unit is then
+ * assembled as: runtime, types and their copy/free helpers, globals,
+ * prototypes, subprograms and main.
+ */
+std::string CCodeGenerator::generate(std::shared_ptr<ProgramStmt> program) {
+    if (!program) return "";
+    checked_ = options_.profile == BuildProfile::DEBUG || options_.profile == BuildProfile::CHECKED;
+    types_ = {
+        CType{Kind::INTEGER, "gate_int", {}, {}},
+        CType{Kind::REAL, "double", {}, {}},
+        CType{Kind::BOOLEAN, "bool", {}, {}},
+        CType{Kind::CHARACTER, "char", {}, {}},
+        CType{Kind::STRING, "GateString", {}, {}},
+        CType{Kind::NIL, "void", {}, {}},
+    };
+    typeNames_.clear();
+    constants_.clear();
+    globals_.clear();
+    locals_.clear();
+    subprograms_.clear();
+    writtenEnums_.clear();
+    out_.str("");
+    globalsOut_.str("");
+    usesCasting_ = false;
+    tempCounter_ = 0;
+    evaluator_ = std::make_unique<ConstantEvaluator>(program);
+
+    execute(program);
+
+    std::stringstream unit;
+    unit << "/* Program " << program->name.lexeme << ", generated by GATE (--target=c) */\n";
+    if (checked_) unit << "#define GATE_CHECKED 1\n";
+    unit << "\n" << readRuntime("CRuntime") << "\n";
+    if (usesCasting_) unit << readRuntime("CCasting") << "\n";
+    unit << typeDefinitions();
+    if (!globalsOut_.str().empty()) unit << globalsOut_.str() << "\n";
+    bool prototypes = false;
+    for (const auto& sub : program->subprograms) {
+        std::string name;
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) name = proc->name.lexeme;
+        else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) name = func->name.lexeme;
+        else continue;
+        unit << signature(subprograms_.at(lower(name))) << ";\n";
+        prototypes = true;
+    }
+    if (prototypes) unit << "\n";
+    unit << out_.str();
+    return unit.str();
+}
+
+// --- Program structure ---
+
+/**
+ * @brief Generates the declarations, every subprogram and then main
+ *
+ * Signatures are collected before any body is generated, so calls do not
+ * depend on the order of the subprograms.
+ */
+std::any CCodeGenerator::visit(std::shared_ptr<ProgramStmt> stmt) {
+    scope_ = &globals_;
+    inSubprogram_ = false;
+    if (stmt->kamus) execute(stmt->kamus);
+    for (const auto& sub : stmt->subprograms) declareSubprogram(sub);
+    for (const auto& sub : stmt->subprograms) execute(sub);
+
+    locals_.clear();
+    returnType_ = -1;
+    out_ << "int main(void) {\n";
+    indentLevel_ = 1;
+    emitLine("gate_io_init();");
+    if (stmt->algoritma) execute(stmt->algoritma);
+    emitLine("return 0;");
+    indentLevel_ = 0;
+    out_ << "}\n";
+    return {};
+}
+
+/**
+ * @brief Declares the types, constants and variables of a KAMUS
+ *
+ * Record names are registered before any field is resolved, so a record can
+ * point to itself or to a record declared after it. Subprogram signatures
+ * in the KAMUS are skipped; they are taken from the definitions.
+ */
+std::any CCodeGenerator::visit(std::shared_ptr<KamusStmt> stmt) {
+    for (const auto& decl : stmt->declarations) {
+        if (auto record = std::dynamic_pointer_cast<RecordTypeDeclStmt>(decl)) {
+            typeNames_[lower(record->typeName.lexeme)] = static_cast<int>(types_.size());
+            types_.push_back(CType{Kind::RECORD, cName(record->typeName.lexeme), {}, {}});
+        } else if (std::dynamic_pointer_cast<EnumTypeDeclStmt>(decl)) {
+            execute(decl);
+        }
+    }
+    for (const auto& decl : stmt->declarations) {
+        if (std::dynamic_pointer_cast<RecordTypeDeclStmt>(decl) || std::dynamic_pointer_cast<ConstDeclStmt>(decl)) execute(decl);
+    }
+    for (const auto& decl : stmt->declarations) {
+        if (std::dynamic_pointer_cast<VarDeclStmt>(decl) || std::dynamic_pointer_cast<StaticArrayDeclStmt>(decl) ||
+            std::dynamic_pointer_cast<DynamicArrayDeclStmt>(decl) || std::dynamic_pointer_cast<ConstrainedVarDeclStmt>(decl)) {
+            execute(decl);
+        }
+    }
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<RecordTypeDeclStmt> stmt) {
+    int id = typeNames_.at(lower(stmt->typeName.lexeme));
+    if (stmt->fields.empty()) error("Record " + stmt->typeName.lexeme + " has no fields.");
+    for (const auto& field : stmt->fields) {
+        int type = resolveType(field.type, field.pointedToType);
+        types_[id].names.push_back(field.name.lexeme);
+        types_[id].fieldTypes.push_back(type);
+    }
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<EnumTypeDeclStmt> stmt) {
+    int id = static_cast<int>(types_.size());
+    CType info{Kind::ENUM, cName(stmt->typeName.lexeme), {}, {}};
+    for (size_t i = 0; i < stmt->values.size(); ++i) {
+        info.names.push_back(stmt->values[i].lexeme);
+        Constant value;
+        value.type = id;
+        value.i = static_cast<long long>(i);
+        constants_[lower(stmt->values[i].lexeme)] = value;
+    }
+    typeNames_[lower(stmt->typeName.lexeme)] = id;
+    types_.push_back(info);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<ConstDeclStmt> stmt) {
+    Constant value;
+    if (!foldConstant(stmt->initializer, value)) {
+        error("The value of constant '" + stmt->name.lexeme + "' is not a constant expression.");
+    }
+    if (!stmt->type.lexeme.empty() && stmt->type.type == TokenType::REAL && value.type == TYPE_INTEGER) {
+        value.r = static_cast<double>(value.i);
+        value.type = TYPE_REAL;
+    }
+    constants_[lower(stmt->name.lexeme)] = value;
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<VarDeclStmt> stmt) {
+    int type = resolveType(stmt->type, stmt->pointedToType);
+    for (const auto& name : stmt->names) declareVariable(name.lexeme, type, nullptr);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<ConstrainedVarDeclStmt> stmt) {
+    int type = resolveType(stmt->type);
+    for (const auto& name : stmt->names) declareVariable(name.lexeme, type, stmt);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<StaticArrayDeclStmt> stmt) {
+    int type = resolveType(stmt->elementType);
+    for (auto dim = stmt->dimensions.rbegin(); dim != stmt->dimensions.rend(); ++dim) {
+        Constant low, high;
+        auto ordinal = [this](const Constant& c) {
+            Kind kind = types_[c.type].kind;
+            return kind == Kind::INTEGER || kind == Kind::CHARACTER || kind == Kind::ENUM || kind == Kind::BOOLEAN;
+        };
+        if (!foldConstant(dim->start, low) || !foldConstant(dim->end, high) || !ordinal(low) || !ordinal(high)) {
+            error("Array bounds of '" + stmt->names[0].lexeme + "' must be ordinal constants.");
+        }
+        if (high.i < low.i) error("Array '" + stmt->names[0].lexeme + "' has no elements.");
+        CType info{Kind::STATIC_ARRAY, "", {}, {}};
+        info.element = type;
+        info.low = low.i;
+        info.high = high.i;
+        type = derivedType(info);
+    }
+    for (const auto& name : stmt->names) declareVariable(name.lexeme, type, nullptr);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<DynamicArrayDeclStmt> stmt) {
+    int type = resolveType(stmt->elementType);
+    for (int i = 0; i < stmt->dimensions; ++i) {
+        CType info{Kind::DYNAMIC_ARRAY, "", {}, {}};
+        info.element = type;
+        type = derivedType(info);
+    }
+    for (const auto& name : stmt->names) declareVariable(name.lexeme, type, nullptr);
+    return {};
+}
+
+/**
+ * @brief Declares a variable in the current scope
+ *
+ * Globals are static and therefore zero-initialized, which is the default
+ * value of every type (0, 0.0, false, empty string, NULL). Locals are
+ * zeroed explicitly, and the ones owning memory are released on return.
+ */
+void CCodeGenerator::declareVariable(const std::string& name, int type, std::shared_ptr<ConstrainedVarDeclStmt> constraint) {
+    Symbol symbol;
+    symbol.name = name;
+    symbol.cname = cName(name);
+    symbol.type = type;
+    symbol.constraint = std::move(constraint);
+    (*scope_)[lower(name)] = symbol;
+    if (inSubprogram_) {
+        emitLine(declaration(type, symbol.cname) + " = " + zeroValue(type) + ";");
+        if (ownsMemory(type)) ownedLocals_.push_back(symbol);
+    } else {
+        globalsOut_ << "static " << declaration(type, symbol.cname) << ";\n";
+    }
+}
+
+void CCodeGenerator::declareSubprogram(std::shared_ptr<Statement> stmt) {
+    Subprogram* sub = nullptr;
+    const std::vector<Parameter>* params = nullptr;
+    if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(stmt)) {
+        sub = &subprograms_[lower(proc->name.lexeme)];
+        sub->cname = cName(proc->name.lexeme);
+        params = &proc->params;
+        sub->returnType = -1;
+    } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(stmt)) {
+        sub = &subprograms_[lower(func->name.lexeme)];
+        sub->cname = cName(func->name.lexeme);
+        params = &func->params;
+        sub->returnType = resolveType(func->returnType);
+    } else {
+        return;
+    }
+    sub->params = *params;
+    for (const auto& param : *params) {
+        sub->paramTypes.push_back(resolveType(param.type));
+        sub->copied.push_back(false);
+    }
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<ProcedureStmt> stmt) {
+    generateSubprogram(stmt->name.lexeme, stmt->kamus, stmt->body);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<FunctionStmt> stmt) {
+    generateSubprogram(stmt->name.lexeme, stmt->kamus, stmt->body);
+    return {};
+}
+
+/**
+ * @brief C signature of a subprogram
+ *
+ * Scalars, strings and dynamic arrays are passed by value, records and
+ * static arrays by const pointer, and output and input/output parameters by
+ * pointer. Input parameters the body writes to arrive as gate_in_<name> and
+ * are copied into a local of the declared name.
+ */
+std::string CCodeGenerator::signature(const Subprogram& sub) const {
+    std::string params;
+    for (size_t i = 0; i < sub.params.size(); ++i) {
+        if (i > 0) params += ", ";
+        std::string name = cName(sub.params[i].name.lexeme);
+        int type = sub.paramTypes[i];
+        if (sub.params[i].mode != ParameterMode::INPUT) {
+            params += declaration(type, "*" + name);
+        } else if (isCompound(type)) {
+            params += "const " + declaration(type, "*gate_in_" + name);
+        } else {
+            params += declaration(type, sub.copied[i] ? "gate_in_" + name : name);
+        }
+    }
+    if (params.empty()) params = "void";
+    std::string head = sub.cname + "(" + params + ")";
+    return sub.returnType < 0 ? "void " + head : declaration(sub.returnType, head);
+}
+
+/**
+ * @brief Generates one subprogram
+ *
+ * A function keeps its result in gate_result and returns it at the end, so
+ * `-> value` sets the result without leaving, as in the Pascal output. A
+ * string result is handed to the temporary arena, to be released with the
+ * caller's statement.
+ */
+void CCodeGenerator::generateSubprogram(const std::string& name, std::shared_ptr<KamusStmt> kamus, std::shared_ptr<AlgoritmaStmt> body) {
+    Subprogram& sub = subprograms_.at(lower(name));
+    for (size_t i = 0; i < sub.params.size(); ++i) {
+        int type = sub.paramTypes[i];
+        if (sub.params[i].mode != ParameterMode::INPUT) continue;
+        if (type == TYPE_STRING || isCompound(type)) sub.copied[i] = isWritten(sub.params[i].name.lexeme, body, false);
+        else if (types_[type].kind == Kind::DYNAMIC_ARRAY) sub.copied[i] = isWritten(sub.params[i].name.lexeme, body, true);
+    }
+
+    std::map<std::string, Constant> savedConstants = constants_;
+    locals_.clear();
+    ownedLocals_.clear();
+    scope_ = &locals_;
+    inSubprogram_ = true;
+    returnType_ = sub.returnType;
+    loopDepth_ = 0;
+
+    out_ << signature(sub) << " {\n";
+    indentLevel_ = 1;
+    for (size_t i = 0; i < sub.params.size(); ++i) {
+        Symbol symbol;
+        symbol.name = sub.params[i].name.lexeme;
+        symbol.cname = cName(symbol.name);
+        symbol.type = sub.paramTypes[i];
+        const std::string& local = symbol.cname;
+        std::string incoming = "gate_in_" + local;
+        int type = symbol.type;
+        if (sub.params[i].mode != ParameterMode::INPUT) {
+            symbol.reference = true;
+        } else if (isCompound(type) && !sub.copied[i]) {
+            symbol.cname = incoming;
+            symbol.reference = true;
+        } else if (isCompound(type) || type == TYPE_STRING) {
+            if (type == TYPE_STRING && sub.copied[i]) {
+                emitLine("GateString " + local + " = gate_str_clone(" + incoming + ");");
+                ownedLocals_.push_back(symbol);
+            } else if (isCompound(type)) {
+                emitLine(declaration(type, local) + " = " + zeroValue(type) + ";");
+                emitLine(copyCode(type, local, "(*" + incoming + ")"));
+                if (ownsMemory(type)) ownedLocals_.push_back(symbol);
+            }
+        } else if (sub.copied[i]) {
+            // Resizing must not move the caller's elements
+            int element = types_[type].element;
+            emitLine(declaration(type, local) + " = {0};");
+            emitLine("gate_dyn_resize(&" + local + ", sizeof *" + local + ".items, " + incoming + ".length, " + std::to_string(line_) + ");");
+            if (ownsMemory(element)) {
+                std::string i = freshName("gate_i");
+                emitLine("for (gate_int " + i + " = 0; " + i + " < " + local + ".length; ++" + i + ") " +
+                         copyCode(element, local + ".items[" + i + "]", incoming + ".items[" + i + "]"));
+            } else {
+                emitLine("if (" + local + ".length) memcpy(" + local + ".items, " + incoming + ".items, (size_t)" + local +
+                         ".length * sizeof *" + local + ".items);");
+            }
+        }
+        locals_[lower(symbol.name)] = symbol;
+    }
+    for (const auto& param : sub.params) {
+        if (!param.constraint || options_.profile == BuildProfile::RELEASE) continue;
+        // Constrained input parameters are checked on entry only
+        line_ = param.name.line;
+        Symbol checked = locals_.at(lower(param.name.lexeme));
+        checked.constraint = std::make_shared<ConstrainedVarDeclStmt>(std::vector<Token>{param.name}, param.type, param.constraint);
+        emitLine(constraintCheck(checked));
+    }
+    if (returnType_ >= 0) emitLine(declaration(returnType_, "gate_result") + " = " + zeroValue(returnType_) + ";");
+    if (kamus) execute(kamus);
+    if (body) execute(body);
+
+    for (const auto& owned : ownedLocals_) emitLine(freeCode(owned.type, owned.cname));
+    if (returnType_ == TYPE_STRING) emitLine("return gate_str_result(&gate_result);");
+    else if (returnType_ >= 0) emitLine("return gate_result;");
+    indentLevel_ = 0;
+    out_ << "}\n\n";
+
+    constants_ = savedConstants;
+    locals_.clear();
+    ownedLocals_.clear();
+    scope_ = &globals_;
+    inSubprogram_ = false;
+    returnType_ = -1;
+}
+
+// --- Types and constants ---
+
+int CCodeGenerator::resolveType(const Token& type, const Token& pointedToType) {
+    switch (type.type) {
+        case TokenType::INTEGER: return TYPE_INTEGER;
+        case TokenType::REAL: return TYPE_REAL;
+        case TokenType::BOOLEAN: return TYPE_BOOLEAN;
+        case TokenType::CHARACTER: return TYPE_CHARACTER;
+        case TokenType::STRING: return TYPE_STRING;
+        case TokenType::NULL_TYPE: return TYPE_NIL;
+        case TokenType::POINTER: {
+            CType info{Kind::POINTER, "", {}, {}};
+            info.element = resolveType(pointedToType);
+            return derivedType(info);
+        }
+        case TokenType::IDENTIFIER: {
+            auto it = typeNames_.find(lower(type.lexeme));
+            if (it == typeNames_.end()) error("Unknown type '" + type.lexeme + "'.");
+            return it->second;
+        }
+        default:
+            error("Unknown type '" + type.lexeme + "'.");
+    }
+}
+
+/**
+ * @brief Finds or adds an array or pointer type
+ *
+ * Array types are C structs named after their type id: GateArr<id> for
+ * static arrays and GateDyn<id> for dynamic ones.
+ */
+int CCodeGenerator::derivedType(CType info) {
+    for (size_t i = BASIC_TYPE_COUNT; i < types_.size(); ++i) {
+        const CType& known = types_[i];
+        if (known.kind == info.kind && known.kind != Kind::RECORD && known.kind != Kind::ENUM &&
+            known.element == info.element && known.low == info.low && known.high == info.high) {
+            return static_cast<int>(i);
+        }
+    }
+    int id = static_cast<int>(types_.size());
+    if (info.kind == Kind::STATIC_ARRAY) info.name = "GateArr" + std::to_string(id);
+    else if (info.kind == Kind::DYNAMIC_ARRAY) info.name = "GateDyn" + std::to_string(id);
+    types_.push_back(std::move(info));
+    return id;
+}
+
+/**
+ * @brief Evaluates a constant expression at compile time
+ *
+ * Covers literals, named constants and enum values, and the arithmetic,
+ * concatenation and negation of those. Constants are inlined at every use.
+ */
+bool CCodeGenerator::foldConstant(std::shared_ptr<Expression> expr, Constant& value) const {
+    if (auto literal = std::dynamic_pointer_cast<Literal>(expr)) {
+        const std::any& v = literal->value;
+        value = Constant{};
+        if (v.type() == typeid(int)) { value.type = TYPE_INTEGER; value.i = std::any_cast<int>(v); return true; }
+        if (v.type() == typeid(double)) { value.type = TYPE_REAL; value.r = std::any_cast<double>(v); return true; }
+        if (v.type() == typeid(bool)) { value.type = TYPE_BOOLEAN; value.i = std::any_cast<bool>(v); return true; }
+        if (v.type() == typeid(std::string)) {
+            const auto& text = std::any_cast<const std::string&>(v);
+            if (text.size() == 1) { value.type = TYPE_CHARACTER; value.i = static_cast<unsigned char>(text[0]); }
+            else { value.type = TYPE_STRING; value.s = text; }
+            return true;
+        }
+        value.type = TYPE_NIL;
+        return true;
+    }
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) return foldConstant(grouping->expression, value);
+    if (auto variable = std::dynamic_pointer_cast<Variable>(expr)) {
+        Symbol symbol;
+        if (lookup(variable->name.lexeme, symbol)) return false;
+        auto it = constants_.find(lower(variable->name.lexeme));
+        if (it == constants_.end()) return false;
+        value = it->second;
+        return true;
+    }
+    if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+        if (!foldConstant(unary->right, value)) return false;
+        if (unary->op.type == TokenType::MINUS && value.type == TYPE_INTEGER) { value.i = -value.i; return true; }
+        if (unary->op.type == TokenType::MINUS && value.type == TYPE_REAL) { value.r = -value.r; return true; }
+        if (unary->op.type == TokenType::NOT && value.type == TYPE_BOOLEAN) { value.i = !value.i; return true; }
+        return false;
+    }
+    if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+        // A call to a pure function is run now, as the Pascal generator does
+        if (!evaluator_ || !evaluator_->callsFunction(call)) return false;
+        std::set<std::string> shadowed;
+        for (const auto& local : locals_) shadowed.insert(local.first);
+        std::string reason;
+        auto literal = evaluator_->evaluate(call, shadowed, reason);
+        return literal && foldConstant(literal, value);
+    }
+    if (auto binary = std::dynamic_pointer_cast<Binary>(expr)) {
+        Constant left, right;
+        if (!foldConstant(binary->left, left) || !foldConstant(binary->right, right)) return false;
+        TokenType op = binary->op.type;
+        value = Constant{};
+        if (isStringish(left.type) && isStringish(right.type) && (op == TokenType::PLUS || op == TokenType::AMPERSAND)) {
+            auto text = [](const Constant& c) { return c.type == TYPE_STRING ? c.s : std::string(1, static_cast<char>(c.i)); };
+            value.type = TYPE_STRING;
+            value.s = text(left) + text(right);
+            return true;
+        }
+        if (left.type == TYPE_INTEGER && right.type == TYPE_INTEGER) {
+            value.type = TYPE_INTEGER;
+            switch (op) {
+                case TokenType::PLUS: value.i = left.i + right.i; return true;
+                case TokenType::MINUS: value.i = left.i - right.i; return true;
+                case TokenType::MULTIPLY: value.i = left.i * right.i; return true;
+                case TokenType::DIV: if (right.i == 0) return false; value.i = left.i / right.i; return true;
+                case TokenType::MOD: if (right.i == 0) return false; value.i = left.i % right.i; return true;
+                default: break;
+            }
+        }
+        if (isNumeric(left.type) && isNumeric(right.type)) {
+            double l = left.type == TYPE_REAL ? left.r : static_cast<double>(left.i);
+            double r = right.type == TYPE_REAL ? right.r : static_cast<double>(right.i);
+            value.type = TYPE_REAL;
+            switch (op) {
+                case TokenType::PLUS: value.r = l + r; return true;
+                case TokenType::MINUS: value.r = l - r; return true;
+                case TokenType::MULTIPLY: value.r = l * r; return true;
+                case TokenType::DIVIDE: if (r == 0.0) return false; value.r = l / r; return true;
+                default: break;
+            }
+        }
+    }
+    return false;
+}
+
+std::string CCodeGenerator::constantCode(const Constant& value) const {
+    switch (types_[value.type].kind) {
+        case Kind::INTEGER: return integerLiteral(value.i);
+        case Kind::REAL: return realLiteral(value.r);
+        case Kind::BOOLEAN: return value.i ? "true" : "false";
+        case Kind::CHARACTER: return characterLiteral(static_cast<unsigned char>(value.i));
+        case Kind::STRING: return "gate_str_lit(" + stringLiteral(value.s) + ", " + std::to_string(value.s.size()) + ")";
+        case Kind::ENUM: return cName(types_[value.type].names[value.i]);
+        default: return "NULL";
+    }
+}
+
+// --- Type definitions ---
+
+/**
+ * @brief Emits the C types of the program and their copy/free helpers
+ *
+ * Enums come first, then a typedef for every struct so that pointers can
+ * refer to any record, then the struct bodies in the order their by-value
+ * members need. Records and static arrays holding strings get
+ * gate_copy_<T> (deep copy, for assignment) and gate_free_<T>.
+ */
+std::string CCodeGenerator::typeDefinitions() {
+    std::stringstream out;
+    bool any = false;
+    for (size_t i = BASIC_TYPE_COUNT; i < types_.size(); ++i) {
+        const CType& type = types_[i];
+        if (type.kind != Kind::ENUM) continue;
+        out << "typedef enum " << type.name << " {";
+        for (size_t v = 0; v < type.names.size(); ++v) out << (v ? ", " : " ") << cName(type.names[v]);
+        out << " } " << type.name << ";\n";
+        if (writtenEnums_.count(static_cast<int>(i))) {
+            out << "static const char *const gate_names_" << type.name << "[] = {";
+            for (size_t v = 0; v < type.names.size(); ++v) out << (v ? ", " : " ") << stringLiteral(type.names[v]);
+            out << " };\n";
+        }
+        any = true;
+    }
+    for (size_t i = BASIC_TYPE_COUNT; i < types_.size(); ++i) {
+        const CType& type = types_[i];
+        if (type.kind == Kind::RECORD || type.kind == Kind::STATIC_ARRAY || type.kind == Kind::DYNAMIC_ARRAY) {
+            out << "typedef struct " << type.name << " " << type.name << ";\n";
+            any = true;
+        }
+    }
+    if (any) out << "\n";
+
+    std::set<int> defined;
+    std::vector<int> order;
+    for (size_t i = BASIC_TYPE_COUNT; i < types_.size(); ++i) defineType(static_cast<int>(i), defined, order, out);
+
+    for (int id : order) {
+        const CType& type = types_[id];
+        if (!isCompound(id) || !ownsMemory(id)) continue;
+        out << "static inline void gate_copy_" << type.name << "(" << type.name << " *dst, const " << type.name << " *src) {\n";
+        if (type.kind == Kind::RECORD) {
+            for (size_t f = 0; f < type.names.size(); ++f) {
+                std::string field = cName(type.names[f]);
+                out << "    " << copyCode(type.fieldTypes[f], "dst->" + field, "src->" + field) << "\n";
+            }
+        } else {
+            out << "    for (size_t i = 0; i < " << (type.high - type.low + 1) << "; ++i) "
+                << copyCode(type.element, "dst->items[i]", "src->items[i]") << "\n";
+        }
+        out << "}\n\n";
+        out << "static inline void gate_free_" << type.name << "(" << type.name << " *x) {\n";
+        if (type.kind == Kind::RECORD) {
+            for (size_t f = 0; f < type.names.size(); ++f) {
+                if (ownsMemory(type.fieldTypes[f])) out << "    " << freeCode(type.fieldTypes[f], "x->" + cName(type.names[f])) << "\n";
+            }
+        } else {
+            out << "    for (size_t i = 0; i < " << (type.high - type.low + 1) << "; ++i) " << freeCode(type.element, "x->items[i]") << "\n";
+        }
+        out << "}\n\n";
+    }
+    return out.str();
+}
+
+void CCodeGenerator::defineType(int type, std::set<int>& defined, std::vector<int>& order, std::stringstream& out) const {
+    const CType& info = types_[type];
+    if (info.kind != Kind::RECORD && info.kind != Kind::STATIC_ARRAY && info.kind != Kind::DYNAMIC_ARRAY) return;
+    if (!defined.insert(type).second) return;
+    if (info.kind == Kind::RECORD) {
+        for (int field : info.fieldTypes) defineType(field, defined, order, out);
+        out << "struct " << info.name << " {\n";
+        for (size_t f = 0; f < info.names.size(); ++f) out << "    " << declaration(info.fieldTypes[f], cName(info.names[f])) << ";\n";
+        out << "};\n\n";
+    } else if (info.kind == Kind::STATIC_ARRAY) {
+        defineType(info.element, defined, order, out);
+        out << "struct " << info.name << " {\n";
+        out << "    " << declaration(info.element, "items[" + std::to_string(info.high - info.low + 1) + "]") << ";\n";
+        out << "};\n\n";
+    } else {
+        out << "struct " << info.name << " {\n";
+        out << "    " << declaration(info.element, "*items") << ";\n";
+        out << "    gate_int length;\n";
+        out << "    gate_int capacity;\n";
+        out << "};\n\n";
+    }
+    order.push_back(type);
+}
+
+std::string CCodeGenerator::declaration(int type, const std::string& name) const {
+    const CType& info = types_[type];
+    if (info.kind == Kind::POINTER) return declaration(info.element, "*" + name);
+    if (info.kind == Kind::NIL) return "void *" + name;
+    if (name.empty() || name[0] == '*') return info.name + " " + name;
+    return info.name + " " + name;
+}
+
+std::string CCodeGenerator::zeroValue(int type) const {
+    switch (types_[type].kind) {
+        case Kind::STRING:
+        case Kind::RECORD:
+        case Kind::STATIC_ARRAY:
+        case Kind::DYNAMIC_ARRAY: return "{0}";
+        case Kind::POINTER:
+        case Kind::NIL: return "NULL";
+        default: return "0";
+    }
+}
+
+/**
+ * @brief Tells whether values of a type hold heap memory of their own
+ *
+ * Strings own their text, and so do records and static arrays that contain
+ * strings. Dynamic arrays and pointers are references and are released
+ * only by deallocate.
+ */
+bool CCodeGenerator::ownsMemory(int type) const {
+    if (type < 0) return false;
+    const CType& info = types_[type];
+    switch (info.kind) {
+        case Kind::STRING: return true;
+        case Kind::RECORD:
+            return std::any_of(info.fieldTypes.begin(), info.fieldTypes.end(), [this](int field) { return ownsMemory(field); });
+        case Kind::STATIC_ARRAY: return ownsMemory(info.element);
+        default: return false;
+    }
+}
+
+bool CCodeGenerator::isCompound(int type) const {
+    if (type < 0) return false;
+    Kind kind = types_[type].kind;
+    return kind == Kind::RECORD || kind == Kind::STATIC_ARRAY;
+}
+
+std::string CCodeGenerator::copyCode(int type, const std::string& target, const std::string& source) const {
+    if (type == TYPE_STRING) return "gate_str_set(&" + target + ", " + source + ");";
+    if (isCompound(type) && ownsMemory(type)) return "gate_copy_" + types_[type].name + "(&" + target + ", &" + source + ");";
+    return target + " = " + source + ";";
+}
+
+std::string CCodeGenerator::freeCode(int type, const std::string& target) const {
+    if (type == TYPE_STRING) return "gate_str_free(&" + target + ");";
+    if (isCompound(type) && ownsMemory(type)) return "gate_free_" + types_[type].name + "(&" + target + ");";
+    return "";
+}
+
+// --- Emission helpers ---
+
+void CCodeGenerator::emitLine(const std::string& text) {
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (!line.empty()) out_ << std::string(indentLevel_ * 4, ' ') << line << "\n";
+    }
+}
+
+void CCodeGenerator::emitBlock(std::shared_ptr<Statement> body) {
+    ++indentLevel_;
+    execute(body);
+    --indentLevel_;
+}
+
+/**
+ * @brief Emits a statement, releasing the temporaries its expressions made
+ */
+void CCodeGenerator::emitWithTemps(const std::string& code, bool temps) {
+    if (!temps) {
+        emitLine(code);
+        return;
+    }
+    emitLine("{");
+    ++indentLevel_;
+    emitLine("size_t gate_mark = gate_tmp_mark();");
+    emitLine(code);
+    emitLine("gate_tmp_release(gate_mark);");
+    --indentLevel_;
+    emitLine("}");
+}
+
+void CCodeGenerator::execute(std::shared_ptr<Statement> stmt) {
+    if (!stmt) return;
+    int savedLine = line_;
+    if (stmt->line > 0) line_ = stmt->line;
+    stmt->accept(*this);
+    line_ = savedLine;
+}
+
+std::string CCodeGenerator::freshName(const std::string& base) {
+    return base + std::to_string(++tempCounter_);
+}
+
+void CCodeGenerator::error(const std::string& message) const {
+    if (line_ > 0) throw std::runtime_error("Line " + std::to_string(line_) + ": " + message);
+    throw std::runtime_error(message);
+}
+
+/**
+ * @brief C spelling of a NOTAL identifier
+ *
+ * Names that are C keywords, C library functions or in the runtime's gate_
+ * namespace get a trailing underscore.
+ */
+std::string CCodeGenerator::cName(const std::string& name) const {
+    std::string key = lower(name);
+    if (RESERVED_C_NAMES.count(name) || key.rfind("gate_", 0) == 0 || key.rfind("gatearr", 0) == 0 ||
+        key.rfind("gatedyn", 0) == 0 || key == "gatestring") {
+        return name + "_";
+    }
+    return name;
+}
+
+// --- Statements ---
+
+std::any CCodeGenerator::visit(std::shared_ptr<AlgoritmaStmt> stmt) {
+    execute(stmt->body);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<BlockStmt> stmt) {
+    for (const auto& s : stmt->statements) execute(s);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<ExpressionStmt> stmt) {
+    temps_ = false;
+    std::string code = evaluate(stmt->expression).code;
+    if (!std::dynamic_pointer_cast<Assign>(stmt->expression) && !std::dynamic_pointer_cast<FieldAssign>(stmt->expression)) code += ";";
+    emitWithTemps(code, temps_);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<InputStmt> stmt) {
+    Symbol symbol;
+    if (!lookup(stmt->variable->name.lexeme, symbol)) error("Unknown variable '" + stmt->variable->name.lexeme + "'.");
+    std::string address = addressOf(CExpr{symbolCode(symbol), symbol.type, true});
+    std::string line = std::to_string(line_);
+    switch (symbol.type) {
+        case TYPE_INTEGER: emitLine("gate_read_int(" + address + ", " + line + ");"); break;
+        case TYPE_REAL: emitLine("gate_read_real(" + address + ", " + line + ");"); break;
+        case TYPE_BOOLEAN: emitLine("gate_read_bool(" + address + ", " + line + ");"); break;
+        case TYPE_CHARACTER: emitLine("gate_read_char(" + address + ");"); break;
+        case TYPE_STRING: emitLine("gate_read_str(" + address + ");"); break;
+        default: error("Cannot read a value of type " + types_[symbol.type].name + " from input.");
+    }
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<OutputStmt> stmt) {
+    temps_ = false;
+    std::string code;
+    for (const auto& expr : stmt->expressions) {
+        Constant constant;
+        if (foldConstant(expr, constant) && constant.type == TYPE_STRING) {
+            code += "gate_write_cstr(" + stringLiteral(constant.s) + ");\n";
+            continue;
+        }
+        CExpr value = evaluate(expr);
+        if (value.type < 0) error("Only integers, reals, booleans, characters, strings and enum values can be written.");
+        switch (types_[value.type].kind) {
+            case Kind::INTEGER: code += "gate_write_int(" + value.code + ");\n"; break;
+            case Kind::REAL: code += "gate_write_real(" + value.code + ");\n"; break;
+            case Kind::BOOLEAN: code += "gate_write_bool(" + value.code + ");\n"; break;
+            case Kind::CHARACTER: code += "gate_write_char(" + value.code + ");\n"; break;
+            case Kind::STRING: code += "gate_write_str(" + value.code + ");\n"; break;
+            case Kind::ENUM:
+                writtenEnums_.insert(value.type);
+                code += "gate_write_cstr(gate_names_" + types_[value.type].name + "[" + value.code + "]);\n";
+                break;
+            default: error("Only integers, reals, booleans, characters, strings and enum values can be written.");
+        }
+    }
+    emitWithTemps(code + "gate_writeln();", temps_);
+    return {};
+}
+
+std::string CCodeGenerator::condition(std::shared_ptr<Expression> expr, bool& temps) {
+    temps_ = false;
+    std::string code = evaluate(expr).code;
+    temps = temps_;
+    return code;
+}
+
+/**
+ * @brief Generates if/else if/else
+ *
+ * A condition that allocates temporaries is computed into gate_test first,
+ * so they are released before either branch runs.
+ */
+std::any CCodeGenerator::visit(std::shared_ptr<IfStmt> stmt) {
+    bool temps = false;
+    std::string test = condition(stmt->condition, temps);
+    if (temps) {
+        emitLine("{");
+        ++indentLevel_;
+        emitLine("size_t gate_mark = gate_tmp_mark();");
+        emitLine("bool gate_test = " + test + ";");
+        emitLine("gate_tmp_release(gate_mark);");
+        test = "gate_test";
+    }
+    emitLine("if " + parenthesized(test) + " {");
+    emitBlock(stmt->thenBranch);
+    std::shared_ptr<Statement> rest = stmt->elseBranch;
+    while (auto next = std::dynamic_pointer_cast<IfStmt>(rest)) {
+        int savedLine = line_;
+        if (next->line > 0) line_ = next->line;
+        bool nextTemps = false;
+        std::string nextTest = condition(next->condition, nextTemps);
+        line_ = savedLine;
+        if (nextTemps) break;
+        emitLine("} else if " + parenthesized(nextTest) + " {");
+        emitBlock(next->thenBranch);
+        rest = next->elseBranch;
+    }
+    if (rest) {
+        emitLine("} else {");
+        emitBlock(rest);
+    }
+    emitLine("}");
+    if (temps) {
+        --indentLevel_;
+        emitLine("}");
+    }
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<WhileStmt> stmt) {
+    bool temps = false;
+    std::string test = condition(stmt->condition, temps);
+    ++loopDepth_;
+    if (temps) {
+        emitLine("for (;;) {");
+        ++indentLevel_;
+        emitLine("size_t gate_mark = gate_tmp_mark();");
+        emitLine("bool gate_test = " + test + ";");
+        emitLine("gate_tmp_release(gate_mark);");
+        emitLine("if (!gate_test) break;");
+        execute(stmt->body);
+        --indentLevel_;
+    } else {
+        emitLine("while " + parenthesized(test) + " {");
+        emitBlock(stmt->body);
+    }
+    emitLine("}");
+    --loopDepth_;
+    return {};
+}
+
+/**
+ * @brief Generates `repeat ... until (condition)` as do/while
+ *
+ * `skip` continues to the condition, as in Pascal. A condition with
+ * temporaries is evaluated in a comma expression so that holds as well.
+ */
+std::any CCodeGenerator::visit(std::shared_ptr<RepeatUntilStmt> stmt) {
+    bool temps = false;
+    std::string test = condition(stmt->condition, temps);
+    ++loopDepth_;
+    if (temps) {
+        emitLine("{");
+        ++indentLevel_;
+        emitLine("size_t gate_mark;");
+        emitLine("bool gate_test;");
+    }
+    emitLine("do {");
+    emitBlock(stmt->body);
+    if (temps) {
+        emitLine("} while ((gate_mark = gate_tmp_mark(), gate_test = " + test + ", gate_tmp_release(gate_mark), !gate_test));");
+        --indentLevel_;
+        emitLine("}");
+    } else {
+        emitLine("} while (!" + parenthesized(test) + ");");
+    }
+    --loopDepth_;
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<IterateStopStmt> stmt) {
+    bool temps = false;
+    std::string test = condition(stmt->condition, temps);
+    ++loopDepth_;
+    emitLine("for (;;) {");
+    emitBlock(stmt->body);
+    ++indentLevel_;
+    if (temps) {
+        emitLine("size_t gate_mark = gate_tmp_mark();");
+        emitLine("bool gate_test = " + test + ";");
+        emitLine("gate_tmp_release(gate_mark);");
+        emitLine("if (gate_test) break;");
+    } else {
+        emitLine("if " + parenthesized(test) + " break;");
+    }
+    --indentLevel_;
+    emitLine("}");
+    --loopDepth_;
+    return {};
+}
+
+/**
+ * @brief Generates `i traversal [start..end] step s` as a for loop
+ *
+ * The end bound is tested before every trip, like the while loop of the
+ * Pascal output. `traversal paralel` runs sequentially.
+ */
+std::any CCodeGenerator::visit(std::shared_ptr<TraversalStmt> stmt) {
+    Symbol symbol;
+    if (!lookup(stmt->iterator.lexeme, symbol)) error("Unknown traversal iterator '" + stmt->iterator.lexeme + "'.");
+    std::string iterator = symbolCode(symbol);
+
+    bool startTemps = false, endTemps = false;
+    std::string start = condition(stmt->start, startTemps);
+    std::string end = condition(stmt->end, endTemps);
+    std::string step = "++" + iterator;
+    Constant constant;
+    if (stmt->step && !(foldConstant(stmt->step, constant) && constant.type == TYPE_INTEGER && constant.i == 1)) {
+        step = iterator + " += " + evaluate(stmt->step).code;
+    }
+
+    std::string init = iterator + " = " + start;
+    if (startTemps) {
+        emitWithTemps(init + ";", true);
+        init.clear();
+    }
+    ++loopDepth_;
+    if (endTemps) {
+        emitLine("for (" + init + "; ; " + step + ") {");
+        ++indentLevel_;
+        emitLine("size_t gate_mark = gate_tmp_mark();");
+        emitLine("bool gate_test = " + iterator + " <= " + end + ";");
+        emitLine("gate_tmp_release(gate_mark);");
+        emitLine("if (!gate_test) break;");
+        execute(stmt->body);
+        --indentLevel_;
+    } else {
+        emitLine("for (" + init + "; " + iterator + " <= " + end + "; " + step + ") {");
+        emitBlock(stmt->body);
+    }
+    emitLine("}");
+    --loopDepth_;
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<RepeatNTimesStmt> stmt) {
+    bool temps = false;
+    std::string times = condition(stmt->times, temps);
+    std::string counter = freshName("gate_n");
+    ++loopDepth_;
+    if (temps) {
+        emitLine("{");
+        ++indentLevel_;
+        emitLine("size_t gate_mark = gate_tmp_mark();");
+        emitLine("gate_int " + counter + " = " + times + ";");
+        emitLine("gate_tmp_release(gate_mark);");
+        emitLine("for (; " + counter + " > 0; --" + counter + ") {");
+    } else {
+        emitLine("for (gate_int " + counter + " = " + times + "; " + counter + " > 0; --" + counter + ") {");
+    }
+    emitBlock(stmt->body);
+    emitLine("}");
+    if (temps) {
+        --indentLevel_;
+        emitLine("}");
+    }
+    --loopDepth_;
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<StopStmt> stmt) {
+    (void)stmt;
+    if (loopDepth_ == 0) error("'stop' used outside of a loop.");
+    emitLine("break;");
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<SkipStmt> stmt) {
+    (void)stmt;
+    if (loopDepth_ == 0) error("'skip' used outside of a loop.");
+    emitLine("continue;");
+    return {};
+}
+
+/**
+ * @brief Generates `depend on` as an if/else if chain
+ *
+ * Uses the same two forms as the Pascal output: a comparison of a single
+ * subject with each condition when the conditions are literals or names,
+ * otherwise the first condition of each branch as a boolean. When the
+ * tests need temporaries, the branch is chosen first and the temporaries
+ * released before it runs.
+ */
+std::any CCodeGenerator::visit(std::shared_ptr<DependOnStmt> stmt) {
+    bool simpleConditions = true;
+    for (const auto& caseItem : stmt->cases) {
+        for (const auto& cond : caseItem.conditions) {
+            if (!std::dynamic_pointer_cast<Literal>(cond) && !std::dynamic_pointer_cast<Variable>(cond)) simpleConditions = false;
+        }
+    }
+
+    temps_ = false;
+    std::string subjectDeclaration;
+    std::vector<std::string> tests;
+    if (simpleConditions && stmt->expressions.size() == 1) {
+        CExpr subject = evaluate(stmt->expressions[0]);
+        if (subject.type < 0) error("'depend on' needs a value.");
+        if (!subject.lvalue || !std::dynamic_pointer_cast<Variable>(stripGrouping(stmt->expressions[0]))) {
+            std::string name = freshName("gate_subject");
+            subjectDeclaration = declaration(subject.type, name) + " = " + subject.code + ";";
+            subject.code = name;
+        }
+        for (const auto& caseItem : stmt->cases) {
+            std::string test;
+            for (const auto& cond : caseItem.conditions) {
+                if (!test.empty()) test += " || ";
+                test += equality(subject, evaluate(cond));
+            }
+            tests.push_back(caseItem.conditions.size() > 1 ? "(" + test + ")" : test);
+        }
+    } else {
+        for (const auto& caseItem : stmt->cases) tests.push_back(evaluate(caseItem.conditions[0]).code);
+    }
+    bool temps = temps_;
+
+    std::string selector;
+    if (temps || !subjectDeclaration.empty()) {
+        emitLine("{");
+        ++indentLevel_;
+    }
+    if (temps) {
+        selector = freshName("gate_case");
+        emitLine("int " + selector + " = 0;");
+        emitLine("{");
+        ++indentLevel_;
+        emitLine("size_t gate_mark = gate_tmp_mark();");
+        emitLine(subjectDeclaration);
+        for (size_t i = 0; i < tests.size(); ++i) {
+            emitLine(std::string(i ? "else if " : "if ") + parenthesized(tests[i]) + " " + selector + " = " + std::to_string(i + 1) + ";");
+        }
+        emitLine("gate_tmp_release(gate_mark);");
+        --indentLevel_;
+        emitLine("}");
+        for (size_t i = 0; i < tests.size(); ++i) tests[i] = selector + " == " + std::to_string(i + 1);
+    } else {
+        emitLine(subjectDeclaration);
+    }
+    for (size_t i = 0; i < stmt->cases.size(); ++i) {
+        emitLine(std::string(i ? "} else if " : "if ") + parenthesized(tests[i]) + " {");
+        emitBlock(stmt->cases[i].body);
+    }
+    if (stmt->otherwiseBranch) {
+        if (stmt->cases.empty()) {
+            execute(stmt->otherwiseBranch);
+        } else {
+            emitLine("} else {");
+            emitBlock(stmt->otherwiseBranch);
+        }
+    }
+    if (!stmt->cases.empty()) emitLine("}");
+    if (temps || !subjectDeclaration.empty()) {
+        --indentLevel_;
+        emitLine("}");
+    }
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<ReturnStmt> stmt) {
+    if (!inSubprogram_ || returnType_ < 0) error("Return statement used outside of a function.");
+    temps_ = false;
+    CExpr value = evaluate(stmt->value);
+    emitWithTemps(store(returnType_, "gate_result", value), temps_);
+    return {};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<AllocateStmt> stmt) {
+    temps_ = false;
+    CExpr target = evaluate(stmt->callee);
+    if (stmt->sizes.empty()) {
+        if (target.type < 0 || types_[target.type].kind != Kind::POINTER) error("allocate without sizes needs a pointer.");
+        if (!target.lvalue) error("allocate needs a variable.");
+        emitWithTemps(target.code + " = gate_alloc(sizeof *" + target.code + ");", temps_);
+        return {};
+    }
+    int levels = 0;
+    for (int t = target.type; t >= 0 && types_[t].kind == Kind::DYNAMIC_ARRAY; t = types_[t].element) ++levels;
+    if (levels == 0) error("allocate with sizes needs a dynamic array.");
+    if (static_cast<int>(stmt->sizes.size()) > levels) error("allocate gives more sizes than the array has dimensions.");
+
+    std::vector<std::string> sizes;
+    for (const auto& size : stmt->sizes) sizes.push_back(evaluate(size).code);
+    bool hoist = sizes.size() > 1 || ownsMemory(types_[target.type].element);
+    std::string code;
+    if (hoist) {
+        for (auto& size : sizes) {
+            std::string name = freshName("gate_size");
+            code += "gate_int " + name + " = " + size + ";\n";
+            size = name;
+        }
+    }
+    code += resizeCode(target.code, target.type, sizes, 0);
+    if (hoist) code = "{\n" + indented(code) + "}";
+    emitWithTemps(code, temps_);
+    return {};
+}
+
+/**
+ * @brief Code that resizes a dynamic array and, for more sizes, its elements
+ *
+ * Strings dropped by shrinking are released first.
+ */
+std::string CCodeGenerator::resizeCode(const std::string& array, int type, const std::vector<std::string>& sizes, size_t level) {
+    int element = types_[type].element;
+    std::string code;
+    if (ownsMemory(element)) {
+        std::string i = freshName("gate_i");
+        code += "for (gate_int " + i + " = " + sizes[level] + "; " + i + " < " + array + ".length; ++" + i + ") " +
+                freeCode(element, array + ".items[" + i + "]") + "\n";
+    }
+    code += "gate_dyn_resize(&" + array + ", sizeof *" + array + ".items, " + sizes[level] + ", " + std::to_string(line_) + ");\n";
+    if (level + 1 < sizes.size()) {
+        std::string i = freshName("gate_i");
+        code += "for (gate_int " + i + " = 0; " + i + " < " + array + ".length; ++" + i + ") {\n";
+        code += indented(resizeCode(array + ".items[" + i + "]", element, sizes, level + 1));
+        code += "}\n";
+    }
+    return code;
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<DeallocateStmt> stmt) {
+    temps_ = false;
+    CExpr target = evaluate(stmt->callee);
+    if (stmt->dimension == -1) {
+        if (target.type < 0 || types_[target.type].kind != Kind::POINTER) error("deallocate without a dimension needs a pointer.");
+        std::string code = "free(" + target.code + ");";
+        if (target.lvalue) code += "\n" + target.code + " = NULL;";
+        emitWithTemps(code, temps_);
+        return {};
+    }
+    int levels = 0;
+    for (int t = target.type; t >= 0 && types_[t].kind == Kind::DYNAMIC_ARRAY; t = types_[t].element) ++levels;
+    if (levels == 0) error("deallocate with a dimension needs a dynamic array.");
+    if (levels != stmt->dimension) {
+        error("Deallocation dimension mismatch. Declared: " + std::to_string(levels) + ", Used: " + std::to_string(stmt->dimension));
+    }
+    emitWithTemps(releaseArrayCode(target.code, target.type), temps_);
+    return {};
+}
+
+/**
+ * @brief Code that frees a dynamic array with its inner arrays and strings
+ */
+std::string CCodeGenerator::releaseArrayCode(const std::string& array, int type) {
+    int element = types_[type].element;
+    std::string code;
+    bool nested = types_[element].kind == Kind::DYNAMIC_ARRAY;
+    if (nested || ownsMemory(element)) {
+        std::string i = freshName("gate_i");
+        std::string item = array + ".items[" + i + "]";
+        std::string inner = nested ? releaseArrayCode(item, element) : freeCode(element, item);
+        code += "for (gate_int " + i + " = 0; " + i + " < " + array + ".length; ++" + i + ") {\n" + indented(inner) + "}\n";
+    }
+    return code + "gate_dyn_free(&" + array + ");";
+}
+
+// --- Expressions ---
+
+CCodeGenerator::CExpr CCodeGenerator::evaluate(std::shared_ptr<Expression> expr) {
+    return std::any_cast<CExpr>(expr->accept(*this));
+}
+
+/**
+ * @brief Converts a value to the type it is stored as
+ *
+ * Characters widen to strings, and a string narrows to its first character.
+ * Integer to real needs nothing in C.
+ */
+std::string CCodeGenerator::convert(const CExpr& value, int to) const {
+    if (to == TYPE_STRING && value.type == TYPE_CHARACTER) return "gate_str_char(" + value.code + ")";
+    if (to == TYPE_CHARACTER && value.type == TYPE_STRING) return "gate_str_get(" + value.code + ", 1, " + std::to_string(line_) + ")";
+    return value.code;
+}
+
+std::string CCodeGenerator::equality(const CExpr& left, const CExpr& right) const {
+    if (isStringish(left.type) && isStringish(right.type) && (left.type == TYPE_STRING || right.type == TYPE_STRING)) {
+        return "gate_str_eq(" + convert(left, TYPE_STRING) + ", " + convert(right, TYPE_STRING) + ")";
+    }
+    return "(" + left.code + " == " + right.code + ")";
+}
+
+std::string CCodeGenerator::addressOf(const CExpr& value) const {
+    const std::string& code = value.code;
+    // (*name) is already held through a pointer
+    if (code.size() > 3 && code.compare(0, 2, "(*") == 0 && code.back() == ')' &&
+        code.find_first_of("()[]. *", 2) == code.size() - 1) {
+        return code.substr(2, code.size() - 3);
+    }
+    return "&" + code;
+}
+
+/**
+ * @brief Code of an assignment
+ *
+ * Strings and records holding strings are deep-copied; a record produced by
+ * a call is moved into place. `s <- s & a & b` appends to s in place, which
+ * keeps accumulation loops linear.
+ */
+std::string CCodeGenerator::assign(std::shared_ptr<Expression> target, std::shared_ptr<Expression> value) {
+    target = stripGrouping(target);
+    std::string line = std::to_string(line_);
+
+    if (auto variable = std::dynamic_pointer_cast<Variable>(target)) {
+        Symbol symbol;
+        if (!lookup(variable->name.lexeme, symbol) && constants_.count(lower(variable->name.lexeme))) {
+            error("Cannot assign to constant '" + variable->name.lexeme + "'.");
+        }
+    }
+
+    if (auto access = std::dynamic_pointer_cast<ArrayAccess>(target)) {
+        std::shared_ptr<Expression> owner = access->callee;
+        if (access->indices.size() > 1) {
+            std::vector<std::shared_ptr<Expression>> indices(access->indices.begin(), access->indices.end() - 1);
+            owner = std::make_shared<ArrayAccess>(access->callee, access->bracket, indices);
+        }
+        CExpr container = evaluate(owner);
+        if (container.type == TYPE_STRING) {
+            if (!container.lvalue) error("Invalid assignment target.");
+            CExpr index = evaluate(access->indices.back());
+            CExpr character = evaluate(value);
+            return "*gate_str_at(&" + container.code + ", " + index.code + ", " + line + ") = " + convert(character, TYPE_CHARACTER) + ";";
+        }
+    }
+
+    CExpr place = evaluate(target);
+    if (!place.lvalue || place.type < 0) error("Invalid assignment target.");
+
+    std::string code;
+    if (place.type == TYPE_STRING) {
+        std::vector<std::shared_ptr<Expression>> parts;
+        std::shared_ptr<Expression> head = value;
+        while (auto binary = std::dynamic_pointer_cast<Binary>(head)) {
+            if (binary->op.type != TokenType::PLUS && binary->op.type != TokenType::AMPERSAND) break;
+            parts.push_back(binary->right);
+            head = binary->left;
+        }
+        std::reverse(parts.begin(), parts.end());
+        auto root = rootVariable(target);
+        bool appends = !parts.empty() && root && !std::dynamic_pointer_cast<Call>(stripGrouping(head));
+        if (appends) {
+            // Appending one part at a time is only right if no part reads the target
+            std::string key = lower(root->name.lexeme);
+            for (const auto& part : parts) {
+                walkExpression(part, [&](const std::shared_ptr<Expression>& e) {
+                    auto var = std::dynamic_pointer_cast<Variable>(e);
+                    if (var && lower(var->name.lexeme) == key) appends = false;
+                    if (std::dynamic_pointer_cast<Call>(e)) appends = false;
+                });
+            }
+        }
+        if (appends) {
+            bool savedTemps = temps_;
+            CExpr first = evaluate(head);
+            appends = first.code == place.code;
+            temps_ = savedTemps;
+        }
+        if (appends) {
+            for (const auto& part : parts) {
+                CExpr piece = evaluate(part);
+                if (!isStringish(piece.type)) error("Only strings and characters can be concatenated.");
+                code += "gate_str_append(&" + place.code + ", " + convert(piece, TYPE_STRING) + ");\n";
+            }
+        }
+    }
+    if (code.empty()) code = store(place.type, place.code, evaluate(value));
+
+    if (auto variable = std::dynamic_pointer_cast<Variable>(target)) {
+        Symbol symbol;
+        if (lookup(variable->name.lexeme, symbol) && symbol.constraint) code += "\n" + constraintCheck(symbol);
+    }
+    return code;
+}
+
+std::string CCodeGenerator::store(int type, const std::string& target, const CExpr& value) const {
+    if (type == TYPE_STRING) {
+        if (!isStringish(value.type)) error("Cannot assign a non-string value to a string.");
+        return "gate_str_set(&" + target + ", " + convert(value, TYPE_STRING) + ");";
+    }
+    if (type == TYPE_CHARACTER) return target + " = " + convert(value, TYPE_CHARACTER) + ";";
+    if (isCompound(type) && ownsMemory(type)) {
+        if (value.lvalue) return copyCode(type, target, value.code);
+        return "{\n    " + declaration(type, "gate_value") + " = " + value.code + ";\n    " + freeCode(type, target) + "\n    " +
+               target + " = gate_value;\n}";
+    }
+    return target + " = " + value.code + ";";
+}
+
+/**
+ * @brief Check of a constrained variable after it is assigned
+ *
+ * Emitted in every profile but release, like the assertions of the Pascal
+ * setters.
+ */
+std::string CCodeGenerator::constraintCheck(const Symbol& symbol) {
+    if (options_.profile == BuildProfile::RELEASE) return "";
+    std::string test = evaluate(symbol.constraint->constraint).code;
+    return "if (!" + parenthesized(test) + ") gate_fail(" + std::to_string(line_) + ", " +
+           stringLiteral("Error: " + symbol.name + " constraint violation!") + ");";
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<Assign> expr) {
+    return CExpr{assign(expr->target, expr->value), -1, false};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<FieldAssign> expr) {
+    return CExpr{assign(expr->target, expr->value), -1, false};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<Literal> expr) {
+    Constant value;
+    foldConstant(expr, value);
+    return CExpr{constantCode(value), value.type, false};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<Variable> expr) {
+    Symbol symbol;
+    if (lookup(expr->name.lexeme, symbol)) return CExpr{symbolCode(symbol), symbol.type, true};
+    std::string key = lower(expr->name.lexeme);
+    auto constant = constants_.find(key);
+    if (constant != constants_.end()) return CExpr{constantCode(constant->second), constant->second.type, false};
+    auto sub = subprograms_.find(key);
+    if (sub != subprograms_.end() && sub->second.params.empty()) {
+        // A parameterless subprogram may be called without parentheses
+        return callSubprogram(std::make_shared<Call>(expr, expr->name, std::vector<std::shared_ptr<Expression>>{}));
+    }
+    error("Unknown identifier '" + expr->name.lexeme + "'.");
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<Grouping> expr) {
+    return evaluate(expr->expression);
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<Binary> expr) {
+    Constant folded;
+    if (foldConstant(expr, folded)) return CExpr{constantCode(folded), folded.type, false};
+
+    TokenType op = expr->op.type;
+    CExpr left = evaluate(expr->left);
+    CExpr right = evaluate(expr->right);
+    std::string line = std::to_string(line_);
+
+    if (op == TokenType::AND || op == TokenType::OR) {
+        bool logical = left.type == TYPE_BOOLEAN;
+        std::string symbol = op == TokenType::AND ? (logical ? " && " : " & ") : (logical ? " || " : " | ");
+        return CExpr{"(" + left.code + symbol + right.code + ")", left.type, false};
+    }
+    if ((op == TokenType::PLUS && isStringish(left.type) && isStringish(right.type)) || op == TokenType::AMPERSAND) {
+        if (!isStringish(left.type) || !isStringish(right.type)) error("Only strings and characters can be concatenated.");
+        temps_ = true;
+        return CExpr{"gate_str_cat(" + convert(left, TYPE_STRING) + ", " + convert(right, TYPE_STRING) + ")", TYPE_STRING, false};
+    }
+
+    int numericType = (left.type == TYPE_REAL || right.type == TYPE_REAL) ? TYPE_REAL : TYPE_INTEGER;
+    auto arithmetic = [&](const char* symbol) {
+        if (!isNumeric(left.type) || !isNumeric(right.type)) error(std::string("Operands of '") + expr->op.lexeme + "' must be numbers.");
+        return CExpr{"(" + left.code + " " + symbol + " " + right.code + ")", numericType, false};
+    };
+    auto comparison = [&](const char* symbol) {
+        if (isStringish(left.type) && isStringish(right.type) && (left.type == TYPE_STRING || right.type == TYPE_STRING)) {
+            std::string code = "gate_str_cmp(" + convert(left, TYPE_STRING) + ", " + convert(right, TYPE_STRING) + ")";
+            return CExpr{"(" + code + " " + symbol + " 0)", TYPE_BOOLEAN, false};
+        }
+        return CExpr{"(" + left.code + " " + symbol + " " + right.code + ")", TYPE_BOOLEAN, false};
+    };
+    std::string divisor = checked_ ? "gate_divisor(" + right.code + ", " + line + ")" : right.code;
+    switch (op) {
+        case TokenType::PLUS: return arithmetic("+");
+        case TokenType::MINUS: return arithmetic("-");
+        case TokenType::MULTIPLY: return arithmetic("*");
+        case TokenType::DIVIDE:
+            arithmetic("/");
+            return CExpr{"((double)" + left.code + " / " + right.code + ")", TYPE_REAL, false};
+        case TokenType::DIV: return CExpr{"(" + left.code + " / " + divisor + ")", TYPE_INTEGER, false};
+        case TokenType::MOD: return CExpr{"(" + left.code + " % " + divisor + ")", TYPE_INTEGER, false};
+        case TokenType::POWER: return CExpr{"gate_pow(" + left.code + ", " + right.code + ")", TYPE_INTEGER, false};
+        case TokenType::XOR:
+            return CExpr{"(" + left.code + (left.type == TYPE_BOOLEAN ? " != " : " ^ ") + right.code + ")", left.type, false};
+        case TokenType::EQUAL:
+            if (isStringish(left.type) && isStringish(right.type)) return CExpr{equality(left, right), TYPE_BOOLEAN, false};
+            return comparison("==");
+        case TokenType::NOT_EQUAL:
+            if (isStringish(left.type) && isStringish(right.type) && (left.type == TYPE_STRING || right.type == TYPE_STRING)) {
+                return CExpr{"!" + equality(left, right), TYPE_BOOLEAN, false};
+            }
+            return comparison("!=");
+        case TokenType::LESS: return comparison("<");
+        case TokenType::LESS_EQUAL: return comparison("<=");
+        case TokenType::GREATER: return comparison(">");
+        case TokenType::GREATER_EQUAL: return comparison(">=");
+        default: error("Unsupported operator '" + expr->op.lexeme + "'.");
+    }
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<Unary> expr) {
+    Constant folded;
+    if (foldConstant(expr, folded)) return CExpr{constantCode(folded), folded.type, false};
+
+    CExpr value = evaluate(expr->right);
+    switch (expr->op.type) {
+        case TokenType::MINUS: return CExpr{"(-" + value.code + ")", value.type, false};
+        case TokenType::NOT: return CExpr{(value.type == TYPE_BOOLEAN ? "(!" : "(~") + value.code + ")", value.type, false};
+        case TokenType::AT: {
+            if (!value.lvalue || value.type < 0) error("'@' needs a variable.");
+            CType info{Kind::POINTER, "", {}, {}};
+            info.element = value.type;
+            return CExpr{"(&" + value.code + ")", derivedType(info), false};
+        }
+        case TokenType::POWER: {
+            if (value.type < 0 || types_[value.type].kind != Kind::POINTER) error("'^' needs a pointer.");
+            int target = types_[value.type].element;
+            if (checked_) {
+                return CExpr{"(*(" + declaration(target, "*") + ")gate_deref(" + value.code + ", " + std::to_string(line_) + "))", target, true};
+            }
+            return CExpr{"(*" + value.code + ")", target, true};
+        }
+        default: error("Unsupported operator '" + expr->op.lexeme + "'.");
+    }
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<FieldAccess> expr) {
+    CExpr record = evaluate(expr->object);
+    int index = fieldIndex(record.type, expr->name.lexeme);
+    const CType& info = types_[record.type];
+    return CExpr{record.code + "." + cName(info.names[index]), info.fieldTypes[index], record.lvalue};
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<ArrayAccess> expr) {
+    CExpr value = evaluate(expr->callee);
+    for (const auto& index : expr->indices) {
+        int element = elementType(value.type);
+        if (value.type == TYPE_STRING) {
+            CExpr position = evaluate(index);
+            value = CExpr{"gate_str_get(" + value.code + ", " + position.code + ", " + std::to_string(line_) + ")", element, false};
+        } else {
+            bool lvalue = value.lvalue || types_[value.type].kind == Kind::DYNAMIC_ARRAY;
+            value = CExpr{value.code + ".items[" + indexCode(value, index) + "]", element, lvalue};
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief C index into the items of an array for a NOTAL index
+ *
+ * Static arrays subtract their lower bound, folded when the index is a
+ * constant. Checked builds go through gate_index.
+ */
+std::string CCodeGenerator::indexCode(const CExpr& container, std::shared_ptr<Expression> index) {
+    const CType& info = types_[container.type];
+    bool dynamic = info.kind == Kind::DYNAMIC_ARRAY;
+    long long low = dynamic ? 0 : info.low;
+    Constant constant;
+    if (!checked_ && foldConstant(index, constant) && types_[constant.type].kind != Kind::REAL &&
+        types_[constant.type].kind != Kind::STRING) {
+        return std::to_string(constant.i - low);
+    }
+    std::string code = evaluate(index).code;
+    if (checked_) {
+        std::string high = dynamic ? container.code + ".length - 1" : std::to_string(info.high);
+        return "gate_index(" + code + ", " + std::to_string(low) + ", " + high + ", " + std::to_string(line_) + ")";
+    }
+    if (low == 0) return code;
+    return code + (low > 0 ? " - " + std::to_string(low) : " + " + std::to_string(-low));
+}
+
+std::any CCodeGenerator::visit(std::shared_ptr<Call> expr) {
+    auto callee = std::dynamic_pointer_cast<Variable>(expr->callee);
+    if (!callee) error("Only named subprograms can be called.");
+    std::string name = lower(callee->name.lexeme);
+    if (subprograms_.count(name)) return callSubprogram(expr);
+    return callBuiltin(name, expr);
+}
+
+/**
+ * @brief Code of a call to a user subprogram
+ *
+ * A record or static array that is not a variable is passed through a
+ * one-element compound literal, which gives it an address.
+ */
+CCodeGenerator::CExpr CCodeGenerator::callSubprogram(std::shared_ptr<Call> expr) {
+    auto callee = std::dynamic_pointer_cast<Variable>(expr->callee);
+    const Subprogram& target = subprograms_.at(lower(callee->name.lexeme));
+    if (expr->arguments.size() != target.params.size()) {
+        error("'" + callee->name.lexeme + "' expects " + std::to_string(target.params.size()) + " arguments.");
+    }
+    std::string args;
+    for (size_t i = 0; i < expr->arguments.size(); ++i) {
+        if (i > 0) args += ", ";
+        CExpr arg = evaluate(expr->arguments[i]);
+        int type = target.paramTypes[i];
+        if (target.params[i].mode != ParameterMode::INPUT) {
+            if (!arg.lvalue) error("Argument for an output parameter must be a variable.");
+            args += addressOf(arg);
+        } else if (isCompound(type)) {
+            args += arg.lvalue ? addressOf(arg) : "(" + types_[type].name + "[1]){" + arg.code + "}";
+        } else {
+            args += convert(arg, type);
+        }
+    }
+    if (target.returnType == TYPE_STRING) temps_ = true;
+    return CExpr{target.cname + "(" + args + ")", target.returnType, false};
+}
+
+CCodeGenerator::CExpr CCodeGenerator::callBuiltin(const std::string& name, std::shared_ptr<Call> expr) {
+    std::string displayName = std::dynamic_pointer_cast<Variable>(expr->callee)->name.lexeme;
+    auto casting = std::find_if(CASTING_FUNCTIONS.begin(), CASTING_FUNCTIONS.end(),
+                                [&](const std::string& f) { return lower(f) == name; });
+    size_t arity = casting != CASTING_FUNCTIONS.end() ? 2 : 1;
+    if (expr->arguments.size() != arity) error("'" + displayName + "' expects " + std::to_string(arity) + " arguments.");
+    CExpr arg = evaluate(expr->arguments[0]);
+
+    if (casting != CASTING_FUNCTIONS.end()) {
+        CExpr out = evaluate(expr->arguments[1]);
+        if (!out.lvalue) error("Argument for an output parameter must be a variable.");
+        std::string input = arg.code;
+        if (name.rfind("string", 0) == 0) input = convert(arg, TYPE_STRING);
+        else if (name.rfind("char", 0) == 0) input = convert(arg, TYPE_CHARACTER);
+        usesCasting_ = true;
+        bool predicate = CASTING_PREDICATES.count(*casting) > 0;
+        return CExpr{"gate_" + *casting + "(" + input + ", " + addressOf(out) + ")", predicate ? TYPE_BOOLEAN : -1, false};
+    }
+
+    const std::string& x = arg.code;
+    Kind kind = arg.type >= 0 ? types_[arg.type].kind : Kind::NIL;
+    if (name == "length" || name == "high" || name == "low") {
+        if (kind == Kind::STRING || kind == Kind::CHARACTER) {
+            if (name == "low") return CExpr{"1", TYPE_INTEGER, false};
+            return CExpr{kind == Kind::CHARACTER ? "1" : "((gate_int)" + x + ".len)", TYPE_INTEGER, false};
+        }
+        if (kind == Kind::STATIC_ARRAY) {
+            const CType& info = types_[arg.type];
+            long long value = name == "length" ? info.high - info.low + 1 : name == "high" ? info.high : info.low;
+            return CExpr{integerLiteral(value), TYPE_INTEGER, false};
+        }
+        if (kind == Kind::DYNAMIC_ARRAY) {
+            if (name == "low") return CExpr{"0", TYPE_INTEGER, false};
+            return CExpr{name == "length" ? x + ".length" : "(" + x + ".length - 1)", TYPE_INTEGER, false};
+        }
+        error("length, high and low need a string or an array.");
+    }
+    if (name == "abs") return CExpr{(arg.type == TYPE_REAL ? "fabs(" : "gate_abs_int(") + x + ")", arg.type, false};
+    if (name == "sqr") return CExpr{(arg.type == TYPE_REAL ? "gate_sqr_real(" : "gate_sqr_int(") + x + ")", arg.type, false};
+    if (name == "sqrt" || name == "sin" || name == "cos" || name == "exp") return CExpr{name + "(" + x + ")", TYPE_REAL, false};
+    if (name == "arctan") return CExpr{"atan(" + x + ")", TYPE_REAL, false};
+    if (name == "ln") return CExpr{"log(" + x + ")", TYPE_REAL, false};
+    if (name == "round") return CExpr{"gate_round(" + x + ")", TYPE_INTEGER, false};
+    if (name == "trunc") return CExpr{"((gate_int)trunc(" + x + "))", TYPE_INTEGER, false};
+    if (name == "ord") {
+        return CExpr{(kind == Kind::CHARACTER ? "((gate_int)(unsigned char)" : "((gate_int)") + x + ")", TYPE_INTEGER, false};
+    }
+    if (name == "chr") return CExpr{"((char)" + x + ")", TYPE_CHARACTER, false};
+    if (name == "succ" || name == "pred") {
+        std::string code = "(" + x + (name == "succ" ? " + 1)" : " - 1)");
+        if (kind == Kind::CHARACTER || kind == Kind::ENUM) code = "((" + types_[arg.type].name + ")" + code + ")";
+        if (kind == Kind::BOOLEAN) code = "(" + code + " != 0)";
+        return CExpr{code, arg.type, false};
+    }
+    if (name == "upcase") {
+        if (kind == Kind::STRING) {
+            temps_ = true;
+            return CExpr{"gate_str_upcase(" + x + ")", TYPE_STRING, false};
+        }
+        return CExpr{"gate_char_upcase(" + x + ")", TYPE_CHARACTER, false};
+    }
+    error("Unknown subprogram '" + displayName + "'.");
+}
+
+// --- Variables and types ---
+
+bool CCodeGenerator::lookup(const std::string& name, Symbol& symbol) const {
+    std::string key = lower(name);
+    if (inSubprogram_) {
+        auto local = locals_.find(key);
+        if (local != locals_.end()) {
+            symbol = local->second;
+            return true;
+        }
+    }
+    auto global = globals_.find(key);
+    if (global == globals_.end()) return false;
+    symbol = global->second;
+    return true;
+}
+
+std::string CCodeGenerator::symbolCode(const Symbol& symbol) const {
+    return symbol.reference ? "(*" + symbol.cname + ")" : symbol.cname;
+}
+
+/**
+ * @brief Tells whether a subprogram body writes to one of its parameters
+ *
+ * Assignments, input, output arguments, allocate/deallocate, traversal
+ * iterators and `@` count as writes. With resizeOnly, only allocate and
+ * deallocate do, since the elements of a dynamic array are shared anyway.
+ */
+bool CCodeGenerator::isWritten(const std::string& name, std::shared_ptr<Statement> body, bool resizeOnly) const {
+    std::string key = lower(name);
+    auto rooted = [&](const std::shared_ptr<Expression>& expr) {
+        auto root = rootVariable(expr);
+        return root && lower(root->name.lexeme) == key;
+    };
+    bool written = false;
+    walkStatement(body,
+        [&](const std::shared_ptr<Statement>& stmt) {
+            if (auto allocate = std::dynamic_pointer_cast<AllocateStmt>(stmt)) written = written || rooted(allocate->callee);
+            if (auto deallocate = std::dynamic_pointer_cast<DeallocateStmt>(stmt)) written = written || rooted(deallocate->callee);
+            if (resizeOnly) return !written;
+            if (auto input = std::dynamic_pointer_cast<InputStmt>(stmt)) written = written || rooted(input->variable);
+            if (auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt)) written = written || lower(traversal->iterator.lexeme) == key;
+            return !written;
+        },
+        [&](const std::shared_ptr<Expression>& expr) {
+            if (resizeOnly || written) return;
+            if (auto assign = std::dynamic_pointer_cast<Assign>(expr)) written = rooted(assign->target);
+            else if (auto fieldAssign = std::dynamic_pointer_cast<FieldAssign>(expr)) written = rooted(fieldAssign->target);
+            else if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) written = unary->op.type == TokenType::AT && rooted(unary->right);
+            else if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+                auto callee = std::dynamic_pointer_cast<Variable>(call->callee);
+                if (!callee) return;
+                auto sub = subprograms_.find(lower(callee->name.lexeme));
+                for (size_t i = 0; i < call->arguments.size(); ++i) {
+                    bool output = sub != subprograms_.end() ? i < sub->second.params.size() && sub->second.params[i].mode != ParameterMode::INPUT
+                                                            : i == 1;
+                    if (output && rooted(call->arguments[i])) written = true;
+                }
+            }
+        });
+    return written;
+}
+
+int CCodeGenerator::elementType(int type) const {
+    if (type < 0) error("Indexing a value that is not an array.");
+    const CType& info = types_[type];
+    if (info.kind == Kind::STRING) return TYPE_CHARACTER;
+    if (info.kind != Kind::STATIC_ARRAY && info.kind != Kind::DYNAMIC_ARRAY) error("Indexing a value that is not an array.");
+    return info.element;
+}
+
+int CCodeGenerator::fieldIndex(int recordType, const std::string& name) const {
+    if (recordType < 0 || types_[recordType].kind != Kind::RECORD) error("'." + name + "' used on a value that is not a record.");
+    const auto& names = types_[recordType].names;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (lower(names[i]) == lower(name)) return static_cast<int>(i);
+    }
+    error("Record " + types_[recordType].name + " has no field '" + name + "'.");
+}
+
+bool CCodeGenerator::isStringish(int type) const {
+    return type == TYPE_STRING || type == TYPE_CHARACTER;
+}
+
+bool CCodeGenerator::isNumeric(int type) const {
+    return type == TYPE_INTEGER || type == TYPE_REAL;
+}
+
+} // namespace gate::transpiler
@@ -0,0 +1,896 @@
+/**
+ * @file ConstantEvaluator.cpp
+ * @brief Implementation of transpile-time evaluation of pure NOTAL functions
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "core/ConstantEvaluator.h"
+#include "ast/ASTWalker.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace gate::transpiler {
+
+using namespace gate::ast;
+using core::Token;
+using core::TokenType;
+
+namespace {
+
+/** @brief Bytes accounted to every variable, on top of its string contents */
+constexpr size_t SLOT_BYTES = 32;
+
+/** @brief Raised to abandon an evaluation; the message is the reason */
+class EvaluationFailed : public std::runtime_error {
+public:
+    explicit EvaluationFailed(const std::string& reason) : std::runtime_error(reason) {}
+};
+
+[[noreturn]] void fail(const std::string& reason) {
+    throw EvaluationFailed(reason);
+}
+
+std::string lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+bool isBasicType(TokenType type) {
+    return type == TokenType::INTEGER || type == TokenType::REAL || type == TokenType::BOOLEAN ||
+           type == TokenType::CHARACTER || type == TokenType::STRING;
+}
+
+/** @brief Built-ins whose results are exact, so they fold to what the target computes */
+bool isExactBuiltin(const std::string& name) {
+    static const std::set<std::string> builtins = {"abs", "sqr",   "sqrt",  "ord",    "chr",   "succ",
+                                                   "pred", "round", "trunc", "length", "upcase"};
+    return builtins.count(name) > 0;
+}
+
+std::shared_ptr<Expression> stripGrouping(std::shared_ptr<Expression> expr) {
+    while (auto group = std::dynamic_pointer_cast<Grouping>(expr)) expr = group->expression;
+    return expr;
+}
+
+/** @brief Name of a callee, lower case, or empty if it is not a plain name */
+std::string calleeName(const std::shared_ptr<Call>& call) {
+    auto var = std::dynamic_pointer_cast<Variable>(stripGrouping(call->callee));
+    return var ? lower(var->name.lexeme) : std::string();
+}
+
+} // namespace
+
+ConstantEvaluator::ConstantEvaluator(std::shared_ptr<ProgramStmt> program, ConstantEvaluatorLimits limits)
+    : limits_(limits) {
+    if (!program) return;
+    for (const auto& sub : program->subprograms) {
+        if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) {
+            functions_[lower(func->name.lexeme)] = func;
+        } else if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) {
+            procedures_.insert(lower(proc->name.lexeme));
+        }
+    }
+    if (program->kamus) {
+        for (const auto& decl : program->kamus->declarations) {
+            if (auto constant = std::dynamic_pointer_cast<ConstDeclStmt>(decl)) {
+                constantDecls_[lower(constant->name.lexeme)] = constant;
+            } else if (auto enumType = std::dynamic_pointer_cast<EnumTypeDeclStmt>(decl)) {
+                std::string typeName = lower(enumType->typeName.lexeme);
+                auto& names = enumTypes_[typeName];
+                for (const auto& value : enumType->values) {
+                    Value ordinal;
+                    ordinal.type = TokenType::IDENTIFIER;
+                    ordinal.integer = static_cast<long long>(names.size());
+                    ordinal.text = typeName;
+                    enumConstants_[lower(value.lexeme)] = ordinal;
+                    names.push_back(value.lexeme);
+                }
+            }
+        }
+    }
+}
+
+std::shared_ptr<Literal> ConstantEvaluator::evaluate(std::shared_ptr<Expression> expr,
+                                                     const std::set<std::string>& shadowed, std::string& reason) {
+    steps_ = 0;
+    try {
+        return toLiteral(evaluateConstant(expr, shadowed));
+    } catch (const EvaluationFailed& e) {
+        reason = e.what();
+        frames_.clear();
+        memory_ = 0;
+        return nullptr;
+    }
+}
+
+bool ConstantEvaluator::callsFunction(std::shared_ptr<Expression> expr) const {
+    bool found = false;
+    walkExpression(expr, [&](const std::shared_ptr<Expression>& node) {
+        if (auto call = std::dynamic_pointer_cast<Call>(node)) {
+            if (isFunction(calleeName(call))) found = true;
+        }
+    });
+    return found;
+}
+
+bool ConstantEvaluator::readsOnlyConstants(std::shared_ptr<Expression> expr, const std::set<std::string>& shadowed) const {
+    bool constant = true;
+    std::set<const Expression*> callees;
+    walkExpression(expr, [&](const std::shared_ptr<Expression>& node) {
+        if (auto call = std::dynamic_pointer_cast<Call>(node)) {
+            callees.insert(stripGrouping(call->callee).get());
+        } else if (auto var = std::dynamic_pointer_cast<Variable>(node)) {
+            if (callees.count(var.get())) return;
+            std::string name = lower(var->name.lexeme);
+            if (shadowed.count(var->name.lexeme) || (!constantDecls_.count(name) && !enumConstants_.count(name))) {
+                constant = false;
+            }
+        }
+    });
+    return constant;
+}
+
+bool ConstantEvaluator::isFunction(const std::string& name) const {
+    return functions_.count(lower(name)) > 0;
+}
+
+/**
+ * @brief Evaluates a function once for every ordinal of its parameter
+ *
+ * Each entry runs under its own step budget, as a separate call would;
+ * the first entry that cannot be evaluated fails the whole table.
+ */
+bool ConstantEvaluator::tabulate(const std::string& function, long long low, long long high,
+                                 std::vector<std::shared_ptr<Literal>>& results, std::string& reason) {
+    std::string name = lower(function);
+    results.clear();
+    auto func = functions_.find(name);
+    if (func == functions_.end() || func->second->params.size() != 1) {
+        reason = "'" + name + "' does not take exactly one parameter";
+        return false;
+    }
+    std::string impure = impurityOf(name);
+    if (!impure.empty()) {
+        reason = impure;
+        return false;
+    }
+    const Token& type = func->second->params[0].type;
+    std::string argument;
+    try {
+        for (long long ordinal = low; ordinal <= high; ++ordinal) {
+            steps_ = 0;
+            Value arg;
+            if (type.type == TokenType::CHARACTER) {
+                arg = character(ordinal);
+                argument = "#" + std::to_string(ordinal);
+            } else if (type.type == TokenType::IDENTIFIER) {
+                const auto* names = enumValues(type.lexeme);
+                if (!names || ordinal < 0 || ordinal >= static_cast<long long>(names->size())) {
+                    fail("takes a " + type.lexeme);
+                }
+                arg.type = TokenType::IDENTIFIER;
+                arg.integer = ordinal;
+                arg.text = lower(type.lexeme);
+                argument = (*names)[ordinal];
+            } else {
+                arg = integer(ordinal);
+                argument = std::to_string(ordinal);
+            }
+            // Tables are only read in release, which does not check constraints
+            results.push_back(toLiteral(call(name, {arg}, false)));
+        }
+    } catch (const EvaluationFailed& e) {
+        reason = name + "(" + argument + "): " + e.what();
+        frames_.clear();
+        memory_ = 0;
+        results.clear();
+        return false;
+    }
+    return true;
+}
+
+const std::vector<std::string>* ConstantEvaluator::enumValues(const std::string& name) const {
+    auto found = enumTypes_.find(lower(name));
+    return found == enumTypes_.end() ? nullptr : &found->second;
+}
+
+ConstantEvaluator::Value ConstantEvaluator::evaluateConstant(std::shared_ptr<Expression> expr,
+                                                             const std::set<std::string>& shadowed) {
+    shadowed_.clear();
+    for (const auto& name : shadowed) shadowed_.insert(lower(name));
+    return eval(expr);
+}
+
+/**
+ * @brief Evaluates a global constant on first use
+ *
+ * The initializer runs outside any function and ignores the names shadowed
+ * at the current site, since it is written at program level.
+ */
+ConstantEvaluator::Value ConstantEvaluator::constantValue(const std::string& name) {
+    auto enumValue = enumConstants_.find(name);
+    if (enumValue != enumConstants_.end()) return enumValue->second;
+    auto known = constants_.find(name);
+    if (known != constants_.end()) return known->second;
+    auto decl = constantDecls_.find(name);
+    if (decl == constantDecls_.end()) fail("'" + name + "' is not a constant");
+    if (pendingConstants_.count(name)) fail("constant '" + name + "' depends on itself");
+
+    pendingConstants_.insert(name);
+    std::vector<Frame> frames = std::move(frames_);
+    std::set<std::string> shadowed = std::move(shadowed_);
+    frames_.clear();
+    shadowed_.clear();
+    Value value;
+    try {
+        value = eval(decl->second->initializer);
+        const Token& type = decl->second->type;
+        if (!type.lexeme.empty() && isBasicType(type.type)) {
+            Slot typed{type.type, {}, false};
+            store(typed, value);
+            value = typed.value;
+        }
+    } catch (...) {
+        frames_ = std::move(frames);
+        shadowed_ = std::move(shadowed);
+        pendingConstants_.erase(name);
+        throw;
+    }
+    frames_ = std::move(frames);
+    shadowed_ = std::move(shadowed);
+    pendingConstants_.erase(name);
+    constants_[name] = value;
+    return value;
+}
+
+/**
+ * @brief Returns why a function cannot be evaluated, or an empty string
+ *
+ * A function that is still being checked counts as pure, so recursive
+ * functions are accepted; a callee found impure later is caught when the
+ * call is made.
+ */
+std::string ConstantEvaluator::impurityOf(const std::string& name) {
+    auto known = impurity_.find(name);
+    if (known != impurity_.end()) return known->second;
+    impurity_[name] = "";
+    std::string reason = findImpurity(functions_.at(name));
+    impurity_[name] = reason;
+    return reason;
+}
+
+std::string ConstantEvaluator::findImpurity(std::shared_ptr<FunctionStmt> func) {
+    if (!isSupportedType(func->returnType)) return "returns a " + func->returnType.lexeme;
+
+    std::set<std::string> names;
+    for (const auto& param : func->params) {
+        if (param.mode != ParameterMode::INPUT) return "has an output parameter";
+        if (!isSupportedType(param.type)) return "takes a " + param.type.lexeme;
+        names.insert(lower(param.name.lexeme));
+    }
+
+    std::string reason;
+    std::set<const Expression*> callees;
+    auto checkExpression = [&](const std::shared_ptr<Expression>& expr) {
+        if (!reason.empty()) return;
+        if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+            callees.insert(stripGrouping(call->callee).get());
+            std::string callee = calleeName(call);
+            if (functions_.count(callee)) {
+                if (!impurityOf(callee).empty()) reason = "calls '" + callee + "', which " + impurityOf(callee);
+            } else if (procedures_.count(callee)) {
+                reason = "calls procedure '" + callee + "'";
+            } else if (!isExactBuiltin(callee)) {
+                reason = "calls '" + (callee.empty() ? std::string("an expression") : callee) +
+                         "', which is not evaluated at transpile time";
+            }
+        } else if (auto var = std::dynamic_pointer_cast<Variable>(expr)) {
+            if (callees.count(var.get())) return;
+            std::string name = lower(var->name.lexeme);
+            if (!names.count(name) && !constantDecls_.count(name) && !enumConstants_.count(name)) reason = "uses '" + name + "', which is not a local";
+        } else if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+            if (unary->op.type == TokenType::AT || unary->op.type == TokenType::POWER) reason = "uses pointers";
+        } else if (std::dynamic_pointer_cast<FieldAccess>(expr) || std::dynamic_pointer_cast<FieldAssign>(expr)) {
+            reason = "uses records";
+        } else if (std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+            reason = "uses arrays";
+        }
+    };
+
+    for (const auto& param : func->params) {
+        walkExpression(param.constraint, checkExpression);
+        if (!reason.empty()) return reason;
+    }
+
+    if (func->kamus) {
+        for (const auto& decl : func->kamus->declarations) {
+            if (auto var = std::dynamic_pointer_cast<VarDeclStmt>(decl)) {
+                if (!isSupportedType(var->type)) return "declares a local " + var->type.lexeme;
+                for (const auto& name : var->names) names.insert(lower(name.lexeme));
+            } else if (auto constant = std::dynamic_pointer_cast<ConstDeclStmt>(decl)) {
+                walkExpression(constant->initializer, checkExpression);
+                if (!reason.empty()) return reason;
+                names.insert(lower(constant->name.lexeme));
+            } else {
+                return "declares locals other than basic variables and constants";
+            }
+        }
+    }
+
+    walkStatement(
+        func->body,
+        [&](const std::shared_ptr<Statement>& stmt) {
+            if (!reason.empty()) return false;
+            if (std::dynamic_pointer_cast<InputStmt>(stmt) || std::dynamic_pointer_cast<OutputStmt>(stmt)) {
+                reason = "does input/output";
+            } else if (std::dynamic_pointer_cast<AllocateStmt>(stmt) || std::dynamic_pointer_cast<DeallocateStmt>(stmt)) {
+                reason = "allocates memory";
+            } else if (auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt)) {
+                if (!names.count(lower(traversal->iterator.lexeme))) {
+                    reason = "iterates with '" + traversal->iterator.lexeme + "', which is not a local";
+                }
+            }
+            return reason.empty();
+        },
+        checkExpression);
+    return reason;
+}
+
+bool ConstantEvaluator::isSupportedType(const Token& type) const {
+    if (type.type == TokenType::IDENTIFIER) return enumTypes_.count(lower(type.lexeme)) > 0;
+    return isBasicType(type.type);
+}
+
+/**
+ * @brief Runs a function on argument values
+ *
+ * Parameter constraints are checked on entry, as the generated program
+ * does outside the release profile, so a call that violates one is left
+ * as written. With checkConstraints false the call runs regardless, as in
+ * release, and its result is not cached.
+ */
+ConstantEvaluator::Value ConstantEvaluator::call(const std::string& name, const std::vector<Value>& args,
+                                                 bool checkConstraints) {
+    std::string impure = impurityOf(name);
+    if (!impure.empty()) fail("'" + name + "' " + impure);
+    auto func = functions_.at(name);
+    if (args.size() != func->params.size()) fail("'" + name + "' is called with the wrong number of arguments");
+
+    std::string key = name + "(";
+    for (const auto& arg : args) key += describe(arg) + ",";
+    auto cached = callCache_.find(key);
+    if (cached != callCache_.end()) return cached->second;
+
+    if (frames_.size() >= static_cast<size_t>(limits_.callDepth)) {
+        fail("calls nest deeper than " + std::to_string(limits_.callDepth));
+    }
+
+    Frame frame;
+    frame.function = name;
+    for (size_t i = 0; i < args.size(); ++i) {
+        Slot param{func->params[i].type.type, {}, true};
+        store(param, args[i]);
+        frame.slots[lower(func->params[i].name.lexeme)] = param;
+    }
+    frame.slots[name] = Slot{func->returnType.type, {}, false};
+    std::vector<std::shared_ptr<ConstDeclStmt>> localConstants;
+    if (func->kamus) {
+        for (const auto& decl : func->kamus->declarations) {
+            if (auto var = std::dynamic_pointer_cast<VarDeclStmt>(decl)) {
+                for (const auto& local : var->names) frame.slots[lower(local.lexeme)] = Slot{var->type.type, {}, false};
+            } else if (auto constant = std::dynamic_pointer_cast<ConstDeclStmt>(decl)) {
+                localConstants.push_back(constant);
+            }
+        }
+    }
+    frame.bytes = SLOT_BYTES * (frame.slots.size() + localConstants.size());
+    for (const auto& [slotName, slot] : frame.slots) frame.bytes += slot.value.text.size();
+    memory_ += frame.bytes;
+    if (memory_ > limits_.memory) fail("needs more than " + std::to_string(limits_.memory) + " bytes");
+
+    frames_.push_back(std::move(frame));
+    bool violated = false;
+    for (const auto& param : func->params) {
+        if (!param.constraint || truthy(eval(param.constraint))) continue;
+        if (checkConstraints) fail("violates the constraint on " + param.name.lexeme);
+        violated = true;
+    }
+    for (const auto& constant : localConstants) {
+        Value value = eval(constant->initializer);
+        TokenType type = isBasicType(constant->type.type) ? constant->type.type : value.type;
+        std::string local = lower(constant->name.lexeme);
+        frames_.back().slots[local] = Slot{type, {}, true};
+        assign(local, value);
+    }
+    execute(func->body);
+
+    Slot& result = frames_.back().slots[name];
+    if (!result.assigned) fail("'" + name + "' returns no value");
+    Value value = result.value;
+    memory_ -= frames_.back().bytes;
+    frames_.pop_back();
+    if (!violated) callCache_[key] = value;
+    return value;
+}
+
+/**
+ * @brief Runs a statement of a function body
+ *
+ * Loops behave like the Pascal the generator emits for them: `skip` in a
+ * traversal jumps past the increment, and in `iterate ... stop` past the
+ * exit test.
+ */
+ConstantEvaluator::Flow ConstantEvaluator::execute(std::shared_ptr<Statement> stmt) {
+    if (!stmt) return Flow::NORMAL;
+    step();
+    if (auto block = std::dynamic_pointer_cast<BlockStmt>(stmt)) {
+        for (const auto& inner : block->statements) {
+            Flow flow = execute(inner);
+            if (flow != Flow::NORMAL) return flow;
+        }
+        return Flow::NORMAL;
+    }
+    if (auto algoritma = std::dynamic_pointer_cast<AlgoritmaStmt>(stmt)) return execute(algoritma->body);
+    if (auto exprStmt = std::dynamic_pointer_cast<ExpressionStmt>(stmt)) {
+        if (auto assignment = std::dynamic_pointer_cast<Assign>(exprStmt->expression)) {
+            auto target = std::dynamic_pointer_cast<Variable>(stripGrouping(assignment->target));
+            if (!target) fail("assigns to something other than a variable");
+            assign(lower(target->name.lexeme), eval(assignment->value));
+        } else {
+            eval(exprStmt->expression);
+        }
+        return Flow::NORMAL;
+    }
+    if (auto ifStmt = std::dynamic_pointer_cast<IfStmt>(stmt)) {
+        if (truthy(eval(ifStmt->condition))) return execute(ifStmt->thenBranch);
+        return execute(ifStmt->elseBranch);
+    }
+    if (auto whileStmt = std::dynamic_pointer_cast<WhileStmt>(stmt)) {
+        while (truthy(eval(whileStmt->condition))) {
+            if (execute(whileStmt->body) == Flow::BREAK) break;
+        }
+        return Flow::NORMAL;
+    }
+    if (auto repeat = std::dynamic_pointer_cast<RepeatUntilStmt>(stmt)) {
+        do {
+            if (execute(repeat->body) == Flow::BREAK) break;
+        } while (!truthy(eval(repeat->condition)));
+        return Flow::NORMAL;
+    }
+    if (auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt)) {
+        std::string iterator = lower(traversal->iterator.lexeme);
+        Slot* it = slot(iterator);
+        if (!it || it->type != TokenType::INTEGER) fail("iterates with '" + iterator + "', which is not an integer");
+        assign(iterator, eval(traversal->start));
+        while (compare(slot(iterator)->value, eval(traversal->end)) <= 0) {
+            Flow flow = execute(traversal->body);
+            if (flow == Flow::BREAK) break;
+            if (flow == Flow::CONTINUE) continue;
+            Value stepBy = traversal->step ? eval(traversal->step) : integer(1);
+            assign(iterator, binary(TokenType::PLUS, slot(iterator)->value, stepBy));
+        }
+        return Flow::NORMAL;
+    }
+    if (auto iterate = std::dynamic_pointer_cast<IterateStopStmt>(stmt)) {
+        while (true) {
+            Flow flow = execute(iterate->body);
+            if (flow == Flow::BREAK) break;
+            if (flow == Flow::CONTINUE) continue;
+            if (truthy(eval(iterate->condition))) break;
+        }
+        return Flow::NORMAL;
+    }
+    if (auto repeatN = std::dynamic_pointer_cast<RepeatNTimesStmt>(stmt)) {
+        Value times = eval(repeatN->times);
+        if (times.type != TokenType::INTEGER) fail("repeats a non-integer number of times");
+        for (long long i = 1; i <= times.integer; ++i) {
+            if (execute(repeatN->body) == Flow::BREAK) break;
+        }
+        return Flow::NORMAL;
+    }
+    if (auto depend = std::dynamic_pointer_cast<DependOnStmt>(stmt)) {
+        bool simple = depend->expressions.size() == 1;
+        for (const auto& caseItem : depend->cases) {
+            for (const auto& cond : caseItem.conditions) {
+                if (!std::dynamic_pointer_cast<Literal>(cond) && !std::dynamic_pointer_cast<Variable>(cond)) simple = false;
+            }
+        }
+        if (simple) {
+            // Emitted as a Pascal case statement on the single subject
+            Value subject = eval(depend->expressions[0]);
+            for (const auto& caseItem : depend->cases) {
+                for (const auto& cond : caseItem.conditions) {
+                    if (equal(subject, eval(cond))) return execute(caseItem.body);
+                }
+            }
+        } else {
+            // Emitted as an if-chain on the first condition of every case
+            for (const auto& caseItem : depend->cases) {
+                if (!caseItem.conditions.empty() && truthy(eval(caseItem.conditions[0]))) return execute(caseItem.body);
+            }
+        }
+        return execute(depend->otherwiseBranch);
+    }
+    if (std::dynamic_pointer_cast<StopStmt>(stmt)) return Flow::BREAK;
+    if (std::dynamic_pointer_cast<SkipStmt>(stmt)) return Flow::CONTINUE;
+    if (auto ret = std::dynamic_pointer_cast<ReturnStmt>(stmt)) {
+        // `-> value` compiles to `Name := value`, which does not leave the function
+        if (frames_.empty() || !ret->value) fail("returns outside a function");
+        assign(frames_.back().function, eval(ret->value));
+        return Flow::NORMAL;
+    }
+    fail("runs a statement that is not evaluated at transpile time");
+}
+
+ConstantEvaluator::Value ConstantEvaluator::eval(std::shared_ptr<Expression> expr) {
+    step();
+    if (auto literal = std::dynamic_pointer_cast<Literal>(expr)) {
+        const std::any& value = literal->value;
+        if (value.type() == typeid(int)) return integer(std::any_cast<int>(value));
+        if (value.type() == typeid(double)) return real(std::any_cast<double>(value));
+        if (value.type() == typeid(bool)) {
+            Value result;
+            result.type = TokenType::BOOLEAN;
+            result.integer = std::any_cast<bool>(value) ? 1 : 0;
+            return result;
+        }
+        if (value.type() == typeid(std::string)) return stringValue(std::any_cast<std::string>(value));
+        fail("uses NULL");
+    }
+    if (auto group = std::dynamic_pointer_cast<Grouping>(expr)) return eval(group->expression);
+    if (auto var = std::dynamic_pointer_cast<Variable>(expr)) {
+        std::string name = lower(var->name.lexeme);
+        if (frames_.empty()) {
+            if (shadowed_.count(name)) fail("'" + name + "' is a variable");
+            return constantValue(name);
+        }
+        Slot* local = slot(name);
+        if (!local) return constantValue(name);
+        if (!local->assigned) fail("'" + name + "' is read before it is assigned");
+        return local->value;
+    }
+    if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+        if (unary->op.type == TokenType::AT || unary->op.type == TokenType::POWER) fail("uses pointers");
+        Value right = eval(unary->right);
+        if (unary->op.type == TokenType::MINUS) {
+            if (right.type == TokenType::INTEGER) return integer(-right.integer);
+            if (right.type == TokenType::REAL) return real(-right.real);
+        } else if (unary->op.type == TokenType::PLUS) {
+            if (right.type == TokenType::INTEGER || right.type == TokenType::REAL) return right;
+        } else if (unary->op.type == TokenType::NOT) {
+            if (right.type == TokenType::BOOLEAN) {
+                right.integer = !right.integer;
+                return right;
+            }
+            if (right.type == TokenType::INTEGER) return integer(~right.integer);
+        }
+        fail("applies '" + unary->op.lexeme + "' to an unsupported operand");
+    }
+    if (auto bin = std::dynamic_pointer_cast<Binary>(expr)) {
+        Value left = eval(bin->left);
+        // Boolean and/or short-circuit, as FPC does by default
+        if (left.type == TokenType::BOOLEAN) {
+            if (bin->op.type == TokenType::AND && !left.integer) return left;
+            if (bin->op.type == TokenType::OR && left.integer) return left;
+        }
+        return binary(bin->op.type, left, eval(bin->right));
+    }
+    if (auto callExpr = std::dynamic_pointer_cast<Call>(expr)) {
+        std::string name = calleeName(callExpr);
+        std::vector<Value> args;
+        for (const auto& arg : callExpr->arguments) args.push_back(eval(arg));
+        if (functions_.count(name)) return call(name, args);
+        if (procedures_.count(name)) fail("calls procedure '" + name + "'");
+        if (isExactBuiltin(name)) return builtin(name, args);
+        fail("calls '" + name + "', which is not evaluated at transpile time");
+    }
+    fail("uses an expression that is not evaluated at transpile time");
+}
+
+ConstantEvaluator::Value ConstantEvaluator::binary(TokenType op, const Value& left, const Value& right) {
+    bool numeric = (left.type == TokenType::INTEGER || left.type == TokenType::REAL) &&
+                   (right.type == TokenType::INTEGER || right.type == TokenType::REAL);
+    bool integers = left.type == TokenType::INTEGER && right.type == TokenType::INTEGER;
+    bool texts = (left.type == TokenType::STRING || left.type == TokenType::CHARACTER) &&
+                 (right.type == TokenType::STRING || right.type == TokenType::CHARACTER);
+    auto asReal = [](const Value& v) { return v.type == TokenType::REAL ? v.real : static_cast<double>(v.integer); };
+    auto boolean = [](bool b) {
+        Value result;
+        result.type = TokenType::BOOLEAN;
+        result.integer = b ? 1 : 0;
+        return result;
+    };
+
+    switch (op) {
+        case TokenType::PLUS:
+        case TokenType::AMPERSAND:
+            if (texts) return stringValue(left.text + right.text);
+            if (op == TokenType::PLUS && integers) return integer(left.integer + right.integer);
+            if (op == TokenType::PLUS && numeric) return real(asReal(left) + asReal(right));
+            break;
+        case TokenType::MINUS:
+            if (integers) return integer(left.integer - right.integer);
+            if (numeric) return real(asReal(left) - asReal(right));
+            break;
+        case TokenType::MULTIPLY:
+            if (integers) return integer(left.integer * right.integer);
+            if (numeric) return real(asReal(left) * asReal(right));
+            break;
+        case TokenType::DIVIDE:
+            if (numeric) {
+                if (asReal(right) == 0.0) fail("divides by zero");
+                return real(asReal(left) / asReal(right));
+            }
+            break;
+        case TokenType::DIV:
+        case TokenType::MOD:
+            if (integers) {
+                if (right.integer == 0) fail("divides by zero");
+                return integer(op == TokenType::DIV ? left.integer / right.integer : left.integer % right.integer);
+            }
+            break;
+        case TokenType::POWER:
+            fail("uses '^', which is computed at run time");
+        case TokenType::EQUAL:
+            return boolean(equal(left, right));
+        case TokenType::NOT_EQUAL:
+            return boolean(!equal(left, right));
+        case TokenType::LESS:
+            return boolean(compare(left, right) < 0);
+        case TokenType::LESS_EQUAL:
+            return boolean(compare(left, right) <= 0);
+        case TokenType::GREATER:
+            return boolean(compare(left, right) > 0);
+        case TokenType::GREATER_EQUAL:
+            return boolean(compare(left, right) >= 0);
+        case TokenType::AND:
+        case TokenType::OR:
+        case TokenType::XOR:
+            if (left.type == TokenType::BOOLEAN && right.type == TokenType::BOOLEAN) {
+                if (op == TokenType::AND) return boolean(left.integer && right.integer);
+                if (op == TokenType::OR) return boolean(left.integer || right.integer);
+                return boolean(left.integer != right.integer);
+            }
+            if (integers) {
+                if (op == TokenType::AND) return integer(left.integer & right.integer);
+                if (op == TokenType::OR) return integer(left.integer | right.integer);
+                return integer(left.integer ^ right.integer);
+            }
+            break;
+        default:
+            break;
+    }
+    fail("applies an operator to unsupported operands");
+}
+
+ConstantEvaluator::Value ConstantEvaluator::builtin(const std::string& name, const std::vector<Value>& args) {
+    if (args.size() != 1) fail("calls '" + name + "' with the wrong number of arguments");
+    const Value& arg = args[0];
+    bool isText = arg.type == TokenType::STRING || arg.type == TokenType::CHARACTER;
+    bool isChar = arg.type == TokenType::CHARACTER || (arg.type == TokenType::STRING && arg.text.size() == 1);
+    auto code = [&]() { return static_cast<long long>(static_cast<unsigned char>(arg.text[0])); };
+
+    if (name == "abs") {
+        if (arg.type == TokenType::INTEGER) return integer(arg.integer < 0 ? -arg.integer : arg.integer);
+        if (arg.type == TokenType::REAL) return real(std::fabs(arg.real));
+    } else if (name == "sqr") {
+        if (arg.type == TokenType::INTEGER) return integer(arg.integer * arg.integer);
+        if (arg.type == TokenType::REAL) return real(arg.real * arg.real);
+    } else if (name == "sqrt") {
+        // IEEE square root is correctly rounded, so it matches the target
+        if (arg.type == TokenType::INTEGER) return real(std::sqrt(static_cast<double>(arg.integer)));
+        if (arg.type == TokenType::REAL) return real(std::sqrt(arg.real));
+    } else if (name == "ord") {
+        if (isChar) return integer(code());
+        if (arg.type == TokenType::BOOLEAN || arg.type == TokenType::INTEGER || arg.type == TokenType::IDENTIFIER) {
+            return integer(arg.integer);
+        }
+    } else if (name == "chr") {
+        if (arg.type == TokenType::INTEGER) return character(arg.integer);
+    } else if (name == "succ" || name == "pred") {
+        long long delta = name == "succ" ? 1 : -1;
+        if (arg.type == TokenType::INTEGER) return integer(arg.integer + delta);
+        if (isChar) return character(code() + delta);
+        if (arg.type == TokenType::BOOLEAN && arg.integer + delta >= 0 && arg.integer + delta <= 1) {
+            Value result = arg;
+            result.integer += delta;
+            return result;
+        }
+        if (arg.type == TokenType::IDENTIFIER) {
+            long long size = static_cast<long long>(enumTypes_.at(arg.text).size());
+            if (arg.integer + delta < 0 || arg.integer + delta >= size) fail("'" + name + "' leaves the enum " + arg.text);
+            Value result = arg;
+            result.integer += delta;
+            return result;
+        }
+    } else if (name == "round" || name == "trunc") {
+        if (arg.type == TokenType::INTEGER) return arg;
+        if (arg.type == TokenType::REAL) {
+            // Round half to even, like FPC under the default rounding mode
+            double whole = name == "round" ? std::nearbyint(arg.real) : std::trunc(arg.real);
+            if (std::fabs(whole) > 9.0e15) fail("'" + name + "' overflows the integer type");
+            return integer(static_cast<long long>(whole));
+        }
+    } else if (name == "length") {
+        if (isText) return integer(static_cast<long long>(arg.text.size()));
+    } else if (name == "upcase") {
+        if (isText) {
+            Value result = arg;
+            std::transform(result.text.begin(), result.text.end(), result.text.begin(), [](unsigned char c) {
+                return static_cast<char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+            });
+            if (result.type == TokenType::CHARACTER) result.integer = static_cast<unsigned char>(result.text[0]);
+            return result;
+        }
+    }
+    fail("calls '" + name + "' with an unsupported argument");
+}
+
+/**
+ * @brief Stores into a variable of the running function
+ *
+ * Changes in string length are accounted to the frame and to the memory
+ * budget.
+ */
+void ConstantEvaluator::assign(const std::string& name, const Value& value) {
+    Slot* target = slot(name);
+    if (!target) fail("assigns to '" + name + "', which is not a local");
+    size_t before = target->value.text.size();
+    store(*target, value);
+    size_t after = target->value.text.size();
+    frames_.back().bytes += after - before;
+    memory_ += after - before;
+    if (memory_ > limits_.memory) fail("needs more than " + std::to_string(limits_.memory) + " bytes");
+}
+
+void ConstantEvaluator::store(Slot& target, const Value& value) const {
+    Value stored = value;
+    switch (target.type) {
+        case TokenType::INTEGER:
+            if (value.type != TokenType::INTEGER) fail("stores a non-integer into an integer");
+            break;
+        case TokenType::REAL:
+            if (value.type == TokenType::INTEGER) stored = real(static_cast<double>(value.integer));
+            else if (value.type != TokenType::REAL) fail("stores a non-number into a real");
+            break;
+        case TokenType::BOOLEAN:
+            if (value.type != TokenType::BOOLEAN) fail("stores a non-boolean into a boolean");
+            break;
+        case TokenType::CHARACTER:
+            if (value.type == TokenType::STRING && value.text.size() == 1) stored = character(static_cast<unsigned char>(value.text[0]));
+            else if (value.type != TokenType::CHARACTER) fail("stores a string into a character");
+            break;
+        case TokenType::STRING:
+            if (value.type != TokenType::STRING && value.type != TokenType::CHARACTER) fail("stores a non-string into a string");
+            stored.type = TokenType::STRING;
+            break;
+        case TokenType::IDENTIFIER:
+            if (value.type != TokenType::IDENTIFIER) fail("stores a non-enum value into an enum");
+            break;
+        default:
+            fail("stores into a variable of an unsupported type");
+    }
+    target.value = stored;
+    target.assigned = true;
+}
+
+ConstantEvaluator::Slot* ConstantEvaluator::slot(const std::string& name) {
+    if (frames_.empty()) return nullptr;
+    auto found = frames_.back().slots.find(name);
+    return found == frames_.back().slots.end() ? nullptr : &found->second;
+}
+
+bool ConstantEvaluator::truthy(const Value& value) const {
+    if (value.type != TokenType::BOOLEAN) fail("tests a condition that is not a boolean");
+    return value.integer != 0;
+}
+
+bool ConstantEvaluator::equal(const Value& left, const Value& right) const {
+    if (left.type == TokenType::BOOLEAN && right.type == TokenType::BOOLEAN) return left.integer == right.integer;
+    return compare(left, right) == 0;
+}
+
+/**
+ * @brief Orders two values the way the target compares them
+ * @return Negative, zero or positive as left is less, equal or greater
+ */
+int ConstantEvaluator::compare(const Value& left, const Value& right) const {
+    auto isNumber = [](const Value& v) { return v.type == TokenType::INTEGER || v.type == TokenType::REAL; };
+    auto isText = [](const Value& v) { return v.type == TokenType::STRING || v.type == TokenType::CHARACTER; };
+    if (left.type == TokenType::INTEGER && right.type == TokenType::INTEGER) {
+        return left.integer < right.integer ? -1 : left.integer > right.integer ? 1 : 0;
+    }
+    if (isNumber(left) && isNumber(right)) {
+        double l = left.type == TokenType::REAL ? left.real : static_cast<double>(left.integer);
+        double r = right.type == TokenType::REAL ? right.real : static_cast<double>(right.integer);
+        return l < r ? -1 : l > r ? 1 : 0;
+    }
+    if (isText(left) && isText(right)) {
+        int order = left.text.compare(right.text);
+        return order < 0 ? -1 : order > 0 ? 1 : 0;
+    }
+    if (left.type == TokenType::BOOLEAN && right.type == TokenType::BOOLEAN) {
+        return static_cast<int>(left.integer - right.integer);
+    }
+    if (left.type == TokenType::IDENTIFIER && right.type == TokenType::IDENTIFIER && left.text == right.text) {
+        return left.integer < right.integer ? -1 : left.integer > right.integer ? 1 : 0;
+    }
+    fail("compares values of different types");
+}
+
+/** @brief Makes an integer, failing when the target's integer type cannot hold it */
+ConstantEvaluator::Value ConstantEvaluator::integer(long long value) const {
+    long long limit = 1LL << (limits_.integerBits - 1);
+    if (value < -limit || value >= limit) {
+        fail("overflows the " + std::to_string(limits_.integerBits) + "-bit integer type");
+    }
+    Value result;
+    result.type = TokenType::INTEGER;
+    result.integer = value;
+    return result;
+}
+
+ConstantEvaluator::Value ConstantEvaluator::real(double value) const {
+    if (!std::isfinite(value)) fail("produces a real that is not finite");
+    Value result;
+    result.type = TokenType::REAL;
+    result.real = value;
+    return result;
+}
+
+ConstantEvaluator::Value ConstantEvaluator::character(long long code) const {
+    if (code < 0 || code > 255) fail("produces a character code out of range");
+    Value result;
+    result.type = TokenType::CHARACTER;
+    result.integer = code;
+    result.text = std::string(1, static_cast<char>(code));
+    return result;
+}
+
+/** @brief Makes a string, failing when the target's string type cannot hold it */
+ConstantEvaluator::Value ConstantEvaluator::stringValue(std::string text) const {
+    if (text.size() > limits_.stringLength) {
+        fail("builds a string longer than " + std::to_string(limits_.stringLength) + " characters");
+    }
+    Value result;
+    result.type = TokenType::STRING;
+    result.text = std::move(text);
+    return result;
+}
+
+void ConstantEvaluator::step() {
+    if (++steps_ > limits_.steps) fail("needs more than " + std::to_string(limits_.steps) + " steps");
+    if (++totalSteps_ > limits_.totalSteps) fail("the transpile-time evaluation budget is used up");
+}
+
+std::string ConstantEvaluator::describe(const Value& value) const {
+    switch (value.type) {
+        case TokenType::INTEGER: return "i" + std::to_string(value.integer);
+        case TokenType::BOOLEAN: return value.integer ? "true" : "false";
+        case TokenType::REAL: {
+            char buffer[32];
+            std::snprintf(buffer, sizeof buffer, "r%.17g", value.real);
+            return buffer;
+        }
+        case TokenType::IDENTIFIER: return "e" + value.text + ":" + std::to_string(value.integer);
+        default: return "s" + std::to_string(value.text.size()) + ":" + value.text;
+    }
+}
+
+std::shared_ptr<Literal> ConstantEvaluator::toLiteral(const Value& value) const {
+    switch (value.type) {
+        case TokenType::INTEGER: return std::make_shared<Literal>(static_cast<int>(value.integer));
+        case TokenType::REAL: return std::make_shared<Literal>(value.real);
+        case TokenType::BOOLEAN: return std::make_shared<Literal>(value.integer != 0);
+        case TokenType::IDENTIFIER: fail("produces a value of the enum " + value.text);
+        default: return std::make_shared<Literal>(value.text);
+    }
+}
+
+} // namespace gate::transpiler
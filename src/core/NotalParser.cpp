@@ -243,11 +243,18 @@ std::shared_ptr<Statement> NotalParser::typeDeclaration() {
                 
                 if (fieldType.type != TokenType::INTEGER && fieldType.type != TokenType::REAL &&
                     fieldType.type != TokenType::STRING && fieldType.type != TokenType::BOOLEAN &&
-                    fieldType.type != TokenType::CHARACTER && fieldType.type != TokenType::IDENTIFIER) {
+                    fieldType.type != TokenType::CHARACTER && fieldType.type != TokenType::IDENTIFIER &&
+                    fieldType.type != TokenType::POINTER) {
                     throw error(fieldType, "Expect a basic type name or custom type.");
                 }
                 
-                fields.emplace_back(fieldName, fieldType);
+                if (fieldType.type == TokenType::POINTER) {
+                    consume(TokenType::TO, "Expect 'to' after 'pointer'.");
+                    Token pointedType = advance();
+                    fields.emplace_back(fieldName, fieldType, pointedType);
+                } else {
+                    fields.emplace_back(fieldName, fieldType);
+                }
             } while (match({TokenType::COMMA}));
         }
         
@@ -355,7 +362,10 @@ std::vector<std::shared_ptr<Statement>> NotalParser::parseBlockByIndentation(int
         if (peek().column < expectedIndentLevel) {
             break;
         }
-        statements.push_back(statement());
+        int line = peek().line;
+        std::shared_ptr<Statement> stmt = statement();
+        if (stmt) stmt->line = line;
+        statements.push_back(stmt);
     }
     return statements;
 }
@@ -540,6 +550,7 @@ std::shared_ptr<Statement> NotalParser::repeatUntilStatement() {
 std::shared_ptr<Statement> NotalParser::traversalStatement() {
     Token iterator = consume(TokenType::IDENTIFIER, "Expect iterator name.");
     consume(TokenType::TRAVERSAL, "Expect 'traversal'.");
+    bool parallel = match({TokenType::PARALEL});
     consume(TokenType::LBRACKET, "Expect '[' after 'traversal'.");
     
     std::shared_ptr<Expression> start = expression();
@@ -564,7 +575,9 @@ std::shared_ptr<Statement> NotalParser::traversalStatement() {
 
     auto body = std::make_shared<BlockStmt>(parseBlockByIndentation(bodyIndent));
     
-    return std::make_shared<TraversalStmt>(iterator, start, end, step, body);
+    auto traversal = std::make_shared<TraversalStmt>(iterator, start, end, step, body);
+    traversal->parallel = parallel;
+    return traversal;
 }
 
 std::shared_ptr<Statement> NotalParser::iterateStopStatement() {
@@ -784,7 +797,13 @@ std::vector<Parameter> NotalParser::parameterList() {
                 type.type != TokenType::CHARACTER && type.type != TokenType::IDENTIFIER) {
                     throw error(type, "Expect a valid type name for parameter.");
             }
-            params.emplace_back(mode, name, type);
+            std::shared_ptr<Expression> constraint = nullptr;
+            if (check(TokenType::PIPE)) {
+                if (mode != ParameterMode::INPUT) throw error(peek(), "Only input parameters can have a constraint.");
+                advance();
+                constraint = expression();
+            }
+            params.emplace_back(mode, name, type, constraint);
         } while (match({TokenType::COMMA}));
     }
     consume(TokenType::RPAREN, "Expect ')' after parameter list.");
@@ -825,6 +844,8 @@ void NotalParser::subprogramImplementation(const Token& subprogramKeyword, const
         consume(TokenType::IDENTIFIER, "Expect parameter name.");
         consume(TokenType::COLON, "Expect ':' after parameter name.");
         advance(); 
+        // The declaration's constraint applies; a repeated one is skipped
+        if (match({TokenType::PIPE})) expression();
         if (i < declaredParams.size() - 1) {
             consume(TokenType::COMMA, "Expect ',' between parameters.");
         }
@@ -946,7 +967,7 @@ std::shared_ptr<Expression> NotalParser::comparison() {
 
 std::shared_ptr<Expression> NotalParser::term() {
     std::shared_ptr<Expression> expr = factor();
-    while (match({TokenType::MINUS, TokenType::PLUS})) {
+    while (match({TokenType::MINUS, TokenType::PLUS, TokenType::AMPERSAND})) {
         Token op = previous();
         std::shared_ptr<Expression> right = factor();
         expr = std::make_shared<Binary>(expr, op, right);
@@ -21,6 +21,7 @@
  */
 
 #include "core/PascalCodeGenerator.h"
+#include "ast/ASTWalker.h"
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
@@ -30,6 +31,10 @@
 #include <fstream>
 #include <vector>
 #include <typeinfo>
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <tuple>
 
 namespace gate::transpiler {
 
@@ -38,6 +43,12 @@ using gate::core::Token;
 using gate::core::TokenType;
 using namespace gate::ast;
 
+/** @brief Largest repeat body, in AST nodes, that is copied when unrolling */
+static constexpr int UNROLL_BODY_LIMIT = 24;
+
+/** @brief Most entries a table made by --tabulate may have */
+static constexpr long long TABULATE_MAX_ENTRIES = 256;
+
 /**
  * @brief Set of built-in casting functions that require special handling
  * 
@@ -53,6 +64,87 @@ const std::set<std::string> BUILTIN_CASTING_FUNCTIONS = {
     "StringHexToInteger", "StringToBoolean", "StringToChar", "StringToInteger", "StringToReal"
 };
 
+/**
+ * @brief Returns the body of a loop statement, or null for other statements
+ */
+static std::shared_ptr<Statement> loopBody(const std::shared_ptr<Statement>& stmt) {
+    if (auto whileStmt = std::dynamic_pointer_cast<WhileStmt>(stmt)) return whileStmt->body;
+    if (auto repeatUntil = std::dynamic_pointer_cast<RepeatUntilStmt>(stmt)) return repeatUntil->body;
+    if (auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt)) return traversal->body;
+    if (auto iterate = std::dynamic_pointer_cast<IterateStopStmt>(stmt)) return iterate->body;
+    if (auto repeatN = std::dynamic_pointer_cast<RepeatNTimesStmt>(stmt)) return repeatN->body;
+    return nullptr;
+}
+
+/**
+ * @brief Checks whether a new array size looks like growth by a small step
+ *
+ * Matches `n + c` (or `c + n`) with a literal step of at most 64, and a bare
+ * variable such as a loop counter.
+ */
+static bool isSmallIncrement(const std::shared_ptr<Expression>& size) {
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(size)) return isSmallIncrement(grouping->expression);
+    if (std::dynamic_pointer_cast<Variable>(size)) return true;
+    auto binary = std::dynamic_pointer_cast<Binary>(size);
+    if (!binary || binary->op.type != TokenType::PLUS) return false;
+    for (const auto& side : {binary->left, binary->right}) {
+        auto literal = std::dynamic_pointer_cast<Literal>(side);
+        if (literal && literal->value.type() == typeid(int)) {
+            int step = std::any_cast<int>(literal->value);
+            if (step >= 1 && step <= 64) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks whether an expression can be evaluated twice without effect
+ *
+ * True when the expression calls nothing and assigns nothing, so pasting
+ * its text a second time does not run user code again.
+ */
+static bool isRepeatable(const std::shared_ptr<Expression>& expr) {
+    bool repeatable = true;
+    walkExpression(expr, [&](const std::shared_ptr<Expression>& part) {
+        if (std::dynamic_pointer_cast<Call>(part) || std::dynamic_pointer_cast<Assign>(part) ||
+            std::dynamic_pointer_cast<FieldAssign>(part)) {
+            repeatable = false;
+        }
+    });
+    return repeatable;
+}
+
+/**
+ * @brief Collects the operands of a `&` chain from left to right
+ *
+ * Parenthesized sub-chains are flattened too, since concatenation is
+ * associative.
+ */
+static void collectConcatOperands(const std::shared_ptr<Expression>& expr, std::vector<std::shared_ptr<Expression>>& operands) {
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) {
+        auto inner = std::dynamic_pointer_cast<Binary>(grouping->expression);
+        if (inner && inner->op.type == TokenType::AMPERSAND) {
+            collectConcatOperands(inner, operands);
+            return;
+        }
+    }
+    auto binary = std::dynamic_pointer_cast<Binary>(expr);
+    if (binary && binary->op.type == TokenType::AMPERSAND) {
+        collectConcatOperands(binary->left, operands);
+        collectConcatOperands(binary->right, operands);
+        return;
+    }
+    operands.push_back(expr);
+}
+
+/**
+ * @brief Constructs a code generator with the given options
+ *
+ * @param options Code generation options; the defaults produce plain Pascal
+ *                without compiler directives or runtime support sections
+ */
+PascalCodeGenerator::PascalCodeGenerator(CodeGenOptions options) : options_(std::move(options)) {}
+
 /**
  * @brief Generates Pascal code from a NOTAL program AST
  * 
@@ -68,6 +160,20 @@ const std::set<std::string> BUILTIN_CASTING_FUNCTIONS = {
  */
 std::string PascalCodeGenerator::generate(std::shared_ptr<ProgramStmt> program) {
     if (!program) return "";
+    collectDeclarations(program);
+    ConstantEvaluatorLimits limits;
+    limits.integerBits = PASCAL_INTEGER_BITS;
+    evaluator_ = std::make_unique<ConstantEvaluator>(program, limits);
+    selectArrayLowerings(program);
+    selectInlineSubprograms(program);
+    selectMemoFunctions(program);
+    selectTabulatedFunctions(program);
+    selectParallelTraversals(program);
+    selectPooledTypes(program);
+    if (options_.profile == BuildProfile::DEBUG || options_.profile == BuildProfile::CHECKED) {
+        selectRangeCheckElisions(program);
+    }
+    if (options_.instrument == Instrumentation::PROFILE) numberStatements(program);
     preScan(program->algoritma);
     execute(program);
     return out_.str();
@@ -95,7 +201,12 @@ void PascalCodeGenerator::preScan(std::shared_ptr<Statement> stmt) {
             preScan(s);
         }
     } else if (auto repeat = std::dynamic_pointer_cast<RepeatNTimesStmt>(stmt)) {
-        loopVariables_.push_back("_loop_iterator_" + std::to_string(loopVariables_.size()));
+        // A fully unrolled loop has no iterator to declare
+        int times = unrollableCount(repeat);
+        if (times < 0 || times > options_.unrollFactor) {
+            loopVariables_.push_back("_loop_iterator_" + std::to_string(loopVariables_.size()));
+        }
+        preScan(repeat->body);
     } else if (auto ifStmt = std::dynamic_pointer_cast<IfStmt>(stmt)) {
         preScan(ifStmt->thenBranch);
         preScan(ifStmt->elseBranch);
@@ -113,6 +224,1039 @@ void PascalCodeGenerator::preScan(std::shared_ptr<Statement> stmt) {
     }
 }
 
+/**
+ * @brief Collects program-wide declarations needed before code generation
+ *
+ * Records every record type and subprogram signature found in the global
+ * KAMUS so that parameter passing can be decided from declared types, and
+ * so that call sites can be matched against the callee's parameter modes.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::collectDeclarations(std::shared_ptr<ProgramStmt> program) {
+    mainAlgoritma_ = program->algoritma;
+    if (!program->kamus) return;
+    collectVariableTypes(program->kamus, globalVarTypes_, globalPointerTargets_);
+    for (const auto& decl : program->kamus->declarations) {
+        if (auto record = std::dynamic_pointer_cast<RecordTypeDeclStmt>(decl)) {
+            recordTypes_[record->typeName.lexeme] = record;
+        } else if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(decl)) {
+            subprogramParams_[proc->name.lexeme] = proc->params;
+        } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(decl)) {
+            subprogramParams_[func->name.lexeme] = func->params;
+        }
+    }
+}
+
+/**
+ * @brief Chooses the functions that are emitted behind a memo table
+ *
+ * Only active with --memo. A function qualifies when it calls itself, takes
+ * one or two input parameters of an ordinal type (integer, character,
+ * boolean), returns integer, real, boolean or character, and is pure: it
+ * reads and writes no global variable, does no input/output, allocation or
+ * pointer access, and calls no other user subprogram. Its result then
+ * depends on its arguments alone, so repeated calls can reuse it.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::selectMemoFunctions(std::shared_ptr<ProgramStmt> program) {
+    if (!options_.memo) return;
+    auto isOrdinal = [](TokenType type) {
+        return type == TokenType::INTEGER || type == TokenType::CHARACTER || type == TokenType::BOOLEAN;
+    };
+
+    std::set<std::string> globals = globalVariableNames(program->kamus);
+    for (const auto& sub : program->subprograms) {
+        auto func = std::dynamic_pointer_cast<FunctionStmt>(sub);
+        if (!func || func->params.empty() || func->params.size() > 2) continue;
+        if (!isOrdinal(func->returnType.type) && func->returnType.type != TokenType::REAL) continue;
+        bool eligible = true;
+        for (const auto& p : func->params) {
+            if (p.mode != ParameterMode::INPUT || !isOrdinal(p.type.type)) eligible = false;
+        }
+        if (!eligible) continue;
+
+        bool recursive = false;
+        if (isPureFunction(func, globals, recursive) && recursive) memoFunctions_.insert(func->name.lexeme);
+    }
+}
+
+/**
+ * @brief Collects the names of a program's global variables
+ *
+ * @param kamus Global KAMUS block (may be null)
+ * @return std::set<std::string> Variable and array names; constants are left out
+ */
+std::set<std::string> PascalCodeGenerator::globalVariableNames(std::shared_ptr<KamusStmt> kamus) const {
+    std::set<std::string> globals = declaredNames({}, kamus);
+    if (!kamus) return globals;
+    for (const auto& decl : kamus->declarations) {
+        if (auto constDecl = std::dynamic_pointer_cast<ConstDeclStmt>(decl)) globals.erase(constDecl->name.lexeme);
+    }
+    return globals;
+}
+
+/**
+ * @brief Checks whether a function's result depends on its arguments alone
+ *
+ * A pure function reads and writes no global variable, does no
+ * input/output, allocation or pointer access, and calls no user subprogram
+ * other than itself.
+ *
+ * @param func Function to check
+ * @param globals Names of the program's global variables
+ * @param recursive Set to true when the function calls itself
+ * @return bool True if the function is pure
+ */
+bool PascalCodeGenerator::isPureFunction(std::shared_ptr<FunctionStmt> func, const std::set<std::string>& globals,
+                                         bool& recursive) const {
+    std::set<std::string> locals = declaredNames(func->params, func->kamus);
+    bool pure = true;
+    recursive = false;
+    walkStatement(func->body,
+        [&](const std::shared_ptr<Statement>& stmt) {
+            if (std::dynamic_pointer_cast<InputStmt>(stmt) || std::dynamic_pointer_cast<OutputStmt>(stmt) ||
+                std::dynamic_pointer_cast<AllocateStmt>(stmt) || std::dynamic_pointer_cast<DeallocateStmt>(stmt)) {
+                pure = false;
+            }
+            return pure;
+        },
+        [&](const std::shared_ptr<Expression>& expr) {
+            if (auto var = std::dynamic_pointer_cast<Variable>(expr)) {
+                if (globals.count(var->name.lexeme) && !locals.count(var->name.lexeme)) pure = false;
+            } else if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+                if (unary->op.type == TokenType::AT || unary->op.type == TokenType::POWER) pure = false;
+            } else if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+                auto callee = std::dynamic_pointer_cast<Variable>(call->callee);
+                if (!callee || !subprogramParams_.count(callee->name.lexeme)) return;
+                if (callee->name.lexeme == func->name.lexeme) recursive = true;
+                else pure = false;
+            }
+        });
+    return pure;
+}
+
+/**
+ * @brief Chooses the `traversal paralel` loops that run on worker threads
+ *
+ * Only loops of the main algorithm qualify, since a worker thread cannot
+ * see a subprogram's locals; a paralel loop nested in another one runs
+ * sequentially inside its worker. Every other loop is checked by
+ * parallelBlocker, and the reason a loop stays sequential is kept so that
+ * it can be written next to the loop.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::selectParallelTraversals(std::shared_ptr<ProgramStmt> program) {
+    auto markSequential = [this](const std::shared_ptr<Statement>& body, const std::string& reason) {
+        walkStatement(body, [&](const std::shared_ptr<Statement>& stmt) {
+            auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt);
+            if (traversal && traversal->parallel) sequentialTraversals_[traversal.get()] = reason;
+            return true;
+        }, nullptr);
+    };
+    for (const auto& sub : program->subprograms) {
+        markSequential(sub, "only loops of the main algorithm run in parallel");
+    }
+
+    std::set<std::string> globals = globalVariableNames(program->kamus);
+    std::set<std::string> pureFunctions;
+    for (const auto& sub : program->subprograms) {
+        auto func = std::dynamic_pointer_cast<FunctionStmt>(sub);
+        // A memo table is shared state, so memoized functions are not safe to call from workers
+        if (!func || memoFunctions_.count(func->name.lexeme)) continue;
+        bool inputsOnly = std::all_of(func->params.begin(), func->params.end(),
+                                      [](const Parameter& p) { return p.mode == ParameterMode::INPUT; });
+        bool recursive = false;
+        if (inputsOnly && isPureFunction(func, globals, recursive)) pureFunctions.insert(func->name.lexeme);
+    }
+
+    // Nested iterators stay in the workers, so the loop is only parallel if
+    // nothing outside it reads their final value. Reads in the body of
+    // another traversal over the same name see that loop's value instead.
+    ScopedBodies bodies = {{program->algoritma, {}}};
+    for (const auto& sub : program->subprograms) {
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) {
+            bodies.push_back({sub, declaredNames(proc->params, proc->kamus)});
+        } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) {
+            bodies.push_back({sub, declaredNames(func->params, func->kamus)});
+        }
+    }
+    auto readOutside = [&](const std::string& name, const Statement* loop) {
+        bool read = false;
+        auto onExpression = [&](const std::shared_ptr<Expression>& expr) {
+            auto var = std::dynamic_pointer_cast<Variable>(expr);
+            if (var && var->name.lexeme == name) read = true;
+        };
+        for (const auto& [body, shadowed] : bodies) {
+            if (shadowed.count(name)) continue;
+            walkStatement(body, [&](const std::shared_ptr<Statement>& stmt) {
+                if (stmt.get() == loop) return false;
+                auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt);
+                if (!traversal || traversal->iterator.lexeme != name) return true;
+                for (const auto& bound : {traversal->start, traversal->end, traversal->step}) walkExpression(bound, onExpression);
+                return false;
+            }, onExpression);
+        }
+        return read;
+    };
+
+    walkStatement(program->algoritma, [&](const std::shared_ptr<Statement>& stmt) {
+        auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt);
+        if (!traversal || !traversal->parallel) return true;
+        ParallelTraversal plan;
+        std::string reason = parallelBlocker(traversal, pureFunctions, plan);
+        for (const auto& name : plan.privates) {
+            if (!reason.empty()) break;
+            if (name != traversal->iterator.lexeme && readOutside(name, traversal.get())) {
+                reason = name + " is read outside the loop";
+            }
+        }
+        if (!reason.empty()) {
+            sequentialTraversals_[traversal.get()] = reason;
+            return true;
+        }
+        plan.id = (int)parallelTraversals_.size();
+        plan.traversal = traversal;
+        parallelTraversals_.push_back(plan);
+        markSequential(traversal->body, "nested in a parallel loop");
+        return false;
+    }, nullptr);
+}
+
+/**
+ * @brief Finds what keeps a `traversal paralel` loop from running in parallel
+ *
+ * Iterations may run in any order and at the same time, so the body must
+ * not depend on another iteration:
+ * - no input/output, allocation, pointer access, `stop`, or call to a user
+ *   subprogram other than a pure function (see isPureFunction);
+ * - every array it writes is only indexed by the loop iterator in its first
+ *   dimension, so each iteration touches its own elements;
+ * - the only shared scalars it writes are `+` reductions, `s <- s + e`
+ *   with s used nowhere else in the body. The output argument of a
+ *   casting routine such as IntegerToString counts as a write. Each
+ *   worker sums into a private copy of s and the copies are added to s
+ *   after the join;
+ * - iterators of nested traversals become private to the worker; the
+ *   caller keeps the loop sequential when one is read outside it.
+ * The step must be a positive literal, and the range may not depend on
+ * what the body writes, since it is evaluated once up front.
+ *
+ * @param traversal Loop to check
+ * @param pureFunctions Functions that may be called from a worker
+ * @param plan Receives the reductions and private variables of the loop
+ * @return std::string Empty if the loop can run in parallel, else the reason it cannot
+ */
+std::string PascalCodeGenerator::parallelBlocker(std::shared_ptr<TraversalStmt> traversal,
+                                                 const std::set<std::string>& pureFunctions, ParallelTraversal& plan) {
+    const std::string& iterator = traversal->iterator.lexeme;
+    if (options_.instrument == Instrumentation::PROFILE) return "profile counters are not thread-safe";
+    if (traversal->step) {
+        auto literal = std::dynamic_pointer_cast<Literal>(traversal->step);
+        if (!literal || literal->value.type() != typeid(int) || std::any_cast<int>(literal->value) < 1) {
+            return "the step is not a positive integer literal";
+        }
+    }
+    const Token* iteratorType = lookupVariableType(iterator);
+    if (!iteratorType || iteratorType->type != TokenType::INTEGER) return "the iterator is not an integer variable";
+
+    // `stop` would end only the worker's own chunk
+    std::string blocker;
+    walkStatement(traversal->body, [&](const std::shared_ptr<Statement>& stmt) {
+        if (std::dynamic_pointer_cast<StopStmt>(stmt)) blocker = "the body uses stop";
+        return !loopBody(stmt) && blocker.empty();
+    }, nullptr);
+    if (!blocker.empty()) return blocker;
+
+    std::map<std::string, int> uses;
+    std::map<std::string, std::vector<std::shared_ptr<Assign>>> scalarWrites;
+    std::set<std::string> writtenArrays;
+    std::vector<std::shared_ptr<ArrayAccess>> accesses;
+    plan.privates.insert(iterator);
+
+    auto recordWrite = [&](std::shared_ptr<Expression> target, std::shared_ptr<Assign> assign) {
+        while (auto field = std::dynamic_pointer_cast<FieldAccess>(target)) {
+            target = field->object;
+            assign = nullptr;
+        }
+        auto access = std::dynamic_pointer_cast<ArrayAccess>(target);
+        auto array = access ? std::dynamic_pointer_cast<Variable>(access->callee) : nullptr;
+        if (auto var = std::dynamic_pointer_cast<Variable>(target)) scalarWrites[var->name.lexeme].push_back(assign);
+        else if (array) writtenArrays.insert(array->name.lexeme);
+        else blocker = "the body writes through a pointer";
+    };
+
+    walkStatement(traversal->body,
+        [&](const std::shared_ptr<Statement>& stmt) {
+            if (std::dynamic_pointer_cast<InputStmt>(stmt) || std::dynamic_pointer_cast<OutputStmt>(stmt)) {
+                blocker = "the body does input or output";
+            } else if (std::dynamic_pointer_cast<AllocateStmt>(stmt) || std::dynamic_pointer_cast<DeallocateStmt>(stmt)) {
+                blocker = "the body allocates or frees memory";
+            } else if (auto inner = std::dynamic_pointer_cast<TraversalStmt>(stmt)) {
+                plan.privates.insert(inner->iterator.lexeme);
+            }
+            return blocker.empty();
+        },
+        [&](const std::shared_ptr<Expression>& expr) {
+            if (auto var = std::dynamic_pointer_cast<Variable>(expr)) {
+                uses[var->name.lexeme]++;
+            } else if (auto access = std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+                accesses.push_back(access);
+            } else if (auto assign = std::dynamic_pointer_cast<Assign>(expr)) {
+                recordWrite(assign->target, assign);
+            } else if (auto fieldAssign = std::dynamic_pointer_cast<FieldAssign>(expr)) {
+                recordWrite(fieldAssign->target, nullptr);
+            } else if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+                if (unary->op.type == TokenType::AT || unary->op.type == TokenType::POWER) {
+                    blocker = "the body takes addresses or dereferences pointers";
+                }
+            } else if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+                auto callee = std::dynamic_pointer_cast<Variable>(call->callee);
+                if (callee && subprogramParams_.count(callee->name.lexeme) && !pureFunctions.count(callee->name.lexeme)) {
+                    blocker = "the body calls " + callee->name.lexeme + ", which is not a pure function";
+                } else if (callee && BUILTIN_CASTING_FUNCTIONS.count(callee->name.lexeme) && !call->arguments.empty()) {
+                    // A casting routine stores its result through its last (var) argument
+                    recordWrite(call->arguments.back(), nullptr);
+                }
+            }
+        });
+    if (!blocker.empty()) return blocker;
+    if (scalarWrites.count(iterator)) return "the body assigns the iterator";
+
+    for (const auto& [name, writes] : scalarWrites) {
+        if (plan.privates.count(name)) continue;
+        const Token* type = lookupVariableType(name);
+        bool reduction = type && (type->type == TokenType::INTEGER || type->type == TokenType::REAL);
+        for (const auto& assign : writes) {
+            // s <- s + a + b parses as ((s + a) + b): follow the left operands down to s
+            std::shared_ptr<Expression> operand = assign ? assign->value : nullptr;
+            auto binary = std::dynamic_pointer_cast<Binary>(operand);
+            if (!binary) reduction = false;
+            while (binary && binary->op.type == TokenType::PLUS) {
+                operand = binary->left;
+                binary = std::dynamic_pointer_cast<Binary>(operand);
+            }
+            auto self = std::dynamic_pointer_cast<Variable>(operand);
+            if (binary || !self || self->name.lexeme != name) reduction = false;
+        }
+        if (!reduction || uses[name] != 2 * (int)writes.size()) return "the body writes the shared variable " + name;
+        plan.reductions.push_back(name);
+    }
+
+    std::map<std::string, int> indexed;
+    for (const auto& access : accesses) {
+        auto array = std::dynamic_pointer_cast<Variable>(access->callee);
+        if (!array || !writtenArrays.count(array->name.lexeme)) continue;
+        auto index = std::dynamic_pointer_cast<Variable>(access->indices[0]);
+        if (!index || index->name.lexeme != iterator) {
+            return "the body uses " + array->name.lexeme + " at an index other than " + iterator;
+        }
+        indexed[array->name.lexeme]++;
+    }
+    for (const auto& name : writtenArrays) {
+        if (uses[name] != indexed[name]) return "the body uses " + name + " other than by indexing";
+    }
+
+    for (const auto& bound : {traversal->start, traversal->end}) {
+        walkExpression(bound, [&](const std::shared_ptr<Expression>& expr) {
+            auto var = std::dynamic_pointer_cast<Variable>(expr);
+            if (var && (scalarWrites.count(var->name.lexeme) || writtenArrays.count(var->name.lexeme) ||
+                        plan.privates.count(var->name.lexeme))) {
+                blocker = "the range depends on " + var->name.lexeme + ", which the body writes";
+            }
+        });
+    }
+    for (const auto& name : plan.privates) {
+        if (!lookupVariableType(name)) blocker = "the type of " + name + " is unknown";
+    }
+    return blocker;
+}
+
+/**
+ * @brief Chooses the subprograms that are emitted with the inline directive
+ *
+ * A subprogram qualifies when it is a leaf (it calls no other user
+ * subprogram, so it cannot recurse), declares no constrained or
+ * amortized-growth locals (their setter/resize helpers would become nested
+ * procedures, which FPC does not inline), is called at least once, and is
+ * small enough. The size budget is the inline threshold, doubled for a
+ * single call site since inlining it does not grow the program, and halved
+ * past eight call sites to limit code growth.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::selectInlineSubprograms(std::shared_ptr<ProgramStmt> program) {
+    if (options_.inlineThreshold <= 0) return;
+
+    std::map<std::string, int> callSites;
+    walkStatement(program, {}, [&](const std::shared_ptr<Expression>& expr) {
+        if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+            if (auto callee = std::dynamic_pointer_cast<Variable>(call->callee)) callSites[callee->name.lexeme]++;
+        }
+    });
+
+    for (const auto& sub : program->subprograms) {
+        std::string name;
+        std::shared_ptr<KamusStmt> kamus;
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) {
+            name = proc->name.lexeme;
+            kamus = proc->kamus;
+        } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) {
+            name = func->name.lexeme;
+            kamus = func->kamus;
+        } else {
+            continue;
+        }
+
+        int calls = callSites[name];
+        if (calls == 0 || !subprogramGrownArrays_[name].empty()) continue;
+        int budget = options_.inlineThreshold;
+        if (calls == 1) budget *= 2;
+        else if (calls > 8) budget /= 2;
+
+        int nodes = 0;
+        bool eligible = true;
+        walkStatement(sub,
+            [&](const std::shared_ptr<Statement>& stmt) {
+                if (std::dynamic_pointer_cast<ConstrainedVarDeclStmt>(stmt)) eligible = false;
+                if (!std::dynamic_pointer_cast<BlockStmt>(stmt) && !std::dynamic_pointer_cast<AlgoritmaStmt>(stmt) &&
+                    !std::dynamic_pointer_cast<KamusStmt>(stmt)) nodes++;
+                return eligible;
+            },
+            [&](const std::shared_ptr<Expression>& expr) {
+                nodes++;
+                if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+                    auto callee = std::dynamic_pointer_cast<Variable>(call->callee);
+                    if (callee && subprogramParams_.count(callee->name.lexeme)) eligible = false;
+                }
+            });
+        if (eligible && nodes <= budget) inlineSubprograms_.insert(name);
+    }
+}
+
+/**
+ * @brief Chooses the dynamic arrays that get a specialised lowering
+ *
+ * Picks the arrays grown with amortized capacity, with --flat-arrays the
+ * multi-dimensional arrays stored as one flat buffer, and with --soa the
+ * arrays of records stored as one array per field. Global arrays are
+ * analysed over the main program and every subprogram that does not
+ * redeclare the name; local arrays over their own subprogram.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::selectArrayLowerings(std::shared_ptr<ProgramStmt> program) {
+    ScopedBodies globalBodies = {{program->algoritma, {}}};
+    auto selectLocal = [&](const std::string& name, const std::vector<Parameter>& params,
+                           std::shared_ptr<KamusStmt> kamus, std::shared_ptr<Statement> sub) {
+        globalBodies.push_back({sub, declaredNames(params, kamus)});
+        subprogramGrownArrays_[name] = findGrownArrays(kamus, {{sub, {}}});
+        subprogramFlatArrays_[name] = findFlatArrays(kamus, {{sub, {}}});
+        std::set<std::string> lowered = subprogramGrownArrays_[name];
+        lowered.insert(subprogramFlatArrays_[name].begin(), subprogramFlatArrays_[name].end());
+        subprogramSoaArrays_[name] = findSoaArrays(kamus, {{sub, {}}}, lowered);
+    };
+    for (const auto& sub : program->subprograms) {
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) {
+            selectLocal(proc->name.lexeme, proc->params, proc->kamus, sub);
+        } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) {
+            selectLocal(func->name.lexeme, func->params, func->kamus, sub);
+        }
+    }
+    grownArrays_ = findGrownArrays(program->kamus, globalBodies);
+    flatArrays_ = findFlatArrays(program->kamus, globalBodies);
+    std::set<std::string> lowered = grownArrays_;
+    lowered.insert(flatArrays_.begin(), flatArrays_.end());
+    soaArrays_ = findSoaArrays(program->kamus, globalBodies, lowered);
+}
+
+/** @brief Constant bounds of each dimension of a static array */
+using StaticBounds = std::map<std::string, std::vector<std::pair<long long, long long>>>;
+
+/**
+ * @brief Evaluates an integer expression built from literals and constants
+ *
+ * @param expr Expression to evaluate
+ * @param constants Integer constants in scope
+ * @param value Receives the value
+ * @return true if the expression is a compile-time integer
+ */
+static bool constantValue(const std::shared_ptr<Expression>& expr, const std::map<std::string, long long>& constants, long long& value) {
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) return constantValue(grouping->expression, constants, value);
+    if (auto literal = std::dynamic_pointer_cast<Literal>(expr)) {
+        if (literal->value.type() != typeid(int)) return false;
+        value = std::any_cast<int>(literal->value);
+        return true;
+    }
+    if (auto var = std::dynamic_pointer_cast<Variable>(expr)) {
+        auto it = constants.find(var->name.lexeme);
+        if (it == constants.end()) return false;
+        value = it->second;
+        return true;
+    }
+    if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+        if (unary->op.type != TokenType::MINUS || !constantValue(unary->right, constants, value)) return false;
+        value = -value;
+        return true;
+    }
+    auto binary = std::dynamic_pointer_cast<Binary>(expr);
+    if (!binary || (binary->op.type != TokenType::PLUS && binary->op.type != TokenType::MINUS)) return false;
+    long long left = 0, right = 0;
+    if (!constantValue(binary->left, constants, left) || !constantValue(binary->right, constants, right)) return false;
+    value = binary->op.type == TokenType::PLUS ? left + right : left - right;
+    return true;
+}
+
+/**
+ * @brief Splits an index of the form `i`, `i + c`, `i - c` or `c`
+ *
+ * @param expr Index expression
+ * @param constants Integer constants in scope
+ * @param variable Receives the variable name (empty for a constant index)
+ * @param offset Receives the constant offset
+ * @return true if the index is affine in at most one variable with unit coefficient
+ */
+static bool affineIndex(const std::shared_ptr<Expression>& expr, const std::map<std::string, long long>& constants,
+                        std::string& variable, long long& offset) {
+    if (constantValue(expr, constants, offset)) {
+        variable.clear();
+        return true;
+    }
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) return affineIndex(grouping->expression, constants, variable, offset);
+    if (auto var = std::dynamic_pointer_cast<Variable>(expr)) {
+        variable = var->name.lexeme;
+        offset = 0;
+        return true;
+    }
+    auto binary = std::dynamic_pointer_cast<Binary>(expr);
+    if (!binary || (binary->op.type != TokenType::PLUS && binary->op.type != TokenType::MINUS)) return false;
+    long long step = 0;
+    if (constantValue(binary->right, constants, step) && affineIndex(binary->left, constants, variable, offset)) {
+        offset += binary->op.type == TokenType::PLUS ? step : -step;
+        return !variable.empty();
+    }
+    if (binary->op.type == TokenType::PLUS && constantValue(binary->left, constants, step) &&
+        affineIndex(binary->right, constants, variable, offset)) {
+        offset += step;
+        return !variable.empty();
+    }
+    return false;
+}
+
+/**
+ * @brief Adds the integer constants and constant-bound static arrays of a KAMUS block
+ *
+ * Names the block declares for anything else are removed first, so locals
+ * shadow globals of the same name.
+ *
+ * @param kamus KAMUS block (may be null)
+ * @param shadowed Every name the block declares
+ * @param constants Integer constants in scope, updated in place
+ * @param arrays Static arrays in scope, updated in place
+ */
+static void addStaticScope(std::shared_ptr<KamusStmt> kamus, const std::set<std::string>& shadowed,
+                           std::map<std::string, long long>& constants, StaticBounds& arrays) {
+    for (const auto& name : shadowed) {
+        constants.erase(name);
+        arrays.erase(name);
+    }
+    if (!kamus) return;
+    for (const auto& decl : kamus->declarations) {
+        long long value = 0;
+        if (auto constDecl = std::dynamic_pointer_cast<ConstDeclStmt>(decl)) {
+            if (constantValue(constDecl->initializer, constants, value)) constants[constDecl->name.lexeme] = value;
+        } else if (auto staticArray = std::dynamic_pointer_cast<StaticArrayDeclStmt>(decl)) {
+            std::vector<std::pair<long long, long long>> bounds;
+            for (const auto& dim : staticArray->dimensions) {
+                long long low = 0, high = 0;
+                if (!constantValue(dim.start, constants, low) || !constantValue(dim.end, constants, high)) break;
+                bounds.push_back({low, high});
+            }
+            if (bounds.size() != staticArray->dimensions.size()) continue;
+            for (const auto& name : staticArray->names) arrays[name.lexeme] = bounds;
+        }
+    }
+}
+
+/**
+ * @brief Collects the dynamic arrays declared in a KAMUS block
+ *
+ * @param kamus KAMUS block (may be null)
+ * @param minDimensions Smallest dimension count to include
+ * @param maxDimensions Largest dimension count to include
+ * @return std::map<std::string, int> Array names mapped to their dimension count
+ */
+static std::map<std::string, int> dynamicArraysIn(std::shared_ptr<KamusStmt> kamus, int minDimensions, int maxDimensions) {
+    std::map<std::string, int> arrays;
+    if (!kamus) return arrays;
+    for (const auto& decl : kamus->declarations) {
+        if (auto dynArray = std::dynamic_pointer_cast<DynamicArrayDeclStmt>(decl)) {
+            if (dynArray->dimensions < minDimensions || dynArray->dimensions > maxDimensions) continue;
+            for (const auto& name : dynArray->names) arrays[name.lexeme] = dynArray->dimensions;
+        }
+    }
+    return arrays;
+}
+
+/**
+ * @brief Finds the candidate arrays that are used as whole values
+ *
+ * The specialised array lowerings can only rewrite full-rank indexing
+ * (`a[i]`, `a[i][j]`...), allocate with one size per dimension,
+ * deallocate[n] with the declared dimension count, and length()/high().
+ * Any other use, such as `b <- a`, would expose the changed storage.
+ *
+ * @param candidates Array names mapped to their dimension count
+ * @param bodies Code to analyse, each with the names it shadows
+ * @return std::set<std::string> Names with at least one other use
+ */
+std::set<std::string> PascalCodeGenerator::findArrayEscapes(const std::map<std::string, int>& candidates,
+                                                            const ScopedBodies& bodies) {
+    std::set<std::string> escaped;
+    for (const auto& [body, shadowed] : bodies) {
+        auto candidate = [&](const std::shared_ptr<Expression>& expr) -> std::shared_ptr<Variable> {
+            auto var = std::dynamic_pointer_cast<Variable>(expr);
+            if (var && candidates.count(var->name.lexeme) && !shadowed.count(var->name.lexeme)) return var;
+            return nullptr;
+        };
+
+        std::set<const Expression*> allowed;
+        walkStatement(body,
+            [&](const std::shared_ptr<Statement>& stmt) {
+                if (auto allocate = std::dynamic_pointer_cast<AllocateStmt>(stmt)) {
+                    if (auto var = candidate(allocate->callee)) {
+                        allowed.insert(var.get());
+                        if ((int)allocate->sizes.size() != candidates.at(var->name.lexeme)) escaped.insert(var->name.lexeme);
+                    }
+                } else if (auto deallocate = std::dynamic_pointer_cast<DeallocateStmt>(stmt)) {
+                    if (auto var = candidate(deallocate->callee)) {
+                        allowed.insert(var.get());
+                        if (deallocate->dimension != candidates.at(var->name.lexeme)) escaped.insert(var->name.lexeme);
+                    }
+                }
+                return true;
+            },
+            [&](const std::shared_ptr<Expression>& expr) {
+                if (auto arrayAccess = std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+                    if (auto var = candidate(arrayAccess->callee)) {
+                        allowed.insert(var.get());
+                        if ((int)arrayAccess->indices.size() != candidates.at(var->name.lexeme)) escaped.insert(var->name.lexeme);
+                    }
+                } else if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+                    auto callee = std::dynamic_pointer_cast<Variable>(call->callee);
+                    if (callee && call->arguments.size() == 1) {
+                        std::string fn = callee->name.lexeme;
+                        std::transform(fn.begin(), fn.end(), fn.begin(), [](unsigned char c) { return std::tolower(c); });
+                        if (fn == "length" || fn == "high") {
+                            if (auto var = candidate(call->arguments[0])) allowed.insert(var.get());
+                        }
+                    }
+                } else if (auto var = candidate(expr)) {
+                    if (!allowed.count(var.get())) escaped.insert(var->name.lexeme);
+                }
+            });
+    }
+    return escaped;
+}
+
+/**
+ * @brief Finds the one-dimensional dynamic arrays that grow inside loops
+ *
+ * An array qualifies when some loop resizes it by a small step (see
+ * isSmallIncrement) and it never escapes (see findArrayEscapes). Nothing
+ * qualifies under the debug profile: {$R+} checks indices against the
+ * capacity, not the logical length, so the lowering would hide
+ * out-of-bounds accesses. The checked profile tests them against
+ * _GateLen_ itself.
+ *
+ * @param kamus KAMUS block declaring the candidate arrays
+ * @param bodies Code to analyse, each with the names it shadows
+ * @return std::set<std::string> Names of the qualifying arrays
+ */
+std::set<std::string> PascalCodeGenerator::findGrownArrays(std::shared_ptr<KamusStmt> kamus, const ScopedBodies& bodies) {
+    std::set<std::string> grown;
+    if (options_.profile == BuildProfile::DEBUG) return grown;
+    auto candidates = dynamicArraysIn(kamus, 1, 1);
+    if (candidates.empty()) return grown;
+
+    for (const auto& [body, shadowed] : bodies) {
+        walkStatement(body, [&](const std::shared_ptr<Statement>& stmt) {
+            auto loop = loopBody(stmt);
+            if (!loop) return true;
+            walkStatement(loop, [&](const std::shared_ptr<Statement>& inner) {
+                auto allocate = std::dynamic_pointer_cast<AllocateStmt>(inner);
+                if (allocate && allocate->sizes.size() == 1 && isSmallIncrement(allocate->sizes[0])) {
+                    auto var = std::dynamic_pointer_cast<Variable>(allocate->callee);
+                    if (var && candidates.count(var->name.lexeme) && !shadowed.count(var->name.lexeme)) grown.insert(var->name.lexeme);
+                }
+                return true;
+            }, {});
+            return true;
+        }, {});
+    }
+
+    for (const auto& name : findArrayEscapes(candidates, bodies)) grown.erase(name);
+    return grown;
+}
+
+/**
+ * @brief Finds the multi-dimensional dynamic arrays stored as one flat buffer
+ *
+ * Only active with --flat-arrays. An array qualifies when it never escapes
+ * (see findArrayEscapes) and is never allocated inside a loop: reallocating
+ * a flat buffer with new extents would move elements to new positions,
+ * while SetLength on nested arrays keeps them in place. Arrays declared
+ * together share one declaration, so they qualify together or not at all.
+ * Nothing qualifies under the debug profile, where {$R+} would only see the
+ * combined offset and let m[0][5] land in m[1][1]; the checked profile
+ * tests every index against its extent.
+ *
+ * @param kamus KAMUS block declaring the candidate arrays
+ * @param bodies Code to analyse, each with the names it shadows
+ * @return std::set<std::string> Names of the qualifying arrays
+ */
+std::set<std::string> PascalCodeGenerator::findFlatArrays(std::shared_ptr<KamusStmt> kamus, const ScopedBodies& bodies) {
+    std::set<std::string> flat;
+    if (!options_.flatArrays || options_.profile == BuildProfile::DEBUG) return flat;
+    auto candidates = dynamicArraysIn(kamus, 2, INT_MAX);
+    if (candidates.empty()) return flat;
+
+    std::set<std::string> rejected = findArrayEscapes(candidates, bodies);
+    for (const auto& [body, shadowed] : bodies) {
+        walkStatement(body, [&](const std::shared_ptr<Statement>& stmt) {
+            auto loop = loopBody(stmt);
+            if (!loop) return true;
+            walkStatement(loop, [&](const std::shared_ptr<Statement>& inner) {
+                if (auto allocate = std::dynamic_pointer_cast<AllocateStmt>(inner)) {
+                    auto var = std::dynamic_pointer_cast<Variable>(allocate->callee);
+                    if (var && candidates.count(var->name.lexeme) && !shadowed.count(var->name.lexeme)) rejected.insert(var->name.lexeme);
+                }
+                return true;
+            }, {});
+            return true;
+        }, {});
+    }
+
+    for (const auto& decl : kamus->declarations) {
+        auto dynArray = std::dynamic_pointer_cast<DynamicArrayDeclStmt>(decl);
+        if (!dynArray || !candidates.count(dynArray->names[0].lexeme)) continue;
+        bool all = true;
+        for (const auto& name : dynArray->names) all = all && !rejected.count(name.lexeme);
+        if (all) {
+            for (const auto& name : dynArray->names) flat.insert(name.lexeme);
+        }
+    }
+    return flat;
+}
+
+/**
+ * @brief Finds the arrays of records stored as one array per field
+ *
+ * Only active with --soa. Static and dynamic arrays whose element type is a
+ * record qualify when they never escape (see findArrayEscapes) and every
+ * element access selects a field, as in `a[i].name`: a whole element such
+ * as `b <- a[i]` has no single array to live in. Arrays already lowered to
+ * amortized growth or flat storage are left alone. Arrays declared together
+ * qualify together or not at all.
+ *
+ * @param kamus KAMUS block declaring the candidate arrays
+ * @param bodies Code to analyse, each with the names it shadows
+ * @param lowered Arrays of this block that another lowering already took
+ * @return std::map<std::string, std::string> Qualifying arrays mapped to their record type
+ */
+std::map<std::string, std::string> PascalCodeGenerator::findSoaArrays(std::shared_ptr<KamusStmt> kamus, const ScopedBodies& bodies,
+                                                                      const std::set<std::string>& lowered) {
+    std::map<std::string, std::string> soa;
+    if (!options_.soa || !kamus) return soa;
+
+    // Each candidate declaration: its names, dimension count and record type
+    std::vector<std::tuple<std::vector<Token>, int, std::string>> decls;
+    for (const auto& decl : kamus->declarations) {
+        if (auto staticArray = std::dynamic_pointer_cast<StaticArrayDeclStmt>(decl)) {
+            decls.emplace_back(staticArray->names, (int)staticArray->dimensions.size(), staticArray->elementType.lexeme);
+        } else if (auto dynArray = std::dynamic_pointer_cast<DynamicArrayDeclStmt>(decl)) {
+            decls.emplace_back(dynArray->names, dynArray->dimensions, dynArray->elementType.lexeme);
+        }
+    }
+    std::map<std::string, int> candidates;
+    for (const auto& [names, dimensions, type] : decls) {
+        auto record = recordTypes_.find(type);
+        if (record == recordTypes_.end() || record->second->fields.empty()) continue;
+        for (const auto& name : names) {
+            if (!lowered.count(name.lexeme)) candidates[name.lexeme] = dimensions;
+        }
+    }
+    if (candidates.empty()) return soa;
+
+    std::set<std::string> rejected = findArrayEscapes(candidates, bodies);
+    for (const auto& [body, shadowed] : bodies) {
+        std::set<const Expression*> fieldObjects;
+        std::vector<std::pair<std::string, const Expression*>> accesses;
+        walkStatement(body, {}, [&](const std::shared_ptr<Expression>& expr) {
+            if (auto field = std::dynamic_pointer_cast<FieldAccess>(expr)) {
+                fieldObjects.insert(field->object.get());
+            } else if (auto access = std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+                auto var = std::dynamic_pointer_cast<Variable>(access->callee);
+                if (var && candidates.count(var->name.lexeme) && !shadowed.count(var->name.lexeme)) {
+                    accesses.push_back({var->name.lexeme, access.get()});
+                }
+            }
+        });
+        for (const auto& [name, access] : accesses) {
+            if (!fieldObjects.count(access)) rejected.insert(name);
+        }
+    }
+
+    for (const auto& [names, dimensions, type] : decls) {
+        bool all = true;
+        for (const auto& name : names) all = all && candidates.count(name.lexeme) && !rejected.count(name.lexeme);
+        if (all) {
+            for (const auto& name : names) soa[name.lexeme] = type;
+        }
+    }
+    return soa;
+}
+
+/**
+ * @brief Gets the record type of an array stored as one array per field
+ *
+ * @param name Array name
+ * @return The record declaration, or nullptr if the array is stored normally
+ */
+std::shared_ptr<RecordTypeDeclStmt> PascalCodeGenerator::soaRecord(const std::string& name) const {
+    const auto& arrays = localNames_.count(name) ? localSoaArrays_ : soaArrays_;
+    auto it = arrays.find(name);
+    if (it == arrays.end()) return nullptr;
+    return recordTypes_.at(it->second);
+}
+
+/**
+ * @brief Checks whether a dynamic array in the current scope uses amortized growth
+ *
+ * @param name Array name
+ * @return true if resizes of the array go through its _GateResize_ helper
+ */
+bool PascalCodeGenerator::isGrownArray(const std::string& name) const {
+    if (localNames_.count(name)) return localGrownArrays_.count(name) > 0;
+    return grownArrays_.count(name) > 0;
+}
+
+/**
+ * @brief Checks whether a dynamic array in the current scope is stored flat
+ *
+ * @param name Array name
+ * @return true if the array is one buffer indexed through _GateExt_ extents
+ */
+bool PascalCodeGenerator::isFlatArray(const std::string& name) const {
+    if (localNames_.count(name)) return localFlatArrays_.count(name) > 0;
+    return flatArrays_.count(name) > 0;
+}
+
+/**
+ * @brief Collects every name a subprogram declares
+ *
+ * @param params Subprogram parameters
+ * @param kamus Local KAMUS block (may be null)
+ * @return std::set<std::string> Parameter, variable, array and constant names
+ */
+std::set<std::string> PascalCodeGenerator::declaredNames(const std::vector<Parameter>& params, std::shared_ptr<KamusStmt> kamus) const {
+    std::set<std::string> names;
+    for (const auto& p : params) names.insert(p.name.lexeme);
+    if (!kamus) return names;
+    for (const auto& decl : kamus->declarations) {
+        if (auto varDecl = std::dynamic_pointer_cast<VarDeclStmt>(decl)) {
+            for (const auto& name : varDecl->names) names.insert(name.lexeme);
+        } else if (auto staticArray = std::dynamic_pointer_cast<StaticArrayDeclStmt>(decl)) {
+            for (const auto& name : staticArray->names) names.insert(name.lexeme);
+        } else if (auto dynArray = std::dynamic_pointer_cast<DynamicArrayDeclStmt>(decl)) {
+            for (const auto& name : dynArray->names) names.insert(name.lexeme);
+        } else if (auto constrained = std::dynamic_pointer_cast<ConstrainedVarDeclStmt>(decl)) {
+            for (const auto& name : constrained->names) names.insert(name.lexeme);
+        } else if (auto constDecl = std::dynamic_pointer_cast<ConstDeclStmt>(decl)) {
+            names.insert(constDecl->name.lexeme);
+        }
+    }
+    return names;
+}
+
+/**
+ * @brief Records the declared type of every scalar variable in a KAMUS block
+ *
+ * @param kamus KAMUS block to scan (may be null)
+ * @param types Table receiving name-to-type entries
+ * @param pointerTargets Table receiving name-to-pointed-type entries for pointer variables
+ */
+void PascalCodeGenerator::collectVariableTypes(std::shared_ptr<KamusStmt> kamus, std::map<std::string, Token>& types,
+                                               std::map<std::string, Token>& pointerTargets) {
+    if (!kamus) return;
+    for (const auto& decl : kamus->declarations) {
+        if (auto varDecl = std::dynamic_pointer_cast<VarDeclStmt>(decl)) {
+            for (const auto& name : varDecl->names) {
+                types[name.lexeme] = varDecl->type;
+                if (varDecl->type.type == TokenType::POINTER) pointerTargets[name.lexeme] = varDecl->pointedToType;
+            }
+        } else if (auto constrained = std::dynamic_pointer_cast<ConstrainedVarDeclStmt>(decl)) {
+            for (const auto& name : constrained->names) types[name.lexeme] = constrained->type;
+        }
+    }
+}
+
+/**
+ * @brief Looks up the declared type of a variable
+ *
+ * @param name Variable name
+ * @return const Token* Type token, or nullptr if the name is not a known variable
+ */
+const Token* PascalCodeGenerator::lookupVariableType(const std::string& name) const {
+    auto local = localVarTypes_.find(name);
+    if (local != localVarTypes_.end()) return &local->second;
+    auto global = globalVarTypes_.find(name);
+    if (global != globalVarTypes_.end()) return &global->second;
+    return nullptr;
+}
+
+/**
+ * @brief Finds the pointed-to type of a pointer-valued expression
+ *
+ * Handles pointer variables and pointer fields reached through records,
+ * e.g. `p` or `p^.next`.
+ *
+ * @param expr Pointer-valued expression
+ * @return const Token* Pointed-to type, or nullptr if it cannot be determined
+ */
+const Token* PascalCodeGenerator::pointerTargetType(std::shared_ptr<Expression> expr) const {
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) return pointerTargetType(grouping->expression);
+    if (auto var = std::dynamic_pointer_cast<Variable>(expr)) {
+        auto local = localPointerTargets_.find(var->name.lexeme);
+        if (local != localPointerTargets_.end()) return &local->second;
+        if (localVarTypes_.count(var->name.lexeme)) return nullptr;
+        auto global = globalPointerTargets_.find(var->name.lexeme);
+        if (global != globalPointerTargets_.end()) return &global->second;
+        return nullptr;
+    }
+    if (auto fieldAccess = std::dynamic_pointer_cast<FieldAccess>(expr)) {
+        auto record = recordTypeOf(fieldAccess->object);
+        if (!record) return nullptr;
+        for (const auto& field : record->fields) {
+            if (field.name.lexeme == fieldAccess->name.lexeme && field.type.type == TokenType::POINTER) return &field.pointedToType;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Finds the record type an expression evaluates to
+ *
+ * @param expr Record-valued expression (variable, dereference or field)
+ * @return std::shared_ptr<RecordTypeDeclStmt> Record declaration, or nullptr
+ */
+std::shared_ptr<RecordTypeDeclStmt> PascalCodeGenerator::recordTypeOf(std::shared_ptr<Expression> expr) const {
+    const Token* type = nullptr;
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) {
+        return recordTypeOf(grouping->expression);
+    } else if (auto var = std::dynamic_pointer_cast<Variable>(expr)) {
+        type = lookupVariableType(var->name.lexeme);
+    } else if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+        if (unary->op.type == TokenType::POWER) type = pointerTargetType(unary->right);
+    } else if (auto fieldAccess = std::dynamic_pointer_cast<FieldAccess>(expr)) {
+        auto record = recordTypeOf(fieldAccess->object);
+        if (!record) return nullptr;
+        for (const auto& field : record->fields) {
+            if (field.name.lexeme == fieldAccess->name.lexeme) type = &field.type;
+        }
+    }
+    if (!type || type->type != TokenType::IDENTIFIER) return nullptr;
+    auto it = recordTypes_.find(type->lexeme);
+    return it == recordTypes_.end() ? nullptr : it->second;
+}
+
+/**
+ * @brief Chooses the pointed-to types that are allocated through a pool
+ *
+ * Every pointer allocate/deallocate in the program must resolve to a
+ * pointed-to type; otherwise a node taken from a pool could be handed to
+ * Dispose (or the reverse), so pooling is left off for the whole program.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::selectPooledTypes(std::shared_ptr<ProgramStmt> program) {
+    if (options_.alloc != AllocStrategy::POOL) return;
+
+    std::map<std::string, std::string> types;
+    bool resolved = true;
+    auto scan = [&](const std::shared_ptr<Statement>& body) {
+        walkStatement(body, [&](const std::shared_ptr<Statement>& stmt) {
+            std::shared_ptr<Expression> target;
+            if (auto allocate = std::dynamic_pointer_cast<AllocateStmt>(stmt)) {
+                if (allocate->sizes.empty()) target = allocate->callee;
+            } else if (auto deallocate = std::dynamic_pointer_cast<DeallocateStmt>(stmt)) {
+                if (deallocate->dimension == -1) target = deallocate->callee;
+            }
+            if (target) {
+                const Token* type = pointerTargetType(target);
+                if (type) types[type->lexeme] = pascalType(*type);
+                else resolved = false;
+            }
+            return true;
+        }, {});
+    };
+
+    scan(program->algoritma);
+    for (const auto& sub : program->subprograms) {
+        std::shared_ptr<KamusStmt> kamus;
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) {
+            for (const auto& p : proc->params) localVarTypes_[p.name.lexeme] = p.type;
+            kamus = proc->kamus;
+        } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) {
+            for (const auto& p : func->params) localVarTypes_[p.name.lexeme] = p.type;
+            kamus = func->kamus;
+        }
+        collectVariableTypes(kamus, localVarTypes_, localPointerTargets_);
+        scan(sub);
+        localVarTypes_.clear();
+        localPointerTargets_.clear();
+    }
+
+    if (resolved) pooledTypes_ = types;
+}
+
+/**
+ * @brief Assigns profile counters to statements and timers to subprograms
+ *
+ * Every statement that appears directly in a block gets the next counter
+ * index, in source order, and its NOTAL line is recorded for the report.
+ * Each subprogram gets a timer, indexed by its position in the program.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::numberStatements(std::shared_ptr<ProgramStmt> program) {
+    auto number = [&](const std::shared_ptr<Statement>& body) {
+        std::set<const Statement*> inBlock;
+        walkStatement(body, [&](const std::shared_ptr<Statement>& stmt) {
+            if (auto block = std::dynamic_pointer_cast<BlockStmt>(stmt)) {
+                for (const auto& s : block->statements) inBlock.insert(s.get());
+            }
+            if (inBlock.count(stmt.get()) && !statementIds_.count(stmt.get())) {
+                statementIds_[stmt.get()] = static_cast<int>(statementLines_.size());
+                statementLines_.push_back(stmt->line);
+            }
+            return true;
+        }, {});
+    };
+
+    number(program->algoritma);
+    for (const auto& sub : program->subprograms) {
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) {
+            profiledSubprograms_.push_back(proc->name.lexeme);
+        } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) {
+            profiledSubprograms_.push_back(func->name.lexeme);
+        }
+        number(sub);
+    }
+}
+
 /**
  * @brief Outputs indentation spaces based on current indentation level
  * 
@@ -221,14 +1365,40 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<ProgramStmt> stmt) {
     }
     scanForCastingFunctions(stmt->algoritma);
 
+    generateCompilerDirectives();
     out_ << "program " << stmt->name.lexeme << ";\n\n";
 
-    if (!usedCastingFunctions_.empty()) {
+    if (!parallelTraversals_.empty()) {
+        // cthreads installs the thread manager on Unix and must come first
+        out_ << "uses {$IFDEF UNIX}cthreads, {$ENDIF}SysUtils;\n\n";
+    } else if (!usedCastingFunctions_.empty() || options_.instrument == Instrumentation::PROFILE) {
         out_ << "uses SysUtils;\n\n";
     }
 
     execute(stmt->kamus);
 
+    if (options_.fastIO) {
+        generateRuntimeSection("FastIO");
+    }
+    if (options_.profile == BuildProfile::CHECKED) {
+        generateRuntimeSection("CheckedArrays");
+    }
+    for (const auto& [type, valueType] : pooledTypes_) {
+        generateRuntimeSection("Pool", type, valueType);
+    }
+    if (options_.instrument == Instrumentation::PROFILE) {
+        generateProfileTables();
+        generateRuntimeSection("Profile");
+    }
+    if (!memoFunctions_.empty()) {
+        generateRuntimeSection("Memo");
+        generateMemoTables(stmt);
+    }
+    generateTabulatedTables();
+    if (!parallelTraversals_.empty()) {
+        generateRuntimeSection("Parallel");
+    }
+
     // Generate forward declarations from the original declaration order
     if (stmt->kamus) {
         forwardDeclare_ = true;
@@ -254,6 +1424,8 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<ProgramStmt> stmt) {
         generateCastingImplementations();
     }
 
+    generateParallelWorkers();
+
     execute(stmt->algoritma);
     out_ << ".\n";
     return {};
@@ -288,7 +1460,21 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<KamusStmt> stmt) {
     if (!varDecls.empty() || !constrainedVarDecls.empty() || !loopVariables_.empty()) {
         out_ << "var\n";
         indentLevel_++;
-        for (const auto& decl : varDecls) { indent(); execute(decl); out_ << ";\n"; }
+        for (const auto& decl : varDecls) {
+            indent(); execute(decl); out_ << ";\n";
+            if (auto dynArray = std::dynamic_pointer_cast<DynamicArrayDeclStmt>(decl)) {
+                for (const auto& name : dynArray->names) {
+                    if (isGrownArray(name.lexeme)) { indent(); out_ << "_GateLen_" << name.lexeme << ": longint = 0;\n"; }
+                    if (isFlatArray(name.lexeme)) {
+                        indent();
+                        std::string zeros = "0";
+                        for (int d = 1; d < dynArray->dimensions; ++d) zeros += ", 0";
+                        out_ << "_GateExt_" << name.lexeme << ": array[0.." << dynArray->dimensions - 1
+                             << "] of longint = (" << zeros << ");\n";
+                    }
+                }
+            }
+        }
         for (const auto& decl : constrainedVarDecls) {
             auto constrainedVar = std::dynamic_pointer_cast<ConstrainedVarDeclStmt>(decl);
             if (constrainedVar) {
@@ -311,8 +1497,10 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<KamusStmt> stmt) {
                     out_ << "procedure Set" << name.lexeme << "(var " << name.lexeme << ": " << pascalType(constrainedVar->type) << "; value: " << pascalType(constrainedVar->type) << ");\n";
                     out_ << "begin\n";
                     indentLevel_++;
-                    indent();
-                    out_ << "Assert(" << generateConstraintCheck(constrainedVar, name) << ", 'Error: " << name.lexeme << " constraint violation!');\n";
+                    if (options_.profile != BuildProfile::RELEASE) {
+                        indent();
+                        out_ << "Assert(" << generateConstraintCheck(constrainedVar, name) << ", 'Error: " << name.lexeme << " constraint violation!');\n";
+                    }
                     indent();
                     out_ << name.lexeme << " := value;\n";
                     indentLevel_--;
@@ -321,6 +1509,27 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<KamusStmt> stmt) {
             }
         }
     }
+
+    // Amortized-growth resize helpers: the array keeps spare capacity and
+    // _GateLen_ holds its logical length. Elements exposed again after a
+    // shrink are zeroed, as SetLength would leave them.
+    for (const auto& decl : varDecls) {
+        auto dynArray = std::dynamic_pointer_cast<DynamicArrayDeclStmt>(decl);
+        if (!dynArray) continue;
+        for (const auto& name : dynArray->names) {
+            if (!isGrownArray(name.lexeme)) continue;
+            const std::string& a = name.lexeme;
+            out_ << "procedure _GateResize_" << a << "(newLen: longint);\n";
+            out_ << "begin\n";
+            out_ << "  if newLen > _GateLen_" << a << " then\n";
+            out_ << "  begin\n";
+            out_ << "    if newLen > Length(" << a << ") then SetLength(" << a << ", 2 * newLen);\n";
+            out_ << "    FillChar(" << a << "[_GateLen_" << a << "], (newLen - _GateLen_" << a << ") * SizeOf(" << a << "[0]), 0);\n";
+            out_ << "  end;\n";
+            out_ << "  _GateLen_" << a << " := newLen;\n";
+            out_ << "end;\n\n";
+        }
+    }
     return {};
 }
 
@@ -341,22 +1550,39 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<VarDeclStmt> stmt) {
 }
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<StaticArrayDeclStmt> stmt) {
+    std::string bounds;
+    for (size_t i = 0; i < stmt->dimensions.size(); ++i) {
+        if (i > 0) bounds += ", ";
+        bounds += arrayBound(stmt->dimensions[i].start, stmt->names[0]) + ".." +
+                  arrayBound(stmt->dimensions[i].end, stmt->names[0]);
+    }
+    if (auto record = soaRecord(stmt->names[0].lexeme)) {
+        generateSoaDeclaration(stmt->names, *record, "array[" + bounds + "] of ");
+        return {};
+    }
     for (size_t i = 0; i < stmt->names.size(); ++i) {
         out_ << stmt->names[i].lexeme;
         if (i < stmt->names.size() - 1) {
             out_ << ", ";
         }
     }
-    out_ << ": array[";
-    for (size_t i = 0; i < stmt->dimensions.size(); ++i) {
-        out_ << evaluate(stmt->dimensions[i].start) << ".." << evaluate(stmt->dimensions[i].end);
-        if (i < stmt->dimensions.size() - 1) out_ << ", ";
-    }
-    out_ << "] of " << pascalType(stmt->elementType);
+    out_ << ": array[" << bounds << "] of " << pascalType(stmt->elementType);
     return {};
 }
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<DynamicArrayDeclStmt> stmt) {
+    if (auto record = soaRecord(stmt->names[0].lexeme)) {
+        std::string levels;
+        for (int i = 0; i < stmt->dimensions; ++i) levels += "array of ";
+        for (const auto& name : stmt->names) {
+            dynamicArrayDimensions_[name.lexeme] = stmt->dimensions;
+            for (const auto& field : record->fields) {
+                dynamicArrayDimensions_[name.lexeme + "_" + field.name.lexeme] = stmt->dimensions;
+            }
+        }
+        generateSoaDeclaration(stmt->names, *record, levels);
+        return {};
+    }
     for (size_t i = 0; i < stmt->names.size(); ++i) {
         dynamicArrayDimensions_[stmt->names[i].lexeme] = stmt->dimensions;
         out_ << stmt->names[i].lexeme;
@@ -365,7 +1591,9 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<DynamicArrayDeclStmt> stmt)
         }
     }
     out_ << ": ";
-    for (int i = 0; i < stmt->dimensions; ++i) {
+    // Flat arrays keep all elements in one buffer; the extents live in _GateExt_.
+    int levels = isFlatArray(stmt->names[0].lexeme) ? 1 : stmt->dimensions;
+    for (int i = 0; i < levels; ++i) {
         out_ << "array of ";
     }
     out_ << pascalType(stmt->elementType);
@@ -373,8 +1601,35 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<DynamicArrayDeclStmt> stmt)
 }
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<AllocateStmt> stmt) {
+    auto array = std::dynamic_pointer_cast<Variable>(stmt->callee);
+    if (auto record = array ? soaRecord(array->name.lexeme) : nullptr) {
+        std::string sizes;
+        for (const auto& size : stmt->sizes) sizes += ", " + evaluate(size);
+        for (size_t i = 0; i < record->fields.size(); ++i) {
+            if (i > 0) indent();
+            out_ << "SetLength(" << array->name.lexeme << "_" << record->fields[i].name.lexeme << sizes << ");\n";
+        }
+        return {};
+    }
     if (stmt->sizes.empty()) {
-        out_ << "New(" << evaluate(stmt->callee) << ");\n";
+        const Token* type = pointerTargetType(stmt->callee);
+        if (type && pooledTypes_.count(type->lexeme)) {
+            out_ << "PoolNew_" << type->lexeme << "(" << evaluate(stmt->callee) << ");\n";
+        } else {
+            out_ << "New(" << evaluate(stmt->callee) << ");\n";
+        }
+    } else if (stmt->sizes.size() == 1 && std::dynamic_pointer_cast<Variable>(stmt->callee) && isGrownArray(evaluate(stmt->callee))) {
+        out_ << "_GateResize_" << evaluate(stmt->callee) << "(" << evaluate(stmt->sizes[0]) << ");\n";
+    } else if (std::dynamic_pointer_cast<Variable>(stmt->callee) && isFlatArray(evaluate(stmt->callee))) {
+        std::string name = evaluate(stmt->callee);
+        std::string total;
+        for (size_t i = 0; i < stmt->sizes.size(); ++i) {
+            if (i > 0) indent();
+            out_ << "_GateExt_" << name << "[" << i << "] := " << evaluate(stmt->sizes[i]) << ";\n";
+            total += (i > 0 ? " * " : "") + ("_GateExt_" + name + "[" + std::to_string(i) + "]");
+        }
+        indent();
+        out_ << "SetLength(" << name << ", " << total << ");\n";
     } else {
         out_ << "SetLength(" << evaluate(stmt->callee);
         for (const auto& size : stmt->sizes) {
@@ -388,7 +1643,12 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<AllocateStmt> stmt) {
 std::any PascalCodeGenerator::visit(std::shared_ptr<DeallocateStmt> stmt) {
     std::string varName = evaluate(stmt->callee);
     if (stmt->dimension == -1) {
-        out_ << "Dispose(" << varName << ");\n";
+        const Token* type = pointerTargetType(stmt->callee);
+        if (type && pooledTypes_.count(type->lexeme)) {
+            out_ << "PoolDispose_" << type->lexeme << "(" << varName << ");\n";
+        } else {
+            out_ << "Dispose(" << varName << ");\n";
+        }
     } else {
         if (dynamicArrayDimensions_.find(varName) == dynamicArrayDimensions_.end()) {
             throw std::runtime_error("Deallocating an undeclared dynamic array: " + varName);
@@ -397,11 +1657,30 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<DeallocateStmt> stmt) {
         if (declaredDim != stmt->dimension) {
              throw std::runtime_error("Deallocation dimension mismatch for '" + varName + "'. Declared: " + std::to_string(declaredDim) + ", Used: " + std::to_string(stmt->dimension));
         }
+        if (auto record = soaRecord(varName)) {
+            for (size_t i = 0; i < record->fields.size(); ++i) {
+                if (i > 0) indent();
+                out_ << "SetLength(" << varName << "_" << record->fields[i].name.lexeme;
+                for (int d = 0; d < stmt->dimension; ++d) out_ << ", 0";
+                out_ << ");\n";
+            }
+            return {};
+        }
+        if (isFlatArray(varName)) {
+            out_ << "SetLength(" << varName << ", 0);\n";
+            indent();
+            out_ << "FillChar(_GateExt_" << varName << ", SizeOf(_GateExt_" << varName << "), 0);\n";
+            return {};
+        }
         out_ << "SetLength(" << varName;
         for (int i = 0; i < stmt->dimension; ++i) {
             out_ << ", 0";
         }
-        out_ << ");\n";
+        out_ << ");\n";
+        if (isGrownArray(varName)) {
+            indent();
+            out_ << "_GateLen_" << varName << " := 0;\n";
+        }
     }
     return {};
 }
@@ -452,20 +1731,68 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<ConstDeclStmt> stmt) {
         }
     }
     
+    std::string value;
+    if (evaluator_ && evaluator_->callsFunction(stmt->initializer)) {
+        // Pascal constants cannot call functions, so the call is run here
+        std::string reason;
+        value = foldConstantCall(stmt->initializer, reason);
+        if (value.empty()) {
+            indent();
+            out_ << "{ const-eval: " << stmt->name.lexeme << " left as written: " << reason << " }\n";
+            noteConstEvalFallback(stmt->name, "Constant '" + stmt->name.lexeme + "'", reason);
+        }
+    }
+    if (value.empty()) value = writtenAsIs(stmt->initializer);
     indent();
-    out_ << stmt->name.lexeme << " = " << evaluate(stmt->initializer) << ";\n";
+    out_ << stmt->name.lexeme << " = " << value << ";\n";
     return {};
 }
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<InputStmt> stmt) {
-    out_ << "readln(" << stmt->variable->name.lexeme << ");\n";
+    const std::string& name = stmt->variable->name.lexeme;
+    if (options_.fastIO) {
+        // Strings keep line-oriented readln; other basic types use the token reader.
+        if (const Token* type = lookupVariableType(name)) {
+            std::string reader;
+            switch (type->type) {
+                case TokenType::INTEGER: reader = "_GateReadInteger"; break;
+                case TokenType::REAL: reader = "_GateReadReal"; break;
+                case TokenType::CHARACTER: reader = "_GateReadChar"; break;
+                case TokenType::BOOLEAN: reader = "_GateReadBoolean"; break;
+                default: break;
+            }
+            if (!reader.empty()) {
+                out_ << reader << "(" << name << ");\n";
+                return {};
+            }
+        }
+    }
+    out_ << "readln(" << name << ");\n";
     return {};
 }
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<AlgoritmaStmt> stmt) {
+    bool isMain = stmt == mainAlgoritma_;
     out_ << "begin\n";
     indentLevel_++;
+    if (isMain) generateMainPrologue();
+    if (!isMain && currentProfileId_ >= 0) {
+        indent();
+        out_ << "_GateProfileEnter(" << currentProfileId_ << ");\n";
+    }
+    if (!isMain && options_.profile != BuildProfile::RELEASE) {
+        // Constrained input parameters are checked on entry, like the setters of constrained variables
+        for (const auto& param : constrainedParams_) {
+            indent();
+            out_ << "Assert(" << evaluate(param.constraint) << ", 'Error: " << param.name.lexeme << " constraint violation!');\n";
+        }
+    }
     execute(stmt->body);
+    if (!isMain && currentProfileId_ >= 0) {
+        indent();
+        out_ << "_GateProfileLeave(" << currentProfileId_ << ");\n";
+    }
+    if (isMain) generateMainEpilogue();
     indentLevel_--;
     indent();
     out_ << "end";
@@ -474,8 +1801,22 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<AlgoritmaStmt> stmt) {
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<BlockStmt> stmt) {
     for (const auto& statement : stmt->statements) {
+        auto id = statementIds_.find(statement.get());
+        if (id != statementIds_.end()) {
+            indent();
+            out_ << "Inc(_GateHits[" << id->second << "]);\n";
+        }
+        bool unchecked = rangeSafeStatements_.count(statement.get()) > 0;
+        if (unchecked) {
+            indent();
+            out_ << "{$R-}\n";
+        }
         indent();
         execute(statement);
+        if (unchecked) {
+            indent();
+            out_ << "{$R+}\n";
+        }
     }
     return {};
 }
@@ -529,7 +1870,23 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<Binary> expr) {
     }
 
     std::string op = expr->op.lexeme;
-    if (expr->op.type == TokenType::AMPERSAND) op = "+";
+    if (expr->op.type == TokenType::AMPERSAND) {
+        // A chain of two or more `&` becomes one Concat call, so the result is
+        // built in a single pass instead of through a temporary per operator.
+        // FPC also appends in place when the target is the first operand, which
+        // keeps `s <- s & a & b` accumulation loops linear.
+        std::vector<std::shared_ptr<Expression>> operands;
+        collectConcatOperands(expr, operands);
+        if (operands.size() > 2) {
+            std::string args;
+            for (const auto& operand : operands) {
+                if (!args.empty()) args += ", ";
+                args += evaluate(operand);
+            }
+            return "Concat(" + args + ")";
+        }
+        op = "+";
+    }
     return "(" + evaluate(expr->left) + " " + op + " " + evaluate(expr->right) + ")";
 }
 
@@ -574,9 +1931,51 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<Literal> expr) {
 }
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<ArrayAccess> expr) {
-    std::string result = evaluate(expr->callee) + "[";
+    std::string callee = evaluate(expr->callee);
+    if (std::dynamic_pointer_cast<Variable>(expr->callee) && isFlatArray(callee)) {
+        // Row-major offset: ((i0 * e1 + i1) * e2 + i2) ...
+        std::string offset;
+        for (size_t i = 0; i < expr->indices.size(); ++i) {
+            std::string extent = "_GateExt_" + callee + "[" + std::to_string(i) + "]";
+            std::string index = evaluate(expr->indices[i]);
+            if (options_.profile == BuildProfile::CHECKED) {
+                index = "_GateCheckIndex(" + index + ", " + extent + ", '" + callee + "')";
+            }
+            offset = i == 0 ? index : "(" + offset + ") * " + extent + " + " + index;
+        }
+        return callee + "[" + offset + "]";
+    }
+    bool checked = false;
+    std::string arrayName;
+    if (options_.profile == BuildProfile::CHECKED) {
+        // Covers both a[i, j] and a[i][j] on a dynamic array variable.
+        auto base = expr->callee;
+        bool repeatable = true;
+        while (auto inner = std::dynamic_pointer_cast<ArrayAccess>(base)) {
+            for (const auto& index : inner->indices) repeatable = repeatable && isRepeatable(index);
+            base = inner->callee;
+        }
+        if (auto var = std::dynamic_pointer_cast<Variable>(base)) {
+            checked = repeatable && dynamicArrayDimensions_.count(var->name.lexeme) > 0;
+            arrayName = var->name.lexeme;
+        }
+    }
+
+    std::string result = callee + "[";
+    std::string row = callee;
     for (size_t i = 0; i < expr->indices.size(); ++i) {
-        result += evaluate(expr->indices[i]);
+        std::string index = evaluate(expr->indices[i]);
+        if (checked) {
+            std::string length = "Length(" + row + ")";
+            if (i == 0 && row == arrayName && isGrownArray(arrayName)) length = "_GateLen_" + arrayName;
+            result += "_GateCheckIndex(" + index + ", " + length + ", '" + arrayName + "')";
+            row += "[" + index + "]";
+            // The row names every index so far; one with a call or assignment must not run twice,
+            // so the remaining dimensions are left to {$R+}.
+            checked = isRepeatable(expr->indices[i]);
+        } else {
+            result += index;
+        }
         if (i < expr->indices.size() - 1) {
             result += ", ";
         }
@@ -760,6 +2159,27 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<TraversalStmt> stmt) {
     std::string step = "1";
     if (stmt->step) step = evaluate(stmt->step);
 
+    for (const auto& plan : parallelTraversals_) {
+        if (plan.traversal != stmt) continue;
+        // Workers run the chunks; reductions are summed after the join
+        std::string worker = "_GateParallel" + std::to_string(plan.id);
+        out_ << "_GateParBegin(" << start << ", " << end << ", " << step << ");\n";
+        indent();
+        out_ << "_GateParRun(@" << worker << ");\n";
+        for (const auto& name : plan.reductions) {
+            indent();
+            out_ << "for _GateParK := 0 to _GateParWorkers - 1 do " << name << " := " << name << " + "
+                 << worker << "_" << name << "[_GateParK];\n";
+        }
+        indent();
+        out_ << iterator << " := _GateParNext;\n";
+        return {};
+    }
+    if (stmt->parallel) {
+        auto reason = sequentialTraversals_.find(stmt.get());
+        if (reason != sequentialTraversals_.end()) out_ << "{ traversal paralel runs sequentially: " << reason->second << " }\n";
+    }
+
     indent();
     out_ << iterator << " := " << start << ";\n";
     indent();
@@ -791,7 +2211,177 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<IterateStopStmt> stmt) {
     return {};
 }
 
+/**
+ * @brief Finds the statements whose static array indexing needs no range check
+ *
+ * Inside `i traversal [a..b]` with constant bounds, an index `i + c` into a
+ * static array dimension `[lo..hi]` is in range when lo <= a + c and
+ * b + c <= hi. The iterator must not be written in the loop body, nor be a
+ * global that any subprogram writes. A simple statement (expression,
+ * output, return) qualifies when every array access in it is proven in
+ * range this way, so wrapping it in {$R-}...{$R+} only drops checks that
+ * can never fire.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::selectRangeCheckElisions(std::shared_ptr<ProgramStmt> program) {
+    std::map<std::string, long long> globalConstants;
+    StaticBounds globalArrays;
+    addStaticScope(program->kamus, {}, globalConstants, globalArrays);
+
+    std::vector<std::pair<std::shared_ptr<Statement>, std::set<std::string>>> subprograms;
+    for (const auto& sub : program->subprograms) {
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) {
+            subprograms.push_back({sub, declaredNames(proc->params, proc->kamus)});
+        } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) {
+            subprograms.push_back({sub, declaredNames(func->params, func->kamus)});
+        }
+    }
+    auto writtenBySubprogram = [&](const std::string& name) {
+        for (const auto& [sub, names] : subprograms) {
+            if (!names.count(name) && isParameterModified(name, sub)) return true;
+        }
+        return false;
+    };
+
+    using Ranges = std::map<std::string, std::pair<long long, long long>>;
+    auto scanScope = [&](const std::shared_ptr<Statement>& body, const std::set<std::string>& locals,
+                         const std::map<std::string, long long>& constants, const StaticBounds& arrays) {
+        auto inRange = [&](const std::shared_ptr<ArrayAccess>& access, const Ranges& ranges) {
+            auto var = std::dynamic_pointer_cast<Variable>(access->callee);
+            if (!var) return false;
+            auto array = arrays.find(var->name.lexeme);
+            if (array == arrays.end() || array->second.size() != access->indices.size()) return false;
+            for (size_t i = 0; i < access->indices.size(); ++i) {
+                std::string variable;
+                long long offset = 0;
+                if (!affineIndex(access->indices[i], constants, variable, offset)) return false;
+                long long low = offset, high = offset;
+                if (!variable.empty()) {
+                    auto range = ranges.find(variable);
+                    if (range == ranges.end()) return false;
+                    low += range->second.first;
+                    high += range->second.second;
+                }
+                if (low < array->second[i].first || high > array->second[i].second) return false;
+            }
+            return true;
+        };
+
+        std::function<void(const std::shared_ptr<Statement>&, const Ranges&)> scan =
+            [&](const std::shared_ptr<Statement>& root, const Ranges& ranges) {
+            walkStatement(root, [&](const std::shared_ptr<Statement>& stmt) {
+                if (stmt == root) return true;
+                if (auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt)) {
+                    Ranges inner = ranges;
+                    const std::string& it = traversal->iterator.lexeme;
+                    inner.erase(it);
+                    long long low = 0, high = 0, step = 1;
+                    bool bounded = constantValue(traversal->start, constants, low) &&
+                                   constantValue(traversal->end, constants, high) &&
+                                   (!traversal->step || (constantValue(traversal->step, constants, step) && step > 0));
+                    if (bounded && !isParameterModified(it, traversal->body) &&
+                        (locals.count(it) || !writtenBySubprogram(it))) {
+                        inner[it] = {low, high};
+                    }
+                    scan(traversal->body, inner);
+                    return false;
+                }
+                if (!std::dynamic_pointer_cast<ExpressionStmt>(stmt) && !std::dynamic_pointer_cast<OutputStmt>(stmt) &&
+                    !std::dynamic_pointer_cast<ReturnStmt>(stmt)) {
+                    return true;
+                }
+                if (ranges.empty()) return false;
+                bool any = false, safe = true;
+                walkStatement(stmt, {}, [&](const std::shared_ptr<Expression>& expr) {
+                    if (auto access = std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+                        any = true;
+                        if (!inRange(access, ranges)) safe = false;
+                    }
+                });
+                if (any && safe) rangeSafeStatements_.insert(stmt.get());
+                return false;
+            }, {});
+        };
+        scan(body, {});
+    };
+
+    scanScope(program->algoritma, {}, globalConstants, globalArrays);
+    for (const auto& sub : program->subprograms) {
+        std::shared_ptr<KamusStmt> kamus;
+        std::set<std::string> locals;
+        for (const auto& [body, names] : subprograms) {
+            if (body == sub) locals = names;
+        }
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) kamus = proc->kamus;
+        else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) kamus = func->kamus;
+        auto constants = globalConstants;
+        auto arrays = globalArrays;
+        addStaticScope(kamus, locals, constants, arrays);
+        scanScope(sub, locals, constants, arrays);
+    }
+}
+
+/**
+ * @brief Gets the literal trip count of a repeat loop that may be unrolled
+ *
+ * A loop qualifies when unrolling is enabled, its count is an integer
+ * literal, and its body is small (at most UNROLL_BODY_LIMIT AST nodes),
+ * contains no stop or skip (which would leave the loop from a copy) and
+ * no nested repeat (whose iterator would be needed once per copy).
+ *
+ * @param stmt The repeat statement
+ * @return int The trip count, or -1 when the loop is emitted as is
+ */
+int PascalCodeGenerator::unrollableCount(std::shared_ptr<RepeatNTimesStmt> stmt) const {
+    if (options_.unrollFactor < 2) return -1;
+    auto literal = std::dynamic_pointer_cast<Literal>(stmt->times);
+    if (!literal || literal->value.type() != typeid(int)) return -1;
+
+    int nodes = 0;
+    bool eligible = true;
+    walkStatement(stmt->body, [&](const std::shared_ptr<Statement>& inner) {
+        if (std::dynamic_pointer_cast<StopStmt>(inner) || std::dynamic_pointer_cast<SkipStmt>(inner) ||
+            std::dynamic_pointer_cast<RepeatNTimesStmt>(inner)) {
+            eligible = false;
+        }
+        if (!std::dynamic_pointer_cast<BlockStmt>(inner)) nodes++;
+        return eligible;
+    }, [&](const std::shared_ptr<Expression>&) {
+        nodes++;
+    });
+    if (!eligible || nodes > UNROLL_BODY_LIMIT) return -1;
+    return std::max(0, std::any_cast<int>(literal->value));
+}
+
 std::any PascalCodeGenerator::visit(std::shared_ptr<RepeatNTimesStmt> stmt) {
+    int times = unrollableCount(stmt);
+    int factor = options_.unrollFactor;
+    if (times >= 0 && times <= factor) {
+        // Full unroll: one copy of the body per iteration, no loop at all
+        out_ << "begin\n";
+        indentLevel_++;
+        for (int i = 0; i < times; ++i) execute(stmt->body);
+        indentLevel_--;
+        indent();
+        out_ << "end;\n";
+        return {};
+    }
+    if (times > factor) {
+        // Partial unroll: factor copies per trip, then the remainder straight-line
+        std::string iterator = loopVariables_[loopCounter_++];
+        out_ << "for " << iterator << " := 1 to " << times / factor << " do\n";
+        indent();
+        out_ << "begin\n";
+        indentLevel_++;
+        for (int i = 0; i < factor; ++i) execute(stmt->body);
+        indentLevel_--;
+        indent();
+        out_ << "end;\n";
+        for (int i = 0; i < times % factor; ++i) execute(stmt->body);
+        return {};
+    }
+
     std::string iterator = loopVariables_[loopCounter_++];
     indent();
     out_ << "for " << iterator << " := 1 to " << evaluate(stmt->times) << " do\n";
@@ -819,15 +2409,57 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<SkipStmt> stmt) {
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<Call> expr) {
     std::string callee = evaluate(expr->callee);
+    if (expr->arguments.size() == 1) {
+        // length()/high() of an amortized-growth array report its logical length.
+        auto array = std::dynamic_pointer_cast<Variable>(expr->arguments[0]);
+        std::string fn = callee;
+        std::transform(fn.begin(), fn.end(), fn.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (array && isGrownArray(array->name.lexeme)) {
+            if (fn == "length") return "_GateLen_" + array->name.lexeme;
+            if (fn == "high") return "(_GateLen_" + array->name.lexeme + " - 1)";
+        }
+        if (array && isFlatArray(array->name.lexeme)) {
+            if (fn == "length") return "_GateExt_" + array->name.lexeme + "[0]";
+            if (fn == "high") return "(_GateExt_" + array->name.lexeme + "[0] - 1)";
+        }
+        // Every field array of a struct-of-arrays has the same extent.
+        auto record = array ? soaRecord(array->name.lexeme) : nullptr;
+        if (record && (fn == "length" || fn == "high")) {
+            return callee + "(" + array->name.lexeme + "_" + record->fields[0].name.lexeme + ")";
+        }
+    }
     std::string args;
     for (size_t i = 0; i < expr->arguments.size(); ++i) {
         args += evaluate(expr->arguments[i]);
         if (i < expr->arguments.size() - 1) args += ", ";
     }
+    if (options_.constEval && evaluator_ && evaluator_->isFunction(callee) && !localNames_.count(callee) &&
+        evaluator_->readsOnlyConstants(expr, localNames_)) {
+        std::string reason;
+        std::string value = foldConstantCall(expr, reason);
+        if (!value.empty()) return value;
+        noteConstEvalFallback(expr->paren, "Call to '" + callee + "'", reason);
+        return callee + "(" + args + ") { const-eval: " + reason + " }";
+    }
+    // A constrained parameter is checked on entry outside release, so those calls stay
+    auto table = tabulatedFunctions_.find(callee);
+    if (table != tabulatedFunctions_.end() && expr->arguments.size() == 1 && !localNames_.count(callee) &&
+        (!table->second.constrained || options_.profile == BuildProfile::RELEASE)) {
+        return "_GateTab_" + callee + "[" + args + "]";
+    }
     return callee + "(" + args + ")";
 }
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<FieldAccess> expr) {
+    // a[i].f on a struct-of-arrays becomes a_f[i]
+    if (auto access = std::dynamic_pointer_cast<ArrayAccess>(expr->object)) {
+        auto array = std::dynamic_pointer_cast<Variable>(access->callee);
+        if (array && soaRecord(array->name.lexeme)) {
+            Token fieldArray = array->name;
+            fieldArray.lexeme += "_" + expr->name.lexeme;
+            return evaluate(std::make_shared<ArrayAccess>(std::make_shared<Variable>(fieldArray), access->bracket, access->indices));
+        }
+    }
     return evaluate(expr->object) + "." + expr->name.lexeme;
 }
 
@@ -836,12 +2468,30 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<FieldAssign> expr) {
 }
 
 std::any PascalCodeGenerator::visit(std::shared_ptr<RecordTypeDeclStmt> stmt) {
+    std::vector<RecordTypeDeclStmt::Field> fields = stmt->fields;
+    if (options_.recordLayout == RecordLayout::REORDERED) {
+        std::stable_sort(fields.begin(), fields.end(), [this](const auto& a, const auto& b) {
+            return estimatedTypeAlignment(a.type) > estimatedTypeAlignment(b.type);
+        });
+    }
+    bool reordered = false;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].name.lexeme != stmt->fields[i].name.lexeme) reordered = true;
+    }
+
     indent();
-    out_ << stmt->typeName.lexeme << " = record\n";
+    out_ << stmt->typeName.lexeme << " = " << (options_.recordLayout == RecordLayout::PACKED ? "packed " : "") << "record\n";
     indentLevel_++;
-    for (const auto& field : stmt->fields) {
+    if (reordered) {
+        // Keep the NOTAL field order visible next to the reordered layout
+        indent();
+        out_ << "{ declared order:";
+        for (const auto& field : stmt->fields) out_ << " " << field.name.lexeme;
+        out_ << " }\n";
+    }
+    for (const auto& field : fields) {
         indent();
-        out_ << field.name.lexeme << ": " << pascalType(field.type) << ";\n";
+        out_ << field.name.lexeme << ": " << fieldPascalType(field) << ";\n";
     }
     indentLevel_--;
     indent();
@@ -871,34 +2521,230 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<ConstrainedVarDeclStmt> stmt
     return {};
 }
 
-void PascalCodeGenerator::generateParameterList(const std::vector<Parameter>& params) {
+void PascalCodeGenerator::generateParameterList(const std::vector<Parameter>& params, std::shared_ptr<AlgoritmaStmt> body) {
     out_ << "(";
     for (size_t i = 0; i < params.size(); ++i) {
         const auto& p = params[i];
-        switch (p.mode) {
-            case ParameterMode::INPUT: break;
-            case ParameterMode::OUTPUT:
-            case ParameterMode::INPUT_OUTPUT: out_ << "var "; break;
-        }
+        out_ << parameterModifier(p, body);
         out_ << p.name.lexeme << ": " << pascalType(p.type);
         if (i < params.size() - 1) out_ << "; ";
     }
     out_ << ")";
 }
 
+/**
+ * @brief Chooses how a parameter is passed in the generated Pascal code
+ *
+ * Output and input/output parameters are always `var`. Input parameters of
+ * scalar types stay by-value. Input strings and records are passed as `const`
+ * (or `constref` for records larger than two machine words) so calls do not
+ * copy the whole value. A parameter the body writes to keeps by-value
+ * passing, which already gives the subprogram its own local copy.
+ *
+ * @param param The parameter declaration
+ * @param body Body of the subprogram owning the parameter
+ * @return std::string Modifier followed by a space, or empty for by-value
+ */
+std::string PascalCodeGenerator::parameterModifier(const Parameter& param, std::shared_ptr<AlgoritmaStmt> body) {
+    if (param.mode != ParameterMode::INPUT) return "var ";
+
+    bool isString = param.type.type == TokenType::STRING;
+    bool isRecord = param.type.type == TokenType::IDENTIFIER && recordTypes_.count(param.type.lexeme);
+    if (!isString && !isRecord) return "";
+    if (isParameterModified(param.name.lexeme, body)) return "";
+
+    if (isRecord && estimatedTypeSize(param.type) > 16) return "constref ";
+    return "const ";
+}
+
+/**
+ * @brief Estimates the size of a NOTAL type as laid out by Free Pascal
+ *
+ * @param type Type token (basic type or record/enum identifier)
+ * @param depth Current record nesting depth, used to stop on recursive types
+ * @return int Approximate size in bytes
+ */
+int PascalCodeGenerator::estimatedTypeSize(const Token& type, int depth) {
+    switch (type.type) {
+        case TokenType::BOOLEAN:
+        case TokenType::CHARACTER: return 1;
+        case TokenType::INTEGER: return 2;
+        case TokenType::REAL: return 8;
+        case TokenType::STRING: return 256;
+        case TokenType::IDENTIFIER: {
+            auto it = recordTypes_.find(type.lexeme);
+            if (it == recordTypes_.end() || depth > 8) return 4;
+            int size = 0;
+            for (const auto& field : it->second->fields) {
+                size += estimatedTypeSize(field.type, depth + 1);
+            }
+            return size;
+        }
+        default: return sizeof(void*);
+    }
+}
+
+/**
+ * @brief Gets the Pascal type of a record field
+ *
+ * @param field Record field
+ * @return std::string Pascal type, with `^` for pointer fields
+ */
+std::string PascalCodeGenerator::fieldPascalType(const RecordTypeDeclStmt::Field& field) {
+    if (field.type.type == TokenType::POINTER) return "^" + pascalType(field.pointedToType);
+    return pascalType(field.type);
+}
+
+/**
+ * @brief Emits the per-field arrays that replace an array of records (--soa)
+ *
+ * `a, b: array[1..n] of T` with fields f and g becomes `a_f, b_f` and
+ * `a_g, b_g` declarations with the same shape. Like any variable
+ * declaration, the final `;` is left to the caller.
+ *
+ * @param names Array names
+ * @param record Element record type
+ * @param shape Array type prefix, such as `array[1..n] of ` or `array of `
+ */
+void PascalCodeGenerator::generateSoaDeclaration(const std::vector<Token>& names, const RecordTypeDeclStmt& record, const std::string& shape) {
+    out_ << "{ struct-of-arrays: ";
+    for (size_t i = 0; i < names.size(); ++i) out_ << (i > 0 ? ", " : "") << names[i].lexeme;
+    out_ << " of " << record.typeName.lexeme << " }\n";
+    for (size_t f = 0; f < record.fields.size(); ++f) {
+        if (f > 0) out_ << ";\n";
+        indent();
+        for (size_t i = 0; i < names.size(); ++i) {
+            out_ << (i > 0 ? ", " : "") << names[i].lexeme << "_" << record.fields[f].name.lexeme;
+        }
+        out_ << ": " << shape << fieldPascalType(record.fields[f]);
+    }
+}
+
+/**
+ * @brief Estimates the alignment of a NOTAL type as laid out by Free Pascal
+ *
+ * ShortStrings are byte arrays and align to 1; a record aligns to its most
+ * aligned field. Integers are 16-bit in FPC's default mode.
+ *
+ * @param type Type token (basic type or record/enum identifier)
+ * @param depth Current record nesting depth, used to stop on recursive types
+ * @return int Alignment in bytes
+ */
+int PascalCodeGenerator::estimatedTypeAlignment(const Token& type, int depth) {
+    switch (type.type) {
+        case TokenType::BOOLEAN:
+        case TokenType::CHARACTER:
+        case TokenType::STRING: return 1;
+        case TokenType::INTEGER: return 2;
+        case TokenType::REAL: return 8;
+        case TokenType::IDENTIFIER: {
+            auto it = recordTypes_.find(type.lexeme);
+            if (it == recordTypes_.end() || depth > 8) return 4;
+            int alignment = 1;
+            for (const auto& field : it->second->fields) {
+                alignment = std::max(alignment, estimatedTypeAlignment(field.type, depth + 1));
+            }
+            return alignment;
+        }
+        default: return sizeof(void*);
+    }
+}
+
+/**
+ * @brief Checks whether a subprogram body may write to a parameter
+ *
+ * A parameter counts as modified when it is the root of an assignment
+ * target, is read into with input(), is allocated or deallocated, is used
+ * as a traversal iterator, has its address taken, or is passed to an
+ * output/input-output parameter of another subprogram or as the output
+ * argument of a casting routine such as IntegerToString.
+ *
+ * @param name Parameter name
+ * @param body Subprogram body, or any other statement subtree
+ * @return true if any write is found
+ */
+bool PascalCodeGenerator::isParameterModified(const std::string& name, std::shared_ptr<Statement> body) {
+    bool modified = false;
+    auto rootedAt = [&name](const std::shared_ptr<Expression>& expr) {
+        auto root = rootVariable(expr);
+        return root && root->name.lexeme == name;
+    };
+
+    walkStatement(body,
+        [&](const std::shared_ptr<Statement>& stmt) {
+            if (auto input = std::dynamic_pointer_cast<InputStmt>(stmt)) {
+                if (input->variable->name.lexeme == name) modified = true;
+            } else if (auto allocate = std::dynamic_pointer_cast<AllocateStmt>(stmt)) {
+                if (rootedAt(allocate->callee)) modified = true;
+            } else if (auto deallocate = std::dynamic_pointer_cast<DeallocateStmt>(stmt)) {
+                if (rootedAt(deallocate->callee)) modified = true;
+            } else if (auto traversal = std::dynamic_pointer_cast<TraversalStmt>(stmt)) {
+                if (traversal->iterator.lexeme == name) modified = true;
+            }
+            return !modified;
+        },
+        [&](const std::shared_ptr<Expression>& expr) {
+            if (auto assign = std::dynamic_pointer_cast<Assign>(expr)) {
+                if (rootedAt(assign->target)) modified = true;
+            } else if (auto fieldAssign = std::dynamic_pointer_cast<FieldAssign>(expr)) {
+                if (rootedAt(fieldAssign->target)) modified = true;
+            } else if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+                if (unary->op.type == TokenType::AT && rootedAt(unary->right)) modified = true;
+            } else if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+                auto callee = std::dynamic_pointer_cast<Variable>(call->callee);
+                if (!callee) return;
+                if (BUILTIN_CASTING_FUNCTIONS.count(callee->name.lexeme) && !call->arguments.empty()) {
+                    // A casting routine stores its result through its last (var) argument
+                    if (rootedAt(call->arguments.back())) modified = true;
+                    return;
+                }
+                auto it = subprogramParams_.find(callee->name.lexeme);
+                if (it == subprogramParams_.end()) return;
+                for (size_t i = 0; i < call->arguments.size() && i < it->second.size(); ++i) {
+                    if (it->second[i].mode != ParameterMode::INPUT && rootedAt(call->arguments[i])) modified = true;
+                }
+            }
+        });
+    return modified;
+}
+
 std::any PascalCodeGenerator::visit(std::shared_ptr<ProcedureStmt> stmt) {
     if (forwardDeclare_) {
         indent();
         out_ << "procedure " << stmt->name.lexeme;
-        generateParameterList(stmt->params);
-        out_ << "; forward;\n";
+        generateParameterList(stmt->params, stmt->body);
+        out_ << ";";
+        generateSubprogramDirectives(stmt->name.lexeme);
+        out_ << " forward;\n";
     } else {
         indent();
         out_ << "procedure " << stmt->name.lexeme;
-        generateParameterList(stmt->params);
-        out_ << ";\n";
+        generateParameterList(stmt->params, stmt->body);
+        out_ << ";";
+        generateSubprogramDirectives(stmt->name.lexeme);
+        out_ << "\n";
+        for (const auto& p : stmt->params) localVarTypes_[p.name.lexeme] = p.type;
+        collectVariableTypes(stmt->kamus, localVarTypes_, localPointerTargets_);
+        localNames_ = declaredNames(stmt->params, stmt->kamus);
+        localGrownArrays_ = subprogramGrownArrays_[stmt->name.lexeme];
+        localFlatArrays_ = subprogramFlatArrays_[stmt->name.lexeme];
+        localSoaArrays_ = subprogramSoaArrays_[stmt->name.lexeme];
         if (stmt->kamus) execute(stmt->kamus);
+        auto timer = std::find(profiledSubprograms_.begin(), profiledSubprograms_.end(), stmt->name.lexeme);
+        currentProfileId_ = timer == profiledSubprograms_.end() ? -1 : static_cast<int>(timer - profiledSubprograms_.begin());
+        constrainedParams_.clear();
+        for (const auto& p : stmt->params) {
+            if (p.constraint) constrainedParams_.push_back(p);
+        }
         execute(stmt->body);
+        localVarTypes_.clear();
+        localPointerTargets_.clear();
+        localNames_.clear();
+        localGrownArrays_.clear();
+        localFlatArrays_.clear();
+        localSoaArrays_.clear();
+        currentProfileId_ = -1;
+        constrainedParams_.clear();
         out_ << ";\n";
     }
     return {};
@@ -908,22 +2754,445 @@ std::any PascalCodeGenerator::visit(std::shared_ptr<FunctionStmt> stmt) {
     if (forwardDeclare_) {
         indent();
         out_ << "function " << stmt->name.lexeme;
-        generateParameterList(stmt->params);
-        out_ << ": " << pascalType(stmt->returnType) << "; forward;\n";
+        generateParameterList(stmt->params, stmt->body);
+        out_ << ": " << pascalType(stmt->returnType) << ";";
+        generateSubprogramDirectives(stmt->name.lexeme);
+        out_ << " forward;\n";
     } else {
+        // A memoized function's own body becomes _GateCalc_<name>; <name> is
+        // the memo wrapper, so recursive calls go through the table.
+        bool memoized = memoFunctions_.count(stmt->name.lexeme) > 0;
         indent();
-        out_ << "function " << stmt->name.lexeme;
-        generateParameterList(stmt->params);
-        out_ << ": " << pascalType(stmt->returnType) << ";\n";
+        out_ << "function " << (memoized ? "_GateCalc_" : "") << stmt->name.lexeme;
+        generateParameterList(stmt->params, stmt->body);
+        out_ << ": " << pascalType(stmt->returnType) << ";";
+        generateSubprogramDirectives(stmt->name.lexeme);
+        out_ << "\n";
+        for (const auto& p : stmt->params) localVarTypes_[p.name.lexeme] = p.type;
+        collectVariableTypes(stmt->kamus, localVarTypes_, localPointerTargets_);
+        localNames_ = declaredNames(stmt->params, stmt->kamus);
+        localGrownArrays_ = subprogramGrownArrays_[stmt->name.lexeme];
+        localFlatArrays_ = subprogramFlatArrays_[stmt->name.lexeme];
+        localSoaArrays_ = subprogramSoaArrays_[stmt->name.lexeme];
         if (stmt->kamus) execute(stmt->kamus);
-        currentFunctionName_ = stmt->name.lexeme;
+        auto timer = std::find(profiledSubprograms_.begin(), profiledSubprograms_.end(), stmt->name.lexeme);
+        currentProfileId_ = timer == profiledSubprograms_.end() ? -1 : static_cast<int>(timer - profiledSubprograms_.begin());
+        constrainedParams_.clear();
+        for (const auto& p : stmt->params) {
+            if (p.constraint) constrainedParams_.push_back(p);
+        }
+        currentFunctionName_ = memoized ? "_GateCalc_" + stmt->name.lexeme : stmt->name.lexeme;
         execute(stmt->body);
         currentFunctionName_ = "";
+        localVarTypes_.clear();
+        localPointerTargets_.clear();
+        localNames_.clear();
+        localGrownArrays_.clear();
+        localFlatArrays_.clear();
+        localSoaArrays_.clear();
+        currentProfileId_ = -1;
+        constrainedParams_.clear();
         out_ << ";\n";
+        if (memoized) generateMemoWrapper(stmt);
     }
     return {};
 }
 
+/**
+ * @brief Emits the memo tables of every memoized function
+ *
+ * Each function owns a key, an occupancy and a value array sized by the
+ * Memo runtime section's _GateMemoSize.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::generateMemoTables(std::shared_ptr<ProgramStmt> program) {
+    out_ << "var\n";
+    for (const auto& sub : program->subprograms) {
+        auto func = std::dynamic_pointer_cast<FunctionStmt>(sub);
+        if (!func || !memoFunctions_.count(func->name.lexeme)) continue;
+        const std::string& name = func->name.lexeme;
+        out_ << "  _GateMemoKeys_" << name << ": array[0.._GateMemoSize - 1] of Int64;\n";
+        out_ << "  _GateMemoUsed_" << name << ": array[0.._GateMemoSize - 1] of boolean;\n";
+        out_ << "  _GateMemoVals_" << name << ": array[0.._GateMemoSize - 1] of " << pascalType(func->returnType) << ";\n";
+    }
+    out_ << "\n";
+}
+
+/**
+ * @brief Emits the fill-on-miss wrapper of a memoized function
+ *
+ * The arguments are packed into one Int64 key. On a hit the stored value is
+ * returned; on a miss _GateCalc_<name> computes it and it is stored in a
+ * slot looked up again afterwards, because the recursive computation may
+ * have filled the slot found first. When the probe sequence is full the
+ * value is simply not cached.
+ *
+ * @param stmt Memoized function declaration
+ */
+void PascalCodeGenerator::generateMemoWrapper(std::shared_ptr<FunctionStmt> stmt) {
+    const std::string& name = stmt->name.lexeme;
+    std::string key, args;
+    for (size_t i = 0; i < stmt->params.size(); ++i) {
+        const std::string& param = stmt->params[i].name.lexeme;
+        key = i == 0 ? "Int64(Ord(" + param + "))" : "(" + key + " shl 32) xor (Int64(Ord(" + param + ")) and $FFFFFFFF)";
+        args += (i > 0 ? ", " : "") + param;
+    }
+
+    out_ << "\nfunction " << name;
+    generateParameterList(stmt->params, stmt->body);
+    out_ << ": " << pascalType(stmt->returnType) << ";\n";
+    out_ << "var\n";
+    out_ << "  _key: Int64;\n";
+    out_ << "  _slot: longint;\n";
+    out_ << "  _found: boolean;\n";
+    out_ << "  _value: " << pascalType(stmt->returnType) << ";\n";
+    out_ << "begin\n";
+    out_ << "  _key := " << key << ";\n";
+    out_ << "  _slot := _GateMemoSlot(_GateMemoKeys_" << name << ", _GateMemoUsed_" << name << ", _key, _found);\n";
+    out_ << "  if _found then\n";
+    out_ << "    _value := _GateMemoVals_" << name << "[_slot]\n";
+    out_ << "  else\n";
+    out_ << "  begin\n";
+    out_ << "    _value := _GateCalc_" << name << "(" << args << ");\n";
+    out_ << "    _slot := _GateMemoSlot(_GateMemoKeys_" << name << ", _GateMemoUsed_" << name << ", _key, _found);\n";
+    out_ << "    if (_slot >= 0) and not _found then\n";
+    out_ << "    begin\n";
+    out_ << "      _GateMemoKeys_" << name << "[_slot] := _key;\n";
+    out_ << "      _GateMemoUsed_" << name << "[_slot] := true;\n";
+    out_ << "      _GateMemoVals_" << name << "[_slot] := _value;\n";
+    out_ << "    end;\n";
+    out_ << "  end;\n";
+    out_ << "  " << name << " := _value;\n";
+    out_ << "end;\n";
+}
+
+/**
+ * @brief Chooses the functions that are replaced by a constant table
+ *
+ * Only active with --tabulate. A function qualifies when it takes one input
+ * parameter whose type has few values: a character, an enum, or an integer
+ * whose constraint bounds it to at most TABULATE_MAX_ENTRIES values. Its
+ * result for every value is then computed by the ConstantEvaluator, which
+ * also decides whether it is pure; when that fails, the reason is kept for
+ * a comment in the output.
+ *
+ * @param program Shared pointer to the root ProgramStmt AST node
+ */
+void PascalCodeGenerator::selectTabulatedFunctions(std::shared_ptr<ProgramStmt> program) {
+    if (!options_.tabulate) return;
+    for (const auto& sub : program->subprograms) {
+        auto func = std::dynamic_pointer_cast<FunctionStmt>(sub);
+        if (!func || func->params.size() != 1 || func->params[0].mode != ParameterMode::INPUT) continue;
+        const Parameter& param = func->params[0];
+        const auto* enumValues = param.type.type == TokenType::IDENTIFIER ? evaluator_->enumValues(param.type.lexeme) : nullptr;
+
+        TabulatedFunction table;
+        table.constrained = param.constraint != nullptr;
+        long long low = 0;
+        long long high = 0;
+        if (param.type.type == TokenType::CHARACTER) {
+            table.indexType = "char";
+            high = 255;
+        } else if (enumValues && !enumValues->empty()) {
+            table.indexType = param.type.lexeme;
+            high = static_cast<long long>(enumValues->size()) - 1;
+        } else if (param.type.type == TokenType::INTEGER && param.constraint && constraintRange(param, low, high) &&
+                   high - low < TABULATE_MAX_ENTRIES) {
+            table.indexType = std::to_string(low) + ".." + std::to_string(high);
+        } else {
+            continue;
+        }
+
+        std::vector<std::shared_ptr<Literal>> results;
+        std::string reason;
+        if (!evaluator_->tabulate(func->name.lexeme, low, high, results, reason)) {
+            untabulatedFunctions_.emplace_back(func->name.lexeme, reason);
+            continue;
+        }
+        table.elementType = pascalType(func->returnType);
+        for (const auto& result : results) {
+            // Typed constant lists take a bare negative number
+            std::string entry = foldedLiteral(result);
+            if (entry.front() == '(') entry = entry.substr(1, entry.size() - 2);
+            table.entries.push_back(entry);
+        }
+        tabulatedFunctions_[func->name.lexeme] = table;
+    }
+}
+
+/**
+ * @brief Gets the integer range a parameter constraint allows
+ *
+ * The constraint must be a conjunction of comparisons between the parameter
+ * and constant expressions, such as `(x >= 0) and (x <= 100)`.
+ *
+ * @param param Constrained integer parameter
+ * @param low Set to the smallest allowed value
+ * @param high Set to the largest allowed value
+ * @return true if the constraint has this shape and bounds both ends
+ */
+bool PascalCodeGenerator::constraintRange(const Parameter& param, long long& low, long long& high) {
+    auto strip = [](std::shared_ptr<Expression> expr) {
+        while (auto group = std::dynamic_pointer_cast<Grouping>(expr)) expr = group->expression;
+        return expr;
+    };
+    auto isParam = [&](std::shared_ptr<Expression> expr) {
+        auto var = std::dynamic_pointer_cast<Variable>(strip(expr));
+        return var && var->name.lexeme == param.name.lexeme;
+    };
+
+    bool hasLow = false;
+    bool hasHigh = false;
+    std::vector<std::shared_ptr<Expression>> terms = {param.constraint};
+    while (!terms.empty()) {
+        auto term = std::dynamic_pointer_cast<Binary>(strip(terms.back()));
+        terms.pop_back();
+        if (!term) return false;
+        if (term->op.type == TokenType::AND) {
+            terms.push_back(term->left);
+            terms.push_back(term->right);
+            continue;
+        }
+
+        // Read every comparison as `param <op> bound`
+        TokenType op = term->op.type;
+        std::shared_ptr<Expression> bound;
+        if (isParam(term->left)) {
+            bound = term->right;
+        } else if (isParam(term->right)) {
+            bound = term->left;
+            if (op == TokenType::LESS) op = TokenType::GREATER;
+            else if (op == TokenType::LESS_EQUAL) op = TokenType::GREATER_EQUAL;
+            else if (op == TokenType::GREATER) op = TokenType::LESS;
+            else if (op == TokenType::GREATER_EQUAL) op = TokenType::LESS_EQUAL;
+        } else {
+            return false;
+        }
+        std::string reason;
+        auto value = evaluator_->evaluate(bound, {param.name.lexeme}, reason);
+        if (!value || value->value.type() != typeid(int)) return false;
+        long long number = std::any_cast<int>(value->value);
+
+        if (op == TokenType::GREATER) number += 1;
+        if (op == TokenType::LESS) number -= 1;
+        bool lower = op == TokenType::GREATER || op == TokenType::GREATER_EQUAL || op == TokenType::EQUAL;
+        bool upper = op == TokenType::LESS || op == TokenType::LESS_EQUAL || op == TokenType::EQUAL;
+        if (!lower && !upper) return false;
+        if (lower) {
+            low = hasLow ? std::max(low, number) : number;
+            hasLow = true;
+        }
+        if (upper) {
+            high = hasHigh ? std::min(high, number) : number;
+            hasHigh = true;
+        }
+    }
+    return hasLow && hasHigh && low <= high;
+}
+
+/**
+ * @brief Emits the constant table of every tabulated function
+ *
+ * Functions that had the shape but could not be evaluated get a comment
+ * with the reason instead.
+ */
+void PascalCodeGenerator::generateTabulatedTables() {
+    for (const auto& [name, reason] : untabulatedFunctions_) {
+        out_ << "{ not tabulated: " << name << ": " << reason << " }\n";
+    }
+    if (!tabulatedFunctions_.empty()) {
+        out_ << "const\n";
+        for (const auto& [name, table] : tabulatedFunctions_) {
+            out_ << "  _GateTab_" << name << ": array[" << table.indexType << "] of " << table.elementType << " = (";
+            std::string line = "\n    ";
+            for (size_t i = 0; i < table.entries.size(); ++i) {
+                std::string entry = table.entries[i] + (i + 1 < table.entries.size() ? "," : "");
+                if (line.size() + entry.size() > 100) {
+                    out_ << line;
+                    line = "\n    ";
+                } else if (line.size() > 5) {
+                    line += " ";
+                }
+                line += entry;
+            }
+            out_ << line << ");\n";
+        }
+    }
+    if (!tabulatedFunctions_.empty() || !untabulatedFunctions_.empty()) out_ << "\n";
+}
+
+/**
+ * @brief Evaluates an expression that calls pure functions at transpile time
+ *
+ * Integers are checked against the width of `integer` in the generated
+ * program (16 bits in FPC's default mode), so a value is only folded when
+ * the compiled program would compute the same.
+ *
+ * @param expr Constant expression
+ * @param reason Set to why it was left as written, on failure
+ * @return The value as Pascal literal text, or "" on failure
+ */
+std::string PascalCodeGenerator::foldConstantCall(std::shared_ptr<Expression> expr, std::string& reason) {
+    auto value = evaluator_->evaluate(expr, localNames_, reason);
+    return value ? foldedLiteral(value) : "";
+}
+
+/**
+ * @brief Generates a static array bound
+ *
+ * Bounds must be constant in Pascal, so one that calls a function is
+ * evaluated here; if it cannot be, it is left as written with the reason.
+ */
+std::string PascalCodeGenerator::arrayBound(std::shared_ptr<Expression> bound, const core::Token& array) {
+    if (!evaluator_ || !evaluator_->callsFunction(bound)) return evaluate(bound);
+    std::string reason;
+    std::string value = foldConstantCall(bound, reason);
+    if (!value.empty()) return value;
+    noteConstEvalFallback(array, "Bound of array '" + array.lexeme + "'", reason);
+    return writtenAsIs(bound) + " { const-eval: " + reason + " }";
+}
+
+/**
+ * @brief Records a constant expression left as written
+ *
+ * The driver reports each one as a warning, so the fallback is explained
+ * at its line and not only in a comment of the generated code. A call
+ * generated twice (an inlined body, say) is recorded once.
+ */
+void PascalCodeGenerator::noteConstEvalFallback(const core::Token& at, const std::string& what, const std::string& reason) {
+    std::string message = what + " left as written: " + reason;
+    for (const auto& fallback : constEvalFallbacks_) {
+        if (fallback.line == at.line && fallback.column == at.column && fallback.message == message) return;
+    }
+    constEvalFallbacks_.push_back({at.line, at.column, message});
+}
+
+/**
+ * @brief Generates an expression whose evaluation already failed
+ *
+ * Keeps --const-eval from trying the calls in it a second time.
+ */
+std::string PascalCodeGenerator::writtenAsIs(std::shared_ptr<Expression> expr) {
+    bool constEval = options_.constEval;
+    options_.constEval = false;
+    std::string code = evaluate(expr);
+    options_.constEval = constEval;
+    return code;
+}
+
+/**
+ * @brief Spells a folded value as an exact Pascal literal
+ *
+ * Unlike the Literal visitor, reals keep every digit needed to read back
+ * the same double, strings have quotes doubled and control characters
+ * written as #N, and negative numbers are parenthesized so they can stand
+ * anywhere in an expression.
+ */
+std::string PascalCodeGenerator::foldedLiteral(std::shared_ptr<Literal> literal) const {
+    const std::any& value = literal->value;
+    if (value.type() == typeid(int)) {
+        int number = std::any_cast<int>(value);
+        return number < 0 ? "(" + std::to_string(number) + ")" : std::to_string(number);
+    }
+    if (value.type() == typeid(double)) {
+        double number = std::any_cast<double>(value);
+        std::string text;
+        for (int precision = 15; precision <= 17; ++precision) {
+            std::ostringstream digits;
+            digits << std::setprecision(precision) << number;
+            text = digits.str();
+            if (std::stod(text) == number) break;
+        }
+        if (text.find_first_of(".e") == std::string::npos) text += ".0";
+        return number < 0 ? "(" + text + ")" : text;
+    }
+    if (value.type() == typeid(bool)) return std::any_cast<bool>(value) ? "true" : "false";
+    std::string text = std::any_cast<std::string>(value);
+    std::string result;
+    bool quoted = false;
+    for (unsigned char c : text) {
+        if (c < 32 || c >= 127) {
+            if (quoted) result += "'";
+            quoted = false;
+            result += "#" + std::to_string(c);
+            continue;
+        }
+        if (!quoted) result += "'";
+        quoted = true;
+        result += c == '\'' ? std::string("''") : std::string(1, static_cast<char>(c));
+    }
+    if (quoted) result += "'";
+    return result.empty() ? "''" : result;
+}
+
+/**
+ * @brief Emits the worker function of every parallel traversal
+ *
+ * A worker runs the trips of its chunk (see the Parallel runtime section)
+ * and declares the loop iterator, nested iterators, repeat counters and
+ * reduction variables locally under their original names, so the body is
+ * emitted unchanged but shares none of them. Each worker leaves its partial
+ * sums in a per-worker array.
+ */
+void PascalCodeGenerator::generateParallelWorkers() {
+    for (const auto& plan : parallelTraversals_) {
+        std::string worker = "_GateParallel" + std::to_string(plan.id);
+
+        // The body goes to a side buffer first: the repeat counters it uses
+        // are only known once it has been generated.
+        std::stringstream body;
+        out_.swap(body);
+        int firstCounter = loopCounter_;
+        indentLevel_ = 2;
+        execute(plan.traversal->body);
+        indentLevel_ = 0;
+        out_.swap(body);
+
+        if (!plan.reductions.empty()) {
+            out_ << "var\n";
+            for (const auto& name : plan.reductions) {
+                out_ << "  " << worker << "_" << name << ": array[0.._GateParMaxWorkers - 1] of "
+                     << pascalType(*lookupVariableType(name)) << ";\n";
+            }
+            out_ << "\n";
+        }
+        out_ << "function " << worker << "(_GateArg: Pointer): PtrInt;\n";
+        out_ << "var\n";
+        out_ << "  _GateTrip, _GateFirst, _GateLast: longint;\n";
+        for (const auto& name : plan.privates) out_ << "  " << name << ": " << pascalType(*lookupVariableType(name)) << ";\n";
+        for (const auto& name : plan.reductions) out_ << "  " << name << ": " << pascalType(*lookupVariableType(name)) << ";\n";
+        for (int i = firstCounter; i < loopCounter_; ++i) out_ << "  " << loopVariables_[i] << ": integer;\n";
+        out_ << "begin\n";
+        out_ << "  _GateParChunk(PtrInt(_GateArg), _GateFirst, _GateLast);\n";
+        for (const auto& name : plan.reductions) out_ << "  " << name << " := 0;\n";
+        out_ << "  for _GateTrip := _GateFirst to _GateLast do\n";
+        out_ << "  begin\n";
+        out_ << "    " << plan.traversal->iterator.lexeme << " := _GateParStart + _GateTrip * _GateParStep;\n";
+        out_ << body.str();
+        out_ << "  end;\n";
+        for (const auto& name : plan.reductions) {
+            out_ << "  " << worker << "_" << name << "[PtrInt(_GateArg)] := " << name << ";\n";
+        }
+        out_ << "  " << worker << " := 0;\n";
+        out_ << "end;\n\n";
+    }
+}
+
+/**
+ * @brief Emits the directives that follow a subprogram heading
+ *
+ * Used for both the forward declaration and the implementation so the two
+ * headings stay identical. Currently only `inline` is emitted.
+ *
+ * @param name Subprogram name
+ */
+void PascalCodeGenerator::generateSubprogramDirectives(const std::string& name) {
+    if (inlineSubprograms_.count(name)) {
+        out_ << " inline;";
+    }
+}
+
 std::any PascalCodeGenerator::visit(std::shared_ptr<ReturnStmt> stmt) {
     if (currentFunctionName_.empty()) throw std::runtime_error("Return statement used outside of a function.");
     out_ << currentFunctionName_ << " := " << evaluate(stmt->value) << ";\n";
@@ -949,6 +3218,134 @@ std::string PascalCodeGenerator::generateConstraintCheck(std::shared_ptr<Constra
     return "(" + result + ")";
 }
 
+// --- Main Program Prologue/Epilogue ---
+
+/**
+ * @brief Emits FPC compiler directives for the selected build profile
+ *
+ * Directives are placed before the program header so that they apply to
+ * the whole file. The compiler mode is left at FPC's default, so a profile
+ * never changes what a program means: `integer` stays 16-bit and no
+ * identifier becomes reserved. BuildProfile::NONE emits nothing unless some
+ * subprogram is marked inline, which needs {$INLINE ON} to take effect.
+ */
+void PascalCodeGenerator::generateCompilerDirectives() {
+    std::string directives;
+    switch (options_.profile) {
+        case BuildProfile::NONE:
+            break;
+        case BuildProfile::RELEASE:
+            directives = "{$R-}{$Q-}{$C-}{$INLINE ON}{$OPTIMIZATION LEVEL3}";
+            break;
+        case BuildProfile::DEBUG:
+        case BuildProfile::CHECKED:
+            directives = "{$R+}{$Q+}{$C+}";
+            break;
+    }
+    if (!inlineSubprograms_.empty() && options_.profile != BuildProfile::RELEASE) {
+        directives += "{$INLINE ON}";
+    }
+    if (directives.empty()) return;
+    out_ << directives << "\n\n";
+}
+
+/**
+ * @brief Emits statements that run before the main program body
+ *
+ * Installs the large text buffers declared by the FastIO runtime section
+ * when --fast-io is enabled. Must run before any I/O on Input/Output.
+ */
+void PascalCodeGenerator::generateMainPrologue() {
+    if (options_.fastIO) {
+        indent();
+        out_ << "SetTextBuf(Input, _GateInBuf, SizeOf(_GateInBuf));\n";
+        indent();
+        out_ << "SetTextBuf(Output, _GateOutBuf, SizeOf(_GateOutBuf));\n";
+    }
+}
+
+/**
+ * @brief Emits statements that run after the main program body
+ *
+ * Flushes the enlarged output buffer once when --fast-io is enabled,
+ * releases the slabs of every allocation pool in one pass, and prints the
+ * --instrument=profile report.
+ */
+void PascalCodeGenerator::generateMainEpilogue() {
+    if (options_.fastIO) {
+        indent();
+        out_ << "Flush(Output);\n";
+    }
+    for (const auto& type : pooledTypes_) {
+        indent();
+        out_ << "_GatePoolRelease_" << type.first << ";\n";
+    }
+    if (options_.instrument == Instrumentation::PROFILE) {
+        indent();
+        out_ << "_GateProfileReport;\n";
+    }
+}
+
+/**
+ * @brief Emits the constant tables read by the Profile runtime section
+ *
+ * Each table has one trailing sentinel entry so it is never empty, since
+ * a program may have no subprograms (or, in principle, no statements).
+ */
+void PascalCodeGenerator::generateProfileTables() {
+    out_ << "const\n";
+    out_ << "  _GateStmtCount = " << statementLines_.size() << ";\n";
+    out_ << "  _GateStmtLines: array[0.._GateStmtCount] of integer = (";
+    for (int line : statementLines_) out_ << line << ", ";
+    out_ << "0);\n";
+    out_ << "  _GateSubCount = " << profiledSubprograms_.size() << ";\n";
+    out_ << "  _GateSubNames: array[0.._GateSubCount] of string = (";
+    for (const auto& name : profiledSubprograms_) out_ << "'" << name << "', ";
+    out_ << "'');\n\n";
+}
+
+/**
+ * @brief Emits a Pascal runtime support section
+ *
+ * Runtime sections are plain Pascal declarations (variables, procedures,
+ * functions) kept in src/runtime/[name].runtime.txt, in the same way casting
+ * helpers are kept in src/casting. They are emitted after the KAMUS so that
+ * user subprograms and the main program can call them without forward
+ * declarations.
+ *
+ * Sections that are instantiated per type use `<T>` as a placeholder for
+ * the NOTAL type name, which only appears inside identifiers, and `<V>`
+ * for the Pascal type of a value.
+ *
+ * @param name Runtime section name
+ * @param typeName Type substituted for `<T>` (empty for plain sections)
+ * @param valueType Pascal type substituted for `<V>`
+ *
+ * @throws std::runtime_error if the runtime file cannot be opened
+ */
+void PascalCodeGenerator::generateRuntimeSection(const std::string& name, const std::string& typeName,
+                                                 const std::string& valueType) {
+    std::string filePath = "src/runtime/" + name + ".runtime.txt";
+    std::ifstream file(filePath);
+    if (!file) {
+        throw std::runtime_error("Could not open runtime file: " + filePath);
+    }
+    if (typeName.empty()) {
+        out_ << file.rdbuf() << "\n";
+        return;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+    for (size_t pos = text.find("<T>"); pos != std::string::npos; pos = text.find("<T>", pos + typeName.size())) {
+        text.replace(pos, 3, typeName);
+    }
+    for (size_t pos = text.find("<V>"); pos != std::string::npos; pos = text.find("<V>", pos + valueType.size())) {
+        text.replace(pos, 3, valueType);
+    }
+    out_ << text << "\n";
+}
+
 // --- Casting Function Helpers ---
 
 /**
@@ -38,7 +38,7 @@ namespace gate::core {
         {TokenType::ELSE, "ELSE"}, {TokenType::ELIF, "ELIF"}, {TokenType::DEPEND, "DEPEND"},
         {TokenType::ON, "ON"}, {TokenType::OTHERWISE, "OTHERWISE"}, {TokenType::WHILE, "WHILE"},
         {TokenType::DO, "DO"}, {TokenType::REPEAT, "REPEAT"}, {TokenType::UNTIL, "UNTIL"},
-        {TokenType::TRAVERSAL, "TRAVERSAL"}, {TokenType::STEP, "STEP"}, {TokenType::ITERATE, "ITERATE"},
+        {TokenType::TRAVERSAL, "TRAVERSAL"}, {TokenType::PARALEL, "PARALEL"}, {TokenType::STEP, "STEP"}, {TokenType::ITERATE, "ITERATE"},
         {TokenType::STOP, "STOP"}, {TokenType::SKIP, "SKIP"}, {TokenType::TIMES, "TIMES"},
         {TokenType::PROCEDURE, "PROCEDURE"}, {TokenType::FUNCTION, "FUNCTION"}, {TokenType::INPUT, "INPUT"},
         {TokenType::OUTPUT, "OUTPUT"}, {TokenType::POINTER, "POINTER"}, {TokenType::TO, "TO"},
@@ -0,0 +1,149 @@
+/**
+ * @file Batch.cpp
+ * @brief Implementation of multi-file transpilation
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "driver/Batch.h"
+#include "driver/WorkStealingPool.h"
+#include "utils/SecureFileReader.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <ostream>
+
+namespace gate::driver {
+
+namespace {
+
+/** @brief Result of one file, filled in by a worker */
+struct FileResult {
+    bool done = false;
+    bool success = false;
+    std::string output;
+    /** @brief Why the file failed, when it failed before transpiling */
+    std::string error;
+    std::string report;
+};
+
+} // namespace
+
+bool expandInputs(const std::vector<std::string>& args, std::vector<std::string>& files, std::string& error) {
+    for (const auto& arg : args) {
+        if (arg.empty() || arg[0] != '@') {
+            files.push_back(arg);
+            continue;
+        }
+        std::ifstream list(arg.substr(1));
+        if (!list.is_open()) {
+            error = "Cannot open list file: " + arg.substr(1);
+            return false;
+        }
+        std::string line;
+        while (std::getline(list, line)) {
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') continue;
+            size_t last = line.find_last_not_of(" \t\r");
+            files.push_back(line.substr(first, last - first + 1));
+        }
+    }
+    return true;
+}
+
+std::string batchOutputPath(const std::string& input, const BatchOptions& options) {
+    std::string name = std::filesystem::path(input).stem().string() + outputExtension(options.target);
+    return (std::filesystem::path(options.outDir) / name).string();
+}
+
+BatchSummary runBatch(const std::vector<std::string>& files, const BatchOptions& options, std::ostream& out,
+                      std::ostream& err) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<FileResult> results(files.size());
+    std::mutex mutex;
+    std::condition_variable ready;
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.outDir, ec);
+
+    BatchSummary summary;
+    summary.files = files.size();
+    {
+        WorkStealingPool pool(options.jobs);
+        summary.jobs = pool.size();
+
+        // Two inputs with the same stem would race for one output file.
+        std::map<std::string, size_t> outputs;
+        for (size_t i = 0; i < files.size(); ++i) {
+            std::string output = batchOutputPath(files[i], options);
+            auto claimed = outputs.emplace(output, i);
+            if (!claimed.second) {
+                results[i].error = "Output " + output + " is already written for " + files[claimed.first->second];
+            } else if (ec) {
+                results[i].error = "Cannot create output directory " + options.outDir + ": " + ec.message();
+            } else if (!isValidOutputPath(output, options.target)) {
+                results[i].error = "Invalid or potentially unsafe output file path: " + output;
+            }
+            if (!results[i].error.empty()) {
+                results[i].done = true;
+                continue;
+            }
+
+            pool.submit([&, i, output] {
+                FileResult result;
+                result.output = output;
+                auto readResult = utils::SecureFileReader::readFile(files[i]);
+                if (!readResult.success) {
+                    result.error = readResult.errorMessage;
+                } else {
+                    TranspileResult transpiled =
+                        transpileCached(options.cache, readResult.content, files[i], options.codeGen, options.target);
+                    result.report = std::move(transpiled.report);
+                    if (transpiled.success) {
+                        std::ofstream outFile(output, std::ios::binary);
+                        outFile << transpiled.code;
+                        result.success = static_cast<bool>(outFile.flush());
+                        if (!result.success) result.error = "Unable to open output file for writing: " + output;
+                    }
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                result.done = true;
+                results[i] = std::move(result);
+                ready.notify_all();
+            });
+        }
+
+        for (size_t i = 0; i < files.size(); ++i) {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&] { return results[i].done; });
+            FileResult result = std::move(results[i]);
+            lock.unlock();
+
+            if (result.success) {
+                ++summary.succeeded;
+                if (!options.quiet) out << files[i] << " -> " << result.output << "\n";
+            } else {
+                ++summary.failed;
+                err << files[i] << ": failed" << (result.error.empty() ? "" : ": " + result.error) << "\n";
+            }
+            err << result.report;
+        }
+        pool.wait();
+    }
+
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    out << "Transpiled " << summary.succeeded << " of " << summary.files << " files";
+    if (summary.failed > 0) out << " (" << summary.failed << " failed)";
+    out << " in " << std::fixed << std::setprecision(3) << summary.seconds << " s, " << std::setprecision(1)
+        << (summary.seconds > 0 ? summary.files / summary.seconds : 0.0) << " files/s on " << summary.jobs
+        << (summary.jobs == 1 ? " thread" : " threads") << "\n";
+    if (options.cache) out << options.cache->stats().describe() << "\n";
+    out.flush();
+    return summary;
+}
+
+} // namespace gate::driver
@@ -0,0 +1,476 @@
+/**
+ * @file Cache.cpp
+ * @brief Implementation of the transpilation result cache
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "driver/Cache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+
+namespace gate::driver {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint64_t PRIME1 = 11400714785074694791ull;
+constexpr uint64_t PRIME2 = 14029467366897019727ull;
+constexpr uint64_t PRIME3 = 1609587929392839161ull;
+constexpr uint64_t PRIME4 = 9650029242287828579ull;
+constexpr uint64_t PRIME5 = 2870177450012600261ull;
+
+/** @brief First line of every entry; bump it when the entry layout changes */
+const std::string ENTRY_MAGIC = "GATECACHE1\n";
+
+/** @brief Directories the code generators read their templates from, relative to the working directory */
+const char* const TEMPLATE_DIRECTORIES[] = {"src/runtime", "src/casting"};
+
+/** @brief Temporary files older than this were left by a process that died mid-write */
+constexpr auto STALE_TEMP_AGE = std::chrono::hours(1);
+
+uint64_t rotateLeft(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+
+uint64_t read64(const unsigned char* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) value = (value << 8) | p[i];
+    return value;
+}
+
+uint32_t read32(const unsigned char* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+uint64_t mixRound(uint64_t accumulator, uint64_t input) {
+    accumulator += input * PRIME2;
+    return rotateLeft(accumulator, 31) * PRIME1;
+}
+
+uint64_t mergeRound(uint64_t hash, uint64_t accumulator) {
+    hash ^= mixRound(0, accumulator);
+    return hash * PRIME1 + PRIME4;
+}
+
+/** @brief The GATE version and the size and time of the running executable, so every rebuild gets fresh keys */
+const std::string& buildIdentity() {
+    static const std::string identity = [] {
+        std::string id = GATE_VERSION;
+        std::error_code ec;
+        fs::path executable = fs::read_symlink("/proc/self/exe", ec);
+        if (ec) return id;
+        auto size = fs::file_size(executable, ec);
+        if (ec) return id;
+        auto time = fs::last_write_time(executable, ec);
+        if (ec) return id;
+        return id + "|" + std::to_string(size) + "|" + std::to_string(time.time_since_epoch().count());
+    }();
+    return identity;
+}
+
+/** @brief Every code generation option; a new option must be added here or results would be shared across it */
+std::string describeOptions(const transpiler::CodeGenOptions& options, Target target) {
+    std::ostringstream out;
+    out << "target=" << static_cast<int>(target) << " profile=" << static_cast<int>(options.profile)
+        << " inline=" << options.inlineThreshold << " alloc=" << static_cast<int>(options.alloc)
+        << " flat=" << options.flatArrays << " unroll=" << options.unrollFactor
+        << " instrument=" << static_cast<int>(options.instrument)
+        << " layout=" << static_cast<int>(options.recordLayout) << " soa=" << options.soa << " memo=" << options.memo
+        << " const-eval=" << options.constEval << " tabulate=" << options.tabulate << " fast-io=" << options.fastIO;
+    return out.str();
+}
+
+void putField(std::string& out, const std::string& value) {
+    out += std::to_string(value.size());
+    out += ':';
+    out += value;
+    out += '\n';
+}
+
+void putNumber(std::string& out, uint64_t value) { putField(out, std::to_string(value)); }
+
+/**
+ * @brief Reads the fields written by putField in order
+ */
+class FieldReader {
+public:
+    explicit FieldReader(const std::string& data, size_t start) : data_(data), pos_(start) {}
+
+    bool next(std::string& value) {
+        size_t colon = data_.find(':', pos_);
+        if (colon == std::string::npos || colon == pos_ || colon - pos_ > 20) return false;
+        uint64_t size = 0;
+        for (size_t i = pos_; i < colon; ++i) {
+            if (data_[i] < '0' || data_[i] > '9') return false;
+            size = size * 10 + static_cast<uint64_t>(data_[i] - '0');
+        }
+        if (size > data_.size() - colon - 1 || colon + 1 + size >= data_.size() || data_[colon + 1 + size] != '\n') {
+            return false;
+        }
+        value.assign(data_, colon + 1, size);
+        pos_ = colon + 2 + size;
+        return true;
+    }
+
+    bool nextNumber(uint64_t& value) {
+        std::string text;
+        if (!next(text) || text.empty() || text.size() > 19) return false;
+        value = 0;
+        for (char c : text) {
+            if (c < '0' || c > '9') return false;
+            value = value * 10 + static_cast<uint64_t>(c - '0');
+        }
+        return true;
+    }
+
+    bool atEnd() const { return pos_ == data_.size(); }
+
+private:
+    const std::string& data_;
+    size_t pos_;
+};
+
+std::string encodeEntry(const TranspileResult& result) {
+    std::string out = ENTRY_MAGIC;
+    putNumber(out, result.success);
+    putNumber(out, result.errors);
+    putNumber(out, result.warnings);
+    putNumber(out, result.diagnostics.size());
+    for (const auto& diagnostic : result.diagnostics) {
+        putNumber(out, static_cast<uint64_t>(diagnostic.level));
+        putNumber(out, static_cast<uint64_t>(diagnostic.category));
+        putField(out, diagnostic.code);
+        putField(out, diagnostic.message);
+        putNumber(out, diagnostic.location.line);
+        putNumber(out, diagnostic.location.column);
+        putNumber(out, diagnostic.location.length);
+        putNumber(out, diagnostic.notes.size());
+        for (const auto& note : diagnostic.notes) putField(out, note);
+        putNumber(out, diagnostic.suggestions.size());
+        for (const auto& suggestion : diagnostic.suggestions) putField(out, suggestion);
+    }
+    putField(out, result.code);
+    return out;
+}
+
+bool decodeEntry(const std::string& data, TranspileResult& result) {
+    if (data.compare(0, ENTRY_MAGIC.size(), ENTRY_MAGIC) != 0) return false;
+    FieldReader in(data, ENTRY_MAGIC.size());
+    uint64_t success = 0, errors = 0, warnings = 0, count = 0;
+    if (!in.nextNumber(success) || !in.nextNumber(errors) || !in.nextNumber(warnings) || !in.nextNumber(count)) {
+        return false;
+    }
+    result.success = success != 0;
+    result.errors = errors;
+    result.warnings = warnings;
+    for (uint64_t i = 0; i < count; ++i) {
+        diagnostics::Diagnostic diagnostic;
+        uint64_t level = 0, category = 0, line = 0, column = 0, length = 0, notes = 0, suggestions = 0;
+        if (!in.nextNumber(level) || level > static_cast<uint64_t>(diagnostics::DiagnosticLevel::FATAL) ||
+            !in.nextNumber(category) ||
+            category > static_cast<uint64_t>(diagnostics::DiagnosticCategory::CONSTRAINT_ERROR) ||
+            !in.next(diagnostic.code) || !in.next(diagnostic.message) || !in.nextNumber(line) ||
+            !in.nextNumber(column) || !in.nextNumber(length) || !in.nextNumber(notes)) {
+            return false;
+        }
+        diagnostic.level = static_cast<diagnostics::DiagnosticLevel>(level);
+        diagnostic.category = static_cast<diagnostics::DiagnosticCategory>(category);
+        diagnostic.location = diagnostics::SourceLocation("", line, column, length);
+        for (uint64_t n = 0; n < notes; ++n) {
+            if (!in.next(diagnostic.notes.emplace_back())) return false;
+        }
+        if (!in.nextNumber(suggestions)) return false;
+        for (uint64_t n = 0; n < suggestions; ++n) {
+            if (!in.next(diagnostic.suggestions.emplace_back())) return false;
+        }
+        result.diagnostics.push_back(std::move(diagnostic));
+    }
+    return in.next(result.code) && in.atEnd();
+}
+
+std::string hex(uint64_t value) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << value;
+    return out.str();
+}
+
+/**
+ * @brief Hashes of the runtime and casting templates the generators would read
+ *
+ * Generated code embeds these files, read from the working directory, so
+ * an edited template or another working directory gets fresh keys. The
+ * hash of a file is recomputed only when its size or modification time
+ * changes.
+ */
+std::string templateIdentity() {
+    struct Seen {
+        uintmax_t size;
+        fs::file_time_type time;
+        uint64_t hash;
+    };
+    static std::mutex mutex;
+    static std::map<std::string, Seen> seen;
+
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (const char* directory : TEMPLATE_DIRECTORIES) {
+        for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->is_regular_file(ec)) files.push_back(it->path());
+        }
+        ec.clear();
+    }
+    std::sort(files.begin(), files.end());
+
+    std::string identity;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& file : files) {
+        auto size = fs::file_size(file, ec);
+        if (ec) continue;
+        auto time = fs::last_write_time(file, ec);
+        if (ec) continue;
+        auto known = seen.find(file.string());
+        if (known == seen.end() || known->second.size != size || known->second.time != time) {
+            std::ifstream in(file, std::ios::binary);
+            std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            known = seen.insert_or_assign(file.string(), Seen{size, time, xxhash64(content.data(), content.size())}).first;
+        }
+        identity += file.generic_string() + "=" + hex(known->second.hash) + "\n";
+    }
+    return identity;
+}
+
+} // namespace
+
+uint64_t xxhash64(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        for (; end - p >= 32; p += 32) {
+            v1 = mixRound(v1, read64(p));
+            v2 = mixRound(v2, read64(p + 8));
+            v3 = mixRound(v3, read64(p + 16));
+            v4 = mixRound(v4, read64(p + 24));
+        }
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    } else {
+        hash = seed + PRIME5;
+    }
+    hash += static_cast<uint64_t>(size);
+
+    for (; end - p >= 8; p += 8) {
+        hash ^= mixRound(0, read64(p));
+        hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+    }
+    if (end - p >= 4) {
+        hash ^= static_cast<uint64_t>(read32(p)) * PRIME1;
+        hash = rotateLeft(hash, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        hash ^= static_cast<uint64_t>(*p) * PRIME5;
+        hash = rotateLeft(hash, 11) * PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::string defaultCacheDir() {
+    const char* xdg = std::getenv("XDG_CACHE_HOME");
+    if (xdg && *xdg) return (fs::path(xdg) / "gate").string();
+    const char* home = std::getenv("HOME");
+    if (home && *home) return (fs::path(home) / ".cache" / "gate").string();
+    return "";
+}
+
+std::string CacheStats::describe() const {
+    size_t lookups = hits + misses;
+    std::ostringstream out;
+    out << "Cache: " << hits << " hits, " << misses << " misses (" << std::fixed << std::setprecision(1)
+        << (lookups > 0 ? 100.0 * hits / lookups : 0.0) << "% hit rate), " << stores << " stored, " << evictions
+        << " evicted";
+    return out.str();
+}
+
+OutputCache::OutputCache(std::string directory, uint64_t maxBytes)
+    : directory_(std::move(directory)), maxBytes_(maxBytes) {}
+
+bool OutputCache::open(std::string& error) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (ec || !fs::is_directory(directory_, ec)) {
+        error = "Cannot create cache directory " + directory_ + (ec ? ": " + ec.message() : "");
+        return false;
+    }
+    return true;
+}
+
+std::string OutputCache::key(const std::string& source, const transpiler::CodeGenOptions& options, Target target) {
+    std::string prefix = buildIdentity() + "\n" + templateIdentity() + describeOptions(options, target) + "\n";
+    uint64_t low = xxhash64(source.data(), source.size(), xxhash64(prefix.data(), prefix.size(), 0));
+    uint64_t high = xxhash64(source.data(), source.size(), xxhash64(prefix.data(), prefix.size(), 1));
+    return hex(high) + hex(low);
+}
+
+std::string OutputCache::entryPath(const std::string& key) const {
+    return (fs::path(directory_) / key.substr(0, 2) / key).string();
+}
+
+bool OutputCache::lookup(const std::string& key, TranspileResult& result) {
+    std::string path = entryPath(key);
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        ++misses_;
+        return false;
+    }
+    std::ostringstream data;
+    data << in.rdbuf();
+    in.close();
+
+    TranspileResult entry;
+    if (!decodeEntry(data.str(), entry)) {
+        std::error_code ec;
+        fs::remove(path, ec);
+        ++misses_;
+        return false;
+    }
+
+    // The modification time orders the entries for eviction.
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    result = std::move(entry);
+    ++hits_;
+    return true;
+}
+
+void OutputCache::store(const std::string& key, const TranspileResult& result) {
+    fs::path path = entryPath(key);
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    if (ec) return;
+
+    std::string data = encodeEntry(result);
+    fs::path temp = path.parent_path() /
+                    (".tmp-" + std::to_string(getpid()) + "-" + std::to_string(tempCounter_++) + "-" + key);
+    {
+        std::ofstream out(temp, std::ios::binary);
+        out << data;
+        if (!out.flush()) {
+            out.close();
+            fs::remove(temp, ec);
+            return;
+        }
+    }
+    fs::rename(temp, path, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return;
+    }
+    ++stores_;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (usedBytes_ >= 0) usedBytes_ += static_cast<int64_t>(data.size());
+    if (usedBytes_ < 0 || static_cast<uint64_t>(usedBytes_) > maxBytes_) evict();
+}
+
+/**
+ * @brief Measures the directory and, if it is over its bound, removes the
+ *        least recently used entries until it is 10% below it
+ *
+ * Called with mutex_ held. Other processes may add or remove entries
+ * meanwhile; files that vanish are skipped, and the next eviction measures
+ * again.
+ */
+void OutputCache::evict() {
+    struct Entry {
+        fs::file_time_type time;
+        uint64_t size;
+        fs::path path;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    auto now = fs::file_time_type::clock::now();
+
+    std::error_code ec;
+    for (fs::directory_iterator shard(directory_, ec), end; !ec && shard != end; shard.increment(ec)) {
+        if (!shard->is_directory(ec)) continue;
+        std::error_code inner;
+        for (fs::directory_iterator file(shard->path(), inner); !inner && file != end; file.increment(inner)) {
+            std::error_code info;
+            auto time = file->last_write_time(info);
+            uint64_t size = file->file_size(info);
+            if (info) continue;
+            if (file->path().filename().string().rfind(".tmp-", 0) == 0) {
+                if (now - time > STALE_TEMP_AGE) fs::remove(file->path(), info);
+                continue;
+            }
+            entries.push_back({time, size, file->path()});
+            total += size;
+        }
+    }
+
+    if (total > maxBytes_) {
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+        uint64_t target = maxBytes_ - maxBytes_ / 10;
+        for (const auto& entry : entries) {
+            if (total <= target) break;
+            std::error_code removed;
+            if (fs::remove(entry.path, removed)) ++evictions_;
+            total -= entry.size;
+        }
+    }
+    usedBytes_ = static_cast<int64_t>(total);
+}
+
+CacheStats OutputCache::stats() const {
+    CacheStats stats;
+    stats.hits = hits_.load();
+    stats.misses = misses_.load();
+    stats.stores = stores_.load();
+    stats.evictions = evictions_.load();
+    return stats;
+}
+
+TranspileResult transpileCached(OutputCache* cache, const std::string& sourceWithComments, const std::string& fileName,
+                                const transpiler::CodeGenOptions& options, Target target) {
+    if (!cache) return transpileSource(sourceWithComments, fileName, options, target);
+
+    std::string key = OutputCache::key(sourceWithComments, options, target);
+    TranspileResult result;
+    if (cache->lookup(key, result)) {
+        for (auto& diagnostic : result.diagnostics) diagnostic.location.filename = fileName;
+        if (!result.diagnostics.empty()) result.report = renderReport(sourceWithComments, fileName, result.diagnostics);
+        return result;
+    }
+    result = transpileSource(sourceWithComments, fileName, options, target);
+    // A generator failure may come from the environment (a template missing from this working directory).
+    if (!result.generatorFailed) cache->store(key, result);
+    return result;
+}
+
+} // namespace gate::driver
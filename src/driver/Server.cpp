@@ -0,0 +1,431 @@
+/**
+ * @file Server.cpp
+ * @brief Implementation of the transpiler daemon and its client
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "driver/Server.h"
+#include "driver/WorkStealingPool.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace gate::driver {
+
+namespace {
+
+/** @brief Exercises the lexer, parser and both code generators once before the first request */
+const char* const WARM_UP_SOURCE = R"(
+PROGRAM WarmUp
+KAMUS
+    type Point: < x: integer, y: real >
+    p: Point
+    s: string
+    i: integer
+ALGORITMA
+    s <- 'a' & 'b'
+    i traversal [1..3]
+        p.x <- p.x + i
+    if p.x > 2 then
+        output(s, p.x)
+)";
+
+bool sendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool receiveAll(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t received = ::recv(fd, data, size, 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) return false;
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool socketAddress(const std::string& socketPath, sockaddr_un& address, std::string& error) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        error = "Invalid socket path '" + socketPath + "' (at most " + std::to_string(sizeof(address.sun_path) - 1) +
+                " characters)";
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+    return true;
+}
+
+std::string oneLine(std::string text) {
+    for (char& c : text) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return text;
+}
+
+/** @brief Splits the `name=value` lines before the first empty line; returns where the body starts */
+bool splitHeader(const std::string& payload, Settings& header, size_t& body) {
+    size_t pos = 0;
+    while (true) {
+        size_t end = payload.find('\n', pos);
+        if (end == std::string::npos) return false;
+        if (end == pos) {
+            body = end + 1;
+            return true;
+        }
+        std::string line = payload.substr(pos, end - pos);
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) return false;
+        header.emplace_back(line.substr(0, equals), line.substr(equals + 1));
+        pos = end + 1;
+    }
+}
+
+diagnostics::DiagnosticLevel levelFromName(const std::string& name) {
+    if (name == "info") return diagnostics::DiagnosticLevel::INFO;
+    if (name == "warning") return diagnostics::DiagnosticLevel::WARNING;
+    if (name == "fatal") return diagnostics::DiagnosticLevel::FATAL;
+    return diagnostics::DiagnosticLevel::ERROR;
+}
+
+TranspileResult failure(const std::string& fileName, const std::string& message) {
+    TranspileResult result;
+    result.errors = 1;
+    result.diagnostics.push_back(diagnostics::Diagnostic::Builder(message, diagnostics::SourceLocation(fileName, 0, 0))
+                                     .withLevel(diagnostics::DiagnosticLevel::ERROR)
+                                     .build());
+    return result;
+}
+
+} // namespace
+
+bool writeFrame(int fd, const std::string& payload) {
+    if (payload.size() > MAX_FRAME_BYTES) return false;
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    unsigned char length[4] = {static_cast<unsigned char>(size >> 24), static_cast<unsigned char>(size >> 16),
+                               static_cast<unsigned char>(size >> 8), static_cast<unsigned char>(size)};
+    return sendAll(fd, reinterpret_cast<const char*>(length), sizeof(length)) &&
+           sendAll(fd, payload.data(), payload.size());
+}
+
+bool readFrame(int fd, std::string& payload) {
+    unsigned char length[4];
+    if (!receiveAll(fd, reinterpret_cast<char*>(length), sizeof(length))) return false;
+    uint32_t size = (uint32_t(length[0]) << 24) | (uint32_t(length[1]) << 16) | (uint32_t(length[2]) << 8) |
+                    uint32_t(length[3]);
+    if (size > MAX_FRAME_BYTES) return false;
+    payload.resize(size);
+    return receiveAll(fd, payload.data(), size);
+}
+
+std::string encodeRequest(const ServeRequest& request) {
+    std::string payload = "file=" + oneLine(request.fileName) + "\n";
+    for (const auto& [name, value] : request.settings) payload += name + "=" + oneLine(value) + "\n";
+    payload += "\n";
+    payload += request.source;
+    return payload;
+}
+
+bool decodeRequest(const std::string& payload, ServeRequest& request) {
+    Settings header;
+    size_t body = 0;
+    if (!splitHeader(payload, header, body)) return false;
+    for (auto& setting : header) {
+        if (setting.first == "file") {
+            request.fileName = std::move(setting.second);
+        } else {
+            request.settings.push_back(std::move(setting));
+        }
+    }
+    request.source = payload.substr(body);
+    return true;
+}
+
+std::string encodeResponse(const TranspileResult& result) {
+    std::ostringstream payload;
+    payload << "status=" << (result.success ? "ok" : "failed") << "\n";
+    payload << "errors=" << result.errors << "\n";
+    payload << "warnings=" << result.warnings << "\n";
+    for (const auto& diagnostic : result.diagnostics) {
+        payload << "diagnostic=" << diagnosticLevelName(diagnostic.level) << "\t" << diagnostic.location.line << "\t"
+                << diagnostic.location.column << "\t" << oneLine(diagnostic.code) << "\t"
+                << oneLine(diagnostic.message) << "\n";
+    }
+    payload << "\n" << result.code;
+    return payload.str();
+}
+
+bool decodeResponse(const std::string& payload, TranspileResult& result) {
+    Settings header;
+    size_t body = 0;
+    if (!splitHeader(payload, header, body)) return false;
+    try {
+        for (const auto& [name, value] : header) {
+            if (name == "status") {
+                result.success = value == "ok";
+            } else if (name == "errors") {
+                result.errors = std::stoul(value);
+            } else if (name == "warnings") {
+                result.warnings = std::stoul(value);
+            } else if (name == "diagnostic") {
+                std::vector<std::string> fields;
+                std::istringstream in(value);
+                std::string field;
+                while (fields.size() < 4 && std::getline(in, field, '\t')) fields.push_back(field);
+                field.clear();
+                std::getline(in, field);
+                if (fields.size() < 4) return false;
+                diagnostics::SourceLocation location("", std::stoul(fields[1]), std::stoul(fields[2]));
+                result.diagnostics.push_back(diagnostics::Diagnostic::Builder(field, location)
+                                                 .withLevel(levelFromName(fields[0]))
+                                                 .withCode(fields[3])
+                                                 .build());
+            }
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    result.code = payload.substr(body);
+    return true;
+}
+
+std::string serveRequest(const std::string& payload, OutputCache* cache) {
+    ServeRequest request;
+    if (!decodeRequest(payload, request)) {
+        return encodeResponse(failure(request.fileName, "Malformed request: no empty line after the settings"));
+    }
+    transpiler::CodeGenOptions options;
+    Target target = Target::PASCAL;
+    std::string error;
+    if (!parseCodeGenSettings(request.settings, options, target, error)) {
+        return encodeResponse(failure(request.fileName, error));
+    }
+    try {
+        return encodeResponse(transpileCached(cache, request.source, request.fileName, options, target));
+    } catch (const std::exception& e) {
+        return encodeResponse(failure(request.fileName, e.what()));
+    }
+}
+
+int connectToServer(const std::string& socketPath, std::string& error) {
+    sockaddr_un address;
+    if (!socketAddress(socketPath, address, error)) return -1;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        error = std::string("Cannot create socket: ") + std::strerror(errno);
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        error = "Cannot connect to " + socketPath + ": " + std::strerror(errno);
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool transpileRemote(int fd, const ServeRequest& request, TranspileResult& result, std::string& error) {
+    std::string payload = encodeRequest(request);
+    if (!writeFrame(fd, payload)) {
+        error = "Cannot send the request to the server";
+        return false;
+    }
+    if (!readFrame(fd, payload)) {
+        error = "The server closed the connection";
+        return false;
+    }
+    if (!decodeResponse(payload, result)) {
+        error = "Malformed response from the server";
+        return false;
+    }
+    return true;
+}
+
+Server::Server(std::string socketPath, unsigned threads, OutputCache* cache)
+    : socketPath_(std::move(socketPath)),
+      threads_(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads),
+      cache_(cache) {
+    for (int* pipeFds : {stopPipe_, wakePipe_}) {
+        if (::pipe(pipeFds) == 0) {
+            ::fcntl(pipeFds[0], F_SETFD, FD_CLOEXEC);
+            ::fcntl(pipeFds[1], F_SETFD, FD_CLOEXEC);
+        }
+    }
+    // A wake-up only has to be pending, so a full pipe is as good as a write.
+    if (wakePipe_[1] >= 0) ::fcntl(wakePipe_[1], F_SETFL, O_NONBLOCK);
+}
+
+Server::~Server() {
+    if (listenFd_ >= 0) {
+        ::close(listenFd_);
+        ::unlink(socketPath_.c_str());
+    }
+    for (int fd : {stopPipe_[0], stopPipe_[1], wakePipe_[0], wakePipe_[1]}) {
+        if (fd >= 0) ::close(fd);
+    }
+}
+bool Server::listen(std::string& error) {
+    sockaddr_un address;
+    if (!socketAddress(socketPath_, address, error)) return false;
+    if (stopPipe_[0] < 0 || wakePipe_[0] < 0) {
+        error = std::string("Cannot create pipe: ") + std::strerror(errno);
+        return false;
+    }
+
+    struct stat info;
+    if (::lstat(socketPath_.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            error = socketPath_ + " exists and is not a socket";
+            return false;
+        }
+        std::string ignored;
+        int live = connectToServer(socketPath_, ignored);
+        if (live >= 0) {
+            ::close(live);
+            error = "A server is already listening on " + socketPath_;
+            return false;
+        }
+        ::unlink(socketPath_.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        error = std::string("Cannot create socket: ") + std::strerror(errno);
+        return false;
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+        error = "Cannot listen on " + socketPath_ + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    listenFd_ = fd;
+
+    // Static tables (keywords, comment pattern, C runtime text) are built on
+    // first use; pay for that now rather than in the first request.
+    for (Target target : {Target::PASCAL, Target::C}) {
+        try {
+            transpileSource(WARM_UP_SOURCE, "<warm-up>", transpiler::CodeGenOptions(), target);
+        } catch (const std::exception&) {
+        }
+    }
+    return true;
+}
+
+void Server::run() {
+    WorkStealingPool pool(threads_);
+    std::vector<int> idle;
+    std::vector<pollfd> fds;
+    while (listenFd_ >= 0) {
+        fds.assign({{listenFd_, POLLIN, 0}, {stopPipe_[0], POLLIN, 0}, {wakePipe_[0], POLLIN, 0}});
+        for (int fd : idle) fds.push_back({fd, POLLIN, 0});
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents != 0) break;
+
+        if (fds[2].revents != 0) {
+            char drained[64];
+            ssize_t ignored = ::read(wakePipe_[0], drained, sizeof(drained));
+            (void)ignored;
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle.insert(idle.end(), returned_.begin(), returned_.end());
+            returned_.clear();
+        }
+
+        // A readable connection leaves the poll set until its request is answered.
+        for (size_t i = 3; i < fds.size(); ++i) {
+            if (fds[i].revents == 0) continue;
+            idle.erase(std::find(idle.begin(), idle.end(), fds[i].fd));
+            Connection* connection;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                connection = connections_.at(fds[i].fd).get();
+            }
+            pool.submit([this, connection] { serveRequestOn(*connection); });
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) continue;
+            // A client that stalls inside a frame gives its worker back after the timeout.
+            timeval timeout{FRAME_TIMEOUT_SECONDS, 0};
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            std::lock_guard<std::mutex> lock(mutex_);
+            connections_[fd] = std::make_unique<Connection>(Connection{fd, {}, {}});
+            idle.push_back(fd);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : connections_) ::shutdown(entry.first, SHUT_RDWR);
+    }
+    pool.wait();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : connections_) ::close(entry.first);
+    connections_.clear();
+    returned_.clear();
+}
+
+void Server::stop() {
+    char byte = 1;
+    ssize_t ignored = ::write(stopPipe_[1], &byte, 1);
+    (void)ignored;
+}
+
+/**
+ * @brief Answers the request waiting on a connection
+ *
+ * Runs on a worker once the connection is readable. The connection goes
+ * back to run() to wait for its next request, or is closed when the client
+ * has closed it or a frame cannot be read or written. The request and
+ * response buffers live as long as the connection, so a client sending
+ * many requests reuses their storage.
+ */
+void Server::serveRequestOn(Connection& connection) {
+    if (!readFrame(connection.fd, connection.request)) {
+        closeConnection(connection.fd);
+        return;
+    }
+    connection.response = serveRequest(connection.request, cache_);
+    ++requests_;
+    if (!writeFrame(connection.fd, connection.response)) {
+        closeConnection(connection.fd);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        returned_.push_back(connection.fd);
+    }
+    char byte = 1;
+    ssize_t ignored = ::write(wakePipe_[1], &byte, 1);
+    (void)ignored;
+}
+
+void Server::closeConnection(int fd) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    connections_.erase(fd);
+    ::close(fd);
+}
+
+} // namespace gate::driver
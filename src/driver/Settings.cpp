@@ -0,0 +1,133 @@
+/**
+ * @file Settings.cpp
+ * @brief Implementation of the code generation settings parser
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "driver/Settings.h"
+
+namespace gate::driver {
+
+namespace {
+
+bool parseFlag(const std::string& name, const std::string& value, bool& flag, std::string& error) {
+    if (value == "true" || value == "false") {
+        flag = value == "true";
+        return true;
+    }
+    error = "Invalid value '" + value + "' for " + name + ". Expected true or false.";
+    return false;
+}
+
+bool parseCount(const std::string& name, const std::string& value, int& count, std::string& error) {
+    size_t used = 0;
+    try {
+        count = std::stoi(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) {
+        error = "Invalid value '" + value + "' for " + name + ". Expected an integer.";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseCodeGenSettings(const Settings& settings, transpiler::CodeGenOptions& options, Target& target,
+                          std::string& error) {
+    bool inlineThresholdSet = false;
+    bool unrollSet = false;
+
+    for (const auto& [name, value] : settings) {
+        bool ok = true;
+        if (name == "target") {
+            if (value == "c") {
+                target = Target::C;
+            } else if (value == "pascal") {
+                target = Target::PASCAL;
+            } else {
+                error = "Unknown target '" + value + "'. Expected pascal or c.";
+                ok = false;
+            }
+        } else if (name == "profile") {
+            if (value == "release") {
+                options.profile = transpiler::BuildProfile::RELEASE;
+            } else if (value == "debug") {
+                options.profile = transpiler::BuildProfile::DEBUG;
+            } else if (value == "checked") {
+                options.profile = transpiler::BuildProfile::CHECKED;
+            } else if (value.empty()) {
+                options.profile = transpiler::BuildProfile::NONE;
+            } else {
+                error = "Unknown profile '" + value + "'. Expected release, debug or checked.";
+                ok = false;
+            }
+        } else if (name == "alloc") {
+            if (value == "pool") {
+                options.alloc = transpiler::AllocStrategy::POOL;
+            } else if (value == "heap") {
+                options.alloc = transpiler::AllocStrategy::HEAP;
+            } else {
+                error = "Unknown allocation strategy '" + value + "'. Expected heap or pool.";
+                ok = false;
+            }
+        } else if (name == "record-layout") {
+            if (value == "reordered") {
+                options.recordLayout = transpiler::RecordLayout::REORDERED;
+            } else if (value == "packed") {
+                options.recordLayout = transpiler::RecordLayout::PACKED;
+            } else if (value == "declared") {
+                options.recordLayout = transpiler::RecordLayout::DECLARED;
+            } else {
+                error = "Unknown record layout '" + value + "'. Expected declared, reordered or packed.";
+                ok = false;
+            }
+        } else if (name == "instrument") {
+            if (value == "profile") {
+                options.instrument = transpiler::Instrumentation::PROFILE;
+            } else if (value.empty()) {
+                options.instrument = transpiler::Instrumentation::NONE;
+            } else {
+                error = "Unknown instrumentation '" + value + "'. Expected profile.";
+                ok = false;
+            }
+        } else if (name == "inline-threshold") {
+            ok = parseCount(name, value, options.inlineThreshold, error);
+            inlineThresholdSet = true;
+        } else if (name == "unroll") {
+            ok = parseCount(name, value, options.unrollFactor, error);
+            unrollSet = true;
+        } else if (name == "flat-arrays") {
+            ok = parseFlag(name, value, options.flatArrays, error);
+        } else if (name == "soa") {
+            ok = parseFlag(name, value, options.soa, error);
+        } else if (name == "memo") {
+            ok = parseFlag(name, value, options.memo, error);
+        } else if (name == "const-eval") {
+            ok = parseFlag(name, value, options.constEval, error);
+        } else if (name == "tabulate") {
+            ok = parseFlag(name, value, options.tabulate, error);
+        } else if (name == "fast-io") {
+            ok = parseFlag(name, value, options.fastIO, error);
+        } else {
+            error = "Unknown option '" + name + "'.";
+            ok = false;
+        }
+        if (!ok) return false;
+    }
+
+    if (!inlineThresholdSet && options.profile == transpiler::BuildProfile::RELEASE) {
+        options.inlineThreshold = transpiler::DEFAULT_INLINE_THRESHOLD;
+    }
+    if (!unrollSet && options.profile == transpiler::BuildProfile::RELEASE) {
+        options.unrollFactor = transpiler::DEFAULT_UNROLL_FACTOR;
+    }
+    return true;
+}
+
+} // namespace gate::driver
@@ -0,0 +1,126 @@
+/**
+ * @file Transpile.cpp
+ * @brief Implementation of the NOTAL to Pascal/C pipeline as one call
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "driver/Transpile.h"
+#include "core/CCodeGenerator.h"
+#include "core/NotalLexer.h"
+#include "core/NotalParser.h"
+#include "diagnostics/DiagnosticEngine.h"
+#include "utils/InputValidator.h"
+#include <regex>
+
+namespace gate::driver {
+
+/**
+ * @note Uses [\s\S] to match any character including newlines, a portable
+ *       alternative to the dotall flag; a space keeps tokens separated.
+ */
+std::string removeComments(const std::string& source) {
+    static const std::regex comment("\\{[\\s\\S]*?\\}");
+    return std::regex_replace(source, comment, " ");
+}
+
+const char* outputExtension(Target target) {
+    return target == Target::C ? ".c" : ".pas";
+}
+
+bool isValidOutputPath(const std::string& path, Target target) {
+    return utils::InputValidator::isValidOutputPath(path, outputExtension(target));
+}
+
+const char* diagnosticLevelName(diagnostics::DiagnosticLevel level) {
+    switch (level) {
+        case diagnostics::DiagnosticLevel::INFO: return "info";
+        case diagnostics::DiagnosticLevel::WARNING: return "warning";
+        case diagnostics::DiagnosticLevel::ERROR: return "error";
+        case diagnostics::DiagnosticLevel::FATAL: return "fatal";
+    }
+    return "error";
+}
+
+std::string diagnosticLine(const std::string& fileName, const diagnostics::Diagnostic& diagnostic) {
+    std::string line = fileName + ":" + std::to_string(diagnostic.location.line) + ":" +
+                       std::to_string(diagnostic.location.column) + ": " + diagnosticLevelName(diagnostic.level);
+    if (!diagnostic.code.empty()) line += "[" + diagnostic.code + "]";
+    line += ": ";
+    for (char c : diagnostic.message) line += (c == '\n' || c == '\r') ? ' ' : c;
+    return line;
+}
+
+std::string renderReport(const std::string& sourceWithComments, const std::string& fileName,
+                         const std::vector<diagnostics::Diagnostic>& diagnostics) {
+    diagnostics::DiagnosticEngine diagnosticEngine(removeComments(sourceWithComments), fileName);
+    for (diagnostics::Diagnostic diagnostic : diagnostics) {
+        diagnostic.location.filename = fileName;
+        diagnosticEngine.report(std::move(diagnostic));
+    }
+    if (!diagnosticEngine.hasErrors() && !diagnosticEngine.hasWarnings()) return "";
+    return diagnosticEngine.generateReport();
+}
+
+TranspileResult transpileSource(const std::string& sourceWithComments, const std::string& fileName,
+                                const transpiler::CodeGenOptions& options, Target target) {
+    // The DiagnosticEngine needs the source code to provide context for errors.
+    std::string source = removeComments(sourceWithComments);
+    diagnostics::DiagnosticEngine diagnosticEngine(source, fileName);
+    TranspileResult result;
+    diagnosticEngine.setDiagnosticHandler(
+        [&result](const diagnostics::Diagnostic& diagnostic) { result.diagnostics.push_back(diagnostic); });
+
+    auto validationResult = utils::InputValidator::validateNotalSource(sourceWithComments);
+    if (!validationResult.isValid) {
+        diagnostics::SourceLocation loc(fileName, 0, 0);
+        diagnosticEngine.report(diagnostics::Diagnostic::Builder(validationResult.errorMessage, loc)
+                                    .withLevel(diagnostics::DiagnosticLevel::FATAL)
+                                    .build());
+    }
+    for (const auto& warning : validationResult.warnings) {
+        diagnostics::SourceLocation loc(fileName, 0, 0);
+        diagnosticEngine.report(diagnostics::Diagnostic::Builder(warning, loc)
+                                    .withLevel(diagnostics::DiagnosticLevel::WARNING)
+                                    .build());
+    }
+
+    transpiler::NotalLexer lexer(source, fileName);
+    std::vector<core::Token> tokens = lexer.getAllTokens();
+    transpiler::NotalParser parser(tokens, diagnosticEngine);
+    std::shared_ptr<ast::ProgramStmt> program = parser.parse();
+
+    if (program && !diagnosticEngine.hasErrors()) {
+        try {
+            if (target == Target::C) {
+                result.code = transpiler::CCodeGenerator(options).generate(program);
+            } else {
+                transpiler::PascalCodeGenerator generator(options);
+                result.code = generator.generate(program);
+                // --const-eval leaves what it cannot evaluate as written; say why at its line
+                for (const auto& fallback : generator.constEvalFallbacks()) {
+                    diagnostics::SourceLocation loc(fileName, fallback.line, fallback.column);
+                    diagnosticEngine.report(diagnostics::Diagnostic::Builder(fallback.message, loc)
+                                                .withLevel(diagnostics::DiagnosticLevel::WARNING)
+                                                .build());
+                }
+            }
+            result.success = true;
+        } catch (const std::exception& e) {
+            result.generatorFailed = true;
+            diagnostics::SourceLocation loc(fileName, 0, 0);
+            diagnosticEngine.report(diagnostics::Diagnostic::Builder(e.what(), loc)
+                                        .withLevel(diagnostics::DiagnosticLevel::ERROR)
+                                        .build());
+        }
+    }
+
+    result.errors = diagnosticEngine.getErrorCount();
+    result.warnings = diagnosticEngine.getWarningCount();
+    if (diagnosticEngine.hasErrors() || diagnosticEngine.hasWarnings()) result.report = diagnosticEngine.generateReport();
+    return result;
+}
+
+} // namespace gate::driver
@@ -0,0 +1,351 @@
+/**
+ * @file Watch.cpp
+ * @brief Implementation of `gate watch`
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "driver/Watch.h"
+#include "utils/SecureFileReader.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace gate::driver {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t WATCH_EVENTS =
+    IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE | IN_DELETE_SELF;
+
+/** @brief A burst of events longer than this many debounce intervals is rebuilt without waiting for quiet */
+constexpr unsigned MAX_DEBOUNCE_INTERVALS = 10;
+
+bool isSource(const fs::path& path) { return path.extension() == ".notal"; }
+
+uint64_t hashOf(const std::string& text) { return xxhash64(text.data(), text.size()); }
+
+/** @brief Writes a file through a temporary and a rename, so readers never see it half written */
+bool writeAtomically(const std::string& path, const std::string& content) {
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    std::string temp = path + ".tmp-gate-" + std::to_string(getpid());
+    {
+        std::ofstream out(temp, std::ios::binary);
+        out << content;
+        if (!out.flush()) {
+            out.close();
+            fs::remove(temp, ec);
+            return false;
+        }
+    }
+    fs::rename(temp, path, ec);
+    if (ec) fs::remove(temp, ec);
+    return !ec;
+}
+
+} // namespace
+
+Watcher::Watcher(WatchOptions options) : options_(std::move(options)), pool_(options_.jobs) {
+    while (options_.directory.size() > 1 && options_.directory.back() == '/') options_.directory.pop_back();
+    if (::pipe(stopPipe_) == 0) {
+        ::fcntl(stopPipe_[0], F_SETFD, FD_CLOEXEC);
+        ::fcntl(stopPipe_[1], F_SETFD, FD_CLOEXEC);
+    }
+}
+
+Watcher::~Watcher() {
+    if (inotifyFd_ >= 0) ::close(inotifyFd_);
+    for (int fd : stopPipe_) {
+        if (fd >= 0) ::close(fd);
+    }
+}
+
+bool Watcher::start(std::string& error) {
+    std::error_code ec;
+    if (!fs::is_directory(options_.directory, ec)) {
+        error = "Not a directory: " + options_.directory;
+        return false;
+    }
+    if (stopPipe_[0] < 0) {
+        error = std::string("Cannot create pipe: ") + std::strerror(errno);
+        return false;
+    }
+    inotifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        error = std::string("Cannot start inotify: ") + std::strerror(errno);
+        return false;
+    }
+    addWatches(options_.directory, nullptr);
+    if (watches_.empty()) {
+        error = "Cannot watch " + options_.directory + ": " + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+std::string Watcher::outputPath(const std::string& file) const {
+    fs::path output = options_.outDir.empty()
+                          ? fs::path(file)
+                          : fs::path(options_.outDir) / fs::path(file).lexically_relative(options_.directory);
+    return output.replace_extension(outputExtension(options_.target)).string();
+}
+
+std::vector<std::string> Watcher::sourcesUnder(const std::string& directory) const {
+    std::vector<std::string> sources;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        std::error_code type;
+        if (it->is_regular_file(type) && isSource(it->path())) sources.push_back(it->path().string());
+    }
+    return sources;
+}
+
+/**
+ * @brief Watches a directory and every directory under it
+ * @param directory Directory to watch
+ * @param found If given, receives the sources already in the new directories
+ */
+void Watcher::addWatches(const std::string& directory, std::set<std::string>* found) {
+    int wd = ::inotify_add_watch(inotifyFd_, directory.c_str(), WATCH_EVENTS | IN_ONLYDIR);
+    if (wd < 0) return;
+    watches_[wd] = directory;
+
+    std::error_code ec;
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code type;
+        if (it->is_directory(type) && !it->is_symlink(type)) {
+            addWatches(it->path().string(), found);
+        } else if (found && it->is_regular_file(type) && isSource(it->path())) {
+            found->insert(it->path().string());
+        }
+    }
+}
+
+/**
+ * @brief Drains the pending inotify events into the set of paths to rebuild
+ *
+ * Deleted and renamed-away files are included too; rebuild() forgets them.
+ */
+void Watcher::readEvents(std::set<std::string>& changed) {
+    alignas(inotify_event) char buffer[64 * 1024];
+    while (true) {
+        ssize_t size = ::read(inotifyFd_, buffer, sizeof(buffer));
+        if (size < 0 && errno == EINTR) continue;
+        if (size <= 0) return;
+
+        for (ssize_t offset = 0; offset < size;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Events were lost: look at everything; unchanged sources are skipped by their hash.
+                for (const auto& source : sourcesUnder(options_.directory)) changed.insert(source);
+                for (const auto& file : files_) changed.insert(file.first);
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                watches_.erase(event->wd);
+                continue;
+            }
+            auto watch = watches_.find(event->wd);
+            if (watch == watches_.end() || event->len == 0) continue;
+            std::string path = (fs::path(watch->second) / event->name).string();
+
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    addWatches(path, &changed);
+                } else if (event->mask & IN_MOVED_FROM) {
+                    for (auto it = watches_.begin(); it != watches_.end();) {
+                        if (it->second == path || it->second.rfind(path + "/", 0) == 0) {
+                            ::inotify_rm_watch(inotifyFd_, it->first);
+                            it = watches_.erase(it);
+                        } else {
+                            ++it;
+                        }
+                    }
+                    for (const auto& file : files_) {
+                        if (file.first.rfind(path + "/", 0) == 0) changed.insert(file.first);
+                    }
+                }
+            } else if (isSource(path) && (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE))) {
+                changed.insert(path);
+            }
+        }
+    }
+}
+
+RebuildSummary Watcher::rebuild(const std::vector<std::string>& files, std::ostream& out, std::ostream& err) {
+    auto start = std::chrono::steady_clock::now();
+
+    /** Work and outcome of one file; workers touch only their own */
+    struct Job {
+        std::string file;
+        std::string output;
+        FileState state;
+        bool known = false;
+        bool exists = true;
+        bool transpiled = false;
+        bool success = false;
+        bool written = false;
+        std::string error;
+        std::string report;
+    };
+
+    std::vector<std::string> sorted(files);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::vector<Job> jobs(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        jobs[i].file = sorted[i];
+        jobs[i].output = outputPath(sorted[i]);
+        auto known = files_.find(sorted[i]);
+        if (known != files_.end()) {
+            jobs[i].known = true;
+            jobs[i].state = known->second;
+        }
+    }
+
+    for (auto& job : jobs) {
+        pool_.submit([this, &job] {
+            std::error_code ec;
+            if (!fs::exists(job.file, ec)) {
+                job.exists = false;
+                return;
+            }
+            if (!isValidOutputPath(job.output, options_.target)) {
+                job.error = "Invalid or potentially unsafe output file path: " + job.output;
+                return;
+            }
+            auto readResult = utils::SecureFileReader::readFile(job.file);
+            if (!readResult.success) {
+                job.error = readResult.errorMessage;
+                return;
+            }
+
+            uint64_t sourceHash = hashOf(readResult.content);
+            bool outputPresent = fs::exists(job.output, ec);
+            if (job.known && job.state.sourceHash == sourceHash && (!job.state.hasOutput || outputPresent)) {
+                job.success = job.state.hasOutput;
+                return;
+            }
+            job.state.sourceHash = sourceHash;
+
+            TranspileResult transpiled =
+                transpileCached(options_.cache, readResult.content, job.file, options_.codeGen, options_.target);
+            job.transpiled = true;
+            job.report = std::move(transpiled.report);
+            if (!transpiled.success) {
+                job.state.hasOutput = false;
+                return;
+            }
+
+            uint64_t outputHash = hashOf(transpiled.code);
+            if (!job.state.hasOutput && outputPresent) {
+                // First sight of this output: adopt what is on disk if it is already current.
+                auto existing = utils::SecureFileReader::readFile(job.output);
+                if (existing.success) {
+                    job.state.outputHash = hashOf(existing.content);
+                    job.state.hasOutput = true;
+                }
+            }
+            if (!(job.state.hasOutput && outputPresent && job.state.outputHash == outputHash)) {
+                if (!writeAtomically(job.output, transpiled.code)) {
+                    job.error = "Unable to open output file for writing: " + job.output;
+                    job.state.hasOutput = false;
+                    return;
+                }
+                job.written = true;
+            }
+            job.state.outputHash = outputHash;
+            job.state.hasOutput = true;
+            job.success = true;
+        });
+    }
+    pool_.wait();
+
+    RebuildSummary summary;
+    for (auto& job : jobs) {
+        if (!job.exists) {
+            if (files_.erase(job.file) > 0 && !options_.quiet) out << job.file << ": removed\n";
+            continue;
+        }
+        files_[job.file] = job.state;
+        if (job.transpiled) ++summary.transpiled;
+
+        if (!job.error.empty() || (job.transpiled && !job.success)) {
+            ++summary.failed;
+            err << job.file << ": failed" << (job.error.empty() ? "" : ": " + job.error) << "\n";
+        } else if (job.written) {
+            ++summary.written;
+            if (!options_.quiet) out << job.file << " -> " << job.output << "\n";
+        } else {
+            ++summary.unchanged;
+        }
+        err << job.report;
+    }
+
+    summary.milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    out << "Rebuilt in " << std::fixed << std::setprecision(1) << summary.milliseconds << " ms: " << summary.transpiled
+        << " transpiled, " << summary.written << " written, " << summary.unchanged << " unchanged, " << summary.failed
+        << " failed\n";
+    out.flush();
+    err.flush();
+    return summary;
+}
+
+RebuildSummary Watcher::rebuildAll(std::ostream& out, std::ostream& err) {
+    return rebuild(sourcesUnder(options_.directory), out, err);
+}
+
+void Watcher::run(std::ostream& out, std::ostream& err) {
+    pollfd fds[2] = {{inotifyFd_, POLLIN, 0}, {stopPipe_[0], POLLIN, 0}};
+    std::set<std::string> changed;
+    auto burstStart = std::chrono::steady_clock::now();
+    const auto maxBurst = std::chrono::milliseconds(options_.debounceMs * MAX_DEBOUNCE_INTERVALS);
+
+    while (inotifyFd_ >= 0) {
+        int timeout = changed.empty() ? -1 : static_cast<int>(options_.debounceMs);
+        int ready = ::poll(fds, 2, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents != 0) break;
+
+        if (ready > 0 && (fds[0].revents & POLLIN)) {
+            if (changed.empty()) burstStart = std::chrono::steady_clock::now();
+            readEvents(changed);
+            if (changed.empty() || std::chrono::steady_clock::now() - burstStart < maxBurst) continue;
+        }
+        if (changed.empty()) continue;
+
+        std::vector<std::string> files(changed.begin(), changed.end());
+        changed.clear();
+        rebuild(files, out, err);
+    }
+}
+
+void Watcher::stop() {
+    char byte = 1;
+    ssize_t ignored = ::write(stopPipe_[1], &byte, 1);
+    (void)ignored;
+}
+
+} // namespace gate::driver
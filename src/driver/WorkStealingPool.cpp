@@ -0,0 +1,119 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementation of the work-stealing thread pool
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "driver/WorkStealingPool.h"
+#include <algorithm>
+
+namespace gate::driver {
+
+namespace {
+
+/** @brief Pool of the calling worker thread, so submit can use its own queue */
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+    for (unsigned i = 0; i < threads; ++i) workers_.emplace_back([this, i] { run(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    size_t index = currentPool == this ? currentWorker : nextQueue_++ % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queued_;
+        ++pending_;
+    }
+    wake_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return pending_ == 0; });
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Worker loop
+ *
+ * A worker first reserves a task by decrementing queued_, so it only goes
+ * looking when some queue is known to hold a task nobody else has claimed.
+ */
+void WorkStealingPool::run(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return queued_ > 0 || stopping_; });
+            if (queued_ == 0) return;
+            --queued_;
+        }
+
+        std::function<void()> task;
+        while (!take(index, task)) std::this_thread::yield();
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) idle_.notify_all();
+    }
+}
+
+/**
+ * @brief Takes the newest task of the worker's own queue, or steals the oldest of another's
+ */
+bool WorkStealingPool::take(size_t index, std::function<void()>& task) {
+    {
+        Queue& own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        Queue& victim = *queues_[(index + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            ++stolen_;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace gate::driver
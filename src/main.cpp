@@ -14,40 +14,492 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
-#include <regex>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <memory>
+#include <unistd.h>
 #include <cxxopts.hpp>
 
 // GATE transpiler components
 #include "core/NotalLexer.h"
 #include "core/NotalParser.h"
+#include "core/CCodeGenerator.h"
 #include "core/PascalCodeGenerator.h"
 #include "diagnostics/DiagnosticEngine.h"
 #include "core/Token.h"
 #include "ast/Statement.h"
 #include "ast/Expression.h"
 #include "utils/SecureFileReader.h"
-#include "utils/InputValidator.h"
+#include "vm/BytecodeCompiler.h"
+#include "vm/VirtualMachine.h"
+#include "driver/Batch.h"
+#include "driver/Cache.h"
+#include "driver/Server.h"
+#include "driver/Settings.h"
+#include "driver/Transpile.h"
+#include "driver/Watch.h"
 
 /**
- * @brief Removes comments from NOTAL source code before transpilation
- * 
- * This function performs a pre-processing step to remove all comments from the
- * NOTAL source code. Comments in NOTAL are enclosed in curly braces { }.
- * The function uses regex to find and replace all comment blocks with spaces
- * to maintain proper token separation.
- * 
- * @param source The original NOTAL source code containing comments
- * @return std::string The source code with all comments removed
- * 
- * @note Uses [\s\S] pattern to match any character including newlines,
- *       providing a portable alternative to the dotall regex flag
- * @note Replaces comments with spaces rather than empty strings to ensure
- *       proper token separation in the lexical analysis phase
+ * @brief Adds the code generation flags shared by `gate` and `gate batch`
+ * @param options Command-line options to extend
+ */
+void addCodeGenOptions(cxxopts::Options& options) {
+    options.add_options("Code generation")
+        ("target", "Output language: pascal or c (a single C11 file; of the options below only --profile applies)", cxxopts::value<std::string>()->default_value("pascal"))
+        ("profile", "Code generation profile: release, debug or checked", cxxopts::value<std::string>()->default_value(""))
+        ("inline-threshold", "Mark leaf subprograms of up to this many AST nodes inline (0 disables; release profile default: 40)", cxxopts::value<int>())
+        ("alloc", "Pointer allocation strategy: heap or pool", cxxopts::value<std::string>()->default_value("heap"))
+        ("flat-arrays", "Store multi-dimensional dynamic arrays as one contiguous buffer", cxxopts::value<bool>()->default_value("false"))
+        ("unroll", "Unroll 'repeat N times' loops with a literal N by this factor (0 disables; release profile default: 4)", cxxopts::value<int>())
+        ("instrument", "Instrument the generated program: profile (statement hit counts and subprogram times, reported on stderr at exit)", cxxopts::value<std::string>()->default_value(""))
+        ("record-layout", "Record field layout: declared, reordered (by alignment, least padding) or packed", cxxopts::value<std::string>()->default_value("declared"))
+        ("soa", "Store arrays of records that are only accessed field by field as one array per field", cxxopts::value<bool>()->default_value("false"))
+        ("memo", "Memoize pure recursive functions of one or two ordinal arguments behind a hash table", cxxopts::value<bool>()->default_value("false"))
+        ("const-eval", "Replace calls to pure functions with constant arguments by their value", cxxopts::value<bool>()->default_value("false"))
+        ("tabulate", "Replace pure functions of a character, an enum or a constrained integer by a constant lookup table", cxxopts::value<bool>()->default_value("false"))
+        ("fast-io", "Use buffered console I/O and a token reader in the generated program", cxxopts::value<bool>()->default_value("false"));
+}
+
+/**
+ * @brief Adds the output cache flags shared by `gate`, `gate batch` and `gate serve`
+ * @param options Command-line options to extend
+ */
+void addCacheOptions(cxxopts::Options& options) {
+    options.add_options("Cache")
+        ("cache-dir", "Directory of the output cache (default: $XDG_CACHE_HOME/gate or ~/.cache/gate)", cxxopts::value<std::string>()->default_value(""))
+        ("no-cache", "Always transpile, neither reading nor writing the cache", cxxopts::value<bool>()->default_value("false"))
+        ("cache-max-mb", "Size bound of the cache directory in MiB; least recently used results are evicted", cxxopts::value<unsigned>()->default_value("256"));
+}
+
+/**
+ * @brief Opens the cache selected by the flags added by addCacheOptions
+ *
+ * A cache directory that cannot be created disables the cache, with a
+ * warning when it was given explicitly.
+ *
+ * @param result Parsed command line
+ * @return The cache, or nullptr when caching is off
+ */
+std::unique_ptr<gate::driver::OutputCache> openCache(const cxxopts::ParseResult& result) {
+    if (result["no-cache"].as<bool>()) return nullptr;
+    std::string directory = result["cache-dir"].as<std::string>();
+    bool explicitDirectory = !directory.empty();
+    if (!explicitDirectory) directory = gate::driver::defaultCacheDir();
+    if (directory.empty()) return nullptr;
+
+    auto cache = std::make_unique<gate::driver::OutputCache>(
+        directory, static_cast<uint64_t>(result["cache-max-mb"].as<unsigned>()) * 1024 * 1024);
+    std::string error;
+    if (!cache->open(error)) {
+        if (explicitDirectory) std::cerr << "Warning: " << error << "; transpiling without the cache" << std::endl;
+        return nullptr;
+    }
+    return cache;
+}
+
+/**
+ * @brief Collects the code generation flags added by addCodeGenOptions
+ *
+ * Flags left at their defaults are included too, except the integer flags,
+ * whose absence selects the profile's default.
+ *
+ * @param result Parsed command line
+ * @return The flags as name/value settings
+ */
+gate::driver::Settings codeGenSettings(const cxxopts::ParseResult& result) {
+    gate::driver::Settings settings;
+    for (const char* name : {"target", "profile", "alloc", "instrument", "record-layout"}) {
+        settings.emplace_back(name, result[name].as<std::string>());
+    }
+    for (const char* name : {"flat-arrays", "soa", "memo", "const-eval", "tabulate", "fast-io"}) {
+        settings.emplace_back(name, result[name].as<bool>() ? "true" : "false");
+    }
+    for (const char* name : {"inline-threshold", "unroll"}) {
+        if (result.count(name)) settings.emplace_back(name, std::to_string(result[name].as<int>()));
+    }
+    return settings;
+}
+
+/**
+ * @brief Reads the code generation flags added by addCodeGenOptions
+ *
+ * @param result Parsed command line
+ * @param codeGenOptions Receives the options
+ * @param target Receives the output language
+ * @return false (after printing the error) if a flag has an unknown value
+ */
+bool readCodeGenOptions(const cxxopts::ParseResult& result, gate::transpiler::CodeGenOptions& codeGenOptions,
+                        gate::driver::Target& target) {
+    std::string error;
+    if (!gate::driver::parseCodeGenSettings(codeGenSettings(result), codeGenOptions, target, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Implements `gate run file.notal`: compiles the program to bytecode and executes it
+ *
+ * Skips Pascal generation and the Free Pascal compiler entirely, which makes
+ * the edit-run cycle of small programs much shorter. `--disassemble` prints
+ * the compiled bytecode instead of running it; `--integer-bits 32` matches a
+ * build with fpc -Mobjfpc instead of FPC's default mode.
+ *
+ * @param argc Number of arguments after the `run` word
+ * @param argv Arguments after the `run` word
+ * @return int 0 on success, 1 on compile or runtime errors
+ */
+int runProgram(int argc, char* argv[]) {
+    cxxopts::Options options("gate run", "Compile a NOTAL program to bytecode and run it.");
+    options.add_options()
+        ("i,input", "Input NOTAL file", cxxopts::value<std::string>())
+        ("disassemble", "Print the compiled bytecode instead of running it", cxxopts::value<bool>()->default_value("false"))
+        ("integer-bits", "Width of integer: 16 like the generated Pascal, or 32 like fpc -Mobjfpc",
+         cxxopts::value<int>()->default_value(std::to_string(gate::transpiler::PASCAL_INTEGER_BITS)))
+        ("h,help", "Print usage");
+    options.parse_positional("input");
+    options.positional_help("<input file>");
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+    if (!result.count("input")) {
+        std::cerr << "Error: Input file not specified." << std::endl;
+        return 1;
+    }
+
+    int integerBits = result["integer-bits"].as<int>();
+    if (integerBits != 16 && integerBits != 32) {
+        std::cerr << "Error: --integer-bits must be 16 or 32." << std::endl;
+        return 1;
+    }
+
+    std::string inputFile = result["input"].as<std::string>();
+    auto readResult = gate::utils::SecureFileReader::readFile(inputFile);
+    if (!readResult.success) {
+        std::cerr << "Error: " << readResult.errorMessage << " (" << inputFile << ")" << std::endl;
+        return 1;
+    }
+
+    std::string source = gate::driver::removeComments(readResult.content);
+    gate::diagnostics::DiagnosticEngine diagnosticEngine(source, inputFile);
+    gate::transpiler::NotalLexer lexer(source, inputFile);
+    std::vector<gate::core::Token> tokens = lexer.getAllTokens();
+    gate::transpiler::NotalParser parser(tokens, diagnosticEngine);
+    std::shared_ptr<gate::ast::ProgramStmt> program = parser.parse();
+    if (!program || diagnosticEngine.hasErrors()) {
+        std::cerr << diagnosticEngine.generateReport();
+        return 1;
+    }
+
+    gate::vm::Module module;
+    try {
+        module = gate::vm::BytecodeCompiler(integerBits).compile(program);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    if (result["disassemble"].as<bool>()) {
+        std::cout << module.disassemble();
+        return 0;
+    }
+
+    std::ios::sync_with_stdio(false);
+    try {
+        gate::vm::VirtualMachine(module, std::cin, std::cout).run();
+    } catch (const std::exception& e) {
+        std::cout.flush();
+        std::cerr << "Runtime error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Implements `gate batch <files...|@listfile> --out-dir D -j N`
+ *
+ * Transpiles many files in one process on a work-stealing thread pool,
+ * saving the process start-up and option parsing a `gate` run per file
+ * would cost. Every file gets its own diagnostics; results are reported in
+ * input order, followed by a throughput summary.
+ *
+ * @param argc Number of arguments after the `batch` word
+ * @param argv Arguments after the `batch` word
+ * @return int 0 if every file was transpiled, 1 otherwise
+ */
+int batchMain(int argc, char* argv[]) {
+    cxxopts::Options options("gate batch", "Transpile many NOTAL files concurrently.");
+    options.add_options()
+        ("inputs", "Input NOTAL files, or @file listing one per line", cxxopts::value<std::vector<std::string>>())
+        ("out-dir", "Directory the generated files are written to", cxxopts::value<std::string>())
+        ("j,jobs", "Worker threads (default: one per hardware thread)", cxxopts::value<unsigned>()->default_value("0"))
+        ("q,quiet", "Only report failures, warnings and the summary", cxxopts::value<bool>()->default_value("false"))
+        ("h,help", "Print usage");
+    addCodeGenOptions(options);
+    addCacheOptions(options);
+    options.parse_positional("inputs");
+    options.positional_help("<files...|@listfile>");
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+    if (!result.count("out-dir")) {
+        std::cerr << "Error: Output directory not specified. Use --out-dir." << std::endl;
+        return 1;
+    }
+    if (!result.count("inputs")) {
+        std::cerr << "Error: No input files." << std::endl;
+        return 1;
+    }
+
+    gate::driver::BatchOptions batchOptions;
+    batchOptions.outDir = result["out-dir"].as<std::string>();
+    batchOptions.jobs = result["jobs"].as<unsigned>();
+    batchOptions.quiet = result["quiet"].as<bool>();
+    if (!readCodeGenOptions(result, batchOptions.codeGen, batchOptions.target)) return 1;
+
+    std::vector<std::string> files;
+    std::string error;
+    if (!gate::driver::expandInputs(result["inputs"].as<std::vector<std::string>>(), files, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+
+    auto cache = openCache(result);
+    batchOptions.cache = cache.get();
+    auto summary = gate::driver::runBatch(files, batchOptions, std::cout, std::cerr);
+    return summary.failed == 0 ? 0 : 1;
+}
+
+/** @brief Server of a running `gate serve`, stopped by SIGINT and SIGTERM */
+gate::driver::Server* activeServer = nullptr;
+
+void stopServer(int) {
+    if (activeServer) activeServer->stop();
+}
+
+/**
+ * @brief Implements `gate serve --socket PATH -j N`
+ *
+ * Keeps a warm transpiler listening on a Unix domain socket until it is
+ * interrupted, answering the framed requests of `gate client` and of editor
+ * or grader integrations speaking the protocol described in driver/Server.h.
+ *
+ * @param argc Number of arguments after the `serve` word
+ * @param argv Arguments after the `serve` word
+ * @return int 0 after a clean shutdown, 1 if the socket cannot be bound
+ */
+int serveMain(int argc, char* argv[]) {
+    cxxopts::Options options("gate serve", "Serve transpilation requests on a Unix domain socket.");
+    options.add_options()
+        ("socket", "Path of the socket to listen on", cxxopts::value<std::string>())
+        ("j,jobs", "Worker threads (default: one per hardware thread)", cxxopts::value<unsigned>()->default_value("0"))
+        ("h,help", "Print usage");
+    addCacheOptions(options);
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+    if (!result.count("socket")) {
+        std::cerr << "Error: Socket path not specified. Use --socket." << std::endl;
+        return 1;
+    }
+
+    auto cache = openCache(result);
+    gate::driver::Server server(result["socket"].as<std::string>(), result["jobs"].as<unsigned>(), cache.get());
+    std::string error;
+    if (!server.listen(error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    activeServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+
+    std::cout << "Serving on " << result["socket"].as<std::string>() << " with " << server.threads()
+              << (server.threads() == 1 ? " thread" : " threads") << std::endl;
+    server.run();
+    activeServer = nullptr;
+    std::cout << "Served " << server.requestCount() << " requests" << std::endl;
+    if (cache) std::cout << cache->stats().describe() << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Implements `gate client --socket PATH <input file> [-o output]`
+ *
+ * Sends one file to a running `gate serve` and prints or writes the result
+ * like `gate` does. Diagnostics are printed one per line as
+ * `file:line:column: level[code]: message`.
+ *
+ * @param argc Number of arguments after the `client` word
+ * @param argv Arguments after the `client` word
+ * @return int 0 on success, 1 on errors
  */
-std::string removeComments(const std::string& source) {
-    // Using [\s\S] to match any character including newlines, as a portable alternative to dotall flag.
-    // Replace comment with a space to ensure tokens are separated.
-    return std::regex_replace(source, std::regex("\\{[\\s\\S]*?\\}"), " ");
+int clientMain(int argc, char* argv[]) {
+    cxxopts::Options options("gate client", "Transpile a NOTAL file on a running gate serve.");
+    options.add_options()
+        ("socket", "Path of the server's socket", cxxopts::value<std::string>())
+        ("i,input", "Input NOTAL file", cxxopts::value<std::string>())
+        ("o,output", "Output file (optional)", cxxopts::value<std::string>()->default_value(""))
+        ("repeat", "Send the request this many times on one connection and report the latency percentiles", cxxopts::value<unsigned>()->default_value("1"))
+        ("h,help", "Print usage");
+    addCodeGenOptions(options);
+    options.parse_positional("input");
+    options.positional_help("<input file>");
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+    if (!result.count("socket")) {
+        std::cerr << "Error: Socket path not specified. Use --socket." << std::endl;
+        return 1;
+    }
+    if (!result.count("input")) {
+        std::cerr << "Error: Input file not specified." << std::endl;
+        return 1;
+    }
+
+    // Check the flags here, so a typo is reported without a round trip.
+    gate::transpiler::CodeGenOptions codeGenOptions;
+    gate::driver::Target target = gate::driver::Target::PASCAL;
+    if (!readCodeGenOptions(result, codeGenOptions, target)) return 1;
+
+    std::string inputFile = result["input"].as<std::string>();
+    std::string outputFile = result["output"].as<std::string>();
+    if (!outputFile.empty() && !gate::driver::isValidOutputPath(outputFile, target)) {
+        std::cerr << "Error: Invalid or potentially unsafe output file path: " << outputFile << std::endl;
+        return 1;
+    }
+    auto readResult = gate::utils::SecureFileReader::readFile(inputFile);
+    if (!readResult.success) {
+        std::cerr << "Error: " << readResult.errorMessage << " (" << inputFile << ")" << std::endl;
+        return 1;
+    }
+
+    gate::driver::ServeRequest request;
+    request.fileName = inputFile;
+    request.settings = codeGenSettings(result);
+    request.source = std::move(readResult.content);
+
+    std::string error;
+    int fd = gate::driver::connectToServer(result["socket"].as<std::string>(), error);
+    gate::driver::TranspileResult transpiled;
+    bool answered = fd >= 0;
+    std::vector<double> latencies;
+    for (unsigned i = 0; answered && i < std::max(1u, result["repeat"].as<unsigned>()); ++i) {
+        auto start = std::chrono::steady_clock::now();
+        transpiled = gate::driver::TranspileResult();
+        answered = gate::driver::transpileRemote(fd, request, transpiled, error);
+        latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    if (fd >= 0) close(fd);
+    if (!answered) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    if (result.count("repeat")) {
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+        std::cerr << latencies.size() << " requests: p50 " << percentile(0.50) << " ms, p99 " << percentile(0.99)
+                  << " ms, max " << latencies.back() << " ms" << std::endl;
+    }
+
+    for (const auto& diagnostic : transpiled.diagnostics) {
+        std::cerr << gate::driver::diagnosticLine(inputFile, diagnostic) << "\n";
+    }
+    if (!transpiled.success) return 1;
+
+    if (outputFile.empty()) {
+        std::cout << transpiled.code;
+        return 0;
+    }
+    std::ofstream outFile(outputFile);
+    outFile << transpiled.code;
+    if (!outFile.flush()) {
+        std::cerr << "Error: Unable to open output file for writing: " << outputFile << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/** @brief Watcher of a running `gate watch`, stopped by SIGINT and SIGTERM */
+gate::driver::Watcher* activeWatcher = nullptr;
+
+void stopWatcher(int) {
+    if (activeWatcher) activeWatcher->stop();
+}
+
+/**
+ * @brief Implements `gate watch <dir> [--out-dir D]`
+ *
+ * Transpiles every `.notal` file under the directory, then re-transpiles
+ * the files changed by each burst of edits until it is interrupted.
+ *
+ * @param argc Number of arguments after the `watch` word
+ * @param argv Arguments after the `watch` word
+ * @return int 0 after a clean shutdown, 1 if the directory cannot be watched
+ */
+int watchMain(int argc, char* argv[]) {
+    cxxopts::Options options("gate watch", "Keep the outputs of a directory of NOTAL files up to date.");
+    options.add_options()
+        ("directory", "Directory to watch, with its subdirectories", cxxopts::value<std::string>())
+        ("out-dir", "Directory mirroring the watched one for the outputs (default: beside the sources)", cxxopts::value<std::string>()->default_value(""))
+        ("debounce-ms", "Quiet time in milliseconds that ends a burst of edits", cxxopts::value<unsigned>()->default_value("10"))
+        ("j,jobs", "Worker threads (default: one per hardware thread)", cxxopts::value<unsigned>()->default_value("0"))
+        ("q,quiet", "Only report failures, warnings and the rebuild summaries", cxxopts::value<bool>()->default_value("false"))
+        ("h,help", "Print usage");
+    addCodeGenOptions(options);
+    addCacheOptions(options);
+    options.parse_positional("directory");
+    options.positional_help("<directory>");
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+    if (!result.count("directory")) {
+        std::cerr << "Error: Directory not specified." << std::endl;
+        return 1;
+    }
+
+    gate::driver::WatchOptions watchOptions;
+    watchOptions.directory = result["directory"].as<std::string>();
+    watchOptions.outDir = result["out-dir"].as<std::string>();
+    watchOptions.debounceMs = result["debounce-ms"].as<unsigned>();
+    watchOptions.jobs = result["jobs"].as<unsigned>();
+    watchOptions.quiet = result["quiet"].as<bool>();
+    if (!readCodeGenOptions(result, watchOptions.codeGen, watchOptions.target)) return 1;
+    auto cache = openCache(result);
+    watchOptions.cache = cache.get();
+
+    gate::driver::Watcher watcher(watchOptions);
+    std::string error;
+    if (!watcher.start(error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    activeWatcher = &watcher;
+    std::signal(SIGINT, stopWatcher);
+    std::signal(SIGTERM, stopWatcher);
+
+    watcher.rebuildAll(std::cout, std::cerr);
+    std::cout << "Watching " << watchOptions.directory << " for changes" << std::endl;
+    watcher.run(std::cout, std::cerr);
+    activeWatcher = nullptr;
+    if (cache) std::cout << cache->stats().describe() << std::endl;
+    return 0;
 }
 
 /**
@@ -72,11 +524,30 @@ std::string removeComments(const std::string& source) {
  * @note Supports both file output and console output modes
  */
 int main(int argc, char* argv[]) {
-    cxxopts::Options options("gate", "A transpiler from NOTAL to Pascal.");
+    if (argc > 1 && std::string(argv[1]) == "run") {
+        return runProgram(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "batch") {
+        return batchMain(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "serve") {
+        return serveMain(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "client") {
+        return clientMain(argc - 1, argv + 1);
+    }
+    if (argc > 1 && std::string(argv[1]) == "watch") {
+        return watchMain(argc - 1, argv + 1);
+    }
+
+    cxxopts::Options options("gate", "A transpiler from NOTAL to Pascal or C.");
     options.add_options()
-        ("i,input", "Input NOTAL file", cxxopts::value<std::string>())
-        ("o,output", "Output Pascal file (optional)", cxxopts::value<std::string>()->default_value(""))
+        ("i,input", "Input NOTAL file, or - for standard input", cxxopts::value<std::string>())
+        ("o,output", "Output file (.pas, or .c with --target=c), or - for standard output (optional)", cxxopts::value<std::string>()->default_value(""))
+        ("cache-stats", "Print the cache hit statistics on stderr", cxxopts::value<bool>()->default_value("false"))
         ("h,help", "Print usage");
+    addCodeGenOptions(options);
+    addCacheOptions(options);
 
     options.parse_positional("input");
     options.positional_help("[<input file>]");
@@ -96,71 +567,67 @@ int main(int argc, char* argv[]) {
     std::string inputFile = result["input"].as<std::string>();
     std::string outputFile = result["output"].as<std::string>();
 
-    if (!outputFile.empty() && !gate::utils::InputValidator::isValidOutputPath(outputFile)) {
+    // Filter mode: `-` reads standard input and, unless -o names a file, writes
+    // the bare code to standard output, with one diagnostic per line on stderr.
+    bool fromStdin = inputFile == "-";
+    bool toStdout = outputFile == "-" || (fromStdin && outputFile.empty());
+    bool filter = fromStdin || toStdout;
+    if (filter) std::ios::sync_with_stdio(false);
+
+    gate::transpiler::CodeGenOptions codeGenOptions;
+    gate::driver::Target target = gate::driver::Target::PASCAL;
+    if (!readCodeGenOptions(result, codeGenOptions, target)) return 1;
+
+    if (!toStdout && !outputFile.empty() && !gate::driver::isValidOutputPath(outputFile, target)) {
         std::cerr << "Error: Invalid or potentially unsafe output file path: " << outputFile << std::endl;
         return 1;
     }
 
-    auto readResult = gate::utils::SecureFileReader::readFile(inputFile);
+    auto readResult = fromStdin ? gate::utils::SecureFileReader::readStream(std::cin)
+                                : gate::utils::SecureFileReader::readFile(inputFile);
     if (!readResult.success) {
         std::cerr << "Error: " << readResult.errorMessage << " (" << inputFile << ")" << std::endl;
         return 1;
     }
-    std::string sourceWithComments = readResult.content;
-
-    // The DiagnosticEngine needs the source code to provide context for errors.
-    std::string source = removeComments(sourceWithComments);
-    gate::diagnostics::DiagnosticEngine diagnosticEngine(source, inputFile);
-
-    // Perform preliminary source validation (optional, but good practice)
-    auto validationResult = gate::utils::InputValidator::validateNotalSource(sourceWithComments);
-    if (!validationResult.isValid) {
-        // Report a fatal error through the new system
-        gate::diagnostics::SourceLocation loc(inputFile, 0, 0);
-        auto diag = gate::diagnostics::Diagnostic::Builder(validationResult.errorMessage, loc)
-                        .withLevel(gate::diagnostics::DiagnosticLevel::FATAL)
-                        .build();
-        diagnosticEngine.report(diag);
-    }
-    for (const auto& warning : validationResult.warnings) {
-        gate::diagnostics::SourceLocation loc(inputFile, 0, 0);
-        auto diag = gate::diagnostics::Diagnostic::Builder(warning, loc)
-                        .withLevel(gate::diagnostics::DiagnosticLevel::WARNING)
-                        .build();
-        diagnosticEngine.report(diag);
-    }
-
-    // Lexical Analysis
-    gate::transpiler::NotalLexer lexer(source, inputFile);
-    std::vector<gate::core::Token> tokens = lexer.getAllTokens();
+    std::string sourceName = fromStdin ? "<stdin>" : inputFile;
 
-    // Syntax Analysis
-    gate::transpiler::NotalParser parser(tokens, diagnosticEngine);
-    std::shared_ptr<gate::ast::ProgramStmt> program = parser.parse();
-
-    // Code Generation
-    if (program && !diagnosticEngine.hasErrors()) {
-        gate::transpiler::PascalCodeGenerator generator;
-        std::string pascalCode = generator.generate(program);
+    // Validation, lexing, parsing and code generation, unless the cache has the result
+    auto cache = openCache(result);
+    gate::driver::TranspileResult transpiled =
+        gate::driver::transpileCached(cache.get(), readResult.content, sourceName, codeGenOptions, target);
+    if (cache && result["cache-stats"].as<bool>()) std::cerr << cache->stats().describe() << std::endl;
+    bool toC = target == gate::driver::Target::C;
 
-        if (!outputFile.empty()) {
+    bool written = true;
+    if (transpiled.success) {
+        if (toStdout) {
+            // The program is already one buffer: hand it over in a single write and flush.
+            std::cout.write(transpiled.code.data(), static_cast<std::streamsize>(transpiled.code.size()));
+            written = static_cast<bool>(std::cout.flush());
+            if (!written) std::cerr << "Error: Unable to write to standard output" << std::endl;
+        } else if (!outputFile.empty()) {
             std::ofstream outFile(outputFile);
             if (outFile.is_open()) {
-                outFile << pascalCode;
+                outFile << transpiled.code;
                 outFile.close();
-                std::cout << "Transpilation successful. Pascal code written to '" << outputFile << "'" << std::endl;
+                std::cout << "Transpilation successful. " << (toC ? "C" : "Pascal") << " code written to '" << outputFile << "'" << std::endl;
             } else {
                 std::cerr << "Error: Unable to open output file for writing: " << outputFile << std::endl;
             }
         } else {
-            std::cout << "\n" << pascalCode << std::endl;
+            std::cout << "\n" << transpiled.code << std::endl;
         }
     }
 
-    // Always print the diagnostic report
-    if (diagnosticEngine.hasErrors() || diagnosticEngine.hasWarnings()) {
-        std::cerr << diagnosticEngine.generateReport();
+    // Always print the diagnostics: one line each in filter mode, else the full report
+    if (filter) {
+        for (const auto& diagnostic : transpiled.diagnostics) {
+            std::cerr << gate::driver::diagnosticLine(sourceName, diagnostic) << "\n";
+        }
+        std::cerr.flush();
+    } else {
+        std::cerr << transpiled.report;
     }
-    
-    return diagnosticEngine.hasErrors() ? 1 : 0;
+
+    return transpiled.success && written ? 0 : 1;
 }
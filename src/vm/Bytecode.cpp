@@ -0,0 +1,45 @@
+/**
+ * @file Bytecode.cpp
+ * @brief Opcode names and module disassembly
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "vm/Bytecode.h"
+#include <sstream>
+
+namespace gate::vm {
+
+const char* opcodeName(OpCode op) {
+    static const char* const names[] = {
+#define GATE_VM_OPCODE_NAME(name) #name,
+        GATE_VM_OPCODES(GATE_VM_OPCODE_NAME)
+#undef GATE_VM_OPCODE_NAME
+    };
+    return names[static_cast<size_t>(op)];
+}
+
+/**
+ * @brief Lists every function with its instructions and source lines
+ *
+ * Used by `gate run --disassemble` to inspect what the compiler produced.
+ */
+std::string Module::disassemble() const {
+    std::ostringstream out;
+    out << "; " << constants.size() << " constants, " << types.size() << " types, " << globalCount << " globals\n";
+    for (size_t f = 0; f < functions.size(); ++f) {
+        const Function& function = functions[f];
+        out << "\nfunction " << f << " " << function.name << " (params " << function.paramCount
+            << ", registers " << function.registerCount << ")\n";
+        for (size_t pc = 0; pc < function.code.size(); ++pc) {
+            const Instruction& ins = function.code[pc];
+            out << "  " << pc << "\t" << opcodeName(ins.op) << "\t" << ins.a << " " << ins.b << " " << ins.c
+                << "\t; line " << function.lines[pc] << "\n";
+        }
+    }
+    return out.str();
+}
+
+} // namespace gate::vm
@@ -0,0 +1,1363 @@
+/**
+ * @file BytecodeCompiler.cpp
+ * @brief Implementation of the NOTAL to bytecode compiler
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "vm/BytecodeCompiler.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <set>
+#include <stdexcept>
+
+namespace gate::vm {
+
+using namespace gate::ast;
+using core::Token;
+using core::TokenType;
+
+namespace {
+
+std::string lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+bool isOrdinal(ValueKind kind) {
+    return kind == ValueKind::INTEGER || kind == ValueKind::CHARACTER || kind == ValueKind::ENUM || kind == ValueKind::BOOLEAN;
+}
+
+} // namespace
+
+// --- Module level ---
+
+BytecodeCompiler::BytecodeCompiler(int integerBits) : integerBits_(integerBits) {}
+
+Module BytecodeCompiler::compile(std::shared_ptr<ProgramStmt> program) {
+    module_ = Module{};
+    module_.types = {
+        TypeInfo{TypeKind::INTEGER, "integer", {}, {}},
+        TypeInfo{TypeKind::REAL, "real", {}, {}},
+        TypeInfo{TypeKind::BOOLEAN, "boolean", {}, {}},
+        TypeInfo{TypeKind::CHARACTER, "character", {}, {}},
+        TypeInfo{TypeKind::STRING, "string", {}, {}},
+        TypeInfo{TypeKind::NIL, "NULL", {}, {}},
+    };
+    typeNames_.clear();
+    constants_.clear();
+    globals_.clear();
+    locals_.clear();
+    subprograms_.clear();
+    module_.integerBits = integerBits_;
+    transpiler::ConstantEvaluatorLimits limits;
+    limits.integerBits = integerBits_;
+    evaluator_ = std::make_unique<transpiler::ConstantEvaluator>(program, limits);
+    program->accept(*this);
+    return std::move(module_);
+}
+
+/**
+ * @brief Compiles the program: declarations, the main algorithm, then every subprogram
+ *
+ * Subprogram signatures are collected first so calls can be compiled before
+ * the callee. The main algorithm is the last function of the module.
+ */
+std::any BytecodeCompiler::visit(std::shared_ptr<ProgramStmt> stmt) {
+    int index = 0;
+    for (const auto& sub : stmt->subprograms) {
+        std::string name;
+        if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(sub)) name = proc->name.lexeme;
+        else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(sub)) name = func->name.lexeme;
+        else continue;
+        subprograms_[lower(name)].index = index++;
+    }
+    module_.functions.resize(index + 1);
+    module_.main = index;
+
+    function_ = &module_.functions[module_.main];
+    function_->name = "main";
+    inMain_ = true;
+    nextRegister_ = 0;
+    scope_ = &globals_;
+    if (stmt->kamus) execute(stmt->kamus);
+    module_.globalCount = nextRegister_;
+
+    // Signatures need the declared types, so they are resolved after the KAMUS
+    for (const auto& sub : stmt->subprograms) declareSubprogram(sub);
+
+    if (stmt->algoritma) execute(stmt->algoritma);
+    emit(OpCode::HALT);
+
+    for (const auto& sub : stmt->subprograms) execute(sub);
+    return {};
+}
+
+/**
+ * @brief Declares the types, constants and variables of a KAMUS
+ *
+ * Record names are registered before any field is resolved, so a record can
+ * hold a pointer to itself or to a record declared after it. Variables get
+ * the next free registers of the current frame and are initialized to the
+ * default value of their type.
+ */
+std::any BytecodeCompiler::visit(std::shared_ptr<KamusStmt> stmt) {
+    for (const auto& decl : stmt->declarations) {
+        if (auto record = std::dynamic_pointer_cast<RecordTypeDeclStmt>(decl)) {
+            TypeInfo info{TypeKind::RECORD, record->typeName.lexeme, {}, {}};
+            typeNames_[lower(record->typeName.lexeme)] = static_cast<int>(module_.types.size());
+            module_.types.push_back(info);
+        } else if (std::dynamic_pointer_cast<EnumTypeDeclStmt>(decl)) {
+            execute(decl);
+        }
+    }
+    for (const auto& decl : stmt->declarations) {
+        if (std::dynamic_pointer_cast<RecordTypeDeclStmt>(decl) || std::dynamic_pointer_cast<ConstDeclStmt>(decl)) execute(decl);
+    }
+    for (const auto& decl : stmt->declarations) {
+        if (std::dynamic_pointer_cast<VarDeclStmt>(decl) || std::dynamic_pointer_cast<StaticArrayDeclStmt>(decl) ||
+            std::dynamic_pointer_cast<DynamicArrayDeclStmt>(decl) || std::dynamic_pointer_cast<ConstrainedVarDeclStmt>(decl)) {
+            execute(decl);
+        }
+    }
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<RecordTypeDeclStmt> stmt) {
+    int id = typeNames_.at(lower(stmt->typeName.lexeme));
+    for (const auto& field : stmt->fields) {
+        int type = resolveType(field.type, field.pointedToType);
+        module_.types[id].names.push_back(field.name.lexeme);
+        module_.types[id].fieldTypes.push_back(type);
+    }
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<EnumTypeDeclStmt> stmt) {
+    int id = static_cast<int>(module_.types.size());
+    TypeInfo info{TypeKind::ENUM, stmt->typeName.lexeme, {}, {}};
+    for (size_t i = 0; i < stmt->values.size(); ++i) {
+        info.names.push_back(stmt->values[i].lexeme);
+        constants_[lower(stmt->values[i].lexeme)] = {addConstant(Value::enumeration(static_cast<int64_t>(i))), id};
+    }
+    typeNames_[lower(stmt->typeName.lexeme)] = id;
+    module_.types.push_back(info);
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<ConstDeclStmt> stmt) {
+    Value value;
+    int type = TYPE_INTEGER;
+    if (!foldConstant(stmt->initializer, value, type)) {
+        error("The value of constant '" + stmt->name.lexeme + "' is not a constant expression.");
+    }
+    if (!stmt->type.lexeme.empty() && stmt->type.type == TokenType::REAL && type == TYPE_INTEGER) {
+        value = Value::real(static_cast<double>(value.i));
+        type = TYPE_REAL;
+    }
+    constants_[lower(stmt->name.lexeme)] = {addConstant(value), type};
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<VarDeclStmt> stmt) {
+    int type = resolveType(stmt->type, stmt->pointedToType);
+    for (const auto& name : stmt->names) declareVariable(name.lexeme, type, nullptr);
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<ConstrainedVarDeclStmt> stmt) {
+    int type = resolveType(stmt->type);
+    for (const auto& name : stmt->names) declareVariable(name.lexeme, type, stmt);
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<StaticArrayDeclStmt> stmt) {
+    int type = resolveType(stmt->elementType);
+    for (auto dim = stmt->dimensions.rbegin(); dim != stmt->dimensions.rend(); ++dim) {
+        Value low, high;
+        int lowType = TYPE_INTEGER, highType = TYPE_INTEGER;
+        if (!foldConstant(dim->start, low, lowType) || !foldConstant(dim->end, high, highType) ||
+            !isOrdinal(low.kind) || !isOrdinal(high.kind)) {
+            error("Array bounds of '" + stmt->names[0].lexeme + "' must be ordinal constants.");
+        }
+        TypeInfo info{TypeKind::STATIC_ARRAY, "", {}, {}};
+        info.element = type;
+        info.low = low.i;
+        info.high = high.i;
+        type = derivedType(info);
+    }
+    for (const auto& name : stmt->names) declareVariable(name.lexeme, type, nullptr);
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<DynamicArrayDeclStmt> stmt) {
+    int type = resolveType(stmt->elementType);
+    for (int i = 0; i < stmt->dimensions; ++i) {
+        TypeInfo info{TypeKind::DYNAMIC_ARRAY, "", {}, {}};
+        info.element = type;
+        type = derivedType(info);
+    }
+    for (const auto& name : stmt->names) declareVariable(name.lexeme, type, nullptr);
+    return {};
+}
+
+void BytecodeCompiler::declareVariable(const std::string& name, int type, std::shared_ptr<ConstrainedVarDeclStmt> constraint) {
+    Slot slot;
+    slot.index = allocRegister();
+    slot.type = type;
+    slot.constraint = std::move(constraint);
+    (*scope_)[lower(name)] = slot;
+    emit(OpCode::INIT, slot.index, type);
+}
+
+void BytecodeCompiler::declareSubprogram(std::shared_ptr<Statement> stmt) {
+    const std::vector<Parameter>* params = nullptr;
+    Subprogram* sub = nullptr;
+    if (auto proc = std::dynamic_pointer_cast<ProcedureStmt>(stmt)) {
+        sub = &subprograms_[lower(proc->name.lexeme)];
+        params = &proc->params;
+        sub->returnType = -1;
+    } else if (auto func = std::dynamic_pointer_cast<FunctionStmt>(stmt)) {
+        sub = &subprograms_[lower(func->name.lexeme)];
+        params = &func->params;
+        sub->returnType = resolveType(func->returnType);
+    } else {
+        return;
+    }
+    sub->params = *params;
+    for (const auto& param : *params) sub->paramTypes.push_back(resolveType(param.type));
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<ProcedureStmt> stmt) {
+    compileSubprogram(stmt->name.lexeme, stmt->kamus, stmt->body);
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<FunctionStmt> stmt) {
+    compileSubprogram(stmt->name.lexeme, stmt->kamus, stmt->body);
+    return {};
+}
+
+/**
+ * @brief Compiles one subprogram into its function of the module
+ *
+ * Parameters take registers 0..n-1, where the caller left the arguments.
+ * Input parameters hold their value; output and input/output parameters
+ * hold the address of the caller's variable.
+ */
+void BytecodeCompiler::compileSubprogram(const std::string& name, std::shared_ptr<KamusStmt> kamus, std::shared_ptr<AlgoritmaStmt> body) {
+    const Subprogram& sub = subprograms_.at(lower(name));
+    function_ = &module_.functions[sub.index];
+    function_->name = name;
+    function_->paramCount = static_cast<int>(sub.params.size());
+    inMain_ = false;
+    returnType_ = sub.returnType;
+    locals_.clear();
+    loops_.clear();
+    nextRegister_ = 0;
+    scope_ = &locals_;
+
+    for (size_t i = 0; i < sub.params.size(); ++i) {
+        Slot slot;
+        slot.kind = sub.params[i].mode == ParameterMode::INPUT ? Slot::Kind::LOCAL : Slot::Kind::REF;
+        slot.index = allocRegister();
+        slot.type = sub.paramTypes[i];
+        locals_[lower(sub.params[i].name.lexeme)] = slot;
+    }
+    // `-> value` only sets the result, as in Pascal; a function that never
+    // sets it returns the default value of the result type
+    result_ = -1;
+    if (returnType_ >= 0) {
+        result_ = allocRegister();
+        emit(OpCode::INIT, result_, returnType_);
+    }
+    for (const auto& param : sub.params) {
+        if (!param.constraint) continue;
+        // Constrained input parameters are checked on entry only
+        line_ = param.name.line;
+        Slot checked = locals_.at(lower(param.name.lexeme));
+        checked.constraint = std::make_shared<ConstrainedVarDeclStmt>(std::vector<Token>{param.name}, param.type, param.constraint);
+        checkConstraint(checked, param.name.lexeme);
+    }
+    if (kamus) execute(kamus);
+    if (body) execute(body);
+    emit(OpCode::RET, result_);
+}
+
+// --- Types and constants ---
+
+int BytecodeCompiler::resolveType(const Token& type, const Token& pointedToType) {
+    switch (type.type) {
+        case TokenType::INTEGER: return TYPE_INTEGER;
+        case TokenType::REAL: return TYPE_REAL;
+        case TokenType::BOOLEAN: return TYPE_BOOLEAN;
+        case TokenType::CHARACTER: return TYPE_CHARACTER;
+        case TokenType::STRING: return TYPE_STRING;
+        case TokenType::NULL_TYPE: return TYPE_NIL;
+        case TokenType::POINTER: {
+            TypeInfo info{TypeKind::POINTER, "", {}, {}};
+            info.element = resolveType(pointedToType);
+            return derivedType(info);
+        }
+        case TokenType::IDENTIFIER: {
+            auto it = typeNames_.find(lower(type.lexeme));
+            if (it == typeNames_.end()) error("Unknown type '" + type.lexeme + "'.");
+            return it->second;
+        }
+        default:
+            error("Unknown type '" + type.lexeme + "'.");
+    }
+}
+
+int BytecodeCompiler::derivedType(TypeInfo info) {
+    for (size_t i = BASIC_TYPE_COUNT; i < module_.types.size(); ++i) {
+        const TypeInfo& known = module_.types[i];
+        if (known.kind == info.kind && known.name.empty() && known.element == info.element &&
+            known.low == info.low && known.high == info.high) {
+            return static_cast<int>(i);
+        }
+    }
+    module_.types.push_back(std::move(info));
+    return static_cast<int>(module_.types.size() - 1);
+}
+
+bool BytecodeCompiler::isCompound(int type) const {
+    if (type < 0) return false;
+    TypeKind kind = module_.types[type].kind;
+    return kind == TypeKind::RECORD || kind == TypeKind::STATIC_ARRAY;
+}
+
+/**
+ * @brief Evaluates a constant expression at compile time
+ *
+ * Covers literals, named constants and enum values, and the arithmetic,
+ * concatenation and negation of those, and calls to pure functions. Used
+ * for constant declarations and static array bounds.
+ */
+bool BytecodeCompiler::foldConstant(std::shared_ptr<Expression> expr, Value& value, int& type) {
+    if (auto literal = std::dynamic_pointer_cast<Literal>(expr)) {
+        const std::any& v = literal->value;
+        if (v.type() == typeid(int)) { value = Value::integer(std::any_cast<int>(v)); type = TYPE_INTEGER; return true; }
+        if (v.type() == typeid(double)) { value = Value::real(std::any_cast<double>(v)); type = TYPE_REAL; return true; }
+        if (v.type() == typeid(bool)) { value = Value::boolean(std::any_cast<bool>(v)); type = TYPE_BOOLEAN; return true; }
+        if (v.type() == typeid(std::string)) {
+            const auto& text = std::any_cast<const std::string&>(v);
+            if (text.size() == 1) { value = Value::character(static_cast<unsigned char>(text[0])); type = TYPE_CHARACTER; }
+            else { value = Value::string(text); type = TYPE_STRING; }
+            return true;
+        }
+        value = Value::nil();
+        type = TYPE_NIL;
+        return true;
+    }
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) return foldConstant(grouping->expression, value, type);
+    if (auto variable = std::dynamic_pointer_cast<Variable>(expr)) {
+        auto it = constants_.find(lower(variable->name.lexeme));
+        if (it == constants_.end()) return false;
+        value = module_.constants[it->second.first];
+        type = it->second.second;
+        return true;
+    }
+    if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) {
+        if (!foldConstant(unary->right, value, type)) return false;
+        if (unary->op.type == TokenType::MINUS && value.kind == ValueKind::INTEGER) { value.i = -value.i; return fitsInteger(value.i); }
+        if (unary->op.type == TokenType::MINUS && value.kind == ValueKind::REAL) { value.r = -value.r; return true; }
+        if (unary->op.type == TokenType::NOT && value.kind == ValueKind::BOOLEAN) { value.i = !value.i; return true; }
+        return false;
+    }
+    if (auto call = std::dynamic_pointer_cast<Call>(expr)) {
+        // A call to a pure function is run now, as the code generators do
+        if (!evaluator_ || !evaluator_->callsFunction(call)) return false;
+        std::set<std::string> shadowed;
+        for (const auto& local : locals_) shadowed.insert(local.first);
+        std::string reason;
+        auto literal = evaluator_->evaluate(call, shadowed, reason);
+        return literal && foldConstant(literal, value, type);
+    }
+    if (auto binary = std::dynamic_pointer_cast<Binary>(expr)) {
+        Value left, right;
+        int leftType = 0, rightType = 0;
+        if (!foldConstant(binary->left, left, leftType) || !foldConstant(binary->right, right, rightType)) return false;
+        TokenType op = binary->op.type;
+        bool stringish = (left.kind == ValueKind::STRING || left.kind == ValueKind::CHARACTER) &&
+                         (right.kind == ValueKind::STRING || right.kind == ValueKind::CHARACTER);
+        if (stringish && (op == TokenType::PLUS || op == TokenType::AMPERSAND)) {
+            auto text = [](const Value& v) { return v.kind == ValueKind::STRING ? v.text() : std::string(1, static_cast<char>(v.i)); };
+            value = Value::string(text(left) + text(right));
+            type = TYPE_STRING;
+            return true;
+        }
+        if (left.kind == ValueKind::INTEGER && right.kind == ValueKind::INTEGER) {
+            type = TYPE_INTEGER;
+            switch (op) {
+                case TokenType::PLUS: value = Value::integer(left.i + right.i); return fitsInteger(value.i);
+                case TokenType::MINUS: value = Value::integer(left.i - right.i); return fitsInteger(value.i);
+                case TokenType::MULTIPLY: value = Value::integer(left.i * right.i); return fitsInteger(value.i);
+                case TokenType::DIV: if (right.i == 0) return false; value = Value::integer(left.i / right.i); return true;
+                case TokenType::MOD: if (right.i == 0) return false; value = Value::integer(left.i % right.i); return true;
+                default: break;
+            }
+        }
+        bool numeric = (left.kind == ValueKind::INTEGER || left.kind == ValueKind::REAL) &&
+                       (right.kind == ValueKind::INTEGER || right.kind == ValueKind::REAL);
+        if (numeric) {
+            double l = left.kind == ValueKind::REAL ? left.r : static_cast<double>(left.i);
+            double r = right.kind == ValueKind::REAL ? right.r : static_cast<double>(right.i);
+            type = TYPE_REAL;
+            switch (op) {
+                case TokenType::PLUS: value = Value::real(l + r); return true;
+                case TokenType::MINUS: value = Value::real(l - r); return true;
+                case TokenType::MULTIPLY: value = Value::real(l * r); return true;
+                case TokenType::DIVIDE: if (r == 0.0) return false; value = Value::real(l / r); return true;
+                default: break;
+            }
+        }
+    }
+    return false;
+}
+
+/** @brief Whether a folded integer fits the program's integer type, as it must at run time */
+bool BytecodeCompiler::fitsInteger(int64_t value) const {
+    int64_t limit = int64_t(1) << (integerBits_ - 1);
+    return value >= -limit && value < limit;
+}
+
+int BytecodeCompiler::addConstant(const Value& value) {
+    for (size_t i = 0; i < module_.constants.size(); ++i) {
+        const Value& known = module_.constants[i];
+        if (known.kind != value.kind) continue;
+        if (value.kind == ValueKind::STRING ? known.text() == value.text() : known.i == value.i) return static_cast<int>(i);
+    }
+    module_.constants.push_back(value);
+    return static_cast<int>(module_.constants.size() - 1);
+}
+
+// --- Emission helpers ---
+
+size_t BytecodeCompiler::emit(OpCode op, int a, int b, int c) {
+    function_->code.push_back(Instruction{op, a, b, c});
+    function_->lines.push_back(line_);
+    return function_->code.size() - 1;
+}
+
+void BytecodeCompiler::patch(size_t at, size_t target) {
+    Instruction& ins = function_->code[at];
+    int32_t value = static_cast<int32_t>(target);
+    switch (ins.op) {
+        case OpCode::JMP: ins.a = value; break;
+        case OpCode::JMPF:
+        case OpCode::JMPT: ins.b = value; break;
+        default: ins.c = value; break;
+    }
+}
+
+size_t BytecodeCompiler::here() const {
+    return function_->code.size();
+}
+
+int BytecodeCompiler::allocRegister() {
+    int reg = nextRegister_++;
+    function_->registerCount = std::max(function_->registerCount, nextRegister_);
+    return reg;
+}
+
+void BytecodeCompiler::execute(std::shared_ptr<Statement> stmt) {
+    if (!stmt) return;
+    int savedLine = line_;
+    if (stmt->line > 0) line_ = stmt->line;
+    stmt->accept(*this);
+    line_ = savedLine;
+}
+
+void BytecodeCompiler::error(const std::string& message) const {
+    if (line_ > 0) throw std::runtime_error("Line " + std::to_string(line_) + ": " + message);
+    throw std::runtime_error(message);
+}
+
+// --- Statements ---
+
+std::any BytecodeCompiler::visit(std::shared_ptr<AlgoritmaStmt> stmt) {
+    execute(stmt->body);
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<BlockStmt> stmt) {
+    for (const auto& s : stmt->statements) {
+        // Temporaries of a statement are dead once it is done
+        int mark = nextRegister_;
+        execute(s);
+        nextRegister_ = mark;
+    }
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<ExpressionStmt> stmt) {
+    if (auto call = std::dynamic_pointer_cast<Call>(stmt->expression)) {
+        compileCall(call, -1);
+    } else {
+        compileExpression(stmt->expression, allocRegister());
+    }
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<InputStmt> stmt) {
+    Slot slot;
+    if (!lookup(stmt->variable->name.lexeme, slot)) error("Unknown variable '" + stmt->variable->name.lexeme + "'.");
+    if (slot.type > TYPE_STRING) error("Cannot read a value of type " + module_.types[slot.type].name + " from input.");
+    int value = allocRegister();
+    emit(OpCode::READ, value, slot.type);
+    storeSlot(slot, value);
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<OutputStmt> stmt) {
+    for (const auto& expr : stmt->expressions) {
+        int reg;
+        int type = operand(expr, reg);
+        if (type < 0 || (type > TYPE_STRING && module_.types[type].kind != TypeKind::ENUM)) {
+            error("Only integers, reals, booleans, characters, strings and enum values can be written.");
+        }
+        emit(OpCode::WRITE, reg, type);
+    }
+    emit(OpCode::WRITELN);
+    return {};
+}
+
+void BytecodeCompiler::compileCondition(std::shared_ptr<Expression> expr, std::vector<size_t>& falseJumps) {
+    int mark = nextRegister_;
+    int reg;
+    operand(expr, reg);
+    falseJumps.push_back(emit(OpCode::JMPF, reg));
+    nextRegister_ = mark;
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<IfStmt> stmt) {
+    std::vector<size_t> falseJumps;
+    compileCondition(stmt->condition, falseJumps);
+    execute(stmt->thenBranch);
+    if (stmt->elseBranch) {
+        size_t end = emit(OpCode::JMP);
+        for (size_t jump : falseJumps) patch(jump, here());
+        execute(stmt->elseBranch);
+        patch(end, here());
+    } else {
+        for (size_t jump : falseJumps) patch(jump, here());
+    }
+    return {};
+}
+
+void BytecodeCompiler::closeLoop(size_t continueTarget, size_t breakTarget) {
+    Loop loop = std::move(loops_.back());
+    loops_.pop_back();
+    for (size_t jump : loop.continues) patch(jump, continueTarget);
+    for (size_t jump : loop.breaks) patch(jump, breakTarget);
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<WhileStmt> stmt) {
+    size_t top = here();
+    std::vector<size_t> exits;
+    compileCondition(stmt->condition, exits);
+    loops_.emplace_back();
+    execute(stmt->body);
+    emit(OpCode::JMP, static_cast<int>(top));
+    for (size_t jump : exits) patch(jump, here());
+    closeLoop(top, here());
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<RepeatUntilStmt> stmt) {
+    size_t top = here();
+    loops_.emplace_back();
+    execute(stmt->body);
+    size_t check = here();
+    std::vector<size_t> again;
+    compileCondition(stmt->condition, again);
+    for (size_t jump : again) patch(jump, top);
+    closeLoop(check, here());
+    return {};
+}
+
+/**
+ * @brief Compiles `iterate ... stop (condition)`
+ *
+ * Like the generated `while true` loop, `skip` goes back to the top of the
+ * body without testing the condition.
+ */
+std::any BytecodeCompiler::visit(std::shared_ptr<IterateStopStmt> stmt) {
+    size_t top = here();
+    loops_.emplace_back();
+    execute(stmt->body);
+    int mark = nextRegister_;
+    int reg;
+    operand(stmt->condition, reg);
+    size_t exit = emit(OpCode::JMPT, reg);
+    nextRegister_ = mark;
+    emit(OpCode::JMP, static_cast<int>(top));
+    patch(exit, here());
+    closeLoop(top, here());
+    return {};
+}
+
+/**
+ * @brief Compiles `i traversal [start..end] step s`
+ *
+ * The end bound is evaluated before every trip, as in the generated while
+ * loop. `skip` jumps to the increment, so the iterator always advances.
+ * `traversal paralel` runs sequentially.
+ */
+std::any BytecodeCompiler::visit(std::shared_ptr<TraversalStmt> stmt) {
+    Slot slot;
+    if (!lookup(stmt->iterator.lexeme, slot)) error("Unknown traversal iterator '" + stmt->iterator.lexeme + "'.");
+
+    int mark = nextRegister_;
+    int start = allocRegister();
+    convert(start, compileExpression(stmt->start, start), slot.type);
+    storeSlot(slot, start);
+    nextRegister_ = mark;
+
+    int iterator = slot.kind == Slot::Kind::LOCAL ? slot.index : allocRegister();
+    int loopMark = nextRegister_;
+    size_t top = here();
+    if (slot.kind != Slot::Kind::LOCAL) loadSlot(slot, iterator);
+    int end;
+    operand(stmt->end, end);
+    size_t exit = emit(OpCode::JGT, iterator, end);
+    nextRegister_ = loopMark;
+
+    loops_.emplace_back();
+    execute(stmt->body);
+    nextRegister_ = loopMark;
+
+    size_t next = here();
+    if (slot.kind != Slot::Kind::LOCAL) loadSlot(slot, iterator);
+    Value step = Value::integer(1);
+    int stepType = TYPE_INTEGER;
+    if (!stmt->step || (foldConstant(stmt->step, step, stepType) && step.kind == ValueKind::INTEGER &&
+                        step.i >= std::numeric_limits<int32_t>::min() && step.i <= std::numeric_limits<int32_t>::max())) {
+        emit(OpCode::ADDI, iterator, iterator, static_cast<int>(step.i));
+    } else {
+        int reg;
+        operand(stmt->step, reg);
+        emit(OpCode::ADD, iterator, iterator, reg);
+    }
+    if (slot.kind != Slot::Kind::LOCAL) storeSlot(slot, iterator);
+    emit(OpCode::JMP, static_cast<int>(top));
+    patch(exit, here());
+    closeLoop(next, here());
+    nextRegister_ = mark;
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<RepeatNTimesStmt> stmt) {
+    int mark = nextRegister_;
+    int times = allocRegister();
+    compileExpression(stmt->times, times);
+    int counter = allocRegister();
+    emit(OpCode::LOADI, counter, 1);
+    size_t top = here();
+    size_t exit = emit(OpCode::JGT, counter, times);
+    loops_.emplace_back();
+    execute(stmt->body);
+    size_t next = here();
+    emit(OpCode::ADDI, counter, counter, 1);
+    emit(OpCode::JMP, static_cast<int>(top));
+    patch(exit, here());
+    closeLoop(next, here());
+    nextRegister_ = mark;
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<StopStmt> stmt) {
+    (void)stmt;
+    if (loops_.empty()) error("'stop' used outside of a loop.");
+    loops_.back().breaks.push_back(emit(OpCode::JMP));
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<SkipStmt> stmt) {
+    (void)stmt;
+    if (loops_.empty()) error("'skip' used outside of a loop.");
+    loops_.back().continues.push_back(emit(OpCode::JMP));
+    return {};
+}
+
+/**
+ * @brief Compiles `depend on`
+ *
+ * Chooses between the two forms the Pascal generator emits: a case over a
+ * single subject when the conditions are literals or names, otherwise a
+ * chain of ifs on the first condition of each branch.
+ */
+std::any BytecodeCompiler::visit(std::shared_ptr<DependOnStmt> stmt) {
+    bool simpleConditions = true;
+    for (const auto& caseItem : stmt->cases) {
+        for (const auto& cond : caseItem.conditions) {
+            if (!std::dynamic_pointer_cast<Literal>(cond) && !std::dynamic_pointer_cast<Variable>(cond)) simpleConditions = false;
+        }
+    }
+
+    std::vector<size_t> ends;
+    int mark = nextRegister_;
+    if (simpleConditions && stmt->expressions.size() == 1) {
+        int subject = allocRegister();
+        compileExpression(stmt->expressions[0], subject);
+        for (const auto& caseItem : stmt->cases) {
+            std::vector<size_t> matches;
+            int caseMark = nextRegister_;
+            for (const auto& cond : caseItem.conditions) {
+                int value;
+                operand(cond, value);
+                int test = allocRegister();
+                emit(OpCode::EQ, test, subject, value);
+                matches.push_back(emit(OpCode::JMPT, test));
+                nextRegister_ = caseMark;
+            }
+            size_t next = emit(OpCode::JMP);
+            for (size_t jump : matches) patch(jump, here());
+            execute(caseItem.body);
+            ends.push_back(emit(OpCode::JMP));
+            patch(next, here());
+        }
+    } else {
+        for (const auto& caseItem : stmt->cases) {
+            std::vector<size_t> falseJumps;
+            compileCondition(caseItem.conditions[0], falseJumps);
+            execute(caseItem.body);
+            ends.push_back(emit(OpCode::JMP));
+            for (size_t jump : falseJumps) patch(jump, here());
+        }
+    }
+    if (stmt->otherwiseBranch) execute(stmt->otherwiseBranch);
+    for (size_t jump : ends) patch(jump, here());
+    nextRegister_ = mark;
+    return {};
+}
+
+/**
+ * @brief Compiles `-> value`, which sets the result without leaving the function
+ *
+ * This matches the generated Pascal (`Name := value`) and C, where the
+ * function runs on to its end and returns the last value set.
+ */
+std::any BytecodeCompiler::visit(std::shared_ptr<ReturnStmt> stmt) {
+    if (inMain_ || returnType_ < 0) error("Return statement used outside of a function.");
+    int mark = nextRegister_;
+    int value = allocRegister();
+    int type = compileExpression(stmt->value, value);
+    emit(OpCode::MOVE, result_, prepareStore(value, type, returnType_));
+    nextRegister_ = mark;
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<AllocateStmt> stmt) {
+    if (stmt->sizes.empty()) {
+        int pointer = allocRegister();
+        int type = compileExpression(stmt->callee, pointer);
+        if (type < 0 || module_.types[type].kind != TypeKind::POINTER) error("allocate without sizes needs a pointer.");
+        emit(OpCode::NEWBOX, pointer, module_.types[type].element);
+        assign(stmt->callee, pointer, type);
+        return {};
+    }
+    int array;
+    int type = operand(stmt->callee, array);
+    int levels = 0;
+    for (int t = type; t >= 0 && module_.types[t].kind == TypeKind::DYNAMIC_ARRAY; t = module_.types[t].element) ++levels;
+    if (levels == 0) error("allocate with sizes needs a dynamic array.");
+    if (static_cast<int>(stmt->sizes.size()) > levels) error("allocate gives more sizes than the array has dimensions.");
+    int first = nextRegister_;
+    for (const auto& size : stmt->sizes) {
+        int reg = allocRegister();
+        compileExpression(size, reg);
+    }
+    emit(OpCode::ALLOC, array, first, static_cast<int>(stmt->sizes.size()));
+    return {};
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<DeallocateStmt> stmt) {
+    int reg;
+    int type = operand(stmt->callee, reg);
+    if (stmt->dimension == -1) {
+        if (type < 0 || module_.types[type].kind != TypeKind::POINTER) error("deallocate without a dimension needs a pointer.");
+        emit(OpCode::DISPOSE, reg);
+        return {};
+    }
+    int levels = 0;
+    for (int t = type; t >= 0 && module_.types[t].kind == TypeKind::DYNAMIC_ARRAY; t = module_.types[t].element) ++levels;
+    if (levels == 0) error("deallocate with a dimension needs a dynamic array.");
+    if (levels != stmt->dimension) {
+        error("Deallocation dimension mismatch. Declared: " + std::to_string(levels) + ", Used: " + std::to_string(stmt->dimension));
+    }
+    emit(OpCode::FREE, reg);
+    return {};
+}
+
+// --- Variables ---
+
+bool BytecodeCompiler::lookup(const std::string& name, Slot& slot) const {
+    std::string key = lower(name);
+    auto local = locals_.find(key);
+    if (!inMain_ && local != locals_.end()) {
+        slot = local->second;
+        return true;
+    }
+    auto global = globals_.find(key);
+    if (global == globals_.end()) return false;
+    slot = global->second;
+    if (!inMain_) slot.kind = Slot::Kind::GLOBAL;
+    return true;
+}
+
+void BytecodeCompiler::loadSlot(const Slot& slot, int dest) {
+    switch (slot.kind) {
+        case Slot::Kind::LOCAL: if (slot.index != dest) emit(OpCode::MOVE, dest, slot.index); break;
+        case Slot::Kind::REF: emit(OpCode::LOAD, dest, slot.index); break;
+        case Slot::Kind::GLOBAL: emit(OpCode::GETG, dest, slot.index); break;
+    }
+}
+
+void BytecodeCompiler::storeSlot(const Slot& slot, int value) {
+    switch (slot.kind) {
+        case Slot::Kind::LOCAL: if (slot.index != value) emit(OpCode::MOVE, slot.index, value); break;
+        case Slot::Kind::REF: emit(OpCode::STORE, slot.index, value); break;
+        case Slot::Kind::GLOBAL: emit(OpCode::SETG, slot.index, value); break;
+    }
+}
+
+void BytecodeCompiler::checkConstraint(const Slot& slot, const std::string& name) {
+    if (!slot.constraint) return;
+    int reg;
+    operand(slot.constraint->constraint, reg);
+    emit(OpCode::CHECK, reg, addConstant(Value::string("Error: " + name + " constraint violation!")));
+}
+
+/**
+ * @brief Converts a value register to the type it is stored as
+ *
+ * Integers widen to reals and characters to strings; a one-character
+ * string literal narrows to a character.
+ */
+void BytecodeCompiler::convert(int reg, int from, int to) {
+    if (to == TYPE_REAL && from == TYPE_INTEGER) emit(OpCode::TOREAL, reg, reg);
+    else if (to == TYPE_CHARACTER && from == TYPE_STRING) emit(OpCode::TOCHAR, reg, reg);
+    else if (to == TYPE_STRING && from == TYPE_CHARACTER) emit(OpCode::TOSTRING, reg, reg);
+}
+
+int BytecodeCompiler::prepareStore(int value, int from, int to) {
+    bool converts = (to == TYPE_REAL && from == TYPE_INTEGER) || (to == TYPE_CHARACTER && from == TYPE_STRING) ||
+                    (to == TYPE_STRING && from == TYPE_CHARACTER);
+    if (!converts && !isCompound(to)) return value;
+    // Never convert in place: the value register may belong to another variable
+    int reg = allocRegister();
+    if (converts) {
+        emit(OpCode::MOVE, reg, value);
+        convert(reg, from, to);
+    } else {
+        emit(OpCode::COPY, reg, value);
+    }
+    return reg;
+}
+
+/**
+ * @brief Stores a value into an assignable expression
+ *
+ * Array elements, record fields and pointer targets are written through
+ * their container, which registers share with the variable that owns it.
+ * Strings are values, so setting a character writes the whole string back.
+ */
+void BytecodeCompiler::assign(std::shared_ptr<Expression> target, int value, int type) {
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(target)) {
+        assign(grouping->expression, value, type);
+        return;
+    }
+    if (auto variable = std::dynamic_pointer_cast<Variable>(target)) {
+        Slot slot;
+        if (!lookup(variable->name.lexeme, slot)) {
+            if (constants_.count(lower(variable->name.lexeme))) error("Cannot assign to constant '" + variable->name.lexeme + "'.");
+            error("Unknown variable '" + variable->name.lexeme + "'.");
+        }
+        storeSlot(slot, prepareStore(value, type, slot.type));
+        checkConstraint(slot, variable->name.lexeme);
+        return;
+    }
+    if (auto access = std::dynamic_pointer_cast<ArrayAccess>(target)) {
+        int container;
+        int containerType = accessPrefix(access, access->indices.size() - 1, container, !containsCall(access));
+        int index;
+        operand(access->indices.back(), index);
+        if (containerType == TYPE_STRING) {
+            int character = prepareStore(value, type, TYPE_CHARACTER);
+            Slot slot;
+            auto variable = std::dynamic_pointer_cast<Variable>(access->callee);
+            if (access->indices.size() == 1 && variable && lookup(variable->name.lexeme, slot) &&
+                slot.kind == Slot::Kind::LOCAL) {
+                emit(OpCode::SETCHAR, slot.index, index, character);
+                return;
+            }
+            int text = allocRegister();
+            emit(OpCode::MOVE, text, container);
+            emit(OpCode::SETCHAR, text, index, character);
+            std::shared_ptr<Expression> owner = access->callee;
+            if (access->indices.size() > 1) {
+                std::vector<std::shared_ptr<Expression>> indices(access->indices.begin(), access->indices.end() - 1);
+                owner = std::make_shared<ArrayAccess>(access->callee, access->bracket, indices);
+            }
+            assign(owner, text, TYPE_STRING);
+            return;
+        }
+        emit(OpCode::SETINDEX, container, index, prepareStore(value, type, elementType(containerType)));
+        return;
+    }
+    if (auto field = std::dynamic_pointer_cast<FieldAccess>(target)) {
+        int record;
+        int recordType = containerOperand(field->object, record, !containsCall(field));
+        int index = fieldIndex(recordType, field->name.lexeme);
+        emit(OpCode::SETFIELD, record, index, prepareStore(value, type, module_.types[recordType].fieldTypes[index]));
+        return;
+    }
+    auto unary = std::dynamic_pointer_cast<Unary>(target);
+    if (unary && unary->op.type == TokenType::POWER) {
+        int pointer;
+        int pointerType = operand(unary->right, pointer);
+        if (pointerType < 0 || module_.types[pointerType].kind != TypeKind::POINTER) error("'^' needs a pointer.");
+        emit(OpCode::SETDEREF, pointer, prepareStore(value, type, module_.types[pointerType].element));
+        return;
+    }
+    error("Invalid assignment target.");
+}
+
+/**
+ * @brief Puts the address of an assignable expression into dest, for output parameters
+ */
+int BytecodeCompiler::compileAddress(std::shared_ptr<Expression> expr, int dest) {
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) return compileAddress(grouping->expression, dest);
+    if (auto variable = std::dynamic_pointer_cast<Variable>(expr)) {
+        Slot slot;
+        if (!lookup(variable->name.lexeme, slot)) error("Argument for an output parameter must be a variable.");
+        switch (slot.kind) {
+            case Slot::Kind::LOCAL: emit(OpCode::ADDR_REG, dest, slot.index); break;
+            case Slot::Kind::REF: emit(OpCode::MOVE, dest, slot.index); break;
+            case Slot::Kind::GLOBAL: emit(OpCode::ADDR_GLOBAL, dest, slot.index); break;
+        }
+        return slot.type;
+    }
+    if (auto access = std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+        int container;
+        int containerType = accessPrefix(access, access->indices.size() - 1, container, !containsCall(access));
+        if (containerType == TYPE_STRING) error("A string character cannot be passed to an output parameter.");
+        int index;
+        operand(access->indices.back(), index);
+        emit(OpCode::ADDR_INDEX, dest, container, index);
+        return elementType(containerType);
+    }
+    if (auto field = std::dynamic_pointer_cast<FieldAccess>(expr)) {
+        int record;
+        int recordType = containerOperand(field->object, record, !containsCall(field));
+        int index = fieldIndex(recordType, field->name.lexeme);
+        emit(OpCode::ADDR_FIELD, dest, record, index);
+        return module_.types[recordType].fieldTypes[index];
+    }
+    auto unary = std::dynamic_pointer_cast<Unary>(expr);
+    if (unary && unary->op.type == TokenType::POWER) {
+        int pointer;
+        int pointerType = operand(unary->right, pointer);
+        if (pointerType < 0 || module_.types[pointerType].kind != TypeKind::POINTER) error("'^' needs a pointer.");
+        emit(OpCode::ADDR_DEREF, dest, pointer);
+        return module_.types[pointerType].element;
+    }
+    error("Argument for an output parameter must be a variable.");
+}
+
+int BytecodeCompiler::elementType(int type) const {
+    if (type < 0) error("Indexing a value that is not an array.");
+    const TypeInfo& info = module_.types[type];
+    if (info.kind == TypeKind::STRING) return TYPE_CHARACTER;
+    if (info.kind != TypeKind::STATIC_ARRAY && info.kind != TypeKind::DYNAMIC_ARRAY) error("Indexing a value that is not an array.");
+    return info.element;
+}
+
+int BytecodeCompiler::fieldIndex(int recordType, const std::string& name) const {
+    if (recordType < 0 || module_.types[recordType].kind != TypeKind::RECORD) error("'." + name + "' used on a value that is not a record.");
+    const auto& names = module_.types[recordType].names;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (lower(names[i]) == lower(name)) return static_cast<int>(i);
+    }
+    error("Record " + module_.types[recordType].name + " has no field '" + name + "'.");
+}
+
+// --- Expressions ---
+
+int BytecodeCompiler::compileExpression(std::shared_ptr<Expression> expr, int dest) {
+    int saved = dest_;
+    dest_ = dest;
+    std::any type = expr->accept(*this);
+    dest_ = saved;
+    return type.has_value() ? std::any_cast<int>(type) : -1;
+}
+
+/**
+ * @brief Makes the value of an expression available in a register
+ *
+ * A local variable is used in place; anything else is compiled into a new
+ * temporary.
+ *
+ * @param expr Expression to evaluate
+ * @param reg Receives the register holding the value
+ * @return int Static type of the expression
+ */
+int BytecodeCompiler::operand(std::shared_ptr<Expression> expr, int& reg) {
+    while (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) expr = grouping->expression;
+    if (auto variable = std::dynamic_pointer_cast<Variable>(expr)) {
+        Slot slot;
+        if (lookup(variable->name.lexeme, slot) && slot.kind == Slot::Kind::LOCAL) {
+            reg = slot.index;
+            return slot.type;
+        }
+    }
+    reg = allocRegister();
+    return compileExpression(expr, reg);
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<Literal> expr) {
+    const std::any& v = expr->value;
+    if (v.type() == typeid(int)) {
+        emit(OpCode::LOADI, dest_, std::any_cast<int>(v));
+        return static_cast<int>(TYPE_INTEGER);
+    }
+    Value value;
+    int type = TYPE_NIL;
+    foldConstant(expr, value, type);
+    emit(OpCode::LOADK, dest_, addConstant(value));
+    return type;
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<Variable> expr) {
+    Slot slot;
+    if (lookup(expr->name.lexeme, slot)) {
+        loadSlot(slot, dest_);
+        return slot.type;
+    }
+    std::string key = lower(expr->name.lexeme);
+    auto constant = constants_.find(key);
+    if (constant != constants_.end()) {
+        emit(OpCode::LOADK, dest_, constant->second.first);
+        return constant->second.second;
+    }
+    auto sub = subprograms_.find(key);
+    if (sub != subprograms_.end() && sub->second.params.empty()) {
+        // A parameterless function may be called without parentheses
+        return compileCall(std::make_shared<Call>(expr, expr->name, std::vector<std::shared_ptr<Expression>>{}), dest_);
+    }
+    error("Unknown identifier '" + expr->name.lexeme + "'.");
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<Grouping> expr) {
+    return compileExpression(expr->expression, dest_);
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<Assign> expr) {
+    // Scalar locals are computed straight into their register
+    auto variable = std::dynamic_pointer_cast<Variable>(expr->target);
+    Slot slot;
+    if (variable && lookup(variable->name.lexeme, slot) && slot.kind == Slot::Kind::LOCAL && !isCompound(slot.type)) {
+        convert(slot.index, compileExpression(expr->value, slot.index), slot.type);
+        checkConstraint(slot, variable->name.lexeme);
+        return -1;
+    }
+    int value;
+    int type = operand(expr->value, value);
+    assign(expr->target, value, type);
+    return -1;
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<FieldAssign> expr) {
+    int value;
+    int type = operand(expr->value, value);
+    assign(expr->target, value, type);
+    return -1;
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<Binary> expr) {
+    int dest = dest_;
+    TokenType op = expr->op.type;
+
+    if (op == TokenType::AND || op == TokenType::OR) {
+        // Booleans short-circuit; the result is built in a temporary so that
+        // dest may be one of the operands
+        int result = allocRegister();
+        int leftType = compileExpression(expr->left, result);
+        if (leftType == TYPE_BOOLEAN) {
+            size_t skip = emit(op == TokenType::AND ? OpCode::JMPF : OpCode::JMPT, result);
+            compileExpression(expr->right, result);
+            patch(skip, here());
+            emit(OpCode::MOVE, dest, result);
+            return static_cast<int>(TYPE_BOOLEAN);
+        }
+        int right;
+        operand(expr->right, right);
+        emit(op == TokenType::AND ? OpCode::BAND : OpCode::BOR, dest, result, right);
+        return leftType;
+    }
+
+    int left, right;
+    int leftType = operand(expr->left, left);
+    int rightType = operand(expr->right, right);
+    auto stringish = [](int type) { return type == TYPE_STRING || type == TYPE_CHARACTER; };
+    int numericType = (leftType == TYPE_REAL || rightType == TYPE_REAL) ? TYPE_REAL : TYPE_INTEGER;
+    switch (op) {
+        case TokenType::PLUS:
+            emit(OpCode::ADD, dest, left, right);
+            return static_cast<int>(stringish(leftType) && stringish(rightType) ? TYPE_STRING : numericType);
+        case TokenType::AMPERSAND: emit(OpCode::ADD, dest, left, right); return static_cast<int>(TYPE_STRING);
+        case TokenType::MINUS: emit(OpCode::SUB, dest, left, right); return numericType;
+        case TokenType::MULTIPLY: emit(OpCode::MUL, dest, left, right); return numericType;
+        case TokenType::DIVIDE: emit(OpCode::DIVIDE, dest, left, right); return static_cast<int>(TYPE_REAL);
+        case TokenType::DIV: emit(OpCode::IDIV, dest, left, right); return static_cast<int>(TYPE_INTEGER);
+        case TokenType::MOD: emit(OpCode::MOD, dest, left, right); return static_cast<int>(TYPE_INTEGER);
+        case TokenType::POWER: emit(OpCode::POW, dest, left, right); return static_cast<int>(TYPE_INTEGER);
+        case TokenType::XOR: emit(OpCode::BXOR, dest, left, right); return leftType;
+        case TokenType::EQUAL: emit(OpCode::EQ, dest, left, right); return static_cast<int>(TYPE_BOOLEAN);
+        case TokenType::NOT_EQUAL: emit(OpCode::NE, dest, left, right); return static_cast<int>(TYPE_BOOLEAN);
+        case TokenType::LESS: emit(OpCode::LT, dest, left, right); return static_cast<int>(TYPE_BOOLEAN);
+        case TokenType::LESS_EQUAL: emit(OpCode::LE, dest, left, right); return static_cast<int>(TYPE_BOOLEAN);
+        case TokenType::GREATER: emit(OpCode::GT, dest, left, right); return static_cast<int>(TYPE_BOOLEAN);
+        case TokenType::GREATER_EQUAL: emit(OpCode::GE, dest, left, right); return static_cast<int>(TYPE_BOOLEAN);
+        default: error("Unsupported operator '" + expr->op.lexeme + "'.");
+    }
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<Unary> expr) {
+    int dest = dest_;
+    if (expr->op.type == TokenType::AT) error("The address operator '@' is not supported by gate run.");
+    int value;
+    int type = operand(expr->right, value);
+    switch (expr->op.type) {
+        case TokenType::MINUS: emit(OpCode::NEG, dest, value); return type;
+        case TokenType::NOT: emit(OpCode::NOT, dest, value); return type;
+        case TokenType::POWER:
+            if (type < 0 || module_.types[type].kind != TypeKind::POINTER) error("'^' needs a pointer.");
+            emit(OpCode::DEREF, dest, value);
+            return module_.types[type].element;
+        default: error("Unsupported operator '" + expr->op.lexeme + "'.");
+    }
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<FieldAccess> expr) {
+    int dest = dest_;
+    int record;
+    int recordType = containerOperand(expr->object, record, !containsCall(expr));
+    int index = fieldIndex(recordType, expr->name.lexeme);
+    emit(OpCode::FIELD, dest, record, index);
+    return module_.types[recordType].fieldTypes[index];
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<ArrayAccess> expr) {
+    int dest = dest_;
+    int container;
+    int type = accessPrefix(expr, expr->indices.size() - 1, container, !containsCall(expr));
+    int index;
+    operand(expr->indices.back(), index);
+    emit(OpCode::INDEX, dest, container, index);
+    return elementType(type);
+}
+
+/**
+ * @brief Evaluates the callee and the first count indices of an element access
+ *
+ * Intermediate arrays and records are referenced in place (ADDR_INDEX,
+ * ADDR_FIELD) rather than loaded, which saves a reference count update per
+ * level. That is only safe when nothing evaluated before the address is used
+ * can resize the array, so callers pass inPlace = false when the access
+ * contains a call.
+ *
+ * @return int Type of the container the next index applies to
+ */
+int BytecodeCompiler::accessPrefix(std::shared_ptr<ArrayAccess> access, size_t count, int& container, bool inPlace) {
+    int type = containerOperand(access->callee, container, inPlace);
+    for (size_t i = 0; i < count; ++i) {
+        int index;
+        operand(access->indices[i], index);
+        int element = allocRegister();
+        type = elementType(type);
+        emit(inPlace && isContainer(type) ? OpCode::ADDR_INDEX : OpCode::INDEX, element, container, index);
+        container = element;
+    }
+    return type;
+}
+
+/**
+ * @brief Evaluates the array or record an element or field access applies to
+ */
+int BytecodeCompiler::containerOperand(std::shared_ptr<Expression> expr, int& reg, bool inPlace) {
+    while (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) expr = grouping->expression;
+    if (inPlace) {
+        if (auto access = std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+            int container;
+            int type = elementType(accessPrefix(access, access->indices.size() - 1, container, true));
+            int index;
+            operand(access->indices.back(), index);
+            reg = allocRegister();
+            emit(isContainer(type) ? OpCode::ADDR_INDEX : OpCode::INDEX, reg, container, index);
+            return type;
+        }
+        if (auto field = std::dynamic_pointer_cast<FieldAccess>(expr)) {
+            int record;
+            int recordType = containerOperand(field->object, record, true);
+            int index = fieldIndex(recordType, field->name.lexeme);
+            int type = module_.types[recordType].fieldTypes[index];
+            reg = allocRegister();
+            emit(isContainer(type) ? OpCode::ADDR_FIELD : OpCode::FIELD, reg, record, index);
+            return type;
+        }
+    }
+    return operand(expr, reg);
+}
+
+bool BytecodeCompiler::isContainer(int type) const {
+    if (type < 0) return false;
+    TypeKind kind = module_.types[type].kind;
+    return kind == TypeKind::RECORD || kind == TypeKind::STATIC_ARRAY || kind == TypeKind::DYNAMIC_ARRAY;
+}
+
+/**
+ * @brief Tells whether evaluating an expression may call a subprogram
+ */
+bool BytecodeCompiler::containsCall(std::shared_ptr<Expression> expr) const {
+    if (!expr) return false;
+    if (std::dynamic_pointer_cast<Call>(expr)) return true;
+    if (auto variable = std::dynamic_pointer_cast<Variable>(expr)) {
+        Slot slot;
+        return !lookup(variable->name.lexeme, slot) && subprograms_.count(lower(variable->name.lexeme)) > 0;
+    }
+    if (auto binary = std::dynamic_pointer_cast<Binary>(expr)) return containsCall(binary->left) || containsCall(binary->right);
+    if (auto unary = std::dynamic_pointer_cast<Unary>(expr)) return containsCall(unary->right);
+    if (auto grouping = std::dynamic_pointer_cast<Grouping>(expr)) return containsCall(grouping->expression);
+    if (auto field = std::dynamic_pointer_cast<FieldAccess>(expr)) return containsCall(field->object);
+    if (auto access = std::dynamic_pointer_cast<ArrayAccess>(expr)) {
+        if (containsCall(access->callee)) return true;
+        for (const auto& index : access->indices) {
+            if (containsCall(index)) return true;
+        }
+    }
+    return false;
+}
+
+std::any BytecodeCompiler::visit(std::shared_ptr<Call> expr) {
+    return compileCall(expr, dest_);
+}
+
+/**
+ * @brief Compiles a call to a subprogram or builtin
+ *
+ * Arguments are placed in consecutive registers at the top of the frame,
+ * which become the callee's parameter registers; the result comes back in
+ * the first of them.
+ *
+ * @param expr Call expression
+ * @param dest Register for the result, or -1 to discard it
+ * @return int Result type, -1 for procedures
+ */
+int BytecodeCompiler::compileCall(std::shared_ptr<Call> expr, int dest) {
+    auto callee = std::dynamic_pointer_cast<Variable>(expr->callee);
+    if (!callee) error("Only named subprograms can be called.");
+    std::string name = lower(callee->name.lexeme);
+
+    auto sub = subprograms_.find(name);
+    if (sub == subprograms_.end()) {
+        static const std::map<std::string, Builtin> builtins = {
+#define GATE_VM_BUILTIN_ENTRY(id, text) {text, Builtin::id},
+            GATE_VM_BUILTINS(GATE_VM_BUILTIN_ENTRY)
+#undef GATE_VM_BUILTIN_ENTRY
+        };
+        auto builtin = builtins.find(name);
+        if (builtin == builtins.end()) error("Unknown subprogram '" + callee->name.lexeme + "'.");
+        return compileBuiltin(builtin->second, expr, dest);
+    }
+
+    const Subprogram& target = sub->second;
+    if (expr->arguments.size() != target.params.size()) {
+        error("'" + callee->name.lexeme + "' expects " + std::to_string(target.params.size()) + " arguments.");
+    }
+    int window = nextRegister_;
+    for (size_t i = 0; i < std::max<size_t>(1, expr->arguments.size()); ++i) allocRegister();
+    for (size_t i = 0; i < expr->arguments.size(); ++i) {
+        int reg = window + static_cast<int>(i);
+        if (target.params[i].mode == ParameterMode::INPUT) {
+            int type = compileExpression(expr->arguments[i], reg);
+            convert(reg, type, target.paramTypes[i]);
+            // Input records and static arrays are passed by value
+            if (isCompound(target.paramTypes[i])) emit(OpCode::COPY, reg, reg);
+        } else {
+            compileAddress(expr->arguments[i], reg);
+        }
+        nextRegister_ = window + static_cast<int>(std::max<size_t>(1, expr->arguments.size()));
+    }
+    emit(OpCode::CALL, window, target.index, static_cast<int>(expr->arguments.size()));
+    if (dest >= 0 && dest != window) emit(OpCode::MOVE, dest, window);
+    nextRegister_ = window;
+    return target.returnType;
+}
+
+int BytecodeCompiler::compileBuiltin(Builtin builtin, std::shared_ptr<Call> expr, int dest) {
+    bool casting = builtin >= Builtin::BOOLEAN_TO_CHAR;
+    size_t arity = casting ? 2 : 1;
+    if (expr->arguments.size() != arity) {
+        error("'" + std::dynamic_pointer_cast<Variable>(expr->callee)->name.lexeme + "' expects " + std::to_string(arity) + " arguments.");
+    }
+    int window = nextRegister_;
+    for (size_t i = 0; i < arity; ++i) allocRegister();
+    int argType = compileExpression(expr->arguments[0], window);
+    if (casting) compileAddress(expr->arguments[1], window + 1);
+    emit(OpCode::CALLB, window, static_cast<int>(builtin), static_cast<int>(arity));
+    if (dest >= 0 && dest != window) emit(OpCode::MOVE, dest, window);
+    nextRegister_ = window;
+
+    switch (builtin) {
+        case Builtin::LENGTH:
+        case Builtin::HIGH:
+        case Builtin::LOW:
+            if (argType != TYPE_STRING && argType != TYPE_CHARACTER &&
+                (argType < 0 || (module_.types[argType].kind != TypeKind::STATIC_ARRAY && module_.types[argType].kind != TypeKind::DYNAMIC_ARRAY))) {
+                error("length, high and low need a string or an array.");
+            }
+            return TYPE_INTEGER;
+        case Builtin::ABS:
+        case Builtin::SQR:
+        case Builtin::SUCC:
+        case Builtin::PRED:
+            return argType;
+        case Builtin::SQRT:
+        case Builtin::SIN:
+        case Builtin::COS:
+        case Builtin::ARCTAN:
+        case Builtin::LN:
+        case Builtin::EXP:
+            return TYPE_REAL;
+        case Builtin::ROUND:
+        case Builtin::TRUNC:
+        case Builtin::ORD:
+            return TYPE_INTEGER;
+        case Builtin::CHR:
+            return TYPE_CHARACTER;
+        case Builtin::UPCASE:
+            return argType == TYPE_STRING ? TYPE_STRING : TYPE_CHARACTER;
+        case Builtin::BOOLEAN_TO_CHAR:
+        case Builtin::CHAR_TO_BOOLEAN:
+        case Builtin::CHAR_TO_INTEGER:
+        case Builtin::CHAR_TO_REAL:
+        case Builtin::INTEGER_TO_CHAR:
+        case Builtin::REAL_TO_CHAR:
+        case Builtin::STRING_HEX_TO_INTEGER:
+        case Builtin::STRING_TO_BOOLEAN:
+        case Builtin::STRING_TO_CHAR:
+        case Builtin::STRING_TO_INTEGER:
+        case Builtin::STRING_TO_REAL:
+            return TYPE_BOOLEAN;
+        default:
+            return -1;
+    }
+}
+
+} // namespace gate::vm
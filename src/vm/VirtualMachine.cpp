@@ -0,0 +1,943 @@
+/**
+ * @file VirtualMachine.cpp
+ * @brief Implementation of the GATE bytecode interpreter
+ *
+ * The dispatch loop uses computed goto (a GNU extension) where the compiler
+ * supports it: every handler ends with its own indirect jump, which keeps
+ * branch prediction per opcode. Other compilers get an equivalent switch.
+ *
+ * @author GATE Project Team
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "vm/VirtualMachine.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+#if defined(__GNUC__)
+#define GATE_VM_COMPUTED_GOTO 1
+#else
+#define GATE_VM_COMPUTED_GOTO 0
+#endif
+
+namespace gate::vm {
+
+namespace {
+
+/** @brief Registers available to all frames together */
+constexpr size_t STACK_SIZE = 1 << 18;
+
+/** @brief Deepest call nesting before reporting a stack overflow */
+constexpr size_t MAX_CALL_DEPTH = 100000;
+
+[[noreturn]] void fail(const std::string& message) {
+    throw std::runtime_error(message);
+}
+
+inline bool isOrdinal(ValueKind kind) {
+    return kind == ValueKind::INTEGER || kind == ValueKind::CHARACTER || kind == ValueKind::ENUM || kind == ValueKind::BOOLEAN;
+}
+
+inline bool isNumeric(ValueKind kind) {
+    return kind == ValueKind::INTEGER || kind == ValueKind::REAL;
+}
+
+inline bool isText(ValueKind kind) {
+    return kind == ValueKind::STRING || kind == ValueKind::CHARACTER;
+}
+
+/** @brief Follows the in-place reference the compiler uses for intermediate arrays and records */
+inline const Value& deref(const Value& value) {
+    return value.kind == ValueKind::ADDRESS ? *value.address : value;
+}
+
+/** @brief Overwrites a register with a scalar, releasing any object it held */
+inline void setScalar(Value& target, ValueKind kind, int64_t payload) {
+    target.kind = kind;
+    target.i = payload;
+    if (target.object) target.object.reset();
+}
+
+inline int64_t wrap(uint64_t value) {
+    return static_cast<int64_t>(value);
+}
+
+double toReal(const Value& value) {
+    if (value.kind == ValueKind::REAL) return value.r;
+    if (value.kind == ValueKind::INTEGER) return static_cast<double>(value.i);
+    fail("Expected a number.");
+}
+
+std::string textOf(const Value& value) {
+    if (value.kind == ValueKind::STRING) return value.text();
+    if (value.kind == ValueKind::CHARACTER) return std::string(1, static_cast<char>(value.i));
+    fail("Expected a string or a character.");
+}
+
+/** @brief Pascal Trim: strips control characters and spaces at both ends */
+std::string trim(const std::string& text) {
+    size_t start = 0, end = text.size();
+    while (start < end && static_cast<unsigned char>(text[start]) <= ' ') ++start;
+    while (end > start && static_cast<unsigned char>(text[end - 1]) <= ' ') --end;
+    return text.substr(start, end - start);
+}
+
+/** @brief Pascal Val for Int64: decimal, or hexadecimal after '$' */
+bool parseInteger(const std::string& text, int64_t& result) {
+    size_t pos = 0;
+    bool negative = false;
+    if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) negative = text[pos++] == '-';
+    int base = 10;
+    if (pos < text.size() && text[pos] == '$') { base = 16; ++pos; }
+    if (pos >= text.size()) return false;
+    uint64_t value = 0;
+    for (; pos < text.size(); ++pos) {
+        int digit;
+        char c = static_cast<char>(std::tolower(static_cast<unsigned char>(text[pos])));
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (base == 16 && c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else return false;
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / base) return false;
+        value = value * base + digit;
+    }
+    if (base == 16 && !negative) { result = wrap(value); return true; }
+    uint64_t limit = negative ? uint64_t(std::numeric_limits<int64_t>::max()) + 1 : uint64_t(std::numeric_limits<int64_t>::max());
+    if (value > limit) return false;
+    result = negative ? wrap(0 - value) : static_cast<int64_t>(value);
+    return true;
+}
+
+/** @brief Pascal Val for Double */
+bool parseReal(const std::string& text, double& result) {
+    size_t pos = (!text.empty() && (text[0] == '+' || text[0] == '-')) ? 1 : 0;
+    if (pos >= text.size() || !(std::isdigit(static_cast<unsigned char>(text[pos])) || text[pos] == '.')) return false;
+    errno = 0;
+    char* end = nullptr;
+    result = std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size() && errno != ERANGE;
+}
+
+/** @brief Free Pascal FloatToStr: 15 significant digits, exponent without padding */
+std::string floatToStr(double value) {
+    if (std::isnan(value)) return "Nan";
+    if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.15G", value);
+    std::string text = buffer;
+    size_t e = text.find('E');
+    if (e == std::string::npos) return text;
+    std::string mantissa = text.substr(0, e);
+    int exponent = std::atoi(text.c_str() + e + 1);
+    return mantissa + "E" + (exponent < 0 ? "-" : "") + std::to_string(std::abs(exponent));
+}
+
+/** @brief Write/WriteLn of a real: sign column, 16 decimals, three-digit exponent */
+std::string formatReal(double value) {
+    if (std::isnan(value)) return "                     Nan";
+    if (std::isinf(value)) return value > 0 ? "                    +Inf" : "                    -Inf";
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.16E", value);
+    std::string text = buffer;
+    size_t e = text.find('E');
+    int exponent = std::atoi(text.c_str() + e + 1);
+    std::snprintf(buffer, sizeof(buffer), "E%c%03d", exponent < 0 ? '-' : '+', std::abs(exponent));
+    std::string mantissa = text.substr(0, e);
+    return (mantissa[0] == '-' ? "" : " ") + mantissa + buffer;
+}
+
+} // namespace
+
+RuntimeError::RuntimeError(int line, const std::string& message)
+    : std::runtime_error(line > 0 ? "Line " + std::to_string(line) + ": " + message : message), line_(line) {}
+
+VirtualMachine::VirtualMachine(const Module& module, std::istream& input, std::ostream& output)
+    : module_(module), input_(input), output_(output), stack_(STACK_SIZE), emptyString_(Value::string("")),
+      integerLimit_(int64_t(1) << (module.integerBits - 1)) {
+    frames_.reserve(256);
+}
+
+/**
+ * @brief Returns an integer result, failing when the program's integer type cannot hold it
+ *
+ * The same rule as the constant evaluator, so `gate run` never prints a
+ * value the generated Pascal could not compute.
+ */
+inline int64_t VirtualMachine::checked(int64_t value) const {
+    if (value < -integerLimit_ || value >= integerLimit_) {
+        fail("Arithmetic overflow: " + std::to_string(value) + " does not fit the " +
+             std::to_string(module_.integerBits) + "-bit integer type.");
+    }
+    return value;
+}
+
+bool VirtualMachine::isDynamicArray(int type) const {
+    return module_.types[type].kind == TypeKind::DYNAMIC_ARRAY;
+}
+
+/**
+ * @brief Builds the initial value of a variable of the given type
+ *
+ * Records and static arrays are created with all their elements, so
+ * fields and elements can be assigned without an allocation step.
+ */
+Value VirtualMachine::defaultValue(int type) const {
+    const TypeInfo& info = module_.types[type];
+    switch (info.kind) {
+        case TypeKind::INTEGER: return Value::integer(0);
+        case TypeKind::REAL: return Value::real(0.0);
+        case TypeKind::BOOLEAN: return Value::boolean(false);
+        case TypeKind::CHARACTER: return Value::character(0);
+        case TypeKind::STRING: return emptyString_;
+        case TypeKind::ENUM: return Value::enumeration(0);
+        case TypeKind::NIL:
+        case TypeKind::POINTER: return Value::nil();
+        case TypeKind::RECORD: {
+            auto record = std::make_shared<RecordObject>();
+            record->fields.reserve(info.fieldTypes.size());
+            for (int field : info.fieldTypes) record->fields.push_back(defaultValue(field));
+            Value value;
+            value.kind = ValueKind::RECORD;
+            value.object = std::move(record);
+            return value;
+        }
+        case TypeKind::STATIC_ARRAY:
+        case TypeKind::DYNAMIC_ARRAY: {
+            auto array = std::make_shared<ArrayObject>();
+            array->type = type;
+            if (info.kind == TypeKind::STATIC_ARRAY) {
+                array->low = info.low;
+                size_t count = info.high >= info.low ? static_cast<size_t>(info.high - info.low + 1) : 0;
+                const TypeInfo& element = module_.types[info.element];
+                if (element.kind == TypeKind::RECORD || element.kind == TypeKind::STATIC_ARRAY || element.kind == TypeKind::DYNAMIC_ARRAY) {
+                    array->items.reserve(count);
+                    for (size_t i = 0; i < count; ++i) array->items.push_back(defaultValue(info.element));
+                } else {
+                    array->items.assign(count, defaultValue(info.element));
+                }
+            }
+            Value value;
+            value.kind = ValueKind::ARRAY;
+            value.object = std::move(array);
+            return value;
+        }
+    }
+    return Value();
+}
+
+Value& VirtualMachine::element(const Value& reference, const Value& index) const {
+    const Value& array = deref(reference);
+    if (array.kind != ValueKind::ARRAY) fail("Indexing a value that is not an array.");
+    ArrayObject* object = array.array();
+    if (!isOrdinal(index.kind)) fail("Array index must be an ordinal value.");
+    int64_t offset = index.i - object->low;
+    if (offset < 0 || offset >= static_cast<int64_t>(object->items.size())) {
+        if (object->items.empty()) fail("Index " + std::to_string(index.i) + " out of bounds: the array is empty.");
+        fail("Index " + std::to_string(index.i) + " out of bounds " + std::to_string(object->low) + ".." +
+             std::to_string(object->low + static_cast<int64_t>(object->items.size()) - 1) + ".");
+    }
+    return object->items[static_cast<size_t>(offset)];
+}
+
+Box* VirtualMachine::box(const Value& pointer) const {
+    if (pointer.kind != ValueKind::POINTER || !pointer.object) fail("Dereferencing a NULL pointer.");
+    Box* target = static_cast<Box*>(pointer.object.get());
+    if (target->disposed) fail("Dereferencing a deallocated pointer.");
+    return target;
+}
+
+/**
+ * @brief SetLength over one or more dimensions, keeping existing elements
+ */
+void VirtualMachine::resize(const Value& array, const Value* extents, int count) const {
+    if (array.kind != ValueKind::ARRAY) fail("allocate needs a dynamic array.");
+    ArrayObject* object = array.array();
+    if (extents[0].kind != ValueKind::INTEGER || extents[0].i < 0) fail("Array size must be a non-negative integer.");
+    size_t size = static_cast<size_t>(extents[0].i);
+    int elementType = module_.types[object->type].element;
+    size_t old = object->items.size();
+    object->items.resize(size);
+    for (size_t i = old; i < size; ++i) object->items[i] = defaultValue(elementType);
+    if (count > 1) {
+        for (auto& item : object->items) resize(item, extents + 1, count - 1);
+    }
+}
+
+/**
+ * @brief Slow path of the arithmetic opcodes: reals, mixed operands and concatenation
+ */
+Value VirtualMachine::arithmetic(OpCode op, const Value& left, const Value& right) const {
+    if (op == OpCode::ADD && isText(left.kind) && isText(right.kind)) return Value::string(textOf(left) + textOf(right));
+    if (!isNumeric(left.kind) || !isNumeric(right.kind)) fail(std::string("Operands of ") + opcodeName(op) + " must be numbers.");
+    if (left.kind == ValueKind::INTEGER && right.kind == ValueKind::INTEGER) {
+        uint64_t l = static_cast<uint64_t>(left.i), r = static_cast<uint64_t>(right.i);
+        switch (op) {
+            case OpCode::ADD: return Value::integer(checked(wrap(l + r)));
+            case OpCode::SUB: return Value::integer(checked(wrap(l - r)));
+            case OpCode::MUL: return Value::integer(checked(wrap(l * r)));
+            default: break;
+        }
+    }
+    double l = toReal(left), r = toReal(right);
+    switch (op) {
+        case OpCode::ADD: return Value::real(l + r);
+        case OpCode::SUB: return Value::real(l - r);
+        case OpCode::MUL: return Value::real(l * r);
+        case OpCode::DIVIDE:
+            if (r == 0.0) fail("Division by zero.");
+            return Value::real(l / r);
+        default: fail(std::string("Unsupported operands for ") + opcodeName(op) + ".");
+    }
+}
+
+int VirtualMachine::compare(const Value& left, const Value& right, bool equalityOnly) const {
+    if (isOrdinal(left.kind) && isOrdinal(right.kind)) return (left.i > right.i) - (left.i < right.i);
+    if (isNumeric(left.kind) && isNumeric(right.kind)) {
+        double l = toReal(left), r = toReal(right);
+        return (l > r) - (l < r);
+    }
+    if (isText(left.kind) && isText(right.kind)) {
+        int result = textOf(left).compare(textOf(right));
+        return (result > 0) - (result < 0);
+    }
+    if (equalityOnly && left.kind == ValueKind::POINTER && right.kind == ValueKind::POINTER) {
+        return left.object == right.object ? 0 : 1;
+    }
+    fail("These values cannot be compared.");
+}
+
+/**
+ * @brief Runs a builtin; the result replaces args[0]
+ *
+ * Casting subprograms write their converted value through the address in
+ * args[1] and, for the functions, leave the success flag in args[0].
+ */
+void VirtualMachine::callBuiltin(Builtin builtin, Value* args) const {
+    Value& x = args[0];
+    auto result = [&](Value value) { *args[1].address = std::move(value); };
+    auto success = [&](bool ok) { x = Value::boolean(ok); };
+    switch (builtin) {
+        case Builtin::LENGTH:
+            if (x.kind == ValueKind::ARRAY) x = Value::integer(static_cast<int64_t>(x.array()->items.size()));
+            else x = Value::integer(static_cast<int64_t>(textOf(x).size()));
+            break;
+        case Builtin::HIGH:
+            if (x.kind == ValueKind::ARRAY) x = Value::integer(x.array()->low + static_cast<int64_t>(x.array()->items.size()) - 1);
+            else x = Value::integer(static_cast<int64_t>(textOf(x).size()));
+            break;
+        case Builtin::LOW:
+            x = Value::integer(x.kind == ValueKind::ARRAY ? x.array()->low : 1);
+            break;
+        case Builtin::ABS:
+            if (x.kind == ValueKind::INTEGER) x.i = x.i < 0 ? checked(wrap(0 - static_cast<uint64_t>(x.i))) : x.i;
+            else x = Value::real(std::fabs(toReal(x)));
+            break;
+        case Builtin::SQR:
+            if (x.kind == ValueKind::INTEGER) x.i = checked(wrap(static_cast<uint64_t>(x.i) * static_cast<uint64_t>(x.i)));
+            else x = Value::real(toReal(x) * toReal(x));
+            break;
+        case Builtin::SQRT:
+            if (toReal(x) < 0) fail("Invalid floating point operation.");
+            x = Value::real(std::sqrt(toReal(x)));
+            break;
+        case Builtin::SIN: x = Value::real(std::sin(toReal(x))); break;
+        case Builtin::COS: x = Value::real(std::cos(toReal(x))); break;
+        case Builtin::ARCTAN: x = Value::real(std::atan(toReal(x))); break;
+        case Builtin::LN:
+            if (toReal(x) <= 0) fail("Invalid floating point operation.");
+            x = Value::real(std::log(toReal(x)));
+            break;
+        case Builtin::EXP: x = Value::real(std::exp(toReal(x))); break;
+        case Builtin::ROUND:
+        case Builtin::TRUNC: {
+            double value = toReal(x);
+            double integral = builtin == Builtin::ROUND ? std::nearbyint(value) : std::trunc(value);
+            if (!(std::fabs(integral) < 9.2e18)) fail("Invalid floating point operation.");
+            x = Value::integer(checked(static_cast<int64_t>(integral)));
+            break;
+        }
+        case Builtin::ORD:
+            if (!isOrdinal(x.kind)) fail("ord needs an ordinal value.");
+            x = Value::integer(x.i);
+            break;
+        case Builtin::CHR: x = Value::character(static_cast<unsigned char>(x.i)); break;
+        case Builtin::SUCC:
+        case Builtin::PRED:
+            if (!isOrdinal(x.kind)) fail("succ and pred need an ordinal value.");
+            x.i += builtin == Builtin::SUCC ? 1 : -1;
+            if (x.kind == ValueKind::INTEGER) checked(x.i);
+            break;
+        case Builtin::UPCASE:
+            if (x.kind == ValueKind::CHARACTER) {
+                x.i = std::toupper(static_cast<int>(x.i));
+            } else {
+                std::string text = textOf(x);
+                std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::toupper(c); });
+                x = Value::string(text);
+            }
+            break;
+
+        case Builtin::BOOLEAN_TO_CHAR: result(Value::character(x.i ? 'T' : 'F')); success(true); break;
+        case Builtin::BOOLEAN_TO_INTEGER: result(Value::integer(x.i ? 1 : 0)); break;
+        case Builtin::BOOLEAN_TO_REAL: result(Value::real(x.i ? 1.0 : 0.0)); break;
+        case Builtin::BOOLEAN_TO_STRING: result(Value::string(x.i ? "True" : "False")); break;
+        case Builtin::CHAR_TO_BOOLEAN: {
+            int c = static_cast<int>(x.i);
+            int up = std::toupper(c);
+            if (up == 'T' || (c >= '1' && c <= '9')) { result(Value::boolean(true)); success(true); }
+            else if (up == 'F' || c == '0') { result(Value::boolean(false)); success(true); }
+            else { result(Value::boolean(false)); success(false); }
+            break;
+        }
+        case Builtin::CHAR_TO_INTEGER:
+        case Builtin::CHAR_TO_REAL: {
+            bool digit = x.i >= '0' && x.i <= '9';
+            int64_t value = digit ? x.i - '0' : 0;
+            result(builtin == Builtin::CHAR_TO_INTEGER ? Value::integer(value) : Value::real(static_cast<double>(value)));
+            success(digit);
+            break;
+        }
+        case Builtin::CHAR_TO_STRING: result(Value::string(textOf(x))); break;
+        case Builtin::INTEGER_TO_BOOLEAN: result(Value::boolean(x.i != 0)); break;
+        case Builtin::INTEGER_TO_CHAR: {
+            bool digit = x.i >= 0 && x.i <= 9;
+            result(Value::character(digit ? static_cast<unsigned char>('0' + x.i) : 0));
+            success(digit);
+            break;
+        }
+        case Builtin::INTEGER_TO_HEX_STRING: {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%llX", static_cast<unsigned long long>(x.i));
+            result(Value::string(buffer));
+            break;
+        }
+        case Builtin::INTEGER_TO_REAL: result(Value::real(toReal(x))); break;
+        case Builtin::INTEGER_TO_STRING: result(Value::string(std::to_string(x.i))); break;
+        case Builtin::REAL_TO_BOOLEAN: result(Value::boolean(toReal(x) != 0.0)); break;
+        case Builtin::REAL_TO_CHAR: {
+            double value = toReal(x);
+            bool digit = value == std::trunc(value) && value >= 0 && value <= 9;
+            result(Value::character(digit ? static_cast<unsigned char>('0' + static_cast<int>(value)) : 0));
+            success(digit);
+            break;
+        }
+        case Builtin::REAL_TO_INTEGER: {
+            double integral = std::nearbyint(toReal(x));
+            if (!(std::fabs(integral) < 9.2e18)) fail("Invalid floating point operation.");
+            result(Value::integer(checked(static_cast<int64_t>(integral))));
+            break;
+        }
+        case Builtin::REAL_TO_STRING: result(Value::string(floatToStr(toReal(x)))); break;
+        case Builtin::STRING_HEX_TO_INTEGER:
+        case Builtin::STRING_TO_INTEGER: {
+            std::string text = trim(textOf(x));
+            int64_t value = 0;
+            bool ok = !text.empty() && parseInteger(builtin == Builtin::STRING_HEX_TO_INTEGER ? "$" + text : text, value) &&
+                      value >= -integerLimit_ && value < integerLimit_;
+            result(Value::integer(ok ? value : 0));
+            success(ok);
+            break;
+        }
+        case Builtin::STRING_TO_BOOLEAN: {
+            std::string text = trim(textOf(x));
+            std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+            int64_t number = 0;
+            if (parseInteger(text, number)) { result(Value::boolean(number != 0)); success(true); }
+            else if (text == "true") { result(Value::boolean(true)); success(true); }
+            else if (text == "false") { result(Value::boolean(false)); success(true); }
+            else { result(Value::boolean(false)); success(false); }
+            break;
+        }
+        case Builtin::STRING_TO_CHAR: {
+            std::string text = trim(textOf(x));
+            result(Value::character(text.size() == 1 ? static_cast<unsigned char>(text[0]) : 0));
+            success(text.size() == 1);
+            break;
+        }
+        case Builtin::STRING_TO_REAL: {
+            std::string text = trim(textOf(x));
+            double value = 0.0;
+            bool ok = !text.empty() && parseReal(text, value);
+            result(Value::real(ok ? value : 0.0));
+            success(ok);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Reads one value for `input`, following ReadLn
+ *
+ * Numbers and booleans skip leading blanks and line breaks; the rest of the
+ * line is discarded after every read.
+ */
+Value VirtualMachine::read(int type) {
+    if (type == TYPE_STRING || type == TYPE_CHARACTER) {
+        std::string line;
+        std::getline(input_, line);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (type == TYPE_STRING) return Value::string(line);
+        return Value::character(line.empty() ? ' ' : static_cast<unsigned char>(line[0]));
+    }
+    std::string token;
+    if (!(input_ >> token)) {
+        if (type == TYPE_BOOLEAN) return Value::boolean(false);
+        return type == TYPE_REAL ? Value::real(0.0) : Value::integer(0);
+    }
+    input_.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    if (type == TYPE_INTEGER) {
+        int64_t value;
+        if (!parseInteger(token, value)) fail("Invalid numeric input '" + token + "'.");
+        return Value::integer(checked(value));
+    }
+    if (type == TYPE_REAL) {
+        double value;
+        if (!parseReal(token, value)) fail("Invalid numeric input '" + token + "'.");
+        return Value::real(value);
+    }
+    std::transform(token.begin(), token.end(), token.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (token == "true") return Value::boolean(true);
+    if (token == "false") return Value::boolean(false);
+    fail("Invalid boolean input '" + token + "'.");
+}
+
+void VirtualMachine::write(const Value& value, int type) {
+    switch (value.kind) {
+        case ValueKind::INTEGER: {
+            char buffer[24];
+            int length = std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value.i));
+            output_.write(buffer, length);
+            break;
+        }
+        case ValueKind::REAL: output_ << formatReal(value.r); break;
+        case ValueKind::BOOLEAN: output_ << (value.i ? "TRUE" : "FALSE"); break;
+        case ValueKind::CHARACTER: output_.put(static_cast<char>(value.i)); break;
+        case ValueKind::STRING: output_ << value.text(); break;
+        case ValueKind::ENUM: {
+            const auto& names = module_.types[type].names;
+            if (value.i >= 0 && value.i < static_cast<int64_t>(names.size())) output_ << names[static_cast<size_t>(value.i)];
+            else output_ << value.i;
+            break;
+        }
+        default: fail("This value cannot be written.");
+    }
+}
+
+#if GATE_VM_COMPUTED_GOTO
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+/**
+ * @brief The interpreter loop
+ *
+ * R is the register window of the running frame, G the main frame (globals)
+ * and K the constant pool. Integer fast paths are inlined in the handlers;
+ * everything else goes through the helper methods.
+ */
+void VirtualMachine::run() {
+    frames_.clear();
+    const Function* fn = &module_.functions[module_.main];
+    Value* const G = stack_.data();
+    const Value* const stackEnd = stack_.data() + stack_.size();
+    const Value* const K = module_.constants.data();
+    Value* R = G;
+    const Instruction* code = fn->code.data();
+    const Instruction* pc = code;
+    const Instruction* ins = code;
+    if (static_cast<size_t>(fn->registerCount) > stack_.size()) throw RuntimeError(0, "Stack overflow.");
+
+    try {
+#if GATE_VM_COMPUTED_GOTO
+        static void* const dispatch[] = {
+#define GATE_VM_LABEL(name) &&op_##name,
+            GATE_VM_OPCODES(GATE_VM_LABEL)
+#undef GATE_VM_LABEL
+        };
+#define VM_CASE(name) op_##name:
+#define VM_NEXT() do { ins = pc++; goto *dispatch[static_cast<size_t>(ins->op)]; } while (0)
+        VM_NEXT();
+#else
+#define VM_CASE(name) case OpCode::name:
+#define VM_NEXT() continue
+        for (;;) {
+            ins = pc++;
+            switch (ins->op) {
+#endif
+
+        VM_CASE(MOVE) {
+            R[ins->a] = R[ins->b];
+            VM_NEXT();
+        }
+        VM_CASE(COPY) {
+            Value copy = copyOf(R[ins->b], [this](int type) { return isDynamicArray(type); });
+            R[ins->a] = std::move(copy);
+            VM_NEXT();
+        }
+        VM_CASE(LOADK) {
+            R[ins->a] = K[ins->b];
+            VM_NEXT();
+        }
+        VM_CASE(LOADI) {
+            setScalar(R[ins->a], ValueKind::INTEGER, ins->b);
+            VM_NEXT();
+        }
+        VM_CASE(INIT) {
+            R[ins->a] = defaultValue(ins->b);
+            VM_NEXT();
+        }
+        VM_CASE(GETG) {
+            R[ins->a] = G[ins->b];
+            VM_NEXT();
+        }
+        VM_CASE(SETG) {
+            G[ins->a] = R[ins->b];
+            VM_NEXT();
+        }
+        VM_CASE(LOAD) {
+            R[ins->a] = *R[ins->b].address;
+            VM_NEXT();
+        }
+        VM_CASE(STORE) {
+            *R[ins->a].address = R[ins->b];
+            VM_NEXT();
+        }
+        VM_CASE(ADDR_REG) {
+            R[ins->a] = Value::addressOf(&R[ins->b]);
+            VM_NEXT();
+        }
+        VM_CASE(ADDR_GLOBAL) {
+            R[ins->a] = Value::addressOf(&G[ins->b]);
+            VM_NEXT();
+        }
+        VM_CASE(ADDR_INDEX) {
+            R[ins->a] = Value::addressOf(&element(R[ins->b], R[ins->c]));
+            VM_NEXT();
+        }
+        VM_CASE(ADDR_FIELD) {
+            const Value& record = deref(R[ins->b]);
+            if (record.kind != ValueKind::RECORD) fail("Field access on a value that is not a record.");
+            R[ins->a] = Value::addressOf(&record.record()->fields[ins->c]);
+            VM_NEXT();
+        }
+        VM_CASE(ADDR_DEREF) {
+            R[ins->a] = Value::addressOf(&box(R[ins->b])->value);
+            VM_NEXT();
+        }
+        VM_CASE(INDEX) {
+            const Value& container = deref(R[ins->b]);
+            if (container.kind == ValueKind::STRING) {
+                const std::string& text = container.text();
+                int64_t index = R[ins->c].i;
+                if (index < 1 || index > static_cast<int64_t>(text.size())) {
+                    fail("String index " + std::to_string(index) + " out of range 1.." + std::to_string(text.size()) + ".");
+                }
+                setScalar(R[ins->a], ValueKind::CHARACTER, static_cast<unsigned char>(text[static_cast<size_t>(index - 1)]));
+            } else {
+                const Value& item = element(container, R[ins->c]);
+                Value& target = R[ins->a];
+                if (!item.object) {
+                    setScalar(target, item.kind, item.i);
+                } else if (target.object != item.object) {
+                    // Copy first: the destination may hold the container itself
+                    Value copy = item;
+                    target = std::move(copy);
+                }
+            }
+            VM_NEXT();
+        }
+        VM_CASE(SETINDEX) {
+            element(R[ins->a], R[ins->b]) = R[ins->c];
+            VM_NEXT();
+        }
+        VM_CASE(SETCHAR) {
+            Value& target = R[ins->a];
+            if (target.kind != ValueKind::STRING) fail("Character assignment to a value that is not a string.");
+            int64_t index = R[ins->b].i;
+            if (index < 1 || index > static_cast<int64_t>(target.text().size())) {
+                fail("String index " + std::to_string(index) + " out of range 1.." + std::to_string(target.text().size()) + ".");
+            }
+            // Strings are shared between registers until one of them is written
+            if (target.object.use_count() > 1) target.object = std::make_shared<StringObject>(*static_cast<StringObject*>(target.object.get()));
+            static_cast<StringObject*>(target.object.get())->text[static_cast<size_t>(index - 1)] = static_cast<char>(R[ins->c].i);
+            VM_NEXT();
+        }
+        VM_CASE(FIELD) {
+            const Value& record = deref(R[ins->b]);
+            if (record.kind != ValueKind::RECORD) fail("Field access on a value that is not a record.");
+            const Value& field = record.record()->fields[ins->c];
+            Value& target = R[ins->a];
+            if (!field.object) {
+                setScalar(target, field.kind, field.i);
+            } else if (target.object != field.object) {
+                Value copy = field;
+                target = std::move(copy);
+            }
+            VM_NEXT();
+        }
+        VM_CASE(SETFIELD) {
+            const Value& record = deref(R[ins->a]);
+            if (record.kind != ValueKind::RECORD) fail("Field access on a value that is not a record.");
+            record.record()->fields[ins->b] = R[ins->c];
+            VM_NEXT();
+        }
+        VM_CASE(DEREF) {
+            Value target = box(R[ins->b])->value;
+            R[ins->a] = std::move(target);
+            VM_NEXT();
+        }
+        VM_CASE(SETDEREF) {
+            box(R[ins->a])->value = R[ins->b];
+            VM_NEXT();
+        }
+        VM_CASE(ADD) {
+            const Value& x = R[ins->b];
+            const Value& y = R[ins->c];
+            if (x.kind == ValueKind::INTEGER && y.kind == ValueKind::INTEGER) {
+                setScalar(R[ins->a], ValueKind::INTEGER, checked(wrap(static_cast<uint64_t>(x.i) + static_cast<uint64_t>(y.i))));
+            } else {
+                R[ins->a] = arithmetic(OpCode::ADD, x, y);
+            }
+            VM_NEXT();
+        }
+        VM_CASE(ADDI) {
+            const Value& x = R[ins->b];
+            if (!isOrdinal(x.kind)) fail("Step of a traversal needs an ordinal iterator.");
+            setScalar(R[ins->a], x.kind, wrap(static_cast<uint64_t>(x.i) + static_cast<uint64_t>(static_cast<int64_t>(ins->c))));
+            VM_NEXT();
+        }
+        VM_CASE(SUB) {
+            const Value& x = R[ins->b];
+            const Value& y = R[ins->c];
+            if (x.kind == ValueKind::INTEGER && y.kind == ValueKind::INTEGER) {
+                setScalar(R[ins->a], ValueKind::INTEGER, checked(wrap(static_cast<uint64_t>(x.i) - static_cast<uint64_t>(y.i))));
+            } else {
+                R[ins->a] = arithmetic(OpCode::SUB, x, y);
+            }
+            VM_NEXT();
+        }
+        VM_CASE(MUL) {
+            const Value& x = R[ins->b];
+            const Value& y = R[ins->c];
+            if (x.kind == ValueKind::INTEGER && y.kind == ValueKind::INTEGER) {
+                setScalar(R[ins->a], ValueKind::INTEGER, checked(wrap(static_cast<uint64_t>(x.i) * static_cast<uint64_t>(y.i))));
+            } else {
+                R[ins->a] = arithmetic(OpCode::MUL, x, y);
+            }
+            VM_NEXT();
+        }
+        VM_CASE(DIVIDE) {
+            R[ins->a] = arithmetic(OpCode::DIVIDE, R[ins->b], R[ins->c]);
+            VM_NEXT();
+        }
+        VM_CASE(IDIV) {
+            const Value& x = R[ins->b];
+            const Value& y = R[ins->c];
+            if (x.kind != ValueKind::INTEGER || y.kind != ValueKind::INTEGER) fail("div needs integer operands.");
+            if (y.i == 0) fail("Division by zero.");
+            setScalar(R[ins->a], ValueKind::INTEGER, y.i == -1 ? checked(wrap(0 - static_cast<uint64_t>(x.i))) : x.i / y.i);
+            VM_NEXT();
+        }
+        VM_CASE(MOD) {
+            const Value& x = R[ins->b];
+            const Value& y = R[ins->c];
+            if (x.kind != ValueKind::INTEGER || y.kind != ValueKind::INTEGER) fail("mod needs integer operands.");
+            if (y.i == 0) fail("Division by zero.");
+            setScalar(R[ins->a], ValueKind::INTEGER, y.i == -1 ? 0 : x.i % y.i);
+            VM_NEXT();
+        }
+        VM_CASE(POW) {
+            // Same formula as the generated Pascal: Trunc(Exp(b * Ln(a)))
+            double base = toReal(R[ins->b]);
+            double exponent = toReal(R[ins->c]);
+            if (base <= 0) fail("Invalid floating point operation.");
+            double value = std::trunc(std::exp(exponent * std::log(base)));
+            if (!(std::fabs(value) < 9.2e18)) fail("Invalid floating point operation.");
+            setScalar(R[ins->a], ValueKind::INTEGER, checked(static_cast<int64_t>(value)));
+            VM_NEXT();
+        }
+        VM_CASE(NEG) {
+            const Value& x = R[ins->b];
+            if (x.kind == ValueKind::INTEGER) setScalar(R[ins->a], ValueKind::INTEGER, checked(wrap(0 - static_cast<uint64_t>(x.i))));
+            else if (x.kind == ValueKind::REAL) R[ins->a] = Value::real(-x.r);
+            else fail("Negation needs a number.");
+            VM_NEXT();
+        }
+        VM_CASE(NOT) {
+            const Value& x = R[ins->b];
+            if (x.kind == ValueKind::BOOLEAN) setScalar(R[ins->a], ValueKind::BOOLEAN, !x.i);
+            else if (x.kind == ValueKind::INTEGER) setScalar(R[ins->a], ValueKind::INTEGER, ~x.i);
+            else fail("not needs a boolean or an integer.");
+            VM_NEXT();
+        }
+        VM_CASE(BAND) {
+            setScalar(R[ins->a], R[ins->b].kind, R[ins->b].i & R[ins->c].i);
+            VM_NEXT();
+        }
+        VM_CASE(BOR) {
+            setScalar(R[ins->a], R[ins->b].kind, R[ins->b].i | R[ins->c].i);
+            VM_NEXT();
+        }
+        VM_CASE(BXOR) {
+            setScalar(R[ins->a], R[ins->b].kind, R[ins->b].i ^ R[ins->c].i);
+            VM_NEXT();
+        }
+
+#define GATE_VM_COMPARE(name, test, equalityOnly) \
+        VM_CASE(name) { \
+            const Value& x = R[ins->b]; \
+            const Value& y = R[ins->c]; \
+            int order = (x.kind == ValueKind::INTEGER && y.kind == ValueKind::INTEGER) \
+                ? (x.i > y.i) - (x.i < y.i) : compare(x, y, equalityOnly); \
+            setScalar(R[ins->a], ValueKind::BOOLEAN, order test 0); \
+            VM_NEXT(); \
+        }
+        GATE_VM_COMPARE(EQ, ==, true)
+        GATE_VM_COMPARE(NE, !=, true)
+        GATE_VM_COMPARE(LT, <, false)
+        GATE_VM_COMPARE(LE, <=, false)
+        GATE_VM_COMPARE(GT, >, false)
+        GATE_VM_COMPARE(GE, >=, false)
+#undef GATE_VM_COMPARE
+
+        VM_CASE(TOREAL) {
+            if (R[ins->b].kind == ValueKind::INTEGER) R[ins->a] = Value::real(static_cast<double>(R[ins->b].i));
+            else R[ins->a] = R[ins->b];
+            VM_NEXT();
+        }
+        VM_CASE(TOCHAR) {
+            const Value& x = R[ins->b];
+            if (x.kind == ValueKind::STRING) {
+                if (x.text().size() != 1) fail("'" + x.text() + "' is not a single character.");
+                setScalar(R[ins->a], ValueKind::CHARACTER, static_cast<unsigned char>(x.text()[0]));
+            } else {
+                R[ins->a] = x;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(TOSTRING) {
+            if (R[ins->b].kind == ValueKind::CHARACTER) R[ins->a] = Value::string(textOf(R[ins->b]));
+            else R[ins->a] = R[ins->b];
+            VM_NEXT();
+        }
+        VM_CASE(JMP) {
+            pc = code + ins->a;
+            VM_NEXT();
+        }
+        VM_CASE(JMPF) {
+            if (!R[ins->a].i) pc = code + ins->b;
+            VM_NEXT();
+        }
+        VM_CASE(JMPT) {
+            if (R[ins->a].i) pc = code + ins->b;
+            VM_NEXT();
+        }
+        VM_CASE(JGT) {
+            const Value& x = R[ins->a];
+            const Value& y = R[ins->b];
+            bool greater = (x.kind == ValueKind::INTEGER && y.kind == ValueKind::INTEGER) ? x.i > y.i : compare(x, y, false) > 0;
+            if (greater) pc = code + ins->c;
+            VM_NEXT();
+        }
+        VM_CASE(CALL) {
+            const Function* callee = &module_.functions[ins->b];
+            Value* base = R + ins->a;
+            if (base + callee->registerCount > stackEnd || frames_.size() >= MAX_CALL_DEPTH) fail("Stack overflow.");
+            frames_.push_back(Frame{fn, pc, R});
+            fn = callee;
+            R = base;
+            code = pc = fn->code.data();
+            VM_NEXT();
+        }
+        VM_CASE(CALLB) {
+            callBuiltin(static_cast<Builtin>(ins->b), R + ins->a);
+            VM_NEXT();
+        }
+        VM_CASE(RET) {
+            Value result;
+            if (ins->a >= 0) result = std::move(R[ins->a]);
+            // Release what the frame held so strings become unshared again
+            for (Value* reg = R, *end = R + fn->registerCount; reg != end; ++reg) {
+                if (reg->object) reg->object.reset();
+            }
+            R[0] = std::move(result);
+            const Frame& frame = frames_.back();
+            fn = frame.function;
+            pc = frame.returnPc;
+            R = frame.base;
+            frames_.pop_back();
+            code = fn->code.data();
+            VM_NEXT();
+        }
+        VM_CASE(NEWBOX) {
+            auto target = std::make_shared<Box>();
+            target->value = defaultValue(ins->b);
+            Value& pointer = R[ins->a];
+            pointer.kind = ValueKind::POINTER;
+            pointer.i = 0;
+            pointer.object = std::move(target);
+            VM_NEXT();
+        }
+        VM_CASE(DISPOSE) {
+            Box* target = box(R[ins->a]);
+            target->disposed = true;
+            target->value = Value();
+            VM_NEXT();
+        }
+        VM_CASE(ALLOC) {
+            resize(R[ins->a], R + ins->b, ins->c);
+            VM_NEXT();
+        }
+        VM_CASE(FREE) {
+            if (R[ins->a].kind != ValueKind::ARRAY) fail("deallocate needs a dynamic array.");
+            std::vector<Value>().swap(R[ins->a].array()->items);
+            VM_NEXT();
+        }
+        VM_CASE(READ) {
+            R[ins->a] = read(ins->b);
+            VM_NEXT();
+        }
+        VM_CASE(WRITE) {
+            write(R[ins->a], ins->b);
+            VM_NEXT();
+        }
+        VM_CASE(WRITELN) {
+            output_.put('\n');
+            VM_NEXT();
+        }
+        VM_CASE(CHECK) {
+            if (!R[ins->a].i) fail(K[ins->b].text());
+            VM_NEXT();
+        }
+        VM_CASE(HALT) {
+            output_.flush();
+            return;
+        }
+
+#if !GATE_VM_COMPUTED_GOTO
+            }
+        }
+#endif
+#undef VM_CASE
+#undef VM_NEXT
+    } catch (const RuntimeError&) {
+        output_.flush();
+        throw;
+    } catch (const std::exception& e) {
+        output_.flush();
+        throw RuntimeError(fn->lines[static_cast<size_t>(ins - fn->code.data())], e.what());
+    }
+}
+
+#if GATE_VM_COMPUTED_GOTO
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace gate::vm
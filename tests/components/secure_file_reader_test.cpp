@@ -2,6 +2,7 @@
 #include "utils/SecureFileReader.h"
 #include <fstream>
 #include <filesystem>
+#include <sstream>
 #include <string>
 
 class SecureFileReaderTest : public ::testing::Test {
@@ -183,4 +184,34 @@ TEST_F(SecureFileReaderTest, UnicodeContent) {
     EXPECT_TRUE(result.success);
     EXPECT_FALSE(result.content.empty());
     EXPECT_TRUE(result.content.find("PROGRAM UnicodeTest") != std::string::npos);
-}
\ No newline at end of file
+}
+
+TEST(SecureFileReaderStreamTest, ReadsAWholeStreamAcrossChunks) {
+    std::string content;
+    for (size_t i = 0; content.size() < 3 * gate::utils::SecureFileReader::STREAM_CHUNK_SIZE + 17; ++i) {
+        content += "    output(" + std::to_string(i) + ")\n";
+    }
+    std::istringstream in(content);
+    auto result = gate::utils::SecureFileReader::readStream(in);
+
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.content, content);
+    EXPECT_TRUE(result.errorMessage.empty());
+}
+
+TEST(SecureFileReaderStreamTest, ReadsAnEmptyStream) {
+    std::istringstream in("");
+    auto result = gate::utils::SecureFileReader::readStream(in);
+
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(result.content.empty());
+}
+
+TEST(SecureFileReaderStreamTest, RejectsStreamsOverTheSizeLimit) {
+    std::istringstream in(std::string(gate::utils::SecureFileReader::MAX_FILE_SIZE + 1, 'A'));
+    auto result = gate::utils::SecureFileReader::readStream(in);
+
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(result.content.empty());
+    EXPECT_NE(result.errorMessage.find("too large"), std::string::npos);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+TEST(ArrayGrowthTest, AppendLoopUsesResizeHelper) {
+    std::string source = R"(
+PROGRAM GrowthTest
+KAMUS
+    arr: array of integer
+    n: integer
+    i: integer
+ALGORITMA
+    n <- 0
+    i traversal [1..100]
+        allocate(arr, n + 1)
+        arr[n] <- i
+        n <- n + 1
+    output(length(arr))
+    deallocate[1](arr)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("_GateLen_arr: longint = 0;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure _GateResize_arr(newLen: longint);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("if newLen > Length(arr) then SetLength(arr, 2 * newLen);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateResize_arr((n + 1));") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("SetLength(arr, (n + 1));") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("writeln(_GateLen_arr);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("SetLength(arr, 0);\n  _GateLen_arr := 0;") != std::string::npos);
+}
+
+TEST(ArrayGrowthTest, ResizeOutsideLoopIsUnchanged) {
+    std::string source = R"(
+PROGRAM NoGrowthTest
+KAMUS
+    arr: array of integer
+ALGORITMA
+    allocate(arr, 10)
+    arr[0] <- 1
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("SetLength(arr, 10);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateResize_") == std::string::npos);
+}
+
+TEST(ArrayGrowthTest, WholeArrayUseDisablesLowering) {
+    std::string source = R"(
+PROGRAM EscapeTest
+KAMUS
+    arr: array of integer
+    copy: array of integer
+    i: integer
+ALGORITMA
+    i traversal [1..10]
+        allocate(arr, i)
+    copy <- arr
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("SetLength(arr, i);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateLen_arr") == std::string::npos);
+}
+
+TEST(ArrayGrowthTest, LocalArrayInSubprogram) {
+    std::string source = R"(
+PROGRAM LocalGrowthTest
+KAMUS
+    procedure fill(input count: integer)
+ALGORITMA
+    fill(5)
+
+procedure fill(input count: integer)
+KAMUS
+    buf: array of integer
+    k: integer
+ALGORITMA
+    k traversal [1..count]
+        allocate(buf, k)
+        buf[k - 1] <- k
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("  _GateLen_buf: longint = 0;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure _GateResize_buf(newLen: longint);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateResize_buf(k);") != std::string::npos);
+}
+
+TEST(ArrayGrowthTest, CheckedProfileUsesLogicalLength) {
+    std::string source = R"(
+PROGRAM CheckedGrowthTest
+KAMUS
+    arr: array of integer
+    i: integer
+ALGORITMA
+    i traversal [1..10]
+        allocate(arr, i)
+        arr[i - 1] <- i
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::CHECKED;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("arr[_GateCheckIndex((i - 1), _GateLen_arr, 'arr')] := i;") != std::string::npos);
+}
+
+TEST(ArrayGrowthTest, DebugProfileKeepsSetLength) {
+    std::string source = R"(
+PROGRAM DebugGrowthTest
+KAMUS
+    arr: array of integer
+    i: integer
+ALGORITMA
+    i traversal [1..10]
+        allocate(arr, i)
+    output(arr[12])
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(source, options);
+    // {$R+} checks against Length(arr), so the capacity must not exceed it
+    EXPECT_TRUE(generated_pascal.find("SetLength(arr, i);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateResize_") == std::string::npos);
+}
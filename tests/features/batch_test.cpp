@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "driver/Batch.h"
+#include "driver/WorkStealingPool.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+const std::string HELLO_SOURCE = R"(
+PROGRAM Hello
+KAMUS
+    n: integer
+ALGORITMA
+    n <- 3
+    output('n = ', n)
+)";
+
+const std::string BROKEN_SOURCE = R"(
+PROGRAM Broken
+KAMUS
+    n: integer
+ALGORITMA
+    n <-
+)";
+
+class BatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "gate_batch_test";
+        std::filesystem::remove_all(testDir);
+        std::filesystem::create_directories(testDir / "in");
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(testDir, ec);
+    }
+
+    std::string writeInput(const std::string& name, const std::string& content) {
+        std::filesystem::path path = testDir / "in" / name;
+        std::ofstream(path) << content;
+        return path.string();
+    }
+
+    std::string readOutput(const std::string& name) {
+        std::ifstream in(testDir / "out" / name);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        return buffer.str();
+    }
+
+    gate::driver::BatchOptions options(unsigned jobs) {
+        gate::driver::BatchOptions batch;
+        batch.outDir = (testDir / "out").string();
+        batch.jobs = jobs;
+        return batch;
+    }
+
+    std::filesystem::path testDir;
+};
+
+} // namespace
+
+TEST(WorkStealingPoolTest, RunsTasksSubmittedFromWorkers) {
+    std::atomic<int> count{0};
+    gate::driver::WorkStealingPool pool(4);
+    for (int i = 0; i < 50; ++i) {
+        pool.submit([&] {
+            for (int j = 0; j < 10; ++j) pool.submit([&] { ++count; });
+            ++count;
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(count.load(), 550);
+    EXPECT_EQ(pool.size(), 4u);
+}
+
+TEST(WorkStealingPoolTest, WaitRethrowsTaskException) {
+    gate::driver::WorkStealingPool pool(2);
+    pool.submit([] { throw std::runtime_error("task failed"); });
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    pool.submit([] {});
+    EXPECT_NO_THROW(pool.wait());
+}
+
+TEST(TranspileSourceTest, MatchesSingleFilePipeline) {
+    auto result = gate::driver::transpileSource(HELLO_SOURCE, "hello.notal", {});
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.errors, 0u);
+    EXPECT_EQ(result.code, transpile(HELLO_SOURCE));
+
+    auto broken = gate::driver::transpileSource(BROKEN_SOURCE, "broken.notal", {});
+    EXPECT_FALSE(broken.success);
+    EXPECT_GT(broken.errors, 0u);
+    EXPECT_NE(broken.report.find("broken.notal"), std::string::npos);
+}
+
+TEST_F(BatchTest, ExpandsListFiles) {
+    std::filesystem::path list = testDir / "files.txt";
+    std::ofstream(list) << "# inputs\na.notal\n\n  b.notal  \n";
+
+    std::vector<std::string> files;
+    std::string error;
+    ASSERT_TRUE(gate::driver::expandInputs({"first.notal", "@" + list.string()}, files, error));
+    EXPECT_EQ(files, (std::vector<std::string>{"first.notal", "a.notal", "b.notal"}));
+
+    EXPECT_FALSE(gate::driver::expandInputs({"@" + (testDir / "missing.txt").string()}, files, error));
+    EXPECT_NE(error.find("missing.txt"), std::string::npos);
+}
+
+TEST_F(BatchTest, ReportsInInputOrderOnEveryThreadCount) {
+    std::vector<std::string> files;
+    for (int i = 0; i < 12; ++i) files.push_back(writeInput("prog" + std::to_string(i) + ".notal", HELLO_SOURCE));
+    files.insert(files.begin() + 5, writeInput("broken.notal", BROKEN_SOURCE));
+
+    std::string expected;
+    for (unsigned jobs : {1u, 4u}) {
+        std::ostringstream out, err;
+        auto summary = gate::driver::runBatch(files, options(jobs), out, err);
+        EXPECT_EQ(summary.files, 13u);
+        EXPECT_EQ(summary.succeeded, 12u);
+        EXPECT_EQ(summary.failed, 1u);
+        EXPECT_EQ(summary.jobs, jobs);
+
+        std::string progress = out.str().substr(0, out.str().rfind("Transpiled"));
+        if (expected.empty()) expected = progress;
+        EXPECT_EQ(progress, expected);
+        EXPECT_EQ(progress.find("broken"), std::string::npos);
+        EXPECT_LT(progress.find("prog4.notal"), progress.find("prog5.notal"));
+        EXPECT_NE(out.str().find("Transpiled 12 of 13 files (1 failed)"), std::string::npos);
+        EXPECT_NE(err.str().find("broken.notal: failed"), std::string::npos);
+    }
+    EXPECT_EQ(readOutput("prog7.pas"), transpile(HELLO_SOURCE));
+    EXPECT_FALSE(std::filesystem::exists(testDir / "out" / "broken.pas"));
+}
+
+TEST_F(BatchTest, RejectsInputsSharingAnOutput) {
+    std::string first = writeInput("same.notal", HELLO_SOURCE);
+    std::filesystem::create_directories(testDir / "in" / "sub");
+    std::string second = writeInput("sub/same.notal", HELLO_SOURCE);
+
+    auto batch = options(2);
+    batch.quiet = true;
+    batch.target = gate::driver::Target::C;
+    std::ostringstream out, err;
+    auto summary = gate::driver::runBatch({first, second}, batch, out, err);
+    EXPECT_EQ(summary.succeeded, 1u);
+    EXPECT_EQ(summary.failed, 1u);
+    EXPECT_EQ(out.str().find("->"), std::string::npos);
+    EXPECT_NE(err.str().find("same.c is already written for " + first), std::string::npos);
+    EXPECT_TRUE(std::filesystem::exists(testDir / "out" / "same.c"));
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+namespace {
+
+const std::string CONSTRAINED_SOURCE = R"(
+PROGRAM ProfileTest
+KAMUS
+    age: integer | age >= 0 and age <= 150
+ALGORITMA
+    age <- 25
+    output(age)
+)";
+
+} // namespace
+
+TEST(BuildProfileTest, NoProfileEmitsNoDirectives) {
+    std::string generated_pascal = transpile(CONSTRAINED_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("{$") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("Assert(") != std::string::npos);
+}
+
+TEST(BuildProfileTest, ReleaseDisablesChecksAndDropsAsserts) {
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string generated_pascal = transpile(CONSTRAINED_SOURCE, options);
+    EXPECT_EQ(generated_pascal.find("{$R-}{$Q-}{$C-}{$INLINE ON}{$OPTIMIZATION LEVEL3}"), 0u);
+    EXPECT_TRUE(generated_pascal.find("Assert(") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure Setage(var age: integer; value: integer);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("Setage(age, 25);") != std::string::npos);
+}
+
+TEST(BuildProfileTest, DebugKeepsRangeOverflowAndAssertions) {
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(CONSTRAINED_SOURCE, options);
+    EXPECT_EQ(generated_pascal.find("{$R+}{$Q+}{$C+}"), 0u);
+    EXPECT_TRUE(generated_pascal.find("Assert(") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateCheckIndex") == std::string::npos);
+}
+
+TEST(BuildProfileTest, CheckedAddsDynamicArrayBoundsChecks) {
+    std::string source = R"(
+PROGRAM CheckedTest
+KAMUS
+    grid: array of array of integer
+    fixed: array [1..3] of integer
+    i: integer
+ALGORITMA
+    allocate(grid, 2, 2)
+    grid[1][0] <- 7
+    fixed[1] <- grid[1][0]
+    output(fixed[1])
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::CHECKED;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_EQ(generated_pascal.find("{$R+}{$Q+}{$C+}"), 0u);
+    EXPECT_TRUE(generated_pascal.find("function _GateCheckIndex(index, len: Int64; const name: string): Int64;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find(
+        "grid[_GateCheckIndex(1, Length(grid), 'grid'), _GateCheckIndex(0, Length(grid[1]), 'grid')] := 7;")
+        != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("fixed[1] := ") != std::string::npos);
+}
+
+TEST(BuildProfileTest, CheckedIndexingEvaluatesEachIndexOnce) {
+    std::string source = R"(
+PROGRAM CheckedCalls
+KAMUS
+    m: array of array of integer
+    k: integer
+    function next(input x: integer) -> integer
+ALGORITMA
+    allocate(m, 3, 3)
+    k <- 0
+    m[next(k)][2] <- 5
+    m[k + 1][2] <- 7
+
+function next(input x: integer) -> integer
+ALGORITMA
+    -> x + 1
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::CHECKED;
+    std::string generated_pascal = transpile(source, options);
+    // A call is not pasted into the length of the next dimension, which {$R+} checks instead.
+    EXPECT_TRUE(generated_pascal.find("m[_GateCheckIndex(next(k), Length(m), 'm'), 2] := 5;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("Length(m[next(k)])") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find(
+        "m[_GateCheckIndex((k + 1), Length(m), 'm'), _GateCheckIndex(2, Length(m[(k + 1)]), 'm')] := 7;")
+        != std::string::npos);
+}
+
+TEST(BuildProfileTest, ProfilesKeepTheDefaultCompilerMode) {
+    std::string source = R"(
+PROGRAM ResultGlobal
+KAMUS
+    result: integer
+    function twice(input x: integer) -> integer
+ALGORITMA
+    output(twice(3), result)
+
+function twice(input x: integer) -> integer
+ALGORITMA
+    result <- x
+    -> x * 2
+)";
+    for (auto profile : {gate::transpiler::BuildProfile::RELEASE, gate::transpiler::BuildProfile::DEBUG,
+                         gate::transpiler::BuildProfile::CHECKED}) {
+        gate::transpiler::CodeGenOptions options;
+        options.profile = profile;
+        std::string generated_pascal = transpile(source, options);
+        // objfpc mode would make `result` the function's own return value
+        EXPECT_TRUE(generated_pascal.find("{$mode") == std::string::npos);
+        EXPECT_TRUE(generated_pascal.find("result := x;") != std::string::npos);
+    }
+}
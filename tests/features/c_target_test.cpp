@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+#include "driver/Transpile.h"
+
+TEST(CTargetTest, EmitsSelfContainedTranslationUnit) {
+    std::string source = R"(
+PROGRAM Hello
+KAMUS
+    n: integer
+    x: real
+ALGORITMA
+    n <- 6
+    x <- n / 4
+    output('n = ', n, ' ', x)
+)";
+    std::string code = transpileToC(source);
+    EXPECT_TRUE(code.find("/* Program Hello, generated by GATE (--target=c) */") != std::string::npos);
+    EXPECT_TRUE(code.find("#define GATE_C_RUNTIME_H") != std::string::npos);
+    EXPECT_TRUE(code.find("GATE_C_CASTING_H") == std::string::npos) << "casting helpers are only included when called";
+    EXPECT_TRUE(code.find("static gate_int n;") != std::string::npos);
+    EXPECT_TRUE(code.find("static double x;") != std::string::npos);
+    EXPECT_TRUE(code.find("int main(void) {") != std::string::npos);
+    EXPECT_TRUE(code.find("x = ((double)n / 4);") != std::string::npos);
+    EXPECT_TRUE(code.find("gate_write_cstr(\"n = \");") != std::string::npos);
+    EXPECT_TRUE(code.find("gate_write_int(n);") != std::string::npos);
+}
+
+TEST(CTargetTest, ParametersFollowTheirModes) {
+    std::string source = R"(
+PROGRAM Params
+KAMUS
+    type Point: < x: integer, y: integer >
+    p: Point
+    s: string
+    procedure update(input q: Point, input/output r: Point, input t: string)
+    function shout(input t: string) -> string
+ALGORITMA
+    update(p, p, 'a')
+    s <- shout(s)
+
+procedure update(input q: Point, input/output r: Point, input t: string)
+ALGORITMA
+    r.x <- q.y + length(t)
+
+function shout(input t: string) -> string
+ALGORITMA
+    t <- upcase(t)
+    -> t & '!'
+)";
+    std::string code = transpileToC(source);
+    EXPECT_TRUE(code.find("void update(const Point *gate_in_q, Point *r, GateString t);") != std::string::npos);
+    EXPECT_TRUE(code.find("GateString shout(GateString gate_in_t);") != std::string::npos);
+    EXPECT_TRUE(code.find("GateString t = gate_str_clone(gate_in_t);") != std::string::npos) << "a written input string gets a private copy";
+    EXPECT_TRUE(code.find("(*r).x = ((*gate_in_q).y + ((gate_int)t.len));") != std::string::npos);
+    EXPECT_TRUE(code.find("update(&p, &p, gate_str_char('a'));") != std::string::npos);
+    EXPECT_TRUE(code.find("return gate_str_result(&gate_result);") != std::string::npos);
+}
+
+TEST(CTargetTest, ConcatenationOntoTheTargetAppendsInPlace) {
+    std::string source = R"(
+PROGRAM Concat
+KAMUS
+    s: string
+    t: string
+ALGORITMA
+    s <- s & 'ab' & t
+    s <- t & s
+)";
+    std::string code = transpileToC(source);
+    EXPECT_TRUE(code.find("gate_str_append(&s, gate_str_lit(\"ab\", 2));\n    gate_str_append(&s, t);") != std::string::npos);
+    EXPECT_TRUE(code.find("gate_str_set(&s, gate_str_cat(t, s));") != std::string::npos);
+    EXPECT_TRUE(code.find("size_t gate_mark = gate_tmp_mark();") != std::string::npos) << "temporaries are released after the statement";
+}
+
+TEST(CTargetTest, RecordsHoldingStringsGetCopyAndFreeHelpers) {
+    std::string source = R"(
+PROGRAM Records
+KAMUS
+    type Person: < name: string, age: integer >
+    type Node: < value: integer, next: pointer to Node >
+    a: Person
+    b: Person
+    head: pointer to Node
+ALGORITMA
+    a.name <- 'Ann'
+    b <- a
+    allocate(head)
+    head^.value <- 1
+    deallocate(head)
+)";
+    std::string code = transpileToC(source);
+    EXPECT_TRUE(code.find("typedef struct Person Person;") != std::string::npos);
+    EXPECT_TRUE(code.find("static inline void gate_copy_Person(Person *dst, const Person *src) {") != std::string::npos);
+    EXPECT_TRUE(code.find("gate_copy_Person(&b, &a);") != std::string::npos);
+    EXPECT_TRUE(code.find("gate_copy_Node") == std::string::npos) << "records without strings are copied by assignment";
+    EXPECT_TRUE(code.find("    Node *next;") != std::string::npos);
+    EXPECT_TRUE(code.find("head = gate_alloc(sizeof *head);") != std::string::npos);
+    EXPECT_TRUE(code.find("free(head);\n    head = NULL;") != std::string::npos);
+}
+
+TEST(CTargetTest, ArraysIndexFromTheirLowerBound) {
+    std::string source = R"(
+PROGRAM Arrays
+KAMUS
+    a: array[1..5] of integer
+    d: array of array of real
+    i: integer
+ALGORITMA
+    a[i] <- a[2]
+    allocate(d, 3, i)
+    d[i][0] <- 1.5
+    deallocate[2](d)
+)";
+    std::string code = transpileToC(source);
+    EXPECT_TRUE(code.find("gate_int items[5];") != std::string::npos);
+    EXPECT_TRUE(code.find("a.items[i - 1] = a.items[1];") != std::string::npos);
+    EXPECT_TRUE(code.find("d.items[i].items[0] = 1.5;") != std::string::npos);
+    EXPECT_TRUE(code.find("gate_dyn_free(&d);") != std::string::npos);
+    EXPECT_TRUE(code.find("items[gate_index(") == std::string::npos);
+
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::CHECKED;
+    std::string checked = transpileToC(source, options);
+    EXPECT_TRUE(checked.find("#define GATE_CHECKED 1") != std::string::npos);
+    EXPECT_TRUE(checked.find("a.items[gate_index(i, 1, 5, 8)]") != std::string::npos);
+    EXPECT_TRUE(checked.find("d.items[gate_index(i, 0, d.length - 1, 10)]") != std::string::npos);
+}
+
+TEST(CTargetTest, ConstraintsAreCheckedOutsideRelease) {
+    std::string source = R"(
+PROGRAM Constrained
+KAMUS
+    age: integer | age >= 0
+ALGORITMA
+    age <- 5
+)";
+    std::string check = "if (!(age >= 0)) gate_fail(6, \"Error: age constraint violation!\");";
+    EXPECT_TRUE(transpileToC(source).find(check) != std::string::npos);
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    EXPECT_TRUE(transpileToC(source, options).find(check) == std::string::npos);
+}
+
+TEST(CTargetTest, ReservedNamesAreRenamed) {
+    std::string source = R"(
+PROGRAM Names
+KAMUS
+    index: integer
+    gate_x: integer
+    function round(input x: real) -> integer
+ALGORITMA
+    index <- round(2.5)
+    gate_x <- index
+
+function round(input x: real) -> integer
+ALGORITMA
+    -> 1
+)";
+    std::string code = transpileToC(source);
+    EXPECT_TRUE(code.find("static gate_int index_;") != std::string::npos);
+    EXPECT_TRUE(code.find("static gate_int gate_x_;") != std::string::npos);
+    EXPECT_TRUE(code.find("index_ = round_(2.5);") != std::string::npos);
+}
+
+TEST(CTargetTest, ReportsErrorsWithLineNumbers) {
+    std::string source = R"(
+PROGRAM Bad
+KAMUS
+    n: integer
+ALGORITMA
+    stop
+)";
+    EXPECT_EQ(transpileToC(source), "Error: Line 6: 'stop' used outside of a loop.");
+}
+
+TEST(CTargetTest, OutputPathsUseTheTargetsExtension) {
+    // What `gate prog.notal --target=c -o program.c` checks before writing
+    EXPECT_TRUE(gate::driver::isValidOutputPath("program.c", gate::driver::Target::C));
+    EXPECT_TRUE(gate::driver::isValidOutputPath("build/c/program.c", gate::driver::Target::C));
+    EXPECT_FALSE(gate::driver::isValidOutputPath("program.pas", gate::driver::Target::C));
+    EXPECT_FALSE(gate::driver::isValidOutputPath("../program.c", gate::driver::Target::C));
+    EXPECT_FALSE(gate::driver::isValidOutputPath(".c", gate::driver::Target::C));
+
+    EXPECT_TRUE(gate::driver::isValidOutputPath("program.pas", gate::driver::Target::PASCAL));
+    EXPECT_FALSE(gate::driver::isValidOutputPath("program.c", gate::driver::Target::PASCAL));
+    EXPECT_EQ(std::string(gate::driver::outputExtension(gate::driver::Target::C)), ".c");
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "driver/Cache.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+const std::string SOURCE = R"(
+PROGRAM Cached
+KAMUS
+    i: integer
+ALGORITMA
+    i traversal [1..3]
+        output(i)
+)";
+
+const std::string BROKEN_SOURCE = R"(
+PROGRAM Broken
+KAMUS
+    n: integer
+ALGORITMA
+    n <-
+)";
+
+class CacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        cacheDir = std::filesystem::temp_directory_path() / "gate_cache_test";
+        std::filesystem::remove_all(cacheDir);
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(cacheDir, ec);
+    }
+
+    std::filesystem::path entryPath(const std::string& key) { return cacheDir / key.substr(0, 2) / key; }
+
+    std::filesystem::path cacheDir;
+};
+
+} // namespace
+
+TEST(CacheHashTest, MatchesXxHash64) {
+    EXPECT_EQ(gate::driver::xxhash64("", 0), 0xEF46DB3751D8E999ull);
+    EXPECT_EQ(gate::driver::xxhash64("a", 1), 0xD24EC4F1A98C6E5Bull);
+    EXPECT_EQ(gate::driver::xxhash64("abc", 3), 0x44BC2CF5AD770999ull);
+    std::string stripes(100, 'x');
+    EXPECT_EQ(gate::driver::xxhash64(stripes.data(), stripes.size()), 0x92F0DE5A88A3C094ull);
+}
+
+TEST_F(CacheTest, KeysDependOnSourceOptionsAndTarget) {
+    gate::transpiler::CodeGenOptions options;
+    std::string key = gate::driver::OutputCache::key(SOURCE, options, gate::driver::Target::PASCAL);
+    EXPECT_EQ(key.size(), 32u);
+    EXPECT_EQ(key, gate::driver::OutputCache::key(SOURCE, options, gate::driver::Target::PASCAL));
+    EXPECT_NE(key, gate::driver::OutputCache::key(SOURCE + " ", options, gate::driver::Target::PASCAL));
+    EXPECT_NE(key, gate::driver::OutputCache::key(SOURCE, options, gate::driver::Target::C));
+    options.memo = true;
+    EXPECT_NE(key, gate::driver::OutputCache::key(SOURCE, options, gate::driver::Target::PASCAL));
+}
+
+TEST_F(CacheTest, HitsReturnTheStoredResultUnderTheCallersFileName) {
+    gate::driver::OutputCache cache(cacheDir.string());
+    std::string error;
+    ASSERT_TRUE(cache.open(error)) << error;
+
+    auto first = gate::driver::transpileCached(&cache, SOURCE, "a.notal", {});
+    auto second = gate::driver::transpileCached(&cache, SOURCE, "b.notal", {});
+    EXPECT_TRUE(second.success);
+    EXPECT_EQ(second.code, first.code);
+    EXPECT_EQ(second.code, transpile(SOURCE));
+
+    auto broken = gate::driver::transpileCached(&cache, BROKEN_SOURCE, "a.notal", {});
+    auto brokenHit = gate::driver::transpileCached(&cache, BROKEN_SOURCE, "b.notal", {});
+    EXPECT_FALSE(brokenHit.success);
+    EXPECT_EQ(brokenHit.errors, broken.errors);
+    ASSERT_EQ(brokenHit.diagnostics.size(), broken.diagnostics.size());
+    EXPECT_EQ(brokenHit.diagnostics[0].location.filename, "b.notal");
+    EXPECT_EQ(brokenHit.report, gate::driver::transpileSource(BROKEN_SOURCE, "b.notal", {}).report);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.stores, 2u);
+    EXPECT_EQ(stats.describe(), "Cache: 2 hits, 2 misses (50.0% hit rate), 2 stored, 0 evicted");
+}
+
+TEST_F(CacheTest, CorruptEntriesAreMissesAndRemoved) {
+    gate::driver::OutputCache cache(cacheDir.string());
+    std::string error;
+    ASSERT_TRUE(cache.open(error)) << error;
+    std::string key = gate::driver::OutputCache::key(SOURCE, {}, gate::driver::Target::PASCAL);
+    gate::driver::transpileCached(&cache, SOURCE, "a.notal", {});
+
+    std::filesystem::resize_file(entryPath(key), std::filesystem::file_size(entryPath(key)) / 2);
+    gate::driver::TranspileResult result;
+    EXPECT_FALSE(cache.lookup(key, result));
+    EXPECT_FALSE(std::filesystem::exists(entryPath(key)));
+}
+
+TEST_F(CacheTest, EvictsLeastRecentlyUsedEntries) {
+    gate::driver::TranspileResult result;
+    result.success = true;
+    result.code = std::string(1000, 'x');
+
+    // Room for about four entries.
+    gate::driver::OutputCache cache(cacheDir.string(), 4500);
+    std::string error;
+    ASSERT_TRUE(cache.open(error)) << error;
+
+    std::vector<std::string> keys;
+    auto past = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+    for (int i = 0; i < 4; ++i) {
+        keys.push_back(gate::driver::OutputCache::key(std::to_string(i), {}, gate::driver::Target::PASCAL));
+        cache.store(keys.back(), result);
+        std::filesystem::last_write_time(entryPath(keys.back()), past + std::chrono::minutes(i));
+    }
+
+    gate::driver::TranspileResult hit;
+    ASSERT_TRUE(cache.lookup(keys[0], hit));
+    EXPECT_EQ(hit.code, result.code);
+
+    cache.store(gate::driver::OutputCache::key("4", {}, gate::driver::Target::PASCAL), result);
+    EXPECT_TRUE(std::filesystem::exists(entryPath(keys[0])));
+    EXPECT_FALSE(std::filesystem::exists(entryPath(keys[1])));
+    EXPECT_FALSE(std::filesystem::exists(entryPath(keys[2])));
+    EXPECT_TRUE(std::filesystem::exists(entryPath(keys[3])));
+    EXPECT_EQ(cache.stats().evictions, 2u);
+}
+
+TEST_F(CacheTest, ConcurrentWritersNeverExposePartialEntries) {
+    gate::driver::OutputCache cache(cacheDir.string());
+    std::string error;
+    ASSERT_TRUE(cache.open(error)) << error;
+    std::string expected = transpile(SOURCE);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 25; ++i) {
+                auto result = gate::driver::transpileCached(&cache, SOURCE, "a.notal", {});
+                EXPECT_EQ(result.code, expected);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    size_t files = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(cacheDir)) files += entry.is_regular_file();
+    EXPECT_EQ(files, 1u);
+    EXPECT_EQ(cache.stats().hits + cache.stats().misses, 100u);
+}
+
+TEST_F(CacheTest, GeneratorFailuresAreNotStored) {
+    gate::driver::OutputCache cache(cacheDir.string());
+    std::string error;
+    ASSERT_TRUE(cache.open(error)) << error;
+    gate::transpiler::CodeGenOptions fastIO;
+    fastIO.fastIO = true;
+
+    // Away from the templates the generator cannot load the FastIO runtime.
+    auto repository = std::filesystem::current_path();
+    std::filesystem::create_directories(cacheDir / "elsewhere");
+    std::filesystem::current_path(cacheDir / "elsewhere");
+    auto failed = gate::driver::transpileCached(&cache, SOURCE, "a.notal", fastIO);
+    std::filesystem::current_path(repository);
+    EXPECT_FALSE(failed.success);
+    EXPECT_TRUE(failed.generatorFailed);
+    EXPECT_EQ(cache.stats().stores, 0u);
+
+    auto result = gate::driver::transpileCached(&cache, SOURCE, "a.notal", fastIO);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.code, transpile(SOURCE, fastIO));
+    EXPECT_EQ(cache.stats().hits, 0u);
+}
+
+TEST_F(CacheTest, KeysDependOnTheTemplates) {
+    // A private copy of the templates, edited below
+    auto repository = std::filesystem::current_path();
+    auto copy = cacheDir / "templates";
+    for (const char* directory : {"src/runtime", "src/casting"}) {
+        std::filesystem::create_directories(copy / directory);
+        std::filesystem::copy(repository / directory, copy / directory);
+    }
+    std::filesystem::current_path(copy);
+    std::string before = gate::driver::OutputCache::key(SOURCE, {}, gate::driver::Target::PASCAL);
+    std::string unchanged = gate::driver::OutputCache::key(SOURCE, {}, gate::driver::Target::PASCAL);
+    std::ofstream(copy / "src/runtime/FastIO.runtime.txt", std::ios::app) << "// edited\n";
+    std::string after = gate::driver::OutputCache::key(SOURCE, {}, gate::driver::Target::PASCAL);
+    std::filesystem::current_path(repository);
+
+    EXPECT_EQ(before, unchanged);
+    EXPECT_NE(before, after);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+#include "driver/Transpile.h"
+
+namespace {
+
+const std::string PURE_SOURCE = R"(
+PROGRAM ConstEvalTest
+KAMUS
+    constant N: integer = fact(5)
+    constant BIG: integer = fact(12)
+    table: array[1..fib(10)] of integer
+    i: integer
+    function fact(input n: integer) -> integer
+    function fib(input n: integer) -> integer
+ALGORITMA
+    i <- fact(7) + fib(20)
+    output(fact(i))
+
+function fact(input n: integer) -> integer
+ALGORITMA
+    if n <= 1 then
+        -> 1
+    else
+        -> n * fact(n - 1)
+
+function fib(input n: integer) -> integer
+KAMUS
+    a, b, t, k: integer
+ALGORITMA
+    a <- 0
+    b <- 1
+    k traversal [1..n]
+        t <- a + b
+        a <- b
+        b <- t
+    -> a
+)";
+
+} // namespace
+
+TEST(ConstEvalTest, ConstantsAndArrayBoundsCallingFunctionsAreEvaluated) {
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string generated_pascal = transpile(PURE_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("  N = 120;\n") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("table: array[1..55] of integer;") != std::string::npos);
+    // Without --const-eval, calls in statements are left alone
+    EXPECT_TRUE(generated_pascal.find("i := (fact(7) + fib(20));") != std::string::npos);
+}
+
+TEST(ConstEvalTest, CallsWithConstantArgumentsAreFoldedWithFlag) {
+    gate::transpiler::CodeGenOptions options;
+    options.constEval = true;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string generated_pascal = transpile(PURE_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("i := (5040 + 6765);") != std::string::npos);
+    // An argument that reads a variable is not constant; no comment either
+    EXPECT_TRUE(generated_pascal.find("writeln(fact(i));") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("fact := (n * fact((n - 1)));") != std::string::npos);
+}
+
+TEST(ConstEvalTest, OverflowOfTheTargetIntegerIsLeftAsWritten) {
+    // Every profile keeps FPC's default mode, where integer is 16-bit
+    for (auto profile : {gate::transpiler::BuildProfile::NONE, gate::transpiler::BuildProfile::RELEASE}) {
+        gate::transpiler::CodeGenOptions options;
+        options.profile = profile;
+        std::string generated_pascal = transpile(PURE_SOURCE, options);
+        EXPECT_TRUE(generated_pascal.find("  N = 120;\n") != std::string::npos);
+        EXPECT_TRUE(generated_pascal.find("  { const-eval: BIG left as written: overflows the 16-bit integer type }\n  BIG = fact(12);\n") != std::string::npos);
+    }
+}
+
+TEST(ConstEvalTest, ImpureAndRunawayFunctionsAreLeftAsWritten) {
+    std::string source = R"(
+PROGRAM Impure
+KAMUS
+    counter: integer
+    constant LOOPY: integer = spin(1)
+    function noisy(input n: integer) -> integer
+    function spin(input n: integer) -> integer
+    function bump(input n: integer) -> integer
+ALGORITMA
+    counter <- noisy(3) + bump(1)
+
+function noisy(input n: integer) -> integer
+ALGORITMA
+    output(n)
+    -> n
+
+function spin(input n: integer) -> integer
+ALGORITMA
+    while true do
+        n <- n + 0
+    -> n
+
+function bump(input n: integer) -> integer
+ALGORITMA
+    -> n + counter
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.constEval = true;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("{ const-eval: LOOPY left as written: needs more than 1000000 steps }") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("  LOOPY = spin(1);\n") != std::string::npos) << "a failed constant is not evaluated twice";
+    EXPECT_TRUE(generated_pascal.find("noisy(3) { const-eval: 'noisy' does input/output }") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("bump(1) { const-eval: 'bump' uses 'counter', which is not a local }") != std::string::npos);
+}
+
+TEST(ConstEvalTest, FallbacksAreReportedAsWarningsAtTheirLine) {
+    std::string source = R"(
+PROGRAM Fallbacks
+KAMUS
+    constant BIG: integer = fact(12)
+    t: integer
+    function fact(input n: integer) -> integer
+    function noisy(input n: integer) -> integer
+ALGORITMA
+    t <- noisy(3)
+
+function fact(input n: integer) -> integer
+ALGORITMA
+    if n <= 1 then
+        -> 1
+    else
+        -> n * fact(n - 1)
+
+function noisy(input n: integer) -> integer
+ALGORITMA
+    output(n)
+    -> n
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.constEval = true;
+    auto transpiled = gate::driver::transpileSource(source, "fallbacks.notal", options);
+    ASSERT_TRUE(transpiled.success);
+    std::vector<std::string> lines;
+    for (const auto& diagnostic : transpiled.diagnostics) {
+        lines.push_back(gate::driver::diagnosticLine("fallbacks.notal", diagnostic));
+    }
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0].rfind("fallbacks.notal:4:", 0), 0u);
+    EXPECT_NE(lines[0].find(": warning: Constant 'BIG' left as written: overflows the 16-bit integer type"), std::string::npos);
+    EXPECT_EQ(lines[1].rfind("fallbacks.notal:9:", 0), 0u);
+    EXPECT_NE(lines[1].find(": warning: Call to 'noisy' left as written: 'noisy' does input/output"), std::string::npos);
+    EXPECT_EQ(transpiled.warnings, 2u);
+}
+
+TEST(ConstEvalTest, FoldedValuesAreExactPascalLiterals) {
+    std::string source = R"(
+PROGRAM Literals
+KAMUS
+    constant THIRD: real = third(1)
+    constant DOWN: integer = last(5)
+    constant LINE: string = line('ab')
+    function third(input x: integer) -> real
+    function last(input n: integer) -> integer
+    function line(input s: string) -> string
+ALGORITMA
+    output(THIRD, DOWN, LINE)
+
+function third(input x: integer) -> real
+ALGORITMA
+    -> x / 3
+
+function last(input n: integer) -> integer
+ALGORITMA
+    -> n
+    -> 0 - n
+
+function line(input s: string) -> string
+ALGORITMA
+    -> chr(39) & upcase(s) & chr(10)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("  THIRD = 0.3333333333333333;\n") != std::string::npos);
+    // `->` sets the result without leaving the function, as in the Pascal output
+    EXPECT_TRUE(generated_pascal.find("  DOWN = (-5);\n") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("  LINE = '''AB'#10;\n") != std::string::npos);
+}
+
+TEST(ConstEvalTest, CallsViolatingAParameterConstraintAreLeftAsWritten) {
+    std::string source = R"(
+PROGRAM Constrained
+KAMUS
+    t: integer
+    function score(input x: integer | x >= 0 and x <= 4) -> integer
+ALGORITMA
+    t <- score(9)
+    t <- score(3)
+
+function score(input x: integer | x >= 0 and x <= 4) -> integer
+ALGORITMA
+    -> x * x - 3
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.constEval = true;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("t := score(9) { const-eval: violates the constraint on x };") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("t := 6;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("Assert(((x >= 0) and (x <= 4)), 'Error: x constraint violation!');") != std::string::npos);
+}
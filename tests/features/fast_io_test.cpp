@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+TEST(FastIOTest, DisabledByDefault) {
+    std::string source = R"(
+PROGRAM PlainIO
+KAMUS
+    n: integer
+ALGORITMA
+    input(n)
+    output(n)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("readln(n);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("SetTextBuf") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateReadToken") == std::string::npos);
+}
+
+TEST(FastIOTest, InstallsBuffersAndFlushesOnce) {
+    std::string source = R"(
+PROGRAM FastOutput
+KAMUS
+    i: integer
+ALGORITMA
+    i traversal [1..10]
+        output(i)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.fastIO = true;
+    std::string generated_pascal = transpile(source, options);
+
+    size_t setIn = generated_pascal.find("SetTextBuf(Input, _GateInBuf, SizeOf(_GateInBuf));");
+    size_t setOut = generated_pascal.find("SetTextBuf(Output, _GateOutBuf, SizeOf(_GateOutBuf));");
+    size_t loop = generated_pascal.find("while (i <= 10) do");
+    size_t flush = generated_pascal.find("Flush(Output);");
+    ASSERT_NE(setIn, std::string::npos);
+    ASSERT_NE(setOut, std::string::npos);
+    ASSERT_NE(flush, std::string::npos);
+    EXPECT_LT(setOut, loop);
+    EXPECT_GT(flush, loop);
+    EXPECT_TRUE(generated_pascal.find("_GateOutBuf: array[0..65535] of Char;") != std::string::npos);
+}
+
+TEST(FastIOTest, ReadsBasicTypesThroughTokenReader) {
+    std::string source = R"(
+PROGRAM FastInput
+KAMUS
+    n: integer
+    x: real
+    c: character
+    ok: boolean
+    name: string
+    procedure readOne(output v: integer)
+ALGORITMA
+    input(n)
+    input(x)
+    input(c)
+    input(ok)
+    input(name)
+    readOne(n)
+
+procedure readOne(output v: integer)
+ALGORITMA
+    input(v)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.fastIO = true;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("_GateReadInteger(n);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateReadReal(x);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateReadChar(c);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateReadBoolean(ok);") != std::string::npos);
+    // Only TRUE or FALSE, in any case, is a boolean; anything else is runtime error 106
+    EXPECT_TRUE(generated_pascal.find("token := UpCase(_GateReadToken);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("(token <> 'FALSE') then RunError(106);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("readln(name);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateReadInteger(v);") != std::string::npos);
+}
+
+TEST(FastIOTest, TokenReaderKeepsReadlnLineSemantics) {
+    std::string source = R"(
+PROGRAM MixedLine
+KAMUS
+    x, y: integer
+ALGORITMA
+    input(x)
+    input(y)
+    output(x)
+    output(y)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.fastIO = true;
+    std::string generated_pascal = transpile(source, options);
+
+    // With input "21 ignored\n5" readln gives y = 5: every read discards the rest of its line...
+    size_t reader = generated_pascal.find("function _GateReadToken: string;");
+    ASSERT_NE(reader, std::string::npos);
+    size_t skip = generated_pascal.find("_GateSkipLine(c);", reader);
+    ASSERT_NE(skip, std::string::npos);
+    EXPECT_LT(skip, generated_pascal.find("procedure _GateReadInteger"));
+    EXPECT_TRUE(generated_pascal.find("_GateSkipLine(x);") != std::string::npos);
+    // ...and a token that is not a number is runtime error 106, not a silent 0.
+    EXPECT_TRUE(generated_pascal.find("Val(token, x, code);\n  if code <> 0 then RunError(106);") != std::string::npos);
+
+    // Compile and run when Free Pascal is available.
+    if (std::system("fpc -h > /dev/null 2>&1") != 0) GTEST_SKIP() << "fpc not available";
+    auto dir = std::filesystem::temp_directory_path() / "gate_fast_io_test";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "mixed.pas") << generated_pascal;
+    std::ofstream(dir / "good.txt") << "21 ignored\n5\n";
+    std::ofstream(dir / "bad.txt") << "2x1\n5\n";
+    std::string build = "cd " + dir.string() + " && fpc -omixed mixed.pas > /dev/null 2>&1";
+    ASSERT_EQ(std::system(build.c_str()), 0);
+    std::string run = "cd " + dir.string() + " && ./mixed < good.txt > good.out";
+    EXPECT_EQ(std::system(run.c_str()), 0);
+    std::ifstream out(dir / "good.out");
+    std::stringstream printed;
+    printed << out.rdbuf();
+    EXPECT_EQ(printed.str(), "21\n5\n");
+    std::string bad = "cd " + dir.string() + " && ./mixed < bad.txt > /dev/null 2>&1";
+    EXPECT_NE(std::system(bad.c_str()), 0);
+    std::filesystem::remove_all(dir);
+}
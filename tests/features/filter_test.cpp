@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "driver/Transpile.h"
+#include "utils/SecureFileReader.h"
+#include <sstream>
+
+namespace {
+
+const std::string HELLO_SOURCE = R"(
+PROGRAM Hello
+KAMUS
+    n: integer
+ALGORITMA
+    n <- 3
+    output('n = ', n)
+)";
+
+const std::string BROKEN_SOURCE = R"(
+PROGRAM Broken
+KAMUS
+    n: integer
+ALGORITMA
+    n <-
+)";
+
+gate::diagnostics::Diagnostic diagnostic(const std::string& code, const std::string& message) {
+    gate::diagnostics::SourceLocation location("<stdin>", 7, 12);
+    return gate::diagnostics::Diagnostic::Builder(message, location)
+        .withLevel(gate::diagnostics::DiagnosticLevel::WARNING)
+        .withCode(code)
+        .build();
+}
+
+} // namespace
+
+TEST(FilterTest, SourcesReadFromAStreamTranspileLikeFiles) {
+    std::istringstream in(HELLO_SOURCE);
+    auto readResult = gate::utils::SecureFileReader::readStream(in);
+    ASSERT_TRUE(readResult.success);
+
+    auto transpiled = gate::driver::transpileSource(readResult.content, "<stdin>", {});
+    EXPECT_TRUE(transpiled.success);
+    EXPECT_EQ(transpiled.code, transpile(HELLO_SOURCE));
+}
+
+TEST(FilterTest, DiagnosticsFormatAsOneLineEach) {
+    EXPECT_EQ(gate::driver::diagnosticLine("<stdin>", diagnostic("W0101", "Unused variable")),
+              "<stdin>:7:12: warning[W0101]: Unused variable");
+    EXPECT_EQ(gate::driver::diagnosticLine("a.notal", diagnostic("", "Two\nlines")),
+              "a.notal:7:12: warning: Two lines");
+
+    auto transpiled = gate::driver::transpileSource(BROKEN_SOURCE, "<stdin>", {});
+    ASSERT_FALSE(transpiled.diagnostics.empty());
+    std::string line = gate::driver::diagnosticLine("<stdin>", transpiled.diagnostics[0]);
+    EXPECT_EQ(line.rfind("<stdin>:", 0), 0u);
+    EXPECT_NE(line.find(": error[E"), std::string::npos);
+    EXPECT_EQ(line.find('\n'), std::string::npos);
+}
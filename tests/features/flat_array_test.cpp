@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+namespace {
+
+const std::string MATRIX_SOURCE = R"(
+PROGRAM FlatTest
+KAMUS
+    grid: array of array of integer
+    n: integer
+ALGORITMA
+    n <- 3
+    allocate(grid, n, n + 1)
+    grid[1][2] <- 5
+    output(grid[1][2], length(grid))
+    deallocate[2](grid)
+)";
+
+} // namespace
+
+TEST(FlatArrayTest, DisabledByDefault) {
+    std::string generated_pascal = transpile(MATRIX_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("grid: array of array of integer;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("SetLength(grid, n, (n + 1));") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateExt_") == std::string::npos);
+}
+
+TEST(FlatArrayTest, StoresOneBufferWithExtents) {
+    gate::transpiler::CodeGenOptions options;
+    options.flatArrays = true;
+    std::string generated_pascal = transpile(MATRIX_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("grid: array of integer;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateExt_grid: array[0..1] of longint = (0, 0);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find(
+        "_GateExt_grid[0] := n;\n  _GateExt_grid[1] := (n + 1);\n  SetLength(grid, _GateExt_grid[0] * _GateExt_grid[1]);")
+        != std::string::npos);
+}
+
+TEST(FlatArrayTest, RewritesIndexingAndLength) {
+    gate::transpiler::CodeGenOptions options;
+    options.flatArrays = true;
+    std::string generated_pascal = transpile(MATRIX_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("grid[(1) * _GateExt_grid[1] + 2] := 5;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("writeln(grid[(1) * _GateExt_grid[1] + 2], _GateExt_grid[0]);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("SetLength(grid, 0);\n  FillChar(_GateExt_grid, SizeOf(_GateExt_grid), 0);") != std::string::npos);
+}
+
+TEST(FlatArrayTest, RowAccessKeepsNestedArrays) {
+    std::string source = R"(
+PROGRAM RowTest
+KAMUS
+    grid: array of array of integer
+    row: array of integer
+ALGORITMA
+    allocate(grid, 2, 2)
+    row <- grid[0]
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.flatArrays = true;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("grid: array of array of integer;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateExt_grid") == std::string::npos);
+}
+
+TEST(FlatArrayTest, CheckedProfileChecksEachExtent) {
+    gate::transpiler::CodeGenOptions options;
+    options.flatArrays = true;
+    options.profile = gate::transpiler::BuildProfile::CHECKED;
+    std::string generated_pascal = transpile(MATRIX_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find(
+        "grid[(_GateCheckIndex(1, _GateExt_grid[0], 'grid')) * _GateExt_grid[1] + _GateCheckIndex(2, _GateExt_grid[1], 'grid')] := 5;")
+        != std::string::npos);
+}
+
+TEST(FlatArrayTest, DebugProfileKeepsNestedArrays) {
+    gate::transpiler::CodeGenOptions options;
+    options.flatArrays = true;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(MATRIX_SOURCE, options);
+    // {$R+} alone would only check the combined offset
+    EXPECT_TRUE(generated_pascal.find("grid: array of array of integer;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateExt_grid") == std::string::npos);
+}
+
+TEST(FlatArrayTest, LocalExtentsStartAtZero) {
+    std::string source = R"(
+PROGRAM FlatLocal
+KAMUS
+    procedure show()
+ALGORITMA
+    show()
+
+procedure show()
+KAMUS
+    t: array of array of array of integer
+ALGORITMA
+    output(length(t))
+    allocate(t, 2, 2, 2)
+    t[1][1][1] <- 3
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.flatArrays = true;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("_GateExt_t: array[0..2] of longint = (0, 0, 0);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("writeln(_GateExt_t[0]);") != std::string::npos);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+namespace {
+
+const std::string HELPERS_SOURCE = R"(
+PROGRAM InlineTest
+KAMUS
+    i: integer
+    total: integer
+    function maxOf(input a: integer, input b: integer) -> integer
+    function fact(input n: integer) -> integer
+    procedure report(input x: integer)
+ALGORITMA
+    total <- 0
+    i traversal [1..10]
+        total <- maxOf(total, i)
+    report(fact(total))
+
+function maxOf(input a: integer, input b: integer) -> integer
+ALGORITMA
+    if a > b then
+        -> a
+    else
+        -> b
+
+function fact(input n: integer) -> integer
+ALGORITMA
+    if n <= 1 then
+        -> 1
+    else
+        -> n * fact(n - 1)
+
+procedure report(input x: integer)
+ALGORITMA
+    output(maxOf(x, 0))
+)";
+
+} // namespace
+
+TEST(InlineTest, DisabledByDefault) {
+    std::string generated_pascal = transpile(HELPERS_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("inline;") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("{$INLINE ON}") == std::string::npos);
+}
+
+TEST(InlineTest, MarksSmallLeafFunctionInForwardAndImplementation) {
+    gate::transpiler::CodeGenOptions options;
+    options.inlineThreshold = 40;
+    std::string generated_pascal = transpile(HELPERS_SOURCE, options);
+    EXPECT_EQ(generated_pascal.find("{$INLINE ON}"), 0u);
+    EXPECT_TRUE(generated_pascal.find("function maxOf(a: integer; b: integer): integer; inline; forward;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("function maxOf(a: integer; b: integer): integer; inline;\n") != std::string::npos);
+}
+
+TEST(InlineTest, SkipsRecursiveAndNonLeafSubprograms) {
+    gate::transpiler::CodeGenOptions options;
+    options.inlineThreshold = 40;
+    std::string generated_pascal = transpile(HELPERS_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("function fact(n: integer): integer; forward;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure report(x: integer); forward;") != std::string::npos);
+}
+
+TEST(InlineTest, ThresholdLimitsSubprogramSize) {
+    gate::transpiler::CodeGenOptions options;
+    options.inlineThreshold = 3;
+    std::string generated_pascal = transpile(HELPERS_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("inline;") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("{$") == std::string::npos);
+}
+
+TEST(InlineTest, ReleaseProfileKeepsSingleDirectiveLine) {
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    options.inlineThreshold = gate::transpiler::DEFAULT_INLINE_THRESHOLD;
+    std::string generated_pascal = transpile(HELPERS_SOURCE, options);
+    EXPECT_EQ(generated_pascal.find("{$R-}{$Q-}{$C-}{$INLINE ON}{$OPTIMIZATION LEVEL3}\n\nprogram InlineTest;"), 0u);
+    EXPECT_TRUE(generated_pascal.find("; inline; forward;") != std::string::npos);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+const std::string RECURSIVE_SOURCE = R"(
+PROGRAM MemoTest
+KAMUS
+    calls: integer
+    function fib(input n: integer) -> integer
+    function binom(input n: integer, input k: integer) -> integer
+    function counted(input n: integer) -> integer
+ALGORITMA
+    calls <- 0
+    output(fib(30), binom(20, 10), counted(5))
+
+function fib(input n: integer) -> integer
+ALGORITMA
+    if n < 2 then
+        -> n
+    else
+        -> fib(n - 1) + fib(n - 2)
+
+function binom(input n: integer, input k: integer) -> integer
+ALGORITMA
+    if (k = 0) or (k = n) then
+        -> 1
+    else
+        -> binom(n - 1, k - 1) + binom(n - 1, k)
+
+function counted(input n: integer) -> integer
+ALGORITMA
+    calls <- calls + 1
+    if n = 0 then
+        -> 0
+    else
+        -> counted(n - 1)
+)";
+
+size_t countOf(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) ++count;
+    return count;
+}
+
+// Text of a Pascal function from its header up to its closing "end;"
+std::string functionText(const std::string& pascal, const std::string& header) {
+    size_t start = pascal.find(header);
+    if (start == std::string::npos) return "";
+    size_t end = pascal.find("\nend;\n", start);
+    return pascal.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+// Number of times fib's body ran for fib(25), read from the profile report of
+// the compiled program; -1 when the program cannot be built or run.
+long long fibBodyRuns(bool memo) {
+    std::string source = R"(
+PROGRAM MemoCount
+KAMUS
+    function fib(input n: integer) -> integer
+ALGORITMA
+    output(fib(25))
+
+function fib(input n: integer) -> integer
+ALGORITMA
+    if n < 2 then
+        -> n
+    else
+        -> fib(n - 1) + fib(n - 2)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.memo = memo;
+    options.instrument = gate::transpiler::Instrumentation::PROFILE;
+    auto dir = std::filesystem::temp_directory_path() / (memo ? "gate_memo_on" : "gate_memo_off");
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "count.pas") << transpile(source, options);
+    std::string command = "cd " + dir.string() + " && fpc -ocount count.pas > /dev/null 2>&1 && ./count > out.txt 2> profile.txt";
+    long long runs = -1;
+    if (std::system(command.c_str()) == 0) {
+        std::ifstream profile(dir / "profile.txt");
+        std::string name;
+        long long calls = 0;
+        std::string line;
+        while (std::getline(profile, line)) {
+            std::istringstream fields(line);
+            if (fields >> name >> calls && name == "fib") runs = calls;
+        }
+    }
+    std::filesystem::remove_all(dir);
+    return runs;
+}
+
+} // namespace
+
+TEST(MemoTest, DisabledByDefault) {
+    std::string generated_pascal = transpile(RECURSIVE_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("_GateMemo") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateCalc_") == std::string::npos);
+}
+
+TEST(MemoTest, FibonacciRecursesThroughTable) {
+    gate::transpiler::CodeGenOptions options;
+    options.memo = true;
+    std::string generated_pascal = transpile(RECURSIVE_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("_GateMemoVals_fib: array[0.._GateMemoSize - 1] of integer;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("function _GateCalc_fib(n: integer): integer;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateCalc_fib := (fib((n - 1)) + fib((n - 2)));") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("  _key := Int64(Ord(n));\n") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("    _value := _GateCalc_fib(n);\n") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("  fib := _value;\n") != std::string::npos);
+}
+
+TEST(MemoTest, EveryRecursiveCallGoesThroughTheWrapper) {
+    gate::transpiler::CodeGenOptions options;
+    options.memo = true;
+    std::string generated_pascal = transpile(RECURSIVE_SOURCE, options);
+    // Each computed body calls back into the wrapper at every recursive call
+    // site, and only the wrapper calls the body, so each argument is computed
+    // once: n + 1 bodies for fib(n) and O(n * k) for binom(n, k).
+    std::string fibBody = functionText(generated_pascal, "function _GateCalc_fib(n: integer): integer;");
+    ASSERT_FALSE(fibBody.empty());
+    EXPECT_EQ(countOf(fibBody, "fib(("), 2u);
+    EXPECT_EQ(countOf(generated_pascal, "_GateCalc_fib("), 2u);
+    EXPECT_EQ(countOf(functionText(generated_pascal, "function fib(n: integer): integer;\n"), "_GateCalc_fib(n)"), 1u);
+
+    std::string binomBody = functionText(generated_pascal, "function _GateCalc_binom(n: integer; k: integer): integer;");
+    ASSERT_FALSE(binomBody.empty());
+    EXPECT_EQ(countOf(binomBody, "binom(("), 2u);
+    EXPECT_EQ(countOf(generated_pascal, "_GateCalc_binom("), 2u);
+}
+
+TEST(MemoTest, MemoizedFibonacciComputesEachArgumentOnce) {
+    if (std::system("fpc -h > /dev/null 2>&1") != 0) GTEST_SKIP() << "fpc not available";
+    // fib(25) runs the body 242785 times without the table and 26 times with it.
+    EXPECT_EQ(fibBodyRuns(false), 242785);
+    EXPECT_EQ(fibBodyRuns(true), 26);
+}
+
+TEST(MemoTest, TwoArgumentKeyPacksBothArguments) {
+    gate::transpiler::CodeGenOptions options;
+    options.memo = true;
+    std::string generated_pascal = transpile(RECURSIVE_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("_key := (Int64(Ord(n)) shl 32) xor (Int64(Ord(k)) and $FFFFFFFF);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_value := _GateCalc_binom(n, k);") != std::string::npos);
+}
+
+TEST(MemoTest, FunctionWritingGlobalIsNotMemoized) {
+    gate::transpiler::CodeGenOptions options;
+    options.memo = true;
+    std::string generated_pascal = transpile(RECURSIVE_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("_GateCalc_counted") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("function counted(n: integer): integer;\n") != std::string::npos);
+}
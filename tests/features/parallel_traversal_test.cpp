@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+
+namespace {
+
+const std::string PARALLEL_SOURCE = R"(
+PROGRAM ParallelTest
+KAMUS
+    constant N: integer = 1000
+    a: array[1..N] of integer
+    b: array[1..N] of integer
+    i, j: integer
+    total: integer
+    function square(input x: integer) -> integer
+ALGORITMA
+    total <- 0
+    i traversal paralel [1..N]
+        a[i] <- square(i) mod 7
+        j traversal [1..3]
+            b[i] <- b[i] + j
+        total <- total + a[i]
+    output(total)
+
+function square(input x: integer) -> integer
+ALGORITMA
+    -> x * x
+)";
+
+} // namespace
+
+TEST(ParallelTraversalTest, PlainTraversalStaysSequential) {
+    std::string source = R"(
+PROGRAM Plain
+KAMUS
+    i: integer
+ALGORITMA
+    i traversal [1..10]
+        output(i)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("_GatePar") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("cthreads") == std::string::npos);
+}
+
+TEST(ParallelTraversalTest, LoopRunsOnWorkerThreads) {
+    std::string generated_pascal = transpile(PARALLEL_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("uses {$IFDEF UNIX}cthreads, {$ENDIF}SysUtils;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure _GateParRun(worker: TThreadFunc);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("function _GateParallel0(_GateArg: Pointer): PtrInt;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateParBegin(1, N, 1);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateParRun(@_GateParallel0);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("i := _GateParStart + _GateTrip * _GateParStep;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("i := _GateParNext;") != std::string::npos);
+}
+
+TEST(ParallelTraversalTest, SumIsReducedPerWorker) {
+    std::string generated_pascal = transpile(PARALLEL_SOURCE);
+    // Each worker adds into its own total and the partial sums are combined after the join
+    EXPECT_TRUE(generated_pascal.find("_GateParallel0_total: array[0.._GateParMaxWorkers - 1] of integer;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("  total := 0;\n  for _GateTrip") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateParallel0_total[PtrInt(_GateArg)] := total;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("for _GateParK := 0 to _GateParWorkers - 1 do total := total + _GateParallel0_total[_GateParK];") != std::string::npos);
+}
+
+TEST(ParallelTraversalTest, NestedIteratorIsPrivate) {
+    std::string generated_pascal = transpile(PARALLEL_SOURCE);
+    size_t worker = generated_pascal.find("function _GateParallel0");
+    size_t body = generated_pascal.find("begin", worker);
+    ASSERT_TRUE(worker != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("  j: integer;", worker) < body);
+}
+
+TEST(ParallelTraversalTest, CrossIterationDependencyStaysSequential) {
+    std::string source = R"(
+PROGRAM Prefix
+KAMUS
+    a: array[0..100] of integer
+    i: integer
+ALGORITMA
+    i traversal paralel [1..100]
+        a[i] <- a[i - 1] + i
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("_GateParallel0") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("{ traversal paralel runs sequentially: the body uses a at an index other than i }") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("while (i <= 100) do") != std::string::npos);
+}
+
+TEST(ParallelTraversalTest, SharedScalarWriteStaysSequential) {
+    std::string source = R"(
+PROGRAM LastValue
+KAMUS
+    a: array[1..100] of integer
+    i, last: integer
+ALGORITMA
+    i traversal paralel [1..100]
+        last <- a[i]
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("_GateParallel0") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("the body writes the shared variable last") != std::string::npos);
+}
+
+TEST(ParallelTraversalTest, OutputStaysSequential) {
+    std::string source = R"(
+PROGRAM Printer
+KAMUS
+    i: integer
+ALGORITMA
+    i traversal paralel [1..10]
+        output(i)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("the body does input or output") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("cthreads") == std::string::npos);
+}
+
+TEST(ParallelTraversalTest, SubprogramLoopStaysSequential) {
+    std::string source = R"(
+PROGRAM InProcedure
+KAMUS
+    procedure fill(input count: integer)
+ALGORITMA
+    fill(10)
+
+procedure fill(input count: integer)
+KAMUS
+    a: array[1..10] of integer
+    i: integer
+ALGORITMA
+    i traversal paralel [1..count]
+        a[i] <- i
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("only loops of the main algorithm run in parallel") != std::string::npos);
+}
+
+TEST(ParallelTraversalTest, CastingOutputToSharedScalarStaysSequential) {
+    std::string source = R"(
+PROGRAM Digits
+KAMUS
+    a: array[1..100] of integer
+    t: array[1..100] of string
+    i: integer
+    s: string
+ALGORITMA
+    i traversal paralel [1..100]
+        IntegerToString(i, s)
+        a[i] <- length(s)
+    i traversal paralel [1..100]
+        IntegerToString(i, t[i])
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("the body writes the shared variable s") != std::string::npos);
+    // Writing through the iterator's own element is still safe.
+    EXPECT_TRUE(generated_pascal.find("_GateParallel0") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateParallel1") == std::string::npos);
+}
+
+TEST(ParallelTraversalTest, NestedIteratorReadAfterLoopStaysSequential) {
+    std::string source = R"(
+PROGRAM LastInner
+KAMUS
+    b: array[1..1000] of integer
+    i, j: integer
+ALGORITMA
+    i traversal paralel [1..1000]
+        j traversal [1..3]
+            b[i] <- b[i] + j
+    output(j)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("_GateParallel0") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("{ traversal paralel runs sequentially: j is read outside the loop }") != std::string::npos);
+
+    // Reading j in the body of a later traversal over j does not count
+    std::string reused = R"(
+PROGRAM Reused
+KAMUS
+    b: array[1..1000] of integer
+    i, j: integer
+ALGORITMA
+    i traversal paralel [1..1000]
+        j traversal [1..3]
+            b[i] <- b[i] + j
+    j traversal [1..3]
+        output(b[j])
+)";
+    EXPECT_TRUE(transpile(reused).find("_GateParallel0") != std::string::npos);
+}
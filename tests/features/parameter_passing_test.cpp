@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+
+TEST(ParameterPassingTest, InputStringIsPassedAsConst) {
+    std::string source = R"(
+PROGRAM ConstStringTest
+KAMUS
+    procedure greet(input name: string, input count: integer)
+ALGORITMA
+    greet('World', 2)
+
+procedure greet(input name: string, input count: integer)
+ALGORITMA
+    output('Hello, ', name, count)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("procedure greet(const name: string; count: integer); forward;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure greet(const name: string; count: integer);\n") != std::string::npos);
+}
+
+TEST(ParameterPassingTest, SmallRecordIsConstLargeRecordIsConstref) {
+    std::string source = R"(
+PROGRAM ConstRecordTest
+KAMUS
+    type Point: < x: integer, y: integer >
+    type Student: < name: string, age: integer >
+    procedure showPoint(input p: Point)
+    procedure showStudent(input s: Student)
+ALGORITMA
+    output('records')
+
+procedure showPoint(input p: Point)
+ALGORITMA
+    output(p.x, p.y)
+
+procedure showStudent(input s: Student)
+ALGORITMA
+    output(s.name, s.age)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("procedure showPoint(const p: Point);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure showStudent(constref s: Student);") != std::string::npos);
+}
+
+TEST(ParameterPassingTest, ModifiedInputParameterStaysByValue) {
+    std::string source = R"(
+PROGRAM LocalCopyTest
+KAMUS
+    type Student: < name: string, age: integer >
+    procedure shout(input msg: string)
+    procedure birthday(input s: Student)
+    procedure fill(output target: string)
+    procedure refill(input msg: string)
+ALGORITMA
+    output('copies')
+
+procedure shout(input msg: string)
+ALGORITMA
+    msg <- msg + '!'
+    output(msg)
+
+procedure birthday(input s: Student)
+ALGORITMA
+    s.age <- s.age + 1
+    output(s.age)
+
+procedure fill(output target: string)
+ALGORITMA
+    target <- 'filled'
+
+procedure refill(input msg: string)
+ALGORITMA
+    fill(msg)
+    output(msg)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("procedure shout(msg: string);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure birthday(s: Student);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure fill(var target: string);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure refill(msg: string);") != std::string::npos);
+}
+
+TEST(ParameterPassingTest, ScalarInputParametersStayByValue) {
+    std::string source = R"(
+PROGRAM ScalarTest
+KAMUS
+    function twice(input n: integer, input r: real, input c: character) -> integer
+ALGORITMA
+    output(twice(2, 1.5, 'a'))
+
+function twice(input n: integer, input r: real, input c: character) -> integer
+ALGORITMA
+    -> n * 2
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("function twice(n: integer; r: real; c: char): integer;") != std::string::npos);
+}
+
+TEST(ParameterPassingTest, CastingOutputArgumentStaysByValue) {
+    std::string source = R"(
+PROGRAM CastOutputTest
+KAMUS
+    procedure show(input s: string)
+ALGORITMA
+    show('x')
+
+procedure show(input s: string)
+ALGORITMA
+    IntegerToString(5, s)
+    output(s)
+)";
+    std::string generated_pascal = transpile(source);
+    EXPECT_TRUE(generated_pascal.find("procedure show(s: string);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("const s: string") == std::string::npos);
+}
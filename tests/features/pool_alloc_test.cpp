@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+namespace {
+
+const std::string LIST_SOURCE = R"(
+PROGRAM PoolTest
+KAMUS
+    type Node: < value: integer, next: pointer to Node >
+    head: pointer to Node
+    p: pointer to Node
+ALGORITMA
+    allocate(head)
+    head^.next <- NULL
+    allocate(head^.next)
+    p <- head^.next
+    deallocate(p)
+    deallocate(head)
+)";
+
+} // namespace
+
+TEST(PoolAllocTest, RecordPointerField) {
+    std::string generated_pascal = transpile(LIST_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("next: ^Node;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("New(head);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("PoolNew_") == std::string::npos);
+}
+
+TEST(PoolAllocTest, LowersAllocateAndDeallocateToPool) {
+    gate::transpiler::CodeGenOptions options;
+    options.alloc = gate::transpiler::AllocStrategy::POOL;
+    std::string generated_pascal = transpile(LIST_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("procedure PoolNew_Node(var p);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure PoolDispose_Node(var p);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("PoolNew_Node(head);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("PoolNew_Node((head^).next);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("PoolDispose_Node(p);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("New(head);") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("Dispose(p);") == std::string::npos);
+}
+
+TEST(PoolAllocTest, ReleasesPoolsAtProgramExit) {
+    gate::transpiler::CodeGenOptions options;
+    options.alloc = gate::transpiler::AllocStrategy::POOL;
+    std::string generated_pascal = transpile(LIST_SOURCE, options);
+    size_t lastDispose = generated_pascal.find("PoolDispose_Node(head);");
+    size_t release = generated_pascal.find("  _GatePoolRelease_Node;\nend.");
+    ASSERT_NE(release, std::string::npos);
+    EXPECT_LT(lastDispose, release);
+}
+
+TEST(PoolAllocTest, DynamicArraysKeepSetLength) {
+    std::string source = R"(
+PROGRAM PoolArrayTest
+KAMUS
+    arr: array of integer
+    p: pointer to integer
+ALGORITMA
+    allocate(arr, 10)
+    allocate(p)
+    deallocate[1](arr)
+    deallocate(p)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.alloc = gate::transpiler::AllocStrategy::POOL;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("SetLength(arr, 10);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("PoolNew_integer(p);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("PoolDispose_integer(p);") != std::string::npos);
+}
+
+TEST(PoolAllocTest, NonRecordPointeesUseTheirPascalType) {
+    std::string source = R"(
+PROGRAM PoolCharTest
+KAMUS
+    p: pointer to character
+ALGORITMA
+    allocate(p)
+    p^ <- 'x'
+    deallocate(p)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.alloc = gate::transpiler::AllocStrategy::POOL;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("true: (value: char);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("(value: character)") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("procedure PoolNew_character(var p);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("PoolNew_character(p);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GatePoolRelease_character;\nend.") != std::string::npos);
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+namespace {
+
+const std::string PROFILED_SOURCE = R"(
+PROGRAM ProfileTest
+KAMUS
+    i: integer
+    total: integer
+    function twice(input x: integer) -> integer
+ALGORITMA
+    total <- 0
+    i traversal [1..10]
+        total <- total + twice(i)
+    output(total)
+
+function twice(input x: integer) -> integer
+ALGORITMA
+    -> x * 2
+)";
+
+} // namespace
+
+TEST(ProfileInstrumentTest, DisabledByDefault) {
+    std::string generated_pascal = transpile(PROFILED_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("_GateHits") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateProfileReport") == std::string::npos);
+}
+
+TEST(ProfileInstrumentTest, CountsStatementsByLine) {
+    gate::transpiler::CodeGenOptions options;
+    options.instrument = gate::transpiler::Instrumentation::PROFILE;
+    std::string generated_pascal = transpile(PROFILED_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("uses SysUtils;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateStmtCount = 5;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateStmtLines: array[0.._GateStmtCount] of integer = (8, 9, 10, 11, 15, 0);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("Inc(_GateHits[0]);\n  total := 0;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("Inc(_GateHits[2]);") != std::string::npos);
+}
+
+TEST(ProfileInstrumentTest, TimesSubprogramsAndReportsAtExit) {
+    gate::transpiler::CodeGenOptions options;
+    options.instrument = gate::transpiler::Instrumentation::PROFILE;
+    std::string generated_pascal = transpile(PROFILED_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("_GateSubNames: array[0.._GateSubCount] of string = ('twice', '');") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateProfileEnter(0);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateProfileLeave(0);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("_GateProfileReport;\nend.") != std::string::npos);
+}
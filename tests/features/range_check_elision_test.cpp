@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+namespace {
+
+const std::string TRAVERSAL_SOURCE = R"(
+PROGRAM RangeElision
+KAMUS
+    constant N: integer = 10
+    arr: array[1..N] of integer
+    i: integer
+    total: integer
+ALGORITMA
+    total <- 0
+    i traversal [1..N - 1]
+        total <- total + arr[i + 1] - arr[i]
+    i traversal [1..N]
+        total <- total + arr[i + 1]
+    output(total)
+)";
+
+} // namespace
+
+TEST(RangeCheckElisionTest, DisabledWithoutCheckedProfile) {
+    std::string generated_pascal = transpile(TRAVERSAL_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("{$R-}") == std::string::npos);
+}
+
+TEST(RangeCheckElisionTest, ProvenAffineAccessRunsUnchecked) {
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(TRAVERSAL_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("{$R-}\n    total := ((total + arr[(i + 1)]) - arr[i]);\n    {$R+}") != std::string::npos);
+}
+
+TEST(RangeCheckElisionTest, OutOfRangeOffsetKeepsCheck) {
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::CHECKED;
+    std::string generated_pascal = transpile(TRAVERSAL_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("{$R-}\n    total := (total + arr[(i + 1)]);") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("    total := (total + arr[(i + 1)]);") != std::string::npos);
+}
+
+TEST(RangeCheckElisionTest, IteratorWrittenInBodyKeepsCheck) {
+    std::string notal_code = R"(
+PROGRAM RangeWritten
+KAMUS
+    arr: array[1..10] of integer
+    i: integer
+ALGORITMA
+    i traversal [1..10]
+        arr[i] <- 0
+        i <- i + 1
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("{$R-}") == std::string::npos);
+}
+
+TEST(RangeCheckElisionTest, GlobalIteratorWrittenBySubprogramKeepsCheck) {
+    std::string notal_code = R"(
+PROGRAM RangeGlobal
+KAMUS
+    arr: array[1..10] of integer
+    i: integer
+    procedure bump()
+ALGORITMA
+    i traversal [1..10]
+        arr[i] <- 0
+        bump()
+
+procedure bump()
+ALGORITMA
+    i <- 10
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("{$R-}") == std::string::npos);
+}
+
+TEST(RangeCheckElisionTest, IteratorWrittenByCastingRoutineKeepsCheck) {
+    std::string notal_code = R"(
+PROGRAM RangeCast
+KAMUS
+    arr: array[1..10] of integer
+    i: integer
+    s: string
+ALGORITMA
+    s <- '500'
+    i traversal [1..10]
+        StringToInteger(s, i)
+        arr[i] <- 0
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("{$R-}") == std::string::npos);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+namespace {
+
+const std::string RECORD_SOURCE = R"(
+PROGRAM RecordLayoutTest
+KAMUS
+    type Sample: < active: boolean, value: real, tag: character, count: integer >
+    s: Sample
+ALGORITMA
+    s.count <- 1
+    output(s.count)
+)";
+
+} // namespace
+
+TEST(RecordLayoutTest, DeclaredOrderByDefault) {
+    std::string generated_pascal = transpile(RECORD_SOURCE);
+    EXPECT_TRUE(generated_pascal.find("Sample = record\n    active: boolean;\n    value: real;\n    tag: char;\n    count: integer;\n  end;") != std::string::npos);
+}
+
+TEST(RecordLayoutTest, ReorderedSortsByAlignmentAndKeepsDeclaredOrder) {
+    gate::transpiler::CodeGenOptions options;
+    options.recordLayout = gate::transpiler::RecordLayout::REORDERED;
+    std::string generated_pascal = transpile(RECORD_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("Sample = record\n    { declared order: active value tag count }\n    value: real;\n    count: integer;\n    active: boolean;\n    tag: char;\n  end;") != std::string::npos);
+}
+
+TEST(RecordLayoutTest, PackedKeepsDeclaredOrder) {
+    gate::transpiler::CodeGenOptions options;
+    options.recordLayout = gate::transpiler::RecordLayout::PACKED;
+    std::string generated_pascal = transpile(RECORD_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("Sample = packed record\n    active: boolean;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("declared order") == std::string::npos);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "driver/Server.h"
+#include <filesystem>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+const std::string SOURCE = R"(
+PROGRAM Squares
+KAMUS
+    i: integer
+ALGORITMA
+    i traversal [1..5]
+        output(i * i)
+)";
+
+const std::string BROKEN_SOURCE = R"(
+PROGRAM Broken
+KAMUS
+    n: integer
+ALGORITMA
+    n <-
+)";
+
+class ServeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        socketPath = (std::filesystem::temp_directory_path() / ("gate_serve_test_" + std::to_string(getpid()))).string();
+        std::filesystem::remove(socketPath);
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove(socketPath, ec);
+    }
+
+    gate::driver::TranspileResult request(int fd, const std::string& source, const gate::driver::Settings& settings = {}) {
+        gate::driver::ServeRequest serveRequest;
+        serveRequest.fileName = "squares.notal";
+        serveRequest.settings = settings;
+        serveRequest.source = source;
+        gate::driver::TranspileResult result;
+        std::string error;
+        EXPECT_TRUE(gate::driver::transpileRemote(fd, serveRequest, result, error)) << error;
+        return result;
+    }
+
+    std::string socketPath;
+};
+
+} // namespace
+
+TEST(ServeProtocolTest, RoundTripsRequestsAndResponses) {
+    gate::driver::ServeRequest request;
+    request.fileName = "a.notal";
+    request.settings = {{"profile", "release"}, {"memo", "true"}};
+    request.source = "PROGRAM A\n\nKAMUS\n";
+
+    gate::driver::ServeRequest decoded;
+    ASSERT_TRUE(gate::driver::decodeRequest(gate::driver::encodeRequest(request), decoded));
+    EXPECT_EQ(decoded.fileName, "a.notal");
+    EXPECT_EQ(decoded.settings, request.settings);
+    EXPECT_EQ(decoded.source, request.source);
+
+    gate::driver::TranspileResult result;
+    ASSERT_TRUE(gate::driver::decodeResponse(gate::driver::serveRequest(gate::driver::encodeRequest(request)), result));
+    EXPECT_FALSE(result.success);
+    ASSERT_FALSE(result.diagnostics.empty());
+    EXPECT_EQ(result.diagnostics[0].level, gate::diagnostics::DiagnosticLevel::ERROR);
+}
+
+TEST(ServeProtocolTest, RejectsMalformedRequestsAndUnknownSettings) {
+    gate::driver::TranspileResult result;
+    ASSERT_TRUE(gate::driver::decodeResponse(gate::driver::serveRequest("profile=release"), result));
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.errors, 1u);
+
+    gate::driver::TranspileResult unknown;
+    ASSERT_TRUE(gate::driver::decodeResponse(gate::driver::serveRequest("optimize=yes\n\n" + SOURCE), unknown));
+    EXPECT_FALSE(unknown.success);
+    ASSERT_EQ(unknown.diagnostics.size(), 1u);
+    EXPECT_EQ(unknown.diagnostics[0].message, "Unknown option 'optimize'.");
+}
+
+TEST_F(ServeTest, AnswersConcurrentConnections) {
+    gate::driver::Server server(socketPath, 4);
+    std::string error;
+    ASSERT_TRUE(server.listen(error)) << error;
+    std::thread serving([&] { server.run(); });
+
+    gate::transpiler::CodeGenOptions release;
+    release.profile = gate::transpiler::BuildProfile::RELEASE;
+    release.inlineThreshold = gate::transpiler::DEFAULT_INLINE_THRESHOLD;
+    release.unrollFactor = gate::transpiler::DEFAULT_UNROLL_FACTOR;
+    const std::string expected = transpile(SOURCE, release);
+
+    std::vector<std::thread> clients;
+    for (int c = 0; c < 6; ++c) {
+        clients.emplace_back([&] {
+            std::string connectError;
+            int fd = gate::driver::connectToServer(socketPath, connectError);
+            ASSERT_GE(fd, 0) << connectError;
+            for (int i = 0; i < 5; ++i) {
+                auto result = request(fd, SOURCE, {{"profile", "release"}});
+                EXPECT_TRUE(result.success);
+                EXPECT_EQ(result.code, expected);
+            }
+            auto broken = request(fd, BROKEN_SOURCE);
+            EXPECT_FALSE(broken.success);
+            EXPECT_GT(broken.errors, 0u);
+            EXPECT_TRUE(broken.code.empty());
+            close(fd);
+        });
+    }
+    for (auto& client : clients) client.join();
+
+    // A connection left open does not keep the server from stopping.
+    int idle = gate::driver::connectToServer(socketPath, error);
+    ASSERT_GE(idle, 0) << error;
+    server.stop();
+    serving.join();
+    close(idle);
+    EXPECT_EQ(server.requestCount(), 36u);
+}
+
+TEST_F(ServeTest, ReplacesStaleSocketButNotLiveServer) {
+    int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    ASSERT_EQ(bind(stale, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    close(stale);
+
+    gate::driver::Server server(socketPath, 1);
+    std::string error;
+    ASSERT_TRUE(server.listen(error)) << error;
+
+    gate::driver::Server second(socketPath, 1);
+    EXPECT_FALSE(second.listen(error));
+    EXPECT_NE(error.find("already listening"), std::string::npos);
+}
+
+TEST_F(ServeTest, IdleConnectionsDoNotHoldWorkers) {
+    gate::driver::Server server(socketPath, 2);
+    std::string error;
+    ASSERT_TRUE(server.listen(error)) << error;
+    std::thread serving([&] { server.run(); });
+
+    // More open connections than workers, one of them half-way through a request.
+    std::vector<int> idle;
+    for (int c = 0; c < 4; ++c) {
+        idle.push_back(gate::driver::connectToServer(socketPath, error));
+        ASSERT_GE(idle.back(), 0) << error;
+    }
+    request(idle[0], SOURCE);
+    const char partialLength[2] = {0, 0};
+    ASSERT_EQ(write(idle[1], partialLength, sizeof(partialLength)), 2);
+
+    int fd = gate::driver::connectToServer(socketPath, error);
+    ASSERT_GE(fd, 0) << error;
+    timeval timeout{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    for (int i = 0; i < 3; ++i) {
+        auto result = request(fd, SOURCE);
+        EXPECT_TRUE(result.success);
+    }
+    // The connections are still usable after waiting.
+    EXPECT_TRUE(request(idle[2], SOURCE).success);
+
+    server.stop();
+    serving.join();
+    close(fd);
+    for (int open : idle) close(open);
+    EXPECT_EQ(server.requestCount(), 5u);
+}
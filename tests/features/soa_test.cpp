@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+TEST(SoaTest, DisabledByDefault) {
+    std::string notal_code = R"(
+PROGRAM SoaOff
+KAMUS
+    type Student: < name: string, age: integer >
+    students: array[1..10] of Student
+ALGORITMA
+    students[1].age <- 20
+)";
+    std::string generated_pascal = transpile(notal_code);
+    EXPECT_TRUE(generated_pascal.find("students: array[1..10] of Student;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("students[1].age := 20;") != std::string::npos);
+}
+
+TEST(SoaTest, StaticArraySplitsIntoFieldArrays) {
+    std::string notal_code = R"(
+PROGRAM SoaStatic
+KAMUS
+    type Student: < name: string, age: integer >
+    students: array[1..10] of Student
+    i: integer
+    total: integer
+ALGORITMA
+    total <- 0
+    i traversal [1..10]
+        students[i].age <- i
+        total <- total + students[i].age
+    output(total)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.soa = true;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("{ struct-of-arrays: students of Student }") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("students_name: array[1..10] of string;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("students_age: array[1..10] of integer;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("students_age[i] := i;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("total := (total + students_age[i]);") != std::string::npos);
+}
+
+TEST(SoaTest, DynamicArrayAllocatesEveryField) {
+    std::string notal_code = R"(
+PROGRAM SoaDynamic
+KAMUS
+    type Point: < x: real, y: real >
+    points: array of Point
+    n: integer
+ALGORITMA
+    n <- 5
+    allocate(points, n)
+    points[0].x <- 1.5
+    output(length(points))
+    deallocate[1](points)
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.soa = true;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("points_x: array of real;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("SetLength(points_x, n);\n  SetLength(points_y, n);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("points_x[0] := 1.5;") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("writeln(length(points_x));") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("SetLength(points_x, 0);\n  SetLength(points_y, 0);") != std::string::npos);
+}
+
+TEST(SoaTest, WholeElementUseKeepsArrayOfRecords) {
+    std::string notal_code = R"(
+PROGRAM SoaWhole
+KAMUS
+    type Student: < name: string, age: integer >
+    students: array[1..10] of Student
+    best: Student
+ALGORITMA
+    students[1].age <- 20
+    best <- students[1]
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.soa = true;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("struct-of-arrays") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("students: array[1..10] of Student;") != std::string::npos);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+
+TEST(StringConcatTest, SingleConcatenationStaysBinary) {
+    std::string notal_code = R"(
+PROGRAM ConcatPair
+KAMUS
+    a: string
+    b: string
+ALGORITMA
+    a <- 'x'
+    b <- a & 'y'
+)";
+    std::string generated_pascal = transpile(notal_code);
+    EXPECT_TRUE(generated_pascal.find("b := (a + 'y');") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("Concat(") == std::string::npos);
+}
+
+TEST(StringConcatTest, ChainFlattensToOneConcat) {
+    std::string notal_code = R"(
+PROGRAM ConcatChain
+KAMUS
+    s: string
+    a: string
+    b: string
+    c: character
+ALGORITMA
+    a <- 'x'
+    b <- 'y'
+    c <- 'z'
+    s <- a & b & c & '!'
+)";
+    std::string generated_pascal = transpile(notal_code);
+    EXPECT_TRUE(generated_pascal.find("s := Concat(a, b, c, '!');") != std::string::npos);
+}
+
+TEST(StringConcatTest, ParenthesizedChainFlattens) {
+    std::string notal_code = R"(
+PROGRAM ConcatGrouped
+KAMUS
+    s: string
+    a: string
+ALGORITMA
+    a <- 'x'
+    s <- a & (a & 'y')
+)";
+    std::string generated_pascal = transpile(notal_code);
+    EXPECT_TRUE(generated_pascal.find("s := Concat(a, a, 'y');") != std::string::npos);
+}
+
+TEST(StringConcatTest, AccumulationKeepsTargetFirst) {
+    std::string notal_code = R"(
+PROGRAM ConcatLoop
+KAMUS
+    s: string
+    i: integer
+ALGORITMA
+    s <- ''
+    i traversal [1..20]
+        s <- s & '<' & '>'
+)";
+    std::string generated_pascal = transpile(notal_code);
+    EXPECT_TRUE(generated_pascal.find("s := Concat(s, '<', '>');") != std::string::npos);
+}
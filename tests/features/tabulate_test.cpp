@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+namespace {
+
+const std::string DOMAIN_SOURCE = R"(
+PROGRAM TabulateTest
+KAMUS
+    type Day: (mon, tue, wed)
+    c: character
+    d: Day
+    n, total: integer
+    s: string
+    function isVowel(input c: character) -> boolean
+    function dayName(input d: Day) -> string
+    function score(input x: integer | x >= 0 and x <= 4) -> integer
+ALGORITMA
+    if isVowel(c) then
+        s <- dayName(d)
+    total <- score(n) + score(2)
+
+function isVowel(input c: character) -> boolean
+ALGORITMA
+    -> (c = 'a') or (c = 'e') or (c = 'i') or (c = 'o') or (c = 'u')
+
+function dayName(input d: Day) -> string
+ALGORITMA
+    depend on (d)
+        mon: -> 'Monday'
+        tue: -> 'Tuesday'
+        otherwise: -> 'Wednesday'
+
+function score(input x: integer | x >= 0 and x <= 4) -> integer
+ALGORITMA
+    -> x * x - 3
+)";
+
+} // namespace
+
+
+TEST(TabulateTest, CharacterAndEnumFunctionsBecomeTables) {
+    gate::transpiler::CodeGenOptions options;
+    options.tabulate = true;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string generated_pascal = transpile(DOMAIN_SOURCE, options);
+    EXPECT_TRUE(generated_pascal.find("  _GateTab_isVowel: array[char] of boolean = (\n    false, false,") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("  _GateTab_dayName: array[Day] of string = (\n    'Monday', 'Tuesday', 'Wednesday');\n") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("if _GateTab_isVowel[c] then") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("s := _GateTab_dayName[d];") != std::string::npos);
+    // The function itself is still emitted
+    EXPECT_TRUE(generated_pascal.find("function isVowel(c: char): boolean;") != std::string::npos);
+
+    options.tabulate = false;
+    std::string plain = transpile(DOMAIN_SOURCE, options);
+    EXPECT_TRUE(plain.find("_GateTab_") == std::string::npos);
+}
+
+TEST(TabulateTest, ConstrainedIntegerIsTabulatedOverItsRange) {
+    gate::transpiler::CodeGenOptions options;
+    options.tabulate = true;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string release = transpile(DOMAIN_SOURCE, options);
+    EXPECT_TRUE(release.find("  _GateTab_score: array[0..4] of integer = (\n    -3, -2, 1, 6, 13);\n") != std::string::npos);
+    EXPECT_TRUE(release.find("total := (_GateTab_score[n] + _GateTab_score[2]);") != std::string::npos);
+
+    // Outside release the call stays, so the parameter constraint is checked
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string debug = transpile(DOMAIN_SOURCE, options);
+    EXPECT_TRUE(debug.find("_GateTab_score: array[0..4] of integer") != std::string::npos);
+    EXPECT_TRUE(debug.find("total := (score(n) + score(2));") != std::string::npos);
+    EXPECT_TRUE(debug.find("if _GateTab_isVowel[c] then") != std::string::npos);
+}
+
+TEST(TabulateTest, ParameterConstraintIsAssertedOnEntry) {
+    gate::transpiler::CodeGenOptions options;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string debug = transpile(DOMAIN_SOURCE, options);
+    EXPECT_TRUE(debug.find("Assert(((x >= 0) and (x <= 4)), 'Error: x constraint violation!');") != std::string::npos);
+
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string release = transpile(DOMAIN_SOURCE, options);
+    EXPECT_TRUE(release.find("x constraint violation") == std::string::npos);
+
+    std::string source = R"(
+PROGRAM BadConstraint
+KAMUS
+    procedure clamp(input/output x: integer | x >= 0)
+ALGORITMA
+    clamp(1)
+)";
+    EXPECT_EQ(transpile(source, options), "// Parsing failed: 1 errors");
+}
+
+TEST(TabulateTest, CallsViolatingAConstraintAreNotEvaluated) {
+    std::string source = R"(
+PROGRAM Violation
+KAMUS
+    constant BAD: integer = score(9)
+    t: integer
+    function score(input x: integer | x >= 0 and x <= 4) -> integer
+ALGORITMA
+    t <- score(9) + score(2)
+
+function score(input x: integer | x >= 0 and x <= 4) -> integer
+ALGORITMA
+    -> x * x - 3
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.tabulate = true;
+    options.constEval = true;
+    options.profile = gate::transpiler::BuildProfile::DEBUG;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("  BAD = score(9);\n") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("violates the constraint on x") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("78") == std::string::npos);
+    // The table only covers the allowed range and is still built
+    EXPECT_TRUE(generated_pascal.find("_GateTab_score: array[0..4] of integer") != std::string::npos);
+}
+
+TEST(TabulateTest, ImpureOrUnboundedFunctionsAreLeftAlone) {
+    std::string source = R"(
+PROGRAM Untabulated
+KAMUS
+    c: character
+    n: integer
+    function loud(input c: character) -> character
+    function twice(input n: integer) -> integer
+ALGORITMA
+    c <- loud(c)
+    n <- twice(n)
+
+function loud(input c: character) -> character
+ALGORITMA
+    output(c)
+    -> c
+
+function twice(input n: integer) -> integer
+ALGORITMA
+    -> n * 2
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.tabulate = true;
+    options.profile = gate::transpiler::BuildProfile::RELEASE;
+    std::string generated_pascal = transpile(source, options);
+    EXPECT_TRUE(generated_pascal.find("{ not tabulated: loud: does input/output }") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("c := loud(c);") != std::string::npos);
+    // An integer without a constraint has no small domain
+    EXPECT_TRUE(generated_pascal.find("n := twice(n);") != std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("twice:") == std::string::npos);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "core/PascalCodeGenerator.h"
+
+TEST(UnrollTest, DisabledByDefault) {
+    std::string notal_code = R"(
+PROGRAM UnrollOff
+KAMUS
+    x: integer
+ALGORITMA
+    x <- 0
+    repeat 3 times
+        x <- x + 1
+)";
+    std::string generated_pascal = transpile(notal_code);
+    EXPECT_TRUE(generated_pascal.find("for _loop_iterator_0 := 1 to 3 do") != std::string::npos);
+}
+
+TEST(UnrollTest, SmallCountUnrollsFullyWithoutIterator) {
+    std::string notal_code = R"(
+PROGRAM UnrollFull
+KAMUS
+    x: integer
+ALGORITMA
+    x <- 0
+    repeat 3 times
+        x <- x + 1
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.unrollFactor = 4;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("_loop_iterator_") == std::string::npos);
+    EXPECT_TRUE(generated_pascal.find("begin\n    x := (x + 1);\n    x := (x + 1);\n    x := (x + 1);\n  end;") != std::string::npos);
+}
+
+TEST(UnrollTest, LargeCountUnrollsByFactorWithRemainder) {
+    std::string notal_code = R"(
+PROGRAM UnrollPartial
+KAMUS
+    x: integer
+ALGORITMA
+    x <- 0
+    repeat 10 times
+        x <- x + 2
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.unrollFactor = 4;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("for _loop_iterator_0 := 1 to 2 do") != std::string::npos);
+    size_t copies = 0;
+    for (size_t pos = generated_pascal.find("x := (x + 2);"); pos != std::string::npos;
+         pos = generated_pascal.find("x := (x + 2);", pos + 1)) {
+        copies++;
+    }
+    EXPECT_EQ(copies, 6u);
+}
+
+TEST(UnrollTest, StopInBodyKeepsLoop) {
+    std::string notal_code = R"(
+PROGRAM UnrollStop
+KAMUS
+    x: integer
+ALGORITMA
+    x <- 0
+    repeat 3 times
+        x <- x + 1
+        if x > 1 then
+            stop
+)";
+    gate::transpiler::CodeGenOptions options;
+    options.unrollFactor = 4;
+    std::string generated_pascal = transpile(notal_code, options);
+    EXPECT_TRUE(generated_pascal.find("for _loop_iterator_0 := 1 to 3 do") != std::string::npos);
+}
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+
+namespace {
+
+const std::string RECORD_POINTER_SOURCE = R"(
+PROGRAM VmRecords
+KAMUS
+    type Point: < x: integer, y: integer >
+    type Node: < value: integer, next: pointer to Node >
+    p: Point
+    q: Point
+    pts: array[1..2] of Point
+    head: pointer to Node
+    cur: pointer to Node
+ALGORITMA
+    p.x <- 1
+    q <- p
+    q.x <- 10
+    pts[2].y <- 7
+    output(p.x, ' ', q.x, ' ', pts[2].y)
+    allocate(head)
+    head^.value <- 1
+    allocate(cur)
+    cur^.value <- 2
+    head^.next <- cur
+    output(head^.next^.value)
+    deallocate(cur)
+    output(head^.next^.value)
+)";
+
+const std::string SUBPROGRAM_SOURCE = R"(
+PROGRAM VmSubprograms
+KAMUS
+    i: integer
+    n: integer
+    procedure swap(input/output a: integer, input/output b: integer)
+    function fact(input k: integer) -> integer
+ALGORITMA
+    i <- 3
+    n <- 4
+    swap(i, n)
+    output(i, ' ', n, ' ', fact(10))
+
+procedure swap(input/output a: integer, input/output b: integer)
+KAMUS
+    t: integer
+ALGORITMA
+    t <- a
+    a <- b
+    b <- t
+
+function fact(input k: integer) -> integer
+ALGORITMA
+    if k <= 1 then
+        -> 1
+    else
+        -> k * fact(k - 1)
+)";
+
+} // namespace
+
+TEST(VmRunTest, WritesValuesLikeWriteLn) {
+    std::string source = R"(
+PROGRAM VmOutput
+KAMUS
+    type Color: (red, green, blue)
+    r: real
+    ok: boolean
+    col: Color
+ALGORITMA
+    r <- 7 / 2
+    ok <- r > 3
+    col <- green
+    output('r = ', r, ' ', ok, ' ', col, ' ', 2 ^ 10)
+    output(-2.5)
+)";
+    EXPECT_EQ(runNotal(source), "r =  3.5000000000000000E+000 TRUE green 1024\n-2.5000000000000000E+000\n");
+}
+
+TEST(VmRunTest, StaticArraysAndStrings) {
+    std::string source = R"(
+PROGRAM VmArrays
+KAMUS
+    grid: array[1..3][1..3] of integer
+    s: string
+    c: character
+    i: integer
+ALGORITMA
+    i traversal [1..3]
+        grid[i][i] <- i * 5
+    s <- 'hello'
+    s[1] <- 'J'
+    c <- s[2]
+    output(grid[2][2], ' ', grid[1][2], ' ', s, c, length(s))
+)";
+    EXPECT_EQ(runNotal(source), "10 0 Jelloe5\n");
+}
+
+TEST(VmRunTest, DynamicArraysGrowAndKeepContents) {
+    std::string source = R"(
+PROGRAM VmDynamic
+KAMUS
+    m: array of array of integer
+    i: integer
+ALGORITMA
+    allocate(m, 2, 2)
+    m[1][1] <- 5
+    allocate(m, 3, 3)
+    m[2][2] <- 9
+    output(length(m), ' ', m[1][1], ' ', m[2][2], ' ', m[0][2])
+)";
+    EXPECT_EQ(runNotal(source), "3 5 9 0\n");
+}
+
+TEST(VmRunTest, RecordsHaveValueSemanticsAndPointersFollowLinks) {
+    std::string output = runNotal(RECORD_POINTER_SOURCE);
+    EXPECT_TRUE(output.find("1 10 7\n2\n") == 0);
+    EXPECT_TRUE(output.find("Error: Line 24: Dereferencing a deallocated pointer.") != std::string::npos);
+}
+
+TEST(VmRunTest, ReferenceParametersAndRecursion) {
+    EXPECT_EQ(runNotal(SUBPROGRAM_SOURCE, "", 32), "4 3 3628800\n");
+}
+
+TEST(VmRunTest, IntegersFollowTheTargetWidth) {
+    std::string source = R"(
+PROGRAM VmOverflow
+KAMUS
+    n: integer
+ALGORITMA
+    input(n)
+    output(n + 1)
+    output(n * 2)
+)";
+    // 16-bit like the generated Pascal: a result that does not fit is an error, not a wider value
+    EXPECT_EQ(runNotal(source, "32766"), "32767\nError: Line 8: Arithmetic overflow: 65532 does not fit the 16-bit integer type.");
+    EXPECT_EQ(runNotal(source, "40000"), "Error: Line 6: Arithmetic overflow: 40000 does not fit the 16-bit integer type.");
+    EXPECT_EQ(runNotal(source, "32766", 32), "32767\n65532\n");
+    // fact(10) needs 32 bits
+    EXPECT_NE(runNotal(SUBPROGRAM_SOURCE).find("Arithmetic overflow"), std::string::npos);
+}
+
+TEST(VmRunTest, ReturnSetsTheResultWithoutLeaving) {
+    std::string source = R"(
+PROGRAM VmReturn
+KAMUS
+    constant C: integer = sgn(0 - 3)
+    function sgn(input n: integer) -> integer
+ALGORITMA
+    output(C, ' ', sgn(0 - 3))
+
+function sgn(input n: integer) -> integer
+ALGORITMA
+    if n < 0 then
+        -> -1
+    -> 1
+)";
+    // As in the Pascal build, the last value set is returned
+    EXPECT_EQ(runNotal(source), "1 1\n");
+}
+
+TEST(VmRunTest, SkipInTraversalAdvancesTheIterator) {
+    std::string source = R"(
+PROGRAM VmSkip
+KAMUS
+    i: integer
+    n: integer
+ALGORITMA
+    n <- 0
+    i traversal [1..10]
+        if i mod 2 = 0 then
+            skip
+        if i > 7 then
+            stop
+        n <- n + i
+    output(n)
+)";
+    EXPECT_EQ(runNotal(source), "16\n");
+}
+
+TEST(VmRunTest, ReadsInput) {
+    std::string source = R"(
+PROGRAM VmInput
+KAMUS
+    name: string
+    x: integer
+    r: real
+ALGORITMA
+    input(name)
+    input(x)
+    input(r)
+    output(name, ' ', x * 2, ' ', r)
+)";
+    EXPECT_EQ(runNotal(source, "Ada Lovelace\n  21 ignored\n0.5\n"), "Ada Lovelace 42  5.0000000000000000E-001\n");
+}
+
+TEST(VmRunTest, CastingBuiltins) {
+    std::string source = R"(
+PROGRAM VmCasting
+KAMUS
+    s: string
+    n: integer
+    ok: boolean
+ALGORITMA
+    IntegerToString(42, s)
+    ok <- StringToInteger(' 17 ', n)
+    output(s & '!', ' ', ok, ' ', n)
+    ok <- StringToInteger('x1', n)
+    output(ok, ' ', n)
+)";
+    EXPECT_EQ(runNotal(source), "42! TRUE 17\nFALSE 0\n");
+}
+
+TEST(VmRunTest, RuntimeErrorsReportTheLine) {
+    std::string source = R"(
+PROGRAM VmErrors
+KAMUS
+    a: array[1..3] of integer
+    age: integer | age >= 0 and age <= 150
+ALGORITMA
+    age <- 20
+    output(age)
+    age <- 200
+)";
+    EXPECT_EQ(runNotal(source), "20\nError: Line 9: Error: age constraint violation!");
+
+    std::string bounds = R"(
+PROGRAM VmBounds
+KAMUS
+    a: array[1..3] of integer
+    i: integer
+ALGORITMA
+    i <- 4
+    a[i] <- 1
+)";
+    EXPECT_EQ(runNotal(bounds), "Error: Line 8: Index 4 out of bounds 1..3.");
+}
+
+TEST(VmRunTest, CompileErrorsForUnsupportedConstructs) {
+    std::string source = R"(
+PROGRAM VmStop
+KAMUS
+    i: integer
+ALGORITMA
+    stop
+)";
+    EXPECT_TRUE(runNotal(source).find("'stop' used outside of a loop.") != std::string::npos);
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "../helpers/test_helpers.h"
+#include "driver/Watch.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+const std::string HELLO_SOURCE = R"(
+PROGRAM Hello
+KAMUS
+    n: integer
+ALGORITMA
+    n <- 3
+    output('n = ', n)
+)";
+
+const std::string BROKEN_SOURCE = R"(
+PROGRAM Broken
+KAMUS
+    n: integer
+ALGORITMA
+    n <-
+)";
+
+class WatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testDir = std::filesystem::temp_directory_path() / "gate_watch_test";
+        std::filesystem::remove_all(testDir);
+        std::filesystem::create_directories(testDir / "in" / "sub");
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(testDir, ec);
+    }
+
+    std::string writeInput(const std::string& name, const std::string& content) {
+        std::filesystem::path path = testDir / "in" / name;
+        std::ofstream(path) << content;
+        return path.string();
+    }
+
+    std::string readOutput(const std::string& name) {
+        std::ifstream in(testDir / "out" / name);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        return buffer.str();
+    }
+
+    gate::driver::WatchOptions options() {
+        gate::driver::WatchOptions watch;
+        watch.directory = (testDir / "in").string();
+        watch.outDir = (testDir / "out").string();
+        watch.jobs = 2;
+        watch.debounceMs = 10;
+        return watch;
+    }
+
+    std::filesystem::path testDir;
+};
+
+} // namespace
+
+TEST_F(WatchTest, InitialBuildMirrorsTheTree) {
+    writeInput("a.notal", HELLO_SOURCE);
+    writeInput("sub/b.notal", HELLO_SOURCE);
+    writeInput("notes.txt", "not a source");
+
+    gate::driver::Watcher watcher(options());
+    std::ostringstream out, err;
+    auto summary = watcher.rebuildAll(out, err);
+    EXPECT_EQ(summary.transpiled, 2u);
+    EXPECT_EQ(summary.written, 2u);
+    EXPECT_EQ(summary.failed, 0u);
+    EXPECT_EQ(readOutput("a.pas"), transpile(HELLO_SOURCE));
+    EXPECT_EQ(readOutput("sub/b.pas"), transpile(HELLO_SOURCE));
+    EXPECT_TRUE(err.str().empty()) << err.str();
+
+    summary = watcher.rebuildAll(out, err);
+    EXPECT_EQ(summary.transpiled, 0u);
+    EXPECT_EQ(summary.written, 0u);
+    EXPECT_EQ(summary.unchanged, 2u);
+}
+
+TEST_F(WatchTest, OutputsAreOnlyWrittenWhenTheirBytesChange) {
+    std::string file = writeInput("a.notal", HELLO_SOURCE);
+    gate::driver::Watcher watcher(options());
+    std::ostringstream out, err;
+    watcher.rebuildAll(out, err);
+
+    auto output = testDir / "out" / "a.pas";
+    auto past = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+    std::filesystem::last_write_time(output, past);
+
+    // A comment does not reach the generated code.
+    writeInput("a.notal", HELLO_SOURCE + "{ reviewed }\n");
+    auto summary = watcher.rebuild({file}, out, err);
+    EXPECT_EQ(summary.transpiled, 1u);
+    EXPECT_EQ(summary.written, 0u);
+    EXPECT_EQ(summary.unchanged, 1u);
+    EXPECT_EQ(std::filesystem::last_write_time(output), past);
+
+    std::string edited = HELLO_SOURCE;
+    edited.replace(edited.find("n <- 3"), 6, "n <- 4");
+    writeInput("a.notal", edited);
+    summary = watcher.rebuild({file}, out, err);
+    EXPECT_EQ(summary.written, 1u);
+    EXPECT_EQ(readOutput("a.pas"), transpile(edited));
+}
+
+TEST_F(WatchTest, ExistingCurrentOutputsAreAdopted) {
+    std::string file = writeInput("a.notal", HELLO_SOURCE);
+    std::filesystem::create_directories(testDir / "out");
+    std::ofstream(testDir / "out" / "a.pas") << transpile(HELLO_SOURCE);
+
+    gate::driver::Watcher watcher(options());
+    std::ostringstream out, err;
+    auto summary = watcher.rebuild({file}, out, err);
+    EXPECT_EQ(summary.transpiled, 1u);
+    EXPECT_EQ(summary.written, 0u);
+}
+
+TEST_F(WatchTest, FailuresAndRemovalsAreReported) {
+    std::string good = writeInput("a.notal", HELLO_SOURCE);
+    std::string broken = writeInput("b.notal", BROKEN_SOURCE);
+    gate::driver::Watcher watcher(options());
+    std::ostringstream out, err;
+    auto summary = watcher.rebuildAll(out, err);
+    EXPECT_EQ(summary.written, 1u);
+    EXPECT_EQ(summary.failed, 1u);
+    EXPECT_NE(err.str().find(broken + ": failed"), std::string::npos);
+    EXPECT_FALSE(std::filesystem::exists(testDir / "out" / "b.pas"));
+
+    std::filesystem::remove(good);
+    out.str("");
+    summary = watcher.rebuild({good}, out, err);
+    EXPECT_EQ(summary.transpiled, 0u);
+    EXPECT_NE(out.str().find(good + ": removed"), std::string::npos);
+}
+
+TEST_F(WatchTest, RebuildsFilesChangedWhileRunning) {
+    writeInput("a.notal", HELLO_SOURCE);
+    gate::driver::Watcher watcher(options());
+    std::string error;
+    ASSERT_TRUE(watcher.start(error)) << error;
+    std::ostringstream out, err;
+    watcher.rebuildAll(out, err);
+
+    std::thread runner([&] { watcher.run(out, err); });
+    std::filesystem::create_directories(testDir / "in" / "later");
+    writeInput("later/c.notal", HELLO_SOURCE);
+
+    auto output = testDir / "out" / "later" / "c.pas";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!std::filesystem::exists(output) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    watcher.stop();
+    runner.join();
+    EXPECT_EQ(readOutput("later/c.pas"), transpile(HELLO_SOURCE));
+}
+
+TEST_F(WatchTest, StartFailsForAMissingDirectory) {
+    auto watch = options();
+    watch.directory = (testDir / "missing").string();
+    gate::driver::Watcher watcher(watch);
+    std::string error;
+    EXPECT_FALSE(watcher.start(error));
+    EXPECT_FALSE(error.empty());
+}
@@ -1,14 +1,23 @@
 #include "test_helpers.h"
+#include "core/CCodeGenerator.h"
 #include "core/NotalLexer.h"
 #include "core/NotalParser.h"
 #include "core/PascalCodeGenerator.h"
 #include "diagnostics/DiagnosticEngine.h"
+#include "vm/BytecodeCompiler.h"
+#include "vm/VirtualMachine.h"
 #include <cctype>
 #include <regex>
+#include <sstream>
 #include <algorithm>
 
 // Helper function to transpile NOTAL code to Pascal
 std::string transpile(const std::string& notalCode) {
+    return transpile(notalCode, gate::transpiler::CodeGenOptions{});
+}
+
+// Helper function to transpile NOTAL code to Pascal with code generation options
+std::string transpile(const std::string& notalCode, const gate::transpiler::CodeGenOptions& options) {
     gate::diagnostics::DiagnosticEngine diagnosticEngine(notalCode, "test-helper");
     gate::transpiler::NotalLexer lexer(notalCode, "test-helper");
     std::vector<gate::core::Token> tokens = lexer.getAllTokens();
@@ -17,10 +26,58 @@ std::string transpile(const std::string& notalCode) {
     if (!program || diagnosticEngine.hasErrors()) {
         return "// Parsing failed: " + std::to_string(diagnosticEngine.getErrorCount()) + " errors";
     }
-    gate::transpiler::PascalCodeGenerator generator;
+    gate::transpiler::PascalCodeGenerator generator(options);
     return generator.generate(program);
 }
 
+// Helper function to transpile NOTAL code to C
+std::string transpileToC(const std::string& notalCode) {
+    return transpileToC(notalCode, gate::transpiler::CodeGenOptions{});
+}
+
+// Helper function to transpile NOTAL code to C with code generation options
+std::string transpileToC(const std::string& notalCode, const gate::transpiler::CodeGenOptions& options) {
+    gate::diagnostics::DiagnosticEngine diagnosticEngine(notalCode, "test-helper");
+    gate::transpiler::NotalLexer lexer(notalCode, "test-helper");
+    std::vector<gate::core::Token> tokens = lexer.getAllTokens();
+    gate::transpiler::NotalParser parser(tokens, diagnosticEngine);
+    std::shared_ptr<gate::ast::ProgramStmt> program = parser.parse();
+    if (!program || diagnosticEngine.hasErrors()) {
+        return "// Parsing failed: " + std::to_string(diagnosticEngine.getErrorCount()) + " errors";
+    }
+    try {
+        return gate::transpiler::CCodeGenerator(options).generate(program);
+    } catch (const std::exception& e) {
+        return std::string("Error: ") + e.what();
+    }
+}
+
+// Helper function to compile NOTAL code to bytecode and run it
+std::string runNotal(const std::string& notalCode, const std::string& input) {
+    return runNotal(notalCode, input, gate::transpiler::PASCAL_INTEGER_BITS);
+}
+
+// Helper function to run NOTAL code on the VM with integers of the given width in bits
+std::string runNotal(const std::string& notalCode, const std::string& input, int integerBits) {
+    gate::diagnostics::DiagnosticEngine diagnosticEngine(notalCode, "test-helper");
+    gate::transpiler::NotalLexer lexer(notalCode, "test-helper");
+    std::vector<gate::core::Token> tokens = lexer.getAllTokens();
+    gate::transpiler::NotalParser parser(tokens, diagnosticEngine);
+    std::shared_ptr<gate::ast::ProgramStmt> program = parser.parse();
+    if (!program || diagnosticEngine.hasErrors()) {
+        return "// Parsing failed: " + std::to_string(diagnosticEngine.getErrorCount()) + " errors";
+    }
+    std::istringstream in(input);
+    std::ostringstream out;
+    try {
+        gate::vm::Module module = gate::vm::BytecodeCompiler(integerBits).compile(program);
+        gate::vm::VirtualMachine(module, in, out).run();
+    } catch (const std::exception& e) {
+        out << "Error: " << e.what();
+    }
+    return out.str();
+}
+
 // Helper function to normalize whitespace and remove case sensitivity for comparison
 std::string normalizeCode(const std::string& s) {
     std::string result = s;
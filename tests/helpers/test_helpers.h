@@ -15,9 +15,29 @@ namespace gate::ast {
     struct ProgramStmt;
 }
 
+namespace gate::transpiler {
+    struct CodeGenOptions;
+}
+
 // Helper function to transpile NOTAL code to Pascal
 std::string transpile(const std::string& notalCode);
 
+// Helper function to transpile NOTAL code to Pascal with code generation options
+std::string transpile(const std::string& notalCode, const gate::transpiler::CodeGenOptions& options);
+
+// Helper function to transpile NOTAL code to C; returns "Error: <message>" if generation fails
+std::string transpileToC(const std::string& notalCode);
+
+// Helper function to transpile NOTAL code to C with code generation options
+std::string transpileToC(const std::string& notalCode, const gate::transpiler::CodeGenOptions& options);
+
+// Helper function to compile NOTAL code to bytecode and run it; returns the program output,
+// followed by "Error: <message>" if compiling or running fails
+std::string runNotal(const std::string& notalCode, const std::string& input = "");
+
+// Helper function to run NOTAL code on the VM with integers of the given width in bits
+std::string runNotal(const std::string& notalCode, const std::string& input, int integerBits);
+
 // Helper to remove extra whitespace and newlines for consistent comparison
 std::string normalizeCode(const std::string& s);
 